@@ -0,0 +1,303 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "adpcm_history.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if defined(ARDUINO)
+#include <esp_heap_caps.h>
+#endif
+
+namespace {
+
+constexpr int kMaxStepIndex = 88;
+
+// The standard IMA-ADPCM quantizer step sizes and index adjustments.
+const int16_t kStepSizes[kMaxStepIndex + 1] = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,
+    19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+    50,    55,    60,    66,    73,    80,    88,    97,    107,   118,
+    130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+    337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+    876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+    2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+    5894,  6484,  7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+
+const int8_t kIndexAdjustments[16] = {-1, -1, -1, -1, 2, 4, 6, 8,
+                                      -1, -1, -1, -1, 2, 4, 6, 8};
+
+// Applies a 4-bit code to the state, exactly as both sides of the codec must.
+inline void ApplyCode(AdpcmCoderState* state, int code) {
+  const int step = kStepSizes[state->step_index];
+  int32_t difference = step >> 3;
+  if (code & 4) {
+    difference += step;
+  }
+  if (code & 2) {
+    difference += step >> 1;
+  }
+  if (code & 1) {
+    difference += step >> 2;
+  }
+  int32_t predictor =
+      (code & 8) ? state->predictor - difference : state->predictor + difference;
+  if (predictor > std::numeric_limits<int16_t>::max()) {
+    predictor = std::numeric_limits<int16_t>::max();
+  } else if (predictor < std::numeric_limits<int16_t>::min()) {
+    predictor = std::numeric_limits<int16_t>::min();
+  }
+  state->predictor = predictor;
+  int step_index = state->step_index + kIndexAdjustments[code];
+  if (step_index < 0) {
+    step_index = 0;
+  } else if (step_index > kMaxStepIndex) {
+    step_index = kMaxStepIndex;
+  }
+  state->step_index = step_index;
+}
+
+}  // namespace
+
+void EncodeAdpcm(AdpcmCoderState* state, const int16_t* samples, int count,
+                 uint8_t* output, int first_nibble) {
+  for (int i = 0; i < count; ++i) {
+    int32_t difference = samples[i] - state->predictor;
+    int code = 0;
+    if (difference < 0) {
+      code = 8;
+      difference = -difference;
+    }
+    int step = kStepSizes[state->step_index];
+    if (difference >= step) {
+      code |= 4;
+      difference -= step;
+    }
+    step >>= 1;
+    if (difference >= step) {
+      code |= 2;
+      difference -= step;
+    }
+    step >>= 1;
+    if (difference >= step) {
+      code |= 1;
+    }
+    ApplyCode(state, code);
+    const int nibble = first_nibble + i;
+    output[nibble >> 1] |= static_cast<uint8_t>(code << ((nibble & 1) * 4));
+  }
+}
+
+void DecodeAdpcm(AdpcmCoderState* state, const uint8_t* codes, int first_nibble,
+                 int count, int16_t* output) {
+  for (int i = 0; i < count; ++i) {
+    const int nibble = first_nibble + i;
+    ApplyCode(state, (codes[nibble >> 1] >> ((nibble & 1) * 4)) & 0xf);
+    if (output != nullptr) {
+      output[i] = static_cast<int16_t>(state->predictor);
+    }
+  }
+}
+
+uint8_t* AllocateAdpcmHistoryMemory(size_t size) {
+#if defined(ARDUINO)
+  return static_cast<uint8_t*>(
+      heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+#else   // defined(ARDUINO)
+  return static_cast<uint8_t*>(malloc(size));
+#endif  // defined(ARDUINO)
+}
+
+AdpcmHistory::AdpcmHistory()
+    : memory_(nullptr), block_count_(0), origin_(0), write_index_(0) {
+  encoder_.predictor = 0;
+  encoder_.step_index = 0;
+}
+
+TfLiteStatus AdpcmHistory::Initialize(tflite::ErrorReporter* error_reporter,
+                                      uint8_t* memory, size_t memory_size) {
+  const size_t block_count = memory_size / kAdpcmBlockSize;
+  if ((memory == nullptr) || (block_count < 2)) {
+    error_reporter->Report("ADPCM history needs at least %d bytes",
+                           2 * kAdpcmBlockSize);
+    return kTfLiteError;
+  }
+  if (block_count > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    error_reporter->Report("ADPCM history memory is too large");
+    return kTfLiteError;
+  }
+  memory_ = memory;
+  block_count_ = static_cast<int>(block_count);
+  Reset(0);
+  return kTfLiteOk;
+}
+
+void AdpcmHistory::Reset(int64_t start_index) {
+  // An all-zero block decodes as silence, so the history starts out silent.
+  memset(memory_, 0, memory_used());
+  origin_ = start_index;
+  encoder_.predictor = 0;
+  encoder_.step_index = 0;
+  write_index_.store(start_index, std::memory_order_release);
+}
+
+uint8_t* AdpcmHistory::BlockAt(int64_t block_number) const {
+  return memory_ + (block_number % block_count_) * kAdpcmBlockSize;
+}
+
+void AdpcmHistory::StartBlock(int64_t block_number) {
+  uint8_t* block = BlockAt(block_number);
+  const int16_t predictor = static_cast<int16_t>(encoder_.predictor);
+  memcpy(block, &predictor, sizeof(predictor));
+  block[2] = static_cast<uint8_t>(encoder_.step_index);
+  block[3] = 0;
+  memset(block + kAdpcmBlockHeaderSize, 0,
+         kAdpcmBlockSize - kAdpcmBlockHeaderSize);
+}
+
+void AdpcmHistory::EncodeSamples(const int16_t* samples, int count) {
+  int64_t index = write_index_.load(std::memory_order_relaxed);
+  while (count > 0) {
+    const int64_t block_number = (index - origin_) / kAdpcmBlockSamples;
+    const int offset =
+        static_cast<int>((index - origin_) % kAdpcmBlockSamples);
+    if (offset == 0) {
+      StartBlock(block_number);
+    }
+    const int space = kAdpcmBlockSamples - offset;
+    const int chunk = (count < space) ? count : space;
+    EncodeAdpcm(&encoder_, samples, chunk,
+                BlockAt(block_number) + kAdpcmBlockHeaderSize, offset);
+    samples += chunk;
+    count -= chunk;
+    index += chunk;
+    // Readers rely on the writer never being more than one block ahead of the
+    // published index.
+    write_index_.store(index, std::memory_order_release);
+  }
+}
+
+void AdpcmHistory::AppendSilence(int64_t count) {
+  static const int16_t kZeros[kAdpcmBlockSamples] = {};
+  // Finish the current block through the coder, so it decodes cleanly.
+  const int offset = static_cast<int>(
+      (write_index_.load(std::memory_order_relaxed) - origin_) %
+      kAdpcmBlockSamples);
+  if (offset != 0) {
+    const int64_t space = kAdpcmBlockSamples - offset;
+    const int chunk = static_cast<int>((count < space) ? count : space);
+    EncodeSamples(kZeros, chunk);
+    count -= chunk;
+  }
+  // A whole block of silence is all zeros, which leaves the coder at rest.
+  int64_t index = write_index_.load(std::memory_order_relaxed);
+  int64_t whole_blocks = count / kAdpcmBlockSamples;
+  for (int64_t i = 0; (i < whole_blocks) && (i < block_count_); ++i) {
+    memset(BlockAt((index - origin_) / kAdpcmBlockSamples), 0,
+           kAdpcmBlockSize);
+    index += kAdpcmBlockSamples;
+    write_index_.store(index, std::memory_order_release);
+  }
+  if (whole_blocks > 0) {
+    encoder_.predictor = 0;
+    encoder_.step_index = 0;
+  }
+  // Once every block is silent, skipping the rest changes nothing.
+  if (whole_blocks > block_count_) {
+    index += (whole_blocks - block_count_) * kAdpcmBlockSamples;
+    write_index_.store(index, std::memory_order_release);
+  }
+  EncodeSamples(kZeros, static_cast<int>(count % kAdpcmBlockSamples));
+}
+
+void AdpcmHistory::Append(int64_t start_index, const int16_t* samples,
+                          int count) {
+  const int64_t write_index = write_index_.load(std::memory_order_relaxed);
+  if (start_index < write_index) {
+    const int64_t overlap = write_index - start_index;
+    if (overlap >= count) {
+      return;
+    }
+    samples += overlap;
+    count -= static_cast<int>(overlap);
+    start_index = write_index;
+  } else if (start_index > write_index) {
+    AppendSilence(start_index - write_index);
+  }
+  EncodeSamples(samples, count);
+}
+
+bool AdpcmHistory::AppendFromRing(AudioBroadcastRing* ring, int cursor) {
+  AudioRingView view;
+  ring->Peek(cursor, std::numeric_limits<int>::max(), &view);
+  Append(view.start_index, view.data[0], view.size[0]);
+  Append(view.start_index + view.size[0], view.data[1], view.size[1]);
+  return ring->Consume(cursor, view.total_size());
+}
+
+int64_t AdpcmHistory::OldestReadableIndex(int64_t write_index) const {
+  const int64_t writing_block = (write_index - origin_) / kAdpcmBlockSamples;
+  const int64_t oldest =
+      origin_ + (writing_block - block_count_ + 1) * kAdpcmBlockSamples;
+  return (oldest > origin_) ? oldest : origin_;
+}
+
+TfLiteStatus AdpcmHistory::Read(tflite::ErrorReporter* error_reporter,
+                                int64_t start_index, int count,
+                                int16_t* output) const {
+  const int64_t write_index = this->write_index();
+  if ((count < 0) || (start_index < OldestReadableIndex(write_index)) ||
+      (start_index + count > write_index)) {
+    error_reporter->Report(
+        "ADPCM history holds samples %d to %d, but %d from %d were requested",
+        static_cast<int>(OldestReadableIndex(write_index)),
+        static_cast<int>(write_index), count, static_cast<int>(start_index));
+    return kTfLiteError;
+  }
+
+  int64_t index = start_index;
+  while (count > 0) {
+    const int64_t block_number = (index - origin_) / kAdpcmBlockSamples;
+    const int offset =
+        static_cast<int>((index - origin_) % kAdpcmBlockSamples);
+    const uint8_t* block = BlockAt(block_number);
+    int16_t predictor;
+    memcpy(&predictor, block, sizeof(predictor));
+    AdpcmCoderState state;
+    state.predictor = predictor;
+    // A block that's being recycled can hold anything, so keep the index in
+    // range until the check below throws the result away.
+    state.step_index = (block[2] <= kMaxStepIndex) ? block[2] : kMaxStepIndex;
+    const uint8_t* codes = block + kAdpcmBlockHeaderSize;
+    DecodeAdpcm(&state, codes, 0, offset, nullptr);
+    const int space = kAdpcmBlockSamples - offset;
+    const int chunk = (count < space) ? count : space;
+    DecodeAdpcm(&state, codes, offset, chunk, output);
+    output += chunk;
+    count -= chunk;
+    index += chunk;
+  }
+
+  // Make sure the loads above happen before the writer's position is checked.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (start_index < OldestReadableIndex(this->write_index())) {
+    error_reporter->Report("ADPCM history was overwritten while being read");
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
@@ -0,0 +1,129 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_ADPCM_HISTORY_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_ADPCM_HISTORY_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "audio_broadcast_ring.h"
+#include "tensorflow/lite/c/c_api_internal.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+
+// A long second tier of audio history behind the capture ring. The ring only
+// holds about half a second, which is enough for feature generation but not
+// for keeping the audio leading up to a detection, so this stores tens of
+// seconds as 4-bit IMA-ADPCM in a large buffer, normally in PSRAM.
+//
+// The audio is split into blocks of kAdpcmBlockSamples, and each block starts
+// with the coder's predictor and step index. Any block can be decoded on its
+// own, so pulling out a range only costs decoding from the start of the block
+// it begins in, however much history there is. Blocks are kept in a ring, and
+// the oldest is dropped as each new one starts.
+//
+// One thread appends, and others may read at the same time. A read checks
+// afterwards whether the blocks it decoded were recycled while it was working,
+// in the same way as AudioBroadcastRing::IsViewIntact(), and fails if so.
+
+constexpr int kAdpcmBlockSamples = 512;
+// A 16-bit predictor, the step index and a reserved byte.
+constexpr int kAdpcmBlockHeaderSize = 4;
+constexpr int kAdpcmBlockSize = kAdpcmBlockHeaderSize + (kAdpcmBlockSamples / 2);
+
+// The coder's state between samples.
+struct AdpcmCoderState {
+  int32_t predictor;
+  int step_index;
+};
+
+// Encodes count samples as 4-bit codes, starting at nibble first_nibble of
+// output. Even nibbles go in the low half of each byte. The nibbles being
+// written must be zero beforehand.
+void EncodeAdpcm(AdpcmCoderState* state, const int16_t* samples, int count,
+                 uint8_t* output, int first_nibble);
+
+// Decodes count samples from codes starting at nibble first_nibble. output may
+// be nullptr, to move the state forward without storing anything.
+void DecodeAdpcm(AdpcmCoderState* state, const uint8_t* codes, int first_nibble,
+                 int count, int16_t* output);
+
+// Gets memory for an AdpcmHistory. On the device this comes from PSRAM, and
+// nullptr is returned if there isn't enough. Host builds use the normal heap.
+uint8_t* AllocateAdpcmHistoryMemory(size_t size);
+
+class AdpcmHistory {
+ public:
+  AdpcmHistory();
+
+  // Uses memory_size bytes of memory, which must outlive the history, and
+  // starts empty at sample index zero. At least two blocks are needed.
+  TfLiteStatus Initialize(tflite::ErrorReporter* error_reporter,
+                          uint8_t* memory, size_t memory_size);
+
+  // Empties the history and starts it again at start_index.
+  void Reset(int64_t start_index);
+
+  // Adds samples that start at start_index on the audio sample clock. Anything
+  // before write_index() is ignored, and a gap before start_index is filled
+  // with silence, or, if it's longer than the whole history, the history
+  // restarts at start_index. Only one thread may append.
+  void Append(int64_t start_index, const int16_t* samples, int count);
+
+  // Encodes everything the cursor hasn't read from ring yet and moves the
+  // cursor past it. Returns false if the ring overwrote some of it first, in
+  // which case that part of the history can't be trusted.
+  bool AppendFromRing(AudioBroadcastRing* ring, int cursor);
+
+  // Decodes count samples from start_index into output. Fails if any of them
+  // are older than oldest_index(), haven't been written yet, or were dropped
+  // while being decoded.
+  TfLiteStatus Read(tflite::ErrorReporter* error_reporter, int64_t start_index,
+                    int count, int16_t* output) const;
+
+  // The index after the newest sample held.
+  int64_t write_index() const {
+    return write_index_.load(std::memory_order_acquire);
+  }
+  // The oldest sample that's guaranteed to still be readable.
+  int64_t oldest_index() const { return OldestReadableIndex(write_index()); }
+  // How many samples the history holds once it's full.
+  int64_t capacity_samples() const {
+    return static_cast<int64_t>(block_count_ - 1) * kAdpcmBlockSamples;
+  }
+  size_t memory_used() const {
+    return static_cast<size_t>(block_count_) * kAdpcmBlockSize;
+  }
+
+ private:
+  // The oldest sample that the writer can't be recycling, given the last
+  // write index it published. The writer publishes whenever it finishes a
+  // block, so it can only be working on the block that index falls in.
+  int64_t OldestReadableIndex(int64_t write_index) const;
+  uint8_t* BlockAt(int64_t block_number) const;
+  void StartBlock(int64_t block_number);
+  void AppendSilence(int64_t count);
+  void EncodeSamples(const int16_t* samples, int count);
+
+  uint8_t* memory_;
+  int block_count_;
+  // Sample index where block zero starts.
+  int64_t origin_;
+  AdpcmCoderState encoder_;
+  std::atomic<int64_t> write_index_;
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_ADPCM_HISTORY_H_
@@ -0,0 +1,149 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "allocation_guard.h"
+
+#ifdef MICRO_SPEECH_ALLOCATION_GUARD
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* pointer, size_t size);
+#if defined(ARDUINO)
+void* __real_heap_caps_malloc(size_t size, uint32_t caps);
+void* __real_heap_caps_calloc(size_t count, size_t size, uint32_t caps);
+void* __real_heap_caps_realloc(void* pointer, size_t size, uint32_t caps);
+#endif  // defined(ARDUINO)
+}
+
+namespace {
+
+// Per thread, so other tasks can allocate freely while a guard is open.
+thread_local bool g_is_guarded = false;
+thread_local AllocationGuardAction g_action = kCountAllocations;
+thread_local int g_allocation_count = 0;
+
+void NoteAllocation() {
+  if (!g_is_guarded) {
+    return;
+  }
+  ++g_allocation_count;
+  if (g_action == kAbortOnAllocation) {
+    abort();
+  }
+}
+
+void* AllocateForNew(size_t size) {
+  NoteAllocation();
+  // operator new has to return a unique pointer even for zero bytes.
+  void* pointer = __real_malloc((size > 0) ? size : 1);
+  if (pointer == nullptr) {
+    abort();
+  }
+  return pointer;
+}
+
+}  // namespace
+
+void BeginAllocationGuard(AllocationGuardAction action) {
+  g_action = action;
+  g_allocation_count = 0;
+  g_is_guarded = true;
+}
+
+int EndAllocationGuard() {
+  g_is_guarded = false;
+  return g_allocation_count;
+}
+
+extern "C" {
+
+void* __wrap_malloc(size_t size) {
+  NoteAllocation();
+  return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+  NoteAllocation();
+  return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* pointer, size_t size) {
+  NoteAllocation();
+  return __real_realloc(pointer, size);
+}
+
+#if defined(ARDUINO)
+
+void* __wrap_heap_caps_malloc(size_t size, uint32_t caps) {
+  NoteAllocation();
+  return __real_heap_caps_malloc(size, caps);
+}
+
+void* __wrap_heap_caps_calloc(size_t count, size_t size, uint32_t caps) {
+  NoteAllocation();
+  return __real_heap_caps_calloc(count, size, caps);
+}
+
+void* __wrap_heap_caps_realloc(void* pointer, size_t size, uint32_t caps) {
+  NoteAllocation();
+  return __real_heap_caps_realloc(pointer, size, caps);
+}
+
+// The variadic arguments can't be passed on, so this does what the original
+// does, trying each set of capabilities in turn until one succeeds.
+void* __wrap_heap_caps_malloc_prefer(size_t size, size_t num, ...) {
+  NoteAllocation();
+  va_list caps_list;
+  va_start(caps_list, num);
+  void* pointer = nullptr;
+  for (size_t i = 0; (i < num) && (pointer == nullptr); ++i) {
+    pointer = __real_heap_caps_malloc(size, va_arg(caps_list, uint32_t));
+  }
+  va_end(caps_list);
+  return pointer;
+}
+
+#endif  // defined(ARDUINO)
+
+}  // extern "C"
+
+void* operator new(size_t size) { return AllocateForNew(size); }
+void* operator new[](size_t size) { return AllocateForNew(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  NoteAllocation();
+  return __real_malloc((size > 0) ? size : 1);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  NoteAllocation();
+  return __real_malloc((size > 0) ? size : 1);
+}
+void operator delete(void* pointer) noexcept { free(pointer); }
+void operator delete[](void* pointer) noexcept { free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { free(pointer); }
+
+#else  // MICRO_SPEECH_ALLOCATION_GUARD
+
+void BeginAllocationGuard(AllocationGuardAction action) {}
+
+int EndAllocationGuard() { return 0; }
+
+#endif  // MICRO_SPEECH_ALLOCATION_GUARD
@@ -0,0 +1,96 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_ALLOCATION_GUARD_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_ALLOCATION_GUARD_H_
+
+#include <cstdint>
+
+// Checks that code which should never touch the heap, like a steady-state pass
+// of loop(), really doesn't. A node runs for months, and a few allocations per
+// inference interleaved with everything else's slowly fragment the heap until
+// some larger request fails.
+//
+// The checks are only compiled in when MICRO_SPEECH_ALLOCATION_GUARD is
+// defined, and otherwise everything here does nothing. They replace the global
+// operator new and delete, and wrap malloc, calloc and realloc, which needs
+// the linker's help, so the build flags are:
+//
+//   -DMICRO_SPEECH_ALLOCATION_GUARD
+//   -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc
+//
+// On the device, ESP-IDF code mostly allocates through heap_caps_malloc() and
+// friends, and FreeRTOS's pvPortMalloc() calls heap_caps_malloc() too, none of
+// which go through malloc. Those are wrapped as well, so the device also needs:
+//
+//   -Wl,--wrap=heap_caps_malloc -Wl,--wrap=heap_caps_calloc
+//   -Wl,--wrap=heap_caps_realloc -Wl,--wrap=heap_caps_malloc_prefer
+//
+// That covers the ways the sketch, TFLM and the Arduino core allocate, but not
+// rarer entry points such as heap_caps_aligned_alloc(), or calls the heap
+// library makes to itself inside one object file, which the linker doesn't
+// redirect. On a host it misses allocations made inside shared libraries other
+// than through operator new. Only allocations from the thread or task that
+// opened a guard are counted, so the audio capture task isn't affected.
+
+constexpr bool kAllocationGuardCompiledIn =
+#ifdef MICRO_SPEECH_ALLOCATION_GUARD
+    true;
+#else
+    false;
+#endif
+
+enum AllocationGuardAction {
+  kCountAllocations,
+  // Calls abort() from inside the allocation, so the backtrace shows where it
+  // came from.
+  kAbortOnAllocation,
+};
+
+// Starts counting this thread's allocations. Guards don't nest.
+void BeginAllocationGuard(AllocationGuardAction action);
+
+// Stops counting, and returns how many allocations there were since
+// BeginAllocationGuard().
+int EndAllocationGuard();
+
+// Guards the rest of a scope if active is true, and adds the number of
+// allocations to *allocation_count when it ends.
+class ScopedAllocationGuard {
+ public:
+  ScopedAllocationGuard(bool active, AllocationGuardAction action,
+                        int64_t* allocation_count)
+      : active_(active), allocation_count_(allocation_count) {
+    if (active_) {
+      BeginAllocationGuard(action);
+    }
+  }
+  ~ScopedAllocationGuard() { Release(); }
+
+  // Ends the guard before the scope does, for work at the end of it that is
+  // allowed to allocate.
+  void Release() {
+    if (active_) {
+      *allocation_count_ += EndAllocationGuard();
+      active_ = false;
+    }
+  }
+
+ private:
+  bool active_;
+  int64_t* allocation_count_;
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_ALLOCATION_GUARD_H_
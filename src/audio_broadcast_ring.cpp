@@ -0,0 +1,183 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "audio_broadcast_ring.h"
+
+#include <cstring>
+
+AudioBroadcastRing::AudioBroadcastRing(int16_t* buffer, int capacity,
+                                       int max_write_size)
+    : buffer_(buffer),
+      capacity_(capacity),
+      max_write_size_(max_write_size),
+      write_index_(0) {
+  memset(buffer_, 0, capacity_ * sizeof(int16_t));
+  for (int i = 0; i < kMaxCursors; ++i) {
+    cursors_[i].in_use = false;
+    cursors_[i].name = nullptr;
+    cursors_[i].read_index = 0;
+    cursors_[i].dropped = 0;
+  }
+}
+
+void AudioBroadcastRing::Write(const int16_t* samples, int count) {
+  const int64_t start_index = write_index_.load(std::memory_order_relaxed);
+  const int offset = start_index % capacity_;
+  const int space_before_end = capacity_ - offset;
+  const int first_part = (count < space_before_end) ? count : space_before_end;
+  memcpy(buffer_ + offset, samples, first_part * sizeof(int16_t));
+  memcpy(buffer_, samples + first_part, (count - first_part) * sizeof(int16_t));
+  write_index_.store(start_index + count, std::memory_order_release);
+}
+
+int16_t* AudioBroadcastRing::BeginWrite(int count) {
+  const int offset = write_index_.load(std::memory_order_relaxed) % capacity_;
+  if (offset + count > capacity_) {
+    return nullptr;
+  }
+  return buffer_ + offset;
+}
+
+void AudioBroadcastRing::CommitWrite(int count) {
+  write_index_.store(write_index_.load(std::memory_order_relaxed) + count,
+                     std::memory_order_release);
+}
+
+void AudioBroadcastRing::Reset() {
+  memset(buffer_, 0, capacity_ * sizeof(int16_t));
+  write_index_.store(0, std::memory_order_release);
+  for (int i = 0; i < kMaxCursors; ++i) {
+    cursors_[i].read_index = 0;
+    cursors_[i].dropped = 0;
+  }
+}
+
+int AudioBroadcastRing::AddCursor(const char* name) {
+  for (int i = 0; i < kMaxCursors; ++i) {
+    Cursor& cursor = cursors_[i];
+    if (!cursor.in_use.load(std::memory_order_acquire)) {
+      cursor.name = name;
+      cursor.read_index.store(write_index(), std::memory_order_relaxed);
+      cursor.dropped.store(0, std::memory_order_relaxed);
+      cursor.in_use.store(true, std::memory_order_release);
+      return i;
+    }
+  }
+  return -1;
+}
+
+void AudioBroadcastRing::RemoveCursor(int cursor) {
+  cursors_[cursor].in_use.store(false, std::memory_order_release);
+}
+
+int64_t AudioBroadcastRing::OldestSafeIndex(int64_t write_index) const {
+  const int64_t oldest = write_index - capacity_ + max_write_size_;
+  return (oldest > 0) ? oldest : 0;
+}
+
+void AudioBroadcastRing::FillView(int64_t start_index, int count,
+                                  AudioRingView* view) const {
+  const int offset = start_index % capacity_;
+  const int space_before_end = capacity_ - offset;
+  view->start_index = start_index;
+  view->data[0] = buffer_ + offset;
+  view->size[0] = (count < space_before_end) ? count : space_before_end;
+  view->data[1] = buffer_;
+  view->size[1] = count - view->size[0];
+}
+
+void AudioBroadcastRing::Peek(int cursor, int max_samples,
+                              AudioRingView* view) {
+  Cursor& state = cursors_[cursor];
+  const int64_t write_index = this->write_index();
+  int64_t read_index = state.read_index.load(std::memory_order_relaxed);
+  const int64_t oldest_safe = OldestSafeIndex(write_index);
+  if (read_index < oldest_safe) {
+    state.dropped.fetch_add(oldest_safe - read_index,
+                            std::memory_order_relaxed);
+    read_index = oldest_safe;
+    state.read_index.store(read_index, std::memory_order_relaxed);
+  }
+  const int64_t available = write_index - read_index;
+  const int count =
+      (available < max_samples) ? static_cast<int>(available) : max_samples;
+  FillView(read_index, count, view);
+}
+
+bool AudioBroadcastRing::Consume(int cursor, int count) {
+  // Make sure the reader's loads of the samples happen before the producer's
+  // position is checked.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  Cursor& state = cursors_[cursor];
+  const int64_t read_index = state.read_index.load(std::memory_order_relaxed);
+  const int64_t oldest_safe = OldestSafeIndex(write_index());
+  state.read_index.store(read_index + count, std::memory_order_relaxed);
+  if (read_index < oldest_safe) {
+    const int64_t lost = oldest_safe - read_index;
+    state.dropped.fetch_add((lost < count) ? lost : count,
+                            std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+bool AudioBroadcastRing::ViewRange(int64_t start_index, int count,
+                                   AudioRingView* view) const {
+  const int64_t write_index = this->write_index();
+  if ((start_index < OldestSafeIndex(write_index)) ||
+      (start_index + count > write_index) || (count > capacity_)) {
+    return false;
+  }
+  FillView(start_index, count, view);
+  return true;
+}
+
+bool AudioBroadcastRing::IsViewIntact(const AudioRingView& view) const {
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return view.start_index >= OldestSafeIndex(write_index());
+}
+
+int64_t AudioBroadcastRing::lag(int cursor) const {
+  return write_index() -
+         cursors_[cursor].read_index.load(std::memory_order_relaxed);
+}
+
+int64_t AudioBroadcastRing::dropped(int cursor) const {
+  return cursors_[cursor].dropped.load(std::memory_order_relaxed);
+}
+
+int64_t AudioBroadcastRing::read_index(int cursor) const {
+  return cursors_[cursor].read_index.load(std::memory_order_relaxed);
+}
+
+const char* AudioBroadcastRing::name(int cursor) const {
+  return cursors_[cursor].name;
+}
+
+int AudioBroadcastRing::SlowestCursor() const {
+  int slowest = -1;
+  int64_t slowest_lag = -1;
+  for (int i = 0; i < kMaxCursors; ++i) {
+    if (!cursors_[i].in_use.load(std::memory_order_acquire)) {
+      continue;
+    }
+    const int64_t cursor_lag = lag(i);
+    if (cursor_lag > slowest_lag) {
+      slowest = i;
+      slowest_lag = cursor_lag;
+    }
+  }
+  return slowest;
+}
@@ -0,0 +1,134 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_AUDIO_BROADCAST_RING_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_AUDIO_BROADCAST_RING_H_
+
+#include <atomic>
+#include <cstdint>
+
+// A read-only window onto samples in an AudioBroadcastRing. The samples may
+// wrap around the end of the ring, so they come in up to two parts, and
+// together they start at start_index on the audio sample clock.
+struct AudioRingView {
+  int64_t start_index;
+  const int16_t* data[2];
+  int size[2];
+
+  int total_size() const { return size[0] + size[1]; }
+};
+
+// Holds the most recent audio from a single producer, like the capture task,
+// for any number of consumers to read at their own pace without copies. Each
+// consumer registers a cursor that marks how far it has read, so several
+// independent users, like the keyword spotter, a voice activity detector, a
+// recorder and a level meter, can share one capture buffer.
+//
+// The producer never waits for anyone. If a consumer falls more than a ring's
+// length behind, the audio it hadn't read yet is overwritten, its cursor is
+// moved up to the oldest sample that's still safe to read, and the skipped
+// samples are added to its drop count. Lag and drops are tracked per cursor so
+// the slowest reader can be found and reported.
+//
+// Views point straight into the ring, so the producer could overwrite them
+// while they're being used if the reader is very slow. Consume() and
+// IsViewIntact() check for that afterwards, in the same way as a sequence
+// lock, so readers can throw away anything that was damaged.
+class AudioBroadcastRing {
+ public:
+  static constexpr int kMaxCursors = 8;
+
+  // buffer must hold capacity samples and outlive the ring. max_write_size is
+  // the most the producer will ever add in one Write() or CommitWrite(), and
+  // sets how close to the write position readers can safely go.
+  AudioBroadcastRing(int16_t* buffer, int capacity, int max_write_size);
+
+  // Producer side. These must only be called from one thread.
+
+  // Copies samples into the ring and makes them visible to readers.
+  void Write(const int16_t* samples, int count);
+  // Returns where the next count samples will go, so the producer can fill
+  // them in place, or nullptr if they'd wrap around the end of the ring, in
+  // which case Write() has to be used instead. CommitWrite() publishes them.
+  int16_t* BeginWrite(int count);
+  void CommitWrite(int count);
+  // Clears the ring and moves the write position and every cursor back to
+  // zero, for when the source starts again from the beginning. Readers must
+  // not be using the ring while this happens.
+  void Reset();
+
+  // The index of the next sample to be written, which is also how many have
+  // been written so far.
+  int64_t write_index() const {
+    return write_index_.load(std::memory_order_acquire);
+  }
+  // The oldest sample that's safe to read given what's been written so far.
+  // Anything before it may be overwritten by the next write.
+  int64_t oldest_safe_index() const { return OldestSafeIndex(write_index()); }
+
+  // Consumer side. A cursor must only be moved by the thread that reads
+  // through it, but its lag and drop count can be checked from anywhere.
+
+  // Registers a new reader starting at the current write position, and
+  // returns its cursor, or -1 if all kMaxCursors are taken. name is only used
+  // for reporting and must stay valid while the cursor exists.
+  int AddCursor(const char* name);
+  void RemoveCursor(int cursor);
+
+  // Fills view with up to max_samples of the audio the cursor hasn't read
+  // yet, without moving it.
+  void Peek(int cursor, int max_samples, AudioRingView* view);
+  // Moves the cursor past count samples. Returns false if the producer
+  // overwrote any of them before the call, so their contents can't be
+  // trusted.
+  bool Consume(int cursor, int count);
+
+  // Gives a view of any range of samples that's still in the ring, for
+  // readers that need overlapping windows. Returns false if part of the range
+  // has been overwritten or hasn't arrived yet.
+  bool ViewRange(int64_t start_index, int count, AudioRingView* view) const;
+  // Returns false if the producer has overwritten part of view since it was
+  // taken.
+  bool IsViewIntact(const AudioRingView& view) const;
+
+  // How many written samples the cursor hasn't read yet.
+  int64_t lag(int cursor) const;
+  // How many samples the cursor has lost by falling too far behind.
+  int64_t dropped(int cursor) const;
+  int64_t read_index(int cursor) const;
+  const char* name(int cursor) const;
+  // The registered cursor with the most unread audio, or -1 if there are none.
+  int SlowestCursor() const;
+
+ private:
+  // The oldest sample that can't be overwritten by the next write.
+  int64_t OldestSafeIndex(int64_t write_index) const;
+  void FillView(int64_t start_index, int count, AudioRingView* view) const;
+
+  struct Cursor {
+    std::atomic<bool> in_use;
+    const char* name;
+    std::atomic<int64_t> read_index;
+    std::atomic<int64_t> dropped;
+  };
+
+  int16_t* buffer_;
+  int capacity_;
+  int max_write_size_;
+  std::atomic<int64_t> write_index_;
+  Cursor cursors_[kMaxCursors];
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_AUDIO_BROADCAST_RING_H_
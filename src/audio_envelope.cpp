@@ -0,0 +1,100 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "audio_envelope.h"
+
+namespace {
+
+uint32_t IntegerSquareRoot(uint64_t value) {
+  uint64_t root = 0;
+  uint64_t bit = uint64_t{1} << 62;
+  while (bit > value) {
+    bit >>= 2;
+  }
+  while (bit != 0) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return static_cast<uint32_t>(root);
+}
+
+}  // namespace
+
+void ComputeAudioEnvelope(const int16_t* samples, int count,
+                          int64_t start_index, AudioEnvelope* envelope) {
+  envelope->start_index = start_index;
+  envelope->sample_count = count;
+  if (count <= 0) {
+    envelope->min = 0;
+    envelope->max = 0;
+    envelope->rms = 0;
+    return;
+  }
+  int32_t min = samples[0];
+  int32_t max = samples[0];
+  uint64_t sum_of_squares = 0;
+  for (int i = 0; i < count; ++i) {
+    const int32_t sample = samples[i];
+    min = (sample < min) ? sample : min;
+    max = (sample > max) ? sample : max;
+    sum_of_squares += static_cast<uint32_t>(sample * sample);
+  }
+  envelope->min = static_cast<int16_t>(min);
+  envelope->max = static_cast<int16_t>(max);
+  const uint32_t rms = IntegerSquareRoot(sum_of_squares / count);
+  // Only a block of nothing but -32768 can go past int16's range.
+  envelope->rms = static_cast<int16_t>((rms > 32767) ? 32767 : rms);
+}
+
+AudioEnvelopeChannel::AudioEnvelopeChannel()
+    : write_count_(0), read_count_(0), dropped_(0) {}
+
+bool AudioEnvelopeChannel::Publish(const AudioEnvelope& envelope) {
+  const uint32_t write_count = write_count_.load(std::memory_order_relaxed);
+  if (write_count - read_count_.load(std::memory_order_acquire) >=
+      static_cast<uint32_t>(kCapacity)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  slots_[write_count & (kCapacity - 1)] = envelope;
+  write_count_.store(write_count + 1, std::memory_order_release);
+  return true;
+}
+
+int AudioEnvelopeChannel::Receive(AudioEnvelope* envelopes, int max_count) {
+  const uint32_t read_count = read_count_.load(std::memory_order_relaxed);
+  const uint32_t waiting =
+      write_count_.load(std::memory_order_acquire) - read_count;
+  const int count = (waiting < static_cast<uint32_t>(max_count))
+                        ? static_cast<int>(waiting)
+                        : max_count;
+  for (int i = 0; i < count; ++i) {
+    envelopes[i] = slots_[(read_count + i) & (kCapacity - 1)];
+  }
+  // Hands the slots back to the writer only once they've been copied.
+  read_count_.store(read_count + count, std::memory_order_release);
+  return count;
+}
+
+void AudioEnvelopeChannel::Reset() {
+  write_count_.store(0, std::memory_order_relaxed);
+  read_count_.store(0, std::memory_order_relaxed);
+  dropped_.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,70 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_AUDIO_ENVELOPE_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_AUDIO_ENVELOPE_H_
+
+#include <atomic>
+#include <cstdint>
+
+// A summary of one captured block of audio, for drawing a waveform overview or
+// logging levels without handling every sample.
+struct AudioEnvelope {
+  // Where the block starts on the LatestAudioSampleIndex() clock.
+  int64_t start_index;
+  int32_t sample_count;
+  int16_t min;
+  int16_t max;
+  int16_t rms;
+};
+
+// Fills envelope with the extremes and RMS level of count samples.
+void ComputeAudioEnvelope(const int16_t* samples, int count,
+                          int64_t start_index, AudioEnvelope* envelope);
+
+// Carries envelopes from the capture task to whoever displays them. There's
+// one writer and one reader, and neither ever blocks: the writer publishes an
+// envelope with a single store, and the reader takes everything that's waiting
+// in one batch. If the reader falls kCapacity envelopes behind, new ones are
+// dropped and counted until it catches up.
+class AudioEnvelopeChannel {
+ public:
+  // About two seconds of capture blocks. Must be a power of two.
+  static constexpr int kCapacity = 64;
+
+  AudioEnvelopeChannel();
+
+  // Writer side. Returns false if the channel was full.
+  bool Publish(const AudioEnvelope& envelope);
+
+  // Reader side. Copies up to max_count of the oldest waiting envelopes into
+  // envelopes, and returns how many there were.
+  int Receive(AudioEnvelope* envelopes, int max_count);
+
+  // Empties the channel. Neither side can be using it while this happens.
+  void Reset();
+
+  // How many envelopes were dropped because the channel was full.
+  int64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  AudioEnvelope slots_[kCapacity];
+  // Both only ever count up, and wrap around together.
+  std::atomic<uint32_t> write_count_;
+  std::atomic<uint32_t> read_count_;
+  std::atomic<int64_t> dropped_;
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_AUDIO_ENVELOPE_H_
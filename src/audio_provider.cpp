@@ -14,11 +14,18 @@
   ==============================================================================*/
 
 #include "audio_provider.h"
+#include "audio_broadcast_ring.h"
+#include "audio_envelope.h"
+#include "i2s_slot_converter.h"
 #include "micro_model_settings.h"
+#include "resampler.h"
 #include <Arduino.h>
 #include <driver/i2s.h>
 
 #define I2S_NUM           I2S_NUM_0           // 0 or 1
+// Any rate PolyphaseResampler supports can be used here, and the audio is
+// brought down to kAudioSampleFrequency before it reaches the ring buffer.
+// 可选16000、32000、44100或48000，非16kHz的音频在进入环形缓冲区前重采样
 #define I2S_SAMPLE_RATE   16000
 
 #define I2S_PIN_CLK       21 // 26
@@ -28,30 +35,61 @@
 
 #define BUFFER_SIZE       512
 
+// Enough for the I2S read and one block of conversion. Check the high-water
+// mark in the memory report before changing it.
+// 录音任务的栈大小（字节），修改前请查看内存报告中的栈高水位
+#define AUDIO_RECORDING_TASK_STACK_SIZE 2048
+
+// The microphone sends 24-bit samples in 32-bit slots. Each slot is shifted
+// right by I2S_SLOT_SHIFT, which at 16 keeps the level the same as reading
+// the top 16 bits directly, with a fine Q15 gain on top. The DC bias is
+// tracked with a time constant of about 2^I2S_DC_ADAPTATION_SHIFT blocks.
+// 麦克风在32位槽中发送24位样本，右移、增益、去直流在一次遍历中完成
+#define I2S_SLOT_SHIFT            16
+#define I2S_SLOT_GAIN             32768 // 1.0
+#define I2S_DC_ADAPTATION_SHIFT   2
+
 void CaptureSamples();
-extern QueueHandle_t xQueueAudioWave;
 
 namespace {
 bool g_is_audio_initialized = false;
+TaskHandle_t g_audio_recording_task = nullptr;
 // An internal buffer able to fit 16x our sample size
 // 能够容纳16倍样本大小的内部缓冲区
 constexpr int kAudioCaptureBufferSize = BUFFER_SIZE * 16;
 
-// 1s的采样数据
+// 0.5s的采样数据
 int16_t g_audio_capture_buffer[kAudioCaptureBufferSize];
 
+// Shares the captured audio between any number of readers. The capture task
+// is the only writer, and never adds more than a block at a time.
+// 多个消费者共享的采集环形缓冲区，录音任务是唯一的写入者
+AudioBroadcastRing g_audio_ring(g_audio_capture_buffer,
+                                kAudioCaptureBufferSize, BUFFER_SIZE);
+
+// A min/max/RMS summary of every captured block, for waveform displays
+// 每个采集块的最小值/最大值/均方根，供波形显示使用
+AudioEnvelopeChannel g_audio_envelope_channel;
+
 // A buffer that holds our output
 // 保存输出的缓冲区
 int16_t g_audio_output_buffer[kMaxAudioSampleSize];
 
-// Mark as volatile so we can check in a while loop to see if
-// any samples have arrived yet.
-// 标记为易失性，这样我们就可以在while循环中检查是否有样品到达。
-volatile int32_t g_latest_audio_timestamp = 0;
+// Our buffer for collecting a block of raw 32-bit I2S slots
+// 用于收集一块32位I2S原始数据的缓冲区
+int32_t g_i2s_slot_buffer[BUFFER_SIZE];
+
+// Bias tracking and gain for turning the slots into 16-bit samples
+// 32位槽转换为16位样本的状态（直流估计、增益）
+I2sSlotConverterState g_slot_converter;
 
-// Our callback buffer for collecting a chunk of data
-// 用于收集数据块的回调缓冲区
-volatile int16_t recording_buffer[BUFFER_SIZE];
+// Used when the microphone doesn't run at kAudioSampleFrequency. Every
+// supported rate is higher, so a block never resamples to more samples than
+// it started with.
+// 麦克风采样率不是16kHz时使用的重采样器及其缓冲区
+PolyphaseResampler g_resampler;
+int16_t g_converted_buffer[BUFFER_SIZE];
+int16_t g_resampled_buffer[BUFFER_SIZE];
 
 }  // namespace
 
@@ -59,8 +97,8 @@ void InitI2S()
 {
   i2s_config_t i2s_config = {
     .mode                 = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX), // 主机/接收模式
-    .sample_rate          = I2S_SAMPLE_RATE, // 采样频率 16kHz
-    .bits_per_sample      = I2S_BITS_PER_SAMPLE_16BIT, // 样本量化等级 2字节
+    .sample_rate          = I2S_SAMPLE_RATE, // 采样频率，默认16kHz
+    .bits_per_sample      = I2S_BITS_PER_SAMPLE_32BIT, // 样本量化等级 4字节（24位数据在32位槽中）
     .channel_format       = I2S_CHANNEL_FMT_ONLY_LEFT, // 仅左声道；FMT是音频文件格式的缩写，它是一种基于WAV文件格式的音频数据压缩技术
     .communication_format = I2S_COMM_FORMAT_I2S, // 通讯格式：I2S
     .intr_alloc_flags     = ESP_INTR_FLAG_LEVEL1,
@@ -96,56 +134,19 @@ void InitI2S()
   // 配置引脚
   i2s_set_pin(I2S_NUM, &pin_config);
   // 配置采样频率，量化等级，单声道
-  i2s_set_clk(I2S_NUM, I2S_SAMPLE_RATE, I2S_BITS_PER_SAMPLE_16BIT, I2S_CHANNEL_MONO);
+  i2s_set_clk(I2S_NUM, I2S_SAMPLE_RATE, I2S_BITS_PER_SAMPLE_32BIT, I2S_CHANNEL_MONO);
 }
 
 /**
  * 录音任务
 */
 void AudioRecordingTask(void *pvParameters) {
-  static uint16_t audio_idx = 0;
   size_t bytes_read;
-  int16_t i2s_data;
-  int16_t sample;
 
   while (1) {
-
-    if (audio_idx >= BUFFER_SIZE) {
-      /**
-       * 这是一个调用xQueueGenericSend()的宏。
-       * 包含它是为了向后兼容不包含xQueueSendToFront()和xQueueSendToBack()宏的FreeRTOS.org版本。
-       * 它相当于xQueueSendToBack()。
-       * 
-       * 在队列上张贴一个项目。
-       * 项按拷贝而不是按引用排队。
-       * 这个函数不能从中断服务例程中调用。
-       * 请参阅xQueueSendFromISR()以获取可在ISR中使用的替代方法。
-       * 
-       * @param xQueue 队列的句柄，项目将在该队列上发布。
-       * @param pvItemToQueue
-       * 指向要放在队列上的项的指针。
-       * 时定义队列将保存的项的大小
-       * 队列被创建，所以这些字节将从pvItemToQueue复制
-       * 到队列存储区域。
-       * 
-       * @param xTicksToWait
-       * 如果队列已经满了，任务应该阻塞等待队列上可用空间的最大时间。
-       * 如果该值设置为0并且队列已满，则调用将立即返回。
-       * 时间以刻度周期定义，因此如果需要，应该使用常量portTICK_PERIOD_MS来转换为实时时间。
-       * 
-       * @return pdTRUE 如果条目已成功发布，则返回errQUEUE_FULL。
-      */
-      xQueueSend(xQueueAudioWave, &sample, 0);
-
-      // 循环512次，经历32ms，抓取一次样本，一次抓取512个样本，1024字节
-      CaptureSamples();
-
-      audio_idx = 0;
-    }
-
     /**
       * 从I2S DMA接收缓冲区读取数据
-      * 【每次读取1个样本，2字节数据】
+      * 【每次读取一整块，512个32位样本槽，2048字节】
       *
       * @param i2s_num I2S端口号
       * @param dest 要读入的目的地址
@@ -161,57 +162,68 @@ void AudioRecordingTask(void *pvParameters) {
       *     - ESP_OK               Success
       *     - ESP_ERR_INVALID_ARG  Parameter error
       */
-    i2s_read(I2S_NUM_0, &i2s_data, 2, &bytes_read, portMAX_DELAY );
-
-    if (bytes_read > 0) {
-      //sample = (0xfff - (i2s_data & 0xfff)) - 0x800;
-      sample = i2s_data;
-      // 样本数据存储到样本缓冲区
-      recording_buffer[audio_idx] = sample;
-      audio_idx++;
+    i2s_read(I2S_NUM_0, g_i2s_slot_buffer, sizeof(g_i2s_slot_buffer), &bytes_read, portMAX_DELAY);
+    if (bytes_read < sizeof(g_i2s_slot_buffer)) {
+      continue;
     }
 
+    // 512个样本，32ms，转换后直接写入环形缓冲区，并发布该块的包络
+    CaptureSamples();
   }
 }
 
 /**
- * 每调用一次，g_latest_audio_timestamp 增加32ms, 512个样本，1024字节
+ * 每调用一次处理一块（512个样本槽），16kHz时样本计数增加512个样本（32ms），并发布该块的包络
 */
 void CaptureSamples() {
-  // This is how many bytes of new data we have each time this is called
-  // 这是每次调用这个函数时我们有多少新数据
-  const int number_of_samples = BUFFER_SIZE;
-
-  // Calculate what timestamp the last audio sample represents
-  // 计算最后一个音频样本所代表的时间戳
-  const int32_t time_in_ms = // 32ms, 64ms, 96ms, 128ms, ...
-    g_latest_audio_timestamp +
-    (number_of_samples / (kAudioSampleFrequency / 1000)); // 每次 + 32ms
-
-  // Determine the index, in the history of all samples, of the last sample
-  // 确定所有样本历史中最后一个样本的索引
-  const int32_t start_sample_offset =
-    g_latest_audio_timestamp * (kAudioSampleFrequency / 1000); // 0, 512, 1024, 1536, 2048, ... , 7680, 8192, 8704, ...
-
-  // Determine the index of this sample in our ring buffer
-  // 确定此示例在环形缓冲区中的索引
-  const int capture_index = start_sample_offset % kAudioCaptureBufferSize; // 0, 512, 1024, 1536, 2048, ... , 7680, 0, 512, ...
-
-  // Read the data to the correct place in our buffer, note 2 bytes per buffer entry
-  // 将数据读入缓冲区中的正确位置，注意每个缓冲区条目2字节
-  memcpy(g_audio_capture_buffer + capture_index, (void *)recording_buffer, BUFFER_SIZE * 2);
-
-  // This is how we let the outside world know that new audio data has arrived.
-  // 这就是我们让外界知道新的音频数据已经到来的方式。
-  g_latest_audio_timestamp = time_in_ms;
-
-  //int peak = (max_audio - min_audio);
-  //Serial.printf("peak-to-peak:  %6d\n", peak);
+  AudioEnvelope envelope;
+  int16_t* destination = g_resampler.is_passthrough()
+    ? g_audio_ring.BeginWrite(BUFFER_SIZE) : nullptr;
+  if (destination != nullptr) {
+    // Convert the raw slots straight into the correct place in our buffer.
+    // Blocks are always BUFFER_SIZE long here, so they never straddle the end.
+    // 将原始数据直接转换到缓冲区中的正确位置
+    ConvertI2sSlots(&g_slot_converter, g_i2s_slot_buffer, BUFFER_SIZE,
+                    destination);
+    ComputeAudioEnvelope(destination, BUFFER_SIZE, g_audio_ring.write_index(),
+                         &envelope);
+    // This is how we let the outside world know that new audio data has
+    // arrived.
+    // 这就是我们让外界知道新的音频数据已经到来的方式。
+    g_audio_ring.CommitWrite(BUFFER_SIZE);
+  } else {
+    // The resampler produces a varying number of samples per block, so they
+    // can wrap around the end of the ring buffer.
+    // 重采样后每块的样本数不固定，写入时可能绕回环形缓冲区开头
+    ConvertI2sSlots(&g_slot_converter, g_i2s_slot_buffer, BUFFER_SIZE,
+                    g_converted_buffer);
+    const int number_of_samples = g_resampler.Process(
+      g_converted_buffer, BUFFER_SIZE, g_resampled_buffer);
+    if (number_of_samples == 0) {
+      return;
+    }
+    ComputeAudioEnvelope(g_resampled_buffer, number_of_samples,
+                         g_audio_ring.write_index(), &envelope);
+    g_audio_ring.Write(g_resampled_buffer, number_of_samples);
+  }
+  // Never waits. If nobody is reading, the envelope is counted as dropped.
+  // 从不等待，没有读者时该包络计为丢弃
+  g_audio_envelope_channel.Publish(envelope);
 }
 
 // 初始化一次
-TfLiteStatus InitAudioRecording(tflite::ErrorReporter* error_reporter) {
-  delay(10);
+TfLiteStatus StartAudioRecording(tflite::ErrorReporter* error_reporter) {
+  TfLiteStatus converter_status = InitI2sSlotConverter(
+    error_reporter, I2S_SLOT_SHIFT, I2S_SLOT_GAIN, I2S_DC_ADAPTATION_SHIFT,
+    &g_slot_converter);
+  if (converter_status != kTfLiteOk) {
+    return converter_status;
+  }
+  TfLiteStatus resampler_status =
+    g_resampler.Initialize(error_reporter, I2S_SAMPLE_RATE);
+  if (resampler_status != kTfLiteOk) {
+    return resampler_status;
+  }
 
   // 初始化配置
   InitI2S();
@@ -235,64 +247,92 @@ TfLiteStatus InitAudioRecording(tflite::ErrorReporter* error_reporter) {
   xTaskCreatePinnedToCore(
     AudioRecordingTask, 
     "AudioRecordingTask", 
-    2048, 
+    AUDIO_RECORDING_TASK_STACK_SIZE, 
     NULL, 
     10, 
-    NULL, 
+    &g_audio_recording_task, 
     0);
 
-  // 直到我们得到第一个音频样本
-  while (!g_latest_audio_timestamp) {
-    delay(1);
-  }
+  // There's no need to wait for the first block here. Until it arrives the
+  // timestamp stays at zero and the ring buffer holds silence, which the
+  // feature provider handles like any other quiet audio, so callers can get on
+  // with their own initialization while the DMA fills up.
+  // 这里不需要等待第一个音频块，调用者可以同时进行其他初始化。
 
   return kTfLiteOk;
 }
 
-/**
- * 一次回调 30ms 512个样本 1024字节
-*/
-TfLiteStatus GetAudioSamples(tflite::ErrorReporter* error_reporter,
-                             int start_ms, int duration_ms,
-                             int* audio_samples_size, int16_t** audio_samples) {
+TfLiteStatus InitAudioRecording(tflite::ErrorReporter* error_reporter) {
   // Set everything up to start receiving audio
   // 设置好一切，开始接收音频
   if (!g_is_audio_initialized) {
-    TfLiteStatus init_status = InitAudioRecording(error_reporter);
+    TfLiteStatus init_status = StartAudioRecording(error_reporter);
     if (init_status != kTfLiteOk) {
       return init_status;
     }
     g_is_audio_initialized = true;
   }
+  return kTfLiteOk;
+}
+
+/**
+ * 一次回调 30ms 480个样本 960字节
+*/
+TfLiteStatus GetAudioSamples(tflite::ErrorReporter* error_reporter,
+                             int start_ms, int duration_ms,
+                             int* audio_samples_size, int16_t** audio_samples) {
+  return GetAudioSampleRange(
+    error_reporter, static_cast<int64_t>(start_ms) * kAudioSamplesPerMs,
+    duration_ms * kAudioSamplesPerMs, audio_samples_size, audio_samples);
+}
+
+TfLiteStatus GetAudioSampleRange(tflite::ErrorReporter* error_reporter,
+                                 int64_t start_sample, int sample_count,
+                                 int* audio_samples_size,
+                                 int16_t** audio_samples) {
+  TfLiteStatus init_status = InitAudioRecording(error_reporter);
+  if (init_status != kTfLiteOk) {
+    return init_status;
+  }
+  if ((sample_count < 0) || (sample_count > kMaxAudioSampleSize)) {
+    error_reporter->Report("Requested %d audio samples, at most %d allowed",
+                           sample_count, kMaxAudioSampleSize);
+    return kTfLiteError;
+  }
   // This next part should only be called when the main thread notices that the
-  // latest audio sample data timestamp has changed, so that there's new data
-  // in the capture ring buffer. The ring buffer will eventually wrap around and
+  // latest audio sample index has changed, so that there's new data in the
+  // capture ring buffer. The ring buffer will eventually wrap around and
   // overwrite the data, but the assumption is that the main thread is checking
   // often enough and the buffer is large enough that this call will be made
-  // before that happens.
+  // before that happens. If it isn't, the lost samples read as silence rather
+  // than whatever has replaced them.
 
-  // 下一部分应该只在主线程注意到最近的音频样本数据时间戳发生变化时调用，这样在捕获环缓冲区中就有了新数据。
+  // 下一部分应该只在主线程注意到最近的音频样本索引发生变化时调用，这样在捕获环缓冲区中就有了新数据。
   // 环形缓冲区最终将环绕并覆盖数据，但假设主线程经常检查并且缓冲区足够大，可以在此发生之前进行此调用。
 
-  // Determine the index, in the history of all samples, of the first
-  // sample we want
-  // 在所有样本的历史中，确定我们想要的第一个样本的索引
-  const int start_offset = start_ms * (kAudioSampleFrequency / 1000);
-  // Determine how many samples we want in total
-  // 确定我们总共需要多少个样本
-  const int duration_sample_count =
-    duration_ms * (kAudioSampleFrequency / 1000);
-  for (int i = 0; i < duration_sample_count; ++i) {
-
-    // For each sample, transform its index in the history of all samples into
-    // its index in g_audio_capture_buffer
-
-    // 对于每个示例，将其在所有示例的历史记录中的索引转换为其在g_audio_capture_buffer中的索引
-    const int capture_index = (start_offset + i) % kAudioCaptureBufferSize;
-
-    // Write the sample to the output buffer
-    // 将示例写入输出缓冲区
-    g_audio_output_buffer[i] = g_audio_capture_buffer[capture_index];
+  // Nothing was recorded before the clock started, so treat it as silence.
+  // 时钟开始之前没有录音，按静音处理
+  int silent_count = 0;
+  if (start_sample < 0) {
+    silent_count = (-start_sample < sample_count)
+      ? static_cast<int>(-start_sample) : sample_count;
+  }
+  memset(g_audio_output_buffer, 0, silent_count * sizeof(int16_t));
+
+  // Copy the rest out of the ring
+  // 其余样本从环形缓冲区复制
+  int16_t* output = g_audio_output_buffer + silent_count;
+  const int ring_count = sample_count - silent_count;
+  AudioRingView view;
+  if (g_audio_ring.ViewRange(start_sample + silent_count, ring_count, &view)) {
+    memcpy(output, view.data[0], view.size[0] * sizeof(int16_t));
+    memcpy(output + view.size[0], view.data[1],
+           view.size[1] * sizeof(int16_t));
+    if (!g_audio_ring.IsViewIntact(view)) {
+      memset(output, 0, ring_count * sizeof(int16_t));
+    }
+  } else {
+    memset(output, 0, ring_count * sizeof(int16_t));
   }
 
   // Set pointers to provide access to the audio
@@ -304,5 +344,35 @@ TfLiteStatus GetAudioSamples(tflite::ErrorReporter* error_reporter,
 }
 
 int32_t LatestAudioTimestamp() {
-  return g_latest_audio_timestamp;
+  return static_cast<int32_t>(LatestAudioSampleIndex() / kAudioSamplesPerMs);
+}
+
+int64_t LatestAudioSampleIndex() {
+  return g_audio_ring.write_index();
+}
+
+AudioBroadcastRing* GetAudioRing() {
+  return &g_audio_ring;
+}
+
+AudioEnvelopeChannel* GetAudioEnvelopeChannel() {
+  return &g_audio_envelope_channel;
+}
+
+void AddAudioMemoryRegions(MemoryReport* report) {
+  report->AddRegion("capture ring", g_audio_capture_buffer,
+                    sizeof(g_audio_capture_buffer));
+  report->AddRegion("audio output buffer", g_audio_output_buffer,
+                    sizeof(g_audio_output_buffer));
+  report->AddRegion("I2S slot buffer", g_i2s_slot_buffer,
+                    sizeof(g_i2s_slot_buffer));
+  report->AddRegion("resampler", &g_resampler, sizeof(g_resampler));
+  report->AddRegion("resampler input", g_converted_buffer,
+                    sizeof(g_converted_buffer));
+  report->AddRegion("resampler output", g_resampled_buffer,
+                    sizeof(g_resampled_buffer));
+  report->AddRegion("envelope channel", &g_audio_envelope_channel,
+                    sizeof(g_audio_envelope_channel));
+  report->AddTask("AudioRecordingTask", g_audio_recording_task,
+                  AUDIO_RECORDING_TASK_STACK_SIZE);
 }
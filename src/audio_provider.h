@@ -16,6 +16,11 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_AUDIO_PROVIDER_H_
 #define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_AUDIO_PROVIDER_H_
 
+#include <cstdint>
+
+#include "audio_broadcast_ring.h"
+#include "audio_envelope.h"
+#include "memory_report.h"
 #include "tensorflow/lite/c/c_api_internal.h"
 #include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
 
@@ -33,6 +38,20 @@ TfLiteStatus GetAudioSamples(tflite::ErrorReporter* error_reporter,
                              int start_ms, int duration_ms,
                              int* audio_samples_size, int16_t** audio_samples);
 
+// Sample-accurate version of GetAudioSamples(). start_sample is an index into
+// the history of all captured samples, on the same clock as
+// LatestAudioSampleIndex(), and sample_count can be at most
+// kMaxAudioSampleSize. Samples from before capture started read as silence.
+TfLiteStatus GetAudioSampleRange(tflite::ErrorReporter* error_reporter,
+                                 int64_t start_sample, int sample_count,
+                                 int* audio_samples_size,
+                                 int16_t** audio_samples);
+
+// Starts capturing audio, if that hasn't already happened. GetAudioSamples()
+// does this on its first call, but anything that relies on the audio clock
+// running before then, like restoring saved state, should call this first.
+TfLiteStatus InitAudioRecording(tflite::ErrorReporter* error_reporter);
+
 // Returns the time that audio data was last captured in milliseconds. There's
 // no contract about what time zero represents, the accuracy, or the granularity
 // of the result. Subsequent calls will generally not return a lower value, but
@@ -43,4 +62,25 @@ TfLiteStatus GetAudioSamples(tflite::ErrorReporter* error_reporter,
 // your own platform-specific implementation.
 int32_t LatestAudioTimestamp();
 
+// Returns how many samples have been captured since recording started, which
+// is also the index of the next sample to arrive. This is the time base for the
+// rest of the pipeline: it never goes backwards, and at 16KHz a 64-bit count
+// won't wrap in practice, unlike the 32-bit millisecond timestamp above.
+int64_t LatestAudioSampleIndex();
+
+// Returns the ring the captured audio goes into, on the same clock as
+// LatestAudioSampleIndex(). Anything besides the keyword spotter that wants the
+// audio, like a level meter or a recorder, should add its own cursor here and
+// read the samples in place, rather than keeping another copy.
+AudioBroadcastRing* GetAudioRing();
+
+// Returns the channel that gets a min/max/RMS envelope for each block of audio
+// as it's added to GetAudioRing(). It has a single reader, normally whatever
+// draws the waveform, which should drain it regularly.
+AudioEnvelopeChannel* GetAudioEnvelopeChannel();
+
+// Adds the buffers behind the ring and the output of GetAudioSamples() to a
+// memory report, along with the capture task's stack if there is one.
+void AddAudioMemoryRegions(MemoryReport* report);
+
 #endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_AUDIO_PROVIDER_H_
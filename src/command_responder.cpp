@@ -17,6 +17,8 @@
 
 #include <Arduino.h>
 
+#include "micro_model_settings.h"
+
 int dispMode = 0;
 
 void InitResponder() {
@@ -40,6 +42,15 @@ int8_t lastCommandTime;
 void RespondToCommand(tflite::ErrorReporter* error_reporter,
                       int32_t current_time, const char* found_command,
                       uint8_t score, bool is_new_command) {
+  RespondToCommandAtSample(
+      error_reporter, static_cast<int64_t>(current_time) * kAudioSamplesPerMs,
+      found_command, score, is_new_command);
+}
+
+void RespondToCommandAtSample(tflite::ErrorReporter* error_reporter,
+                              int64_t current_sample_index,
+                              const char* found_command, uint8_t score,
+                              bool is_new_command) {
   static int32_t last_timestamp = 0;
   if(score < 150){
     return;
@@ -66,13 +77,20 @@ void RespondToCommand(tflite::ErrorReporter* error_reporter,
     lastCommandTime = 3;
   }
 
-  Serial.printf("current_time(%d) found_command(%s) score(%d) is_new_command(%d)\n", current_time, found_command, score, is_new_command);
+  // Serial.printf() mallocs a buffer for anything over 64 characters, which
+  // this line is, so it's formatted on the stack instead.
+  char line[96];
+  snprintf(line, sizeof(line),
+           "current_time(%lld) found_command(%s) score(%d) is_new_command(%d)\n",
+           current_sample_index / kAudioSamplesPerMs, found_command, score,
+           is_new_command);
+  Serial.print(line);
 }
 
 int drawWaveX = 160;
 int drawWaveMin = 1000;
 int drawWaveMax = -1000;
-void drawWave(int16_t value) {
+void drawWave(const AudioEnvelope* envelopes, int count) {
 }
 
 void drawInput(uint8_t *uint8) {
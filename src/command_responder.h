@@ -18,6 +18,7 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_COMMAND_RESPONDER_H_
 #define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_COMMAND_RESPONDER_H_
 
+#include "audio_envelope.h"
 #include "tensorflow/lite/c/c_api_internal.h"
 #include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
 
@@ -29,8 +30,16 @@ void RespondToCommand(tflite::ErrorReporter* error_reporter,
                       int32_t current_time, const char* found_command,
                       uint8_t score, bool is_new_command);
 
+// Same as RespondToCommand(), but with the time as an index on the
+// LatestAudioSampleIndex() clock.
+void RespondToCommandAtSample(tflite::ErrorReporter* error_reporter,
+                              int64_t current_sample_index,
+                              const char* found_command, uint8_t score,
+                              bool is_new_command);
+
 void InitResponder();
-void drawWave(int16_t value);
+// Draws the waveform overview from a batch of block envelopes, oldest first.
+void drawWave(const AudioEnvelope* envelopes, int count);
 void drawInput(uint8_t *uint8);
 
 #endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_COMMAND_RESPONDER_H_
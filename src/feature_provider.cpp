@@ -19,10 +19,25 @@ limitations under the License.
 #include "micro_features_generator.h"
 #include "micro_model_settings.h"
 
+namespace {
+
+// Returns the index of the newest slice that's fully covered by the samples
+// captured before sample_index, or -1 if there isn't one yet.
+int64_t LastCompleteSlice(int64_t sample_index) {
+  if (sample_index < kFeatureSliceDurationSamples) {
+    return -1;
+  }
+  return (sample_index - kFeatureSliceDurationSamples) /
+         kFeatureSliceStrideSamples;
+}
+
+}  // namespace
+
 FeatureProvider::FeatureProvider(int feature_size, uint8_t* feature_data)
     : feature_size_(feature_size),
       feature_data_(feature_data),
-      is_first_run_(true) {
+      is_first_run_(true),
+      is_frontend_initialized_(false) {
   // Initialize the feature data to default values.
   for (int n = 0; n < feature_size_; ++n) {
     feature_data_[n] = 0;
@@ -31,24 +46,49 @@ FeatureProvider::FeatureProvider(int feature_size, uint8_t* feature_data)
 
 FeatureProvider::~FeatureProvider() {}
 
+TfLiteStatus FeatureProvider::InitializeFrontend(
+    tflite::ErrorReporter* error_reporter) {
+  if (is_frontend_initialized_) {
+    return kTfLiteOk;
+  }
+  TfLiteStatus init_status = InitializeMicroFeatures(error_reporter);
+  if (init_status != kTfLiteOk) {
+    return init_status;
+  }
+  is_frontend_initialized_ = true;
+  return kTfLiteOk;
+}
+
 TfLiteStatus FeatureProvider::PopulateFeatureData(
     tflite::ErrorReporter* error_reporter, int32_t last_time_in_ms,
     int32_t time_in_ms, int* how_many_new_slices) {
+  return PopulateFeatureDataForSamples(
+      error_reporter, static_cast<int64_t>(last_time_in_ms) * kAudioSamplesPerMs,
+      static_cast<int64_t>(time_in_ms) * kAudioSamplesPerMs,
+      how_many_new_slices);
+}
+
+TfLiteStatus FeatureProvider::PopulateFeatureDataForSamples(
+    tflite::ErrorReporter* error_reporter, int64_t last_sample_index,
+    int64_t current_sample_index, int* how_many_new_slices) {
   if (feature_size_ != kFeatureElementCount) {
     error_reporter->Report("Requested feature_data_ size %d doesn't match %d",
                            feature_size_, kFeatureElementCount);
     return kTfLiteError;
   }
 
-  // Quantize the time into steps as long as each window stride, so we can
-  // figure out which audio data we need to fetch.
-  const int last_step = (last_time_in_ms / kFeatureSliceStrideMs);
-  const int current_step = (time_in_ms / kFeatureSliceStrideMs);
+  // Work out which slices have been completed by the audio that's arrived
+  // since the last call.
+  const int64_t last_step = LastCompleteSlice(last_sample_index);
+  const int64_t current_step = LastCompleteSlice(current_sample_index);
 
-  int slices_needed = current_step - last_step;
+  int64_t slices_needed = current_step - last_step;
+  if (slices_needed < 0) {
+    slices_needed = 0;
+  }
   // If this is the first call, make sure we don't use any cached information.
   if (is_first_run_) {
-    TfLiteStatus init_status = InitializeMicroFeatures(error_reporter);
+    TfLiteStatus init_status = InitializeFrontend(error_reporter);
     if (init_status != kTfLiteOk) {
       return init_status;
     }
@@ -58,9 +98,9 @@ TfLiteStatus FeatureProvider::PopulateFeatureData(
   if (slices_needed > kFeatureSliceCount) {
     slices_needed = kFeatureSliceCount;
   }
-  *how_many_new_slices = slices_needed;
+  *how_many_new_slices = static_cast<int>(slices_needed);
 
-  const int slices_to_keep = kFeatureSliceCount - slices_needed;
+  const int slices_to_keep = kFeatureSliceCount - *how_many_new_slices;
   const int slices_to_drop = kFeatureSliceCount - slices_to_keep;
   // If we can avoid recalculating some slices, just move the existing data
   // up in the spectrogram, to perform something like this:
@@ -91,14 +131,18 @@ TfLiteStatus FeatureProvider::PopulateFeatureData(
   if (slices_needed > 0) {
     for (int new_slice = slices_to_keep; new_slice < kFeatureSliceCount;
          ++new_slice) {
-      const int new_step = (current_step - kFeatureSliceCount + 1) + new_slice;
-      const int32_t slice_start_ms = (new_step * kFeatureSliceStrideMs);
+      const int64_t new_step =
+          (current_step - kFeatureSliceCount + 1) + new_slice;
+      // Slices from before capture started are built from silence.
+      const int64_t slice_start_sample = new_step * kFeatureSliceStrideSamples;
       int16_t* audio_samples = nullptr;
       int audio_samples_size = 0;
-      // TODO(petewarden): Fix bug that leads to non-zero slice_start_ms
-      GetAudioSamples(error_reporter, (slice_start_ms > 0 ? slice_start_ms : 0),
-                      kFeatureSliceDurationMs, &audio_samples_size,
-                      &audio_samples);
+      TfLiteStatus audio_status = GetAudioSampleRange(
+          error_reporter, slice_start_sample, kFeatureSliceDurationSamples,
+          &audio_samples_size, &audio_samples);
+      if (audio_status != kTfLiteOk) {
+        return audio_status;
+      }
       if (audio_samples_size < kMaxAudioSampleSize) {
         error_reporter->Report("Audio data size %d too small, want %d",
                                audio_samples_size, kMaxAudioSampleSize);
@@ -116,3 +160,23 @@ TfLiteStatus FeatureProvider::PopulateFeatureData(
   }
   return kTfLiteOk;
 }
+
+TfLiteStatus FeatureProvider::RestoreFeatureData(
+    tflite::ErrorReporter* error_reporter, const uint8_t* feature_data,
+    const uint32_t* noise_estimates) {
+  if (feature_size_ != kFeatureElementCount) {
+    error_reporter->Report("Requested feature_data_ size %d doesn't match %d",
+                           feature_size_, kFeatureElementCount);
+    return kTfLiteError;
+  }
+  TfLiteStatus init_status = InitializeFrontend(error_reporter);
+  if (init_status != kTfLiteOk) {
+    return init_status;
+  }
+  is_first_run_ = false;
+  for (int n = 0; n < feature_size_; ++n) {
+    feature_data_[n] = feature_data[n];
+  }
+  SetMicroFeaturesNoiseEstimates(noise_estimates);
+  return kTfLiteOk;
+}
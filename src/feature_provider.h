@@ -35,18 +35,45 @@ class FeatureProvider {
   FeatureProvider(int feature_size, uint8_t* feature_data);
   ~FeatureProvider();
 
+  // Sets up the feature generation frontend. This happens automatically on the
+  // first call to PopulateFeatureData(), but can be done up front so that the
+  // cost isn't paid on the way to the first inference.
+  TfLiteStatus InitializeFrontend(tflite::ErrorReporter* error_reporter);
+
   // Fills the feature data with information from audio inputs, and returns how
   // many feature slices were updated.
   TfLiteStatus PopulateFeatureData(tflite::ErrorReporter* error_reporter,
                                    int32_t last_time_in_ms, int32_t time_in_ms,
                                    int* how_many_new_slices);
 
+  // Sample-accurate version of PopulateFeatureData(), taking indexes on the
+  // LatestAudioSampleIndex() clock. Slice n covers the samples starting at
+  // n * kFeatureSliceStrideSamples, and is only calculated once all
+  // kFeatureSliceDurationSamples of them have been captured, so consecutive
+  // slices overlap by exactly the right amount, with no audio skipped or
+  // read before it has arrived.
+  TfLiteStatus PopulateFeatureDataForSamples(
+      tflite::ErrorReporter* error_reporter, int64_t last_sample_index,
+      int64_t current_sample_index, int* how_many_new_slices);
+
+  // Loads a spectrogram and frontend noise estimates saved by an earlier run,
+  // for example before a reboot. The frontend is set up if that hasn't happened
+  // yet, and the next call to PopulateFeatureData() only calculates the slices
+  // that are newer than the restored data, instead of starting from silence.
+  TfLiteStatus RestoreFeatureData(tflite::ErrorReporter* error_reporter,
+                                  const uint8_t* feature_data,
+                                  const uint32_t* noise_estimates);
+
+  const uint8_t* feature_data() const { return feature_data_; }
+  int feature_size() const { return feature_size_; }
+
  private:
   int feature_size_;
   uint8_t* feature_data_;
   // Make sure we don't try to use cached information if this is the first call
   // into the provider.
   bool is_first_run_;
+  bool is_frontend_initialized_;
 };
 
 #endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_FEATURE_PROVIDER_H_
@@ -0,0 +1,30 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// The first stage of the model cascade described in model_cascade.h, a much
+// smaller model than tiny_conv trained on the same spectrogram and labels.
+// None is checked in. To build with one, convert it like the main model:
+// xxd -i first_stage.tflite > first_stage_model_data.cpp
+// renaming the arrays to match the declarations below, and add
+//   -DMICRO_SPEECH_FIRST_STAGE_MODEL
+// to build_flags in platformio.ini.
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_FIRST_STAGE_MODEL_DATA_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_FIRST_STAGE_MODEL_DATA_H_
+
+extern const unsigned char g_first_stage_model_data[];
+extern const int g_first_stage_model_data_len;
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_FIRST_STAGE_MODEL_DATA_H_
@@ -0,0 +1,87 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "frontend_fingerprint.h"
+
+#include <cstring>
+
+#include "micro_features_tables.h"
+#include "micro_model_settings.h"
+
+namespace {
+
+// Floats are hashed by their bits, since any change to them at all may move
+// the generated tables.
+int32_t FloatBits(float value) {
+  int32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+}  // namespace
+
+uint64_t Fnv1a64(const void* data, size_t size, uint64_t hash) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+uint64_t FrontendSettingsFingerprint() {
+  const int32_t settings[] = {
+      kMaxAudioSampleSize,
+      kAudioSampleFrequency,
+      kFeatureSliceSize,
+      kFeatureSliceStrideMs,
+      kFeatureSliceDurationMs,
+      FloatBits(kFilterbankLowerBandLimit),
+      FloatBits(kFilterbankUpperBandLimit),
+      kNoiseReductionSmoothingBits,
+      FloatBits(kNoiseReductionEvenSmoothing),
+      FloatBits(kNoiseReductionOddSmoothing),
+      FloatBits(kNoiseReductionMinSignalRemaining),
+      FloatBits(kPcanGainControlStrength),
+      FloatBits(kPcanGainControlOffset),
+      kPcanGainControlGainBits,
+      kLogScaleShift,
+      g_micro_features_filterbank_start_index,
+      g_micro_features_filterbank_end_index,
+      g_micro_features_filterbank_weight_count,
+      g_micro_features_noise_reduction_even_smoothing,
+      g_micro_features_noise_reduction_odd_smoothing,
+      g_micro_features_noise_reduction_min_signal_remaining,
+      g_micro_features_pcan_snr_shift,
+  };
+  uint64_t hash = Fnv1a64(settings, sizeof(settings));
+  hash = Fnv1a64(g_micro_features_window_coefficients,
+                 sizeof(g_micro_features_window_coefficients), hash);
+  hash = Fnv1a64(g_micro_features_filterbank_channel_frequency_starts,
+                 sizeof(g_micro_features_filterbank_channel_frequency_starts),
+                 hash);
+  hash = Fnv1a64(g_micro_features_filterbank_channel_weight_starts,
+                 sizeof(g_micro_features_filterbank_channel_weight_starts),
+                 hash);
+  hash = Fnv1a64(g_micro_features_filterbank_channel_widths,
+                 sizeof(g_micro_features_filterbank_channel_widths), hash);
+  const size_t weights_size =
+      g_micro_features_filterbank_weight_count * sizeof(int16_t);
+  hash = Fnv1a64(g_micro_features_filterbank_weights, weights_size, hash);
+  hash = Fnv1a64(g_micro_features_filterbank_unweights, weights_size, hash);
+  hash = Fnv1a64(g_micro_features_pcan_gain_lut,
+                 sizeof(g_micro_features_pcan_gain_lut), hash);
+  return hash;
+}
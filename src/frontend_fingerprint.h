@@ -0,0 +1,35 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_FRONTEND_FINGERPRINT_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_FRONTEND_FINGERPRINT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr uint64_t kFnv1a64OffsetBasis = 14695981039346656037ull;
+
+// 64-bit FNV-1a. Pass the result back in as hash to continue over more data.
+uint64_t Fnv1a64(const void* data, size_t size,
+                 uint64_t hash = kFnv1a64OffsetBasis);
+
+// A hash of everything that decides the features the frontend computes: every
+// setting in micro_model_settings.h, and the generated tables that
+// InitializeMicroFeatures() loads. Features stored on disk and warm-state
+// snapshots are tagged with this, so a change to any of them makes older ones
+// unusable rather than silently wrong.
+uint64_t FrontendSettingsFingerprint();
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_FRONTEND_FINGERPRINT_H_
@@ -0,0 +1,211 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "i2s_slot_converter.h"
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#elif defined(__ARM_NEON) && defined(MICRO_SPEECH_I2S_SLOT_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+// Lane sums in the vectorized loops are flushed to 64 bits after this many
+// samples, which is well short of where they could overflow.
+constexpr int kMaxChunkSize = 4096;
+
+int32_t CurrentDcOffset(const I2sSlotConverterState& state) {
+  return static_cast<int32_t>(
+      (state.dc_estimate + (1 << (kI2sSlotDcFractionBits - 1))) >>
+      kI2sSlotDcFractionBits);
+}
+
+// Moves the bias estimate towards the mean of the block after the old
+// estimate was removed.
+void UpdateDcEstimate(I2sSlotConverterState* state, int64_t residual_sum,
+                      int count) {
+  if (count <= 0) {
+    return;
+  }
+  state->dc_estimate +=
+      (residual_sum * (1 << kI2sSlotDcFractionBits)) /
+      (static_cast<int64_t>(count) << state->dc_adaptation_shift);
+}
+
+// The per-sample work shared by every implementation, which also handles the
+// leftovers after the vectorized loops.
+inline int32_t ConvertSlot(int32_t slot, int shift, int32_t dc_offset,
+                           int32_t gain, int16_t* output) {
+  int32_t centred = (slot >> shift) - dc_offset;
+  if (centred > kI2sSlotMaxCentredValue) {
+    centred = kI2sSlotMaxCentredValue;
+  } else if (centred < -kI2sSlotMaxCentredValue) {
+    centred = -kI2sSlotMaxCentredValue;
+  }
+  int32_t scaled =
+      (centred * gain + (1 << (kI2sSlotGainBits - 1))) >> kI2sSlotGainBits;
+  if (scaled > INT16_MAX) {
+    scaled = INT16_MAX;
+  } else if (scaled < INT16_MIN) {
+    scaled = INT16_MIN;
+  }
+  *output = static_cast<int16_t>(scaled);
+  return centred;
+}
+
+}  // namespace
+
+TfLiteStatus InitI2sSlotConverter(tflite::ErrorReporter* error_reporter,
+                                  int shift, int32_t gain,
+                                  int dc_adaptation_shift,
+                                  I2sSlotConverterState* state) {
+  // Anything less than an 8-bit shift could overflow when the bias is
+  // subtracted.
+  if ((shift < 8) || (shift > 24)) {
+    error_reporter->Report("I2S slot shift %d must be between 8 and 24", shift);
+    return kTfLiteError;
+  }
+  if ((gain < 0) || (gain > kI2sSlotMaxGain)) {
+    error_reporter->Report("I2S slot gain %d must be between 0 and %d", gain,
+                           kI2sSlotMaxGain);
+    return kTfLiteError;
+  }
+  if ((dc_adaptation_shift < 0) || (dc_adaptation_shift > 16)) {
+    error_reporter->Report("DC adaptation shift %d must be between 0 and 16",
+                           dc_adaptation_shift);
+    return kTfLiteError;
+  }
+  state->shift = shift;
+  state->gain = gain;
+  state->dc_adaptation_shift = dc_adaptation_shift;
+  state->dc_estimate = 0;
+  return kTfLiteOk;
+}
+
+void ConvertI2sSlotsScalar(I2sSlotConverterState* state, const int32_t* slots,
+                           int count, int16_t* output) {
+  const int shift = state->shift;
+  const int32_t gain = state->gain;
+  const int32_t dc_offset = CurrentDcOffset(*state);
+  int64_t residual_sum = 0;
+  for (int i = 0; i < count; ++i) {
+    residual_sum += ConvertSlot(slots[i], shift, dc_offset, gain, &output[i]);
+  }
+  UpdateDcEstimate(state, residual_sum, count);
+}
+
+#if defined(__SSE4_1__)
+
+void ConvertI2sSlots(I2sSlotConverterState* state, const int32_t* slots,
+                     int count, int16_t* output) {
+  const int shift = state->shift;
+  const int32_t gain = state->gain;
+  const int32_t dc_offset = CurrentDcOffset(*state);
+  const __m128i shift_v = _mm_cvtsi32_si128(shift);
+  const __m128i dc_offset_v = _mm_set1_epi32(dc_offset);
+  const __m128i max_v = _mm_set1_epi32(kI2sSlotMaxCentredValue);
+  const __m128i min_v = _mm_set1_epi32(-kI2sSlotMaxCentredValue);
+  const __m128i gain_v = _mm_set1_epi32(gain);
+  const __m128i round_v = _mm_set1_epi32(1 << (kI2sSlotGainBits - 1));
+
+  int64_t residual_sum = 0;
+  int i = 0;
+  while (count - i >= 8) {
+    const int chunk_end =
+        i + ((count - i < kMaxChunkSize) ? (count - i) : kMaxChunkSize) - 7;
+    __m128i sum_v = _mm_setzero_si128();
+    for (; i < chunk_end; i += 8) {
+      __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(slots + i));
+      __m128i high =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(slots + i + 4));
+      low = _mm_sub_epi32(_mm_sra_epi32(low, shift_v), dc_offset_v);
+      high = _mm_sub_epi32(_mm_sra_epi32(high, shift_v), dc_offset_v);
+      low = _mm_min_epi32(_mm_max_epi32(low, min_v), max_v);
+      high = _mm_min_epi32(_mm_max_epi32(high, min_v), max_v);
+      sum_v = _mm_add_epi32(sum_v, _mm_add_epi32(low, high));
+      low = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(low, gain_v), round_v),
+                           kI2sSlotGainBits);
+      high = _mm_srai_epi32(
+          _mm_add_epi32(_mm_mullo_epi32(high, gain_v), round_v),
+          kI2sSlotGainBits);
+      // The saturating pack does the final clamp to int16.
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                       _mm_packs_epi32(low, high));
+    }
+    int32_t lanes[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sum_v);
+    residual_sum += static_cast<int64_t>(lanes[0]) + lanes[1] + lanes[2] +
+                    lanes[3];
+  }
+  for (; i < count; ++i) {
+    residual_sum += ConvertSlot(slots[i], shift, dc_offset, gain, &output[i]);
+  }
+  UpdateDcEstimate(state, residual_sum, count);
+}
+
+#elif defined(__ARM_NEON) && defined(MICRO_SPEECH_I2S_SLOT_NEON)
+
+// Not yet run against ConvertI2sSlotsScalar(), so it's only built when asked
+// for. tools/i2s_slot_converter_test.cpp does that check.
+void ConvertI2sSlots(I2sSlotConverterState* state, const int32_t* slots,
+                     int count, int16_t* output) {
+  const int shift = state->shift;
+  const int32_t gain = state->gain;
+  const int32_t dc_offset = CurrentDcOffset(*state);
+  // NEON shifts right by shifting left a negative amount.
+  const int32x4_t shift_v = vdupq_n_s32(-shift);
+  const int32x4_t dc_offset_v = vdupq_n_s32(dc_offset);
+  const int32x4_t max_v = vdupq_n_s32(kI2sSlotMaxCentredValue);
+  const int32x4_t min_v = vdupq_n_s32(-kI2sSlotMaxCentredValue);
+  const int32x4_t gain_v = vdupq_n_s32(gain);
+  const int32x4_t round_v = vdupq_n_s32(1 << (kI2sSlotGainBits - 1));
+
+  int64_t residual_sum = 0;
+  int i = 0;
+  while (count - i >= 8) {
+    const int chunk_end =
+        i + ((count - i < kMaxChunkSize) ? (count - i) : kMaxChunkSize) - 7;
+    int32x4_t sum_v = vdupq_n_s32(0);
+    for (; i < chunk_end; i += 8) {
+      int32x4_t low = vshlq_s32(vld1q_s32(slots + i), shift_v);
+      int32x4_t high = vshlq_s32(vld1q_s32(slots + i + 4), shift_v);
+      low = vminq_s32(vmaxq_s32(vsubq_s32(low, dc_offset_v), min_v), max_v);
+      high = vminq_s32(vmaxq_s32(vsubq_s32(high, dc_offset_v), min_v), max_v);
+      sum_v = vaddq_s32(sum_v, vaddq_s32(low, high));
+      low = vshrq_n_s32(vaddq_s32(vmulq_s32(low, gain_v), round_v),
+                        kI2sSlotGainBits);
+      high = vshrq_n_s32(vaddq_s32(vmulq_s32(high, gain_v), round_v),
+                         kI2sSlotGainBits);
+      vst1q_s16(output + i, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+    }
+    residual_sum += static_cast<int64_t>(vgetq_lane_s32(sum_v, 0)) +
+                    vgetq_lane_s32(sum_v, 1) + vgetq_lane_s32(sum_v, 2) +
+                    vgetq_lane_s32(sum_v, 3);
+  }
+  for (; i < count; ++i) {
+    residual_sum += ConvertSlot(slots[i], shift, dc_offset, gain, &output[i]);
+  }
+  UpdateDcEstimate(state, residual_sum, count);
+}
+
+#else  // defined(__SSE4_1__)
+
+void ConvertI2sSlots(I2sSlotConverterState* state, const int32_t* slots,
+                     int count, int16_t* output) {
+  ConvertI2sSlotsScalar(state, slots, count, output);
+}
+
+#endif  // defined(__SSE4_1__)
@@ -0,0 +1,76 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_I2S_SLOT_CONVERTER_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_I2S_SLOT_CONVERTER_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/c_api_internal.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+
+// Turns the raw receive slots from an I2S MEMS microphone into the 16-bit PCM
+// the rest of the pipeline expects. These microphones send a left-justified
+// 24-bit sample in each 32-bit slot, sitting on top of a DC bias. One pass over
+// a block shifts each slot down, subtracts the bias, applies a fine gain and
+// saturates to int16, so the output can be written straight into the capture
+// ring buffer.
+//
+// The bias is tracked per block rather than per sample. Every sample in a
+// block has the same estimate subtracted, and the mean of what's left is then
+// folded into the estimate, which acts as a one-pole high-pass filter running
+// at the block rate. Keeping feedback out of the per-sample work is what lets
+// the inner loop be vectorized.
+
+// The gain is a Q15 fixed-point multiplier, so 32768 leaves the level as is.
+constexpr int kI2sSlotGainBits = 15;
+constexpr int32_t kI2sSlotMaxGain = 1 << kI2sSlotGainBits;
+// Shifted samples are clamped to this magnitude once the bias is removed,
+// which keeps the gain multiply inside 32 bits.
+constexpr int32_t kI2sSlotMaxCentredValue = 65535;
+// Fractional bits kept in the bias estimate.
+constexpr int kI2sSlotDcFractionBits = 8;
+
+struct I2sSlotConverterState {
+  // How far each 32-bit slot is arithmetically shifted right. Each step down
+  // from 16 doubles the output level.
+  int shift;
+  // Q15 gain applied after the bias is removed, at most kI2sSlotMaxGain.
+  int32_t gain;
+  // Each block moves the bias estimate by 1/2^dc_adaptation_shift of the
+  // remaining offset, so larger values give a lower cut-off frequency.
+  int dc_adaptation_shift;
+  // Current bias, in shifted sample units with kI2sSlotDcFractionBits of
+  // fraction.
+  int64_t dc_estimate;
+};
+
+// Checks the settings and sets up the state with no bias estimate.
+TfLiteStatus InitI2sSlotConverter(tflite::ErrorReporter* error_reporter,
+                                  int shift, int32_t gain,
+                                  int dc_adaptation_shift,
+                                  I2sSlotConverterState* state);
+
+// Converts count slots into output, and updates the bias estimate. Uses SSE4.1
+// when the build targets it, or NEON when MICRO_SPEECH_I2S_SLOT_NEON is also
+// defined, otherwise ConvertI2sSlotsScalar().
+void ConvertI2sSlots(I2sSlotConverterState* state, const int32_t* slots,
+                     int count, int16_t* output);
+
+// Portable implementation, which the vectorized versions match bit for bit.
+void ConvertI2sSlotsScalar(I2sSlotConverterState* state, const int32_t* slots,
+                           int count, int16_t* output);
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_I2S_SLOT_CONVERTER_H_
@@ -0,0 +1,260 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "inference_scheduler.h"
+
+#include "micro_model_settings.h"
+
+namespace {
+
+// Returns the index of the newest slice that's fully covered by the samples
+// captured before sample_index, or -1 if there isn't one yet.
+int64_t LastCompleteSlice(int64_t sample_index) {
+  if (sample_index < kFeatureSliceDurationSamples) {
+    return -1;
+  }
+  return (sample_index - kFeatureSliceDurationSamples) /
+         kFeatureSliceStrideSamples;
+}
+
+// The sample index at which a slice's audio is complete.
+int64_t SliceEnd(int64_t slice) {
+  return (slice * kFeatureSliceStrideSamples) + kFeatureSliceDurationSamples;
+}
+
+// How many slices start before sample_index.
+int64_t SlicesStartingBefore(int64_t sample_index) {
+  if (sample_index <= 0) {
+    return 0;
+  }
+  return (sample_index + kFeatureSliceStrideSamples - 1) /
+         kFeatureSliceStrideSamples;
+}
+
+// How many of the slices from first to last inclusive start before
+// sample_index.
+int64_t CountSlicesStartingBefore(int64_t first, int64_t last,
+                                  int64_t sample_index) {
+  int64_t count = SlicesStartingBefore(sample_index) - first;
+  if (count > last - first + 1) {
+    count = last - first + 1;
+  }
+  return (count > 0) ? count : 0;
+}
+
+}  // namespace
+
+InferenceScheduler::InferenceScheduler(
+    const InferenceSchedulerSettings& settings)
+    : settings_(settings),
+      deadline_samples_(static_cast<int64_t>(settings.deadline_ms) *
+                        kAudioSamplesPerMs),
+      score_stride_(settings.min_inference_stride),
+      load_stride_(settings.min_inference_stride),
+      is_started_(false),
+      first_unanswered_slice_(0),
+      backlog_slices_(0) {}
+
+TfLiteStatus InferenceScheduler::CheckSettings(
+    tflite::ErrorReporter* error_reporter) const {
+  if ((settings_.policy != kProcessEverySlice) &&
+      (settings_.policy != kSkipInferenceOnBacklog) &&
+      (settings_.policy != kCatchUpFeaturesOnly)) {
+    error_reporter->Report("Unknown overload policy %d",
+                           static_cast<int>(settings_.policy));
+    return kTfLiteError;
+  }
+  if (settings_.deadline_ms <= 0) {
+    error_reporter->Report("Inference deadline must be positive, not %d ms",
+                           settings_.deadline_ms);
+    return kTfLiteError;
+  }
+  if (settings_.max_catch_up_slices <= 0) {
+    error_reporter->Report("At least one slice must be caught up per pass, "
+                           "not %d",
+                           settings_.max_catch_up_slices);
+    return kTfLiteError;
+  }
+  if ((settings_.min_inference_stride < 1) ||
+      (settings_.max_inference_stride < settings_.min_inference_stride)) {
+    error_reporter->Report("Inference stride range %d to %d isn't valid",
+                           settings_.min_inference_stride,
+                           settings_.max_inference_stride);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+int InferenceScheduler::inference_stride() const {
+  int stride = (score_stride_ > load_stride_) ? score_stride_ : load_stride_;
+  if (stride < settings_.min_inference_stride) {
+    stride = settings_.min_inference_stride;
+  }
+  if (stride > settings_.max_inference_stride) {
+    stride = settings_.max_inference_stride;
+  }
+  return stride;
+}
+
+int64_t InferenceScheduler::DeadlineSamples(int inference_stride) const {
+  return deadline_samples_ +
+         (static_cast<int64_t>(inference_stride - 1) *
+          kFeatureSliceStrideSamples);
+}
+
+void InferenceScheduler::Plan(int64_t processed_sample_index,
+                              int64_t latest_sample_index,
+                              int64_t oldest_safe_sample_index,
+                              InferencePlan* plan) {
+  ++stats_.passes;
+  const int64_t newest_slice = LastCompleteSlice(latest_sample_index);
+  const int64_t last_processed_slice =
+      LastCompleteSlice(processed_sample_index);
+
+  // Slices older than a whole spectrogram would scroll out before the model
+  // saw them, so they're never computed.
+  const int64_t window_first_slice = newest_slice - kFeatureSliceCount + 1;
+  int64_t first_slice = last_processed_slice + 1;
+  plan->start_sample_index = processed_sample_index;
+  if (first_slice < window_first_slice) {
+    first_slice = window_first_slice;
+    plan->start_sample_index = SliceEnd(first_slice - 1);
+  }
+  if (is_started_ && (first_unanswered_slice_ < window_first_slice)) {
+    stats_.missed_deadlines += window_first_slice - first_unanswered_slice_;
+    first_unanswered_slice_ = window_first_slice;
+  }
+
+  const int64_t backlog = newest_slice - first_slice + 1;
+  backlog_slices_ = (backlog > 0) ? static_cast<int>(backlog) : 0;
+  if (backlog_slices_ > stats_.max_backlog_slices) {
+    stats_.max_backlog_slices = backlog_slices_;
+  }
+
+  const int stride = inference_stride();
+  plan->end_sample_index = latest_sample_index;
+  plan->first_slice = first_slice;
+  plan->last_slice = newest_slice;
+  plan->slice_count = backlog_slices_;
+  plan->inference_stride = stride;
+  if (backlog_slices_ == 0) {
+    // Nothing new, but a pass that caught up without running the model may
+    // still owe an inference on what it computed.
+    plan->last_slice = last_processed_slice;
+    plan->run_inference =
+        is_started_ &&
+        (last_processed_slice - first_unanswered_slice_ + 1 >= stride);
+    return;
+  }
+
+  // The first pass fills the whole spectrogram and runs the model whatever
+  // the policy, as the feature provider does on its first call.
+  const bool is_behind =
+      is_started_ &&
+      (SliceEnd(first_slice) + DeadlineSamples(stride) < latest_sample_index);
+  plan->run_inference = true;
+  if (is_behind && (settings_.policy == kSkipInferenceOnBacklog)) {
+    plan->run_inference = false;
+  } else if (is_behind && (settings_.policy == kCatchUpFeaturesOnly)) {
+    // Anything starting in the older half of what the ring still holds has to
+    // be done now, in case the next pass is slow too.
+    const int64_t safe_margin =
+        (latest_sample_index - oldest_safe_sample_index) / 2;
+    int64_t slice_count = CountSlicesStartingBefore(
+        first_slice, newest_slice, oldest_safe_sample_index + safe_margin);
+    if (slice_count < settings_.max_catch_up_slices) {
+      slice_count = settings_.max_catch_up_slices;
+    }
+    if (slice_count < backlog_slices_) {
+      plan->last_slice = first_slice + slice_count - 1;
+      plan->slice_count = static_cast<int>(slice_count);
+      plan->end_sample_index = SliceEnd(plan->last_slice);
+      plan->run_inference = false;
+    }
+  }
+  if (plan->run_inference && is_started_ &&
+      (plan->last_slice - first_unanswered_slice_ + 1 < stride)) {
+    plan->run_inference = false;
+  }
+  stats_.lost_slices += CountSlicesStartingBefore(
+      first_slice, plan->last_slice, oldest_safe_sample_index);
+}
+
+void InferenceScheduler::Finish(const InferencePlan& plan,
+                                int64_t latest_sample_index) {
+  stats_.slices += plan.slice_count;
+  if (!plan.run_inference) {
+    if ((plan.slice_count > 0) &&
+        (plan.last_slice - first_unanswered_slice_ + 1 >=
+         plan.inference_stride)) {
+      ++stats_.skipped_inferences;
+    }
+    return;
+  }
+  ++stats_.inferences;
+  if (is_started_) {
+    // This inference saw every slice computed so far, and was on time for
+    // the ones whose audio was complete less than a deadline ago.
+    const int64_t deadline_samples = DeadlineSamples(plan.inference_stride);
+    stats_.missed_deadlines += CountSlicesStartingBefore(
+        first_unanswered_slice_, plan.last_slice,
+        latest_sample_index - deadline_samples - kFeatureSliceDurationSamples);
+
+    // Results arriving well after their newest slice mean there's little CPU
+    // to spare, so inferences are spread further apart until that recovers.
+    const int64_t lateness = latest_sample_index - SliceEnd(plan.last_slice);
+    if ((lateness * 2 > deadline_samples_) &&
+        (load_stride_ < settings_.max_inference_stride)) {
+      ++load_stride_;
+    } else if ((lateness * 4 < deadline_samples_) &&
+               (load_stride_ > settings_.min_inference_stride)) {
+      --load_stride_;
+    }
+  }
+  is_started_ = true;
+  first_unanswered_slice_ = plan.last_slice + 1;
+}
+
+void InferenceScheduler::RecordScores(const uint8_t* scores) {
+  int top_index = 0;
+  for (int i = 1; i < kCategoryCount; ++i) {
+    if (scores[i] > scores[top_index]) {
+      top_index = i;
+    }
+  }
+  if ((top_index == kSilenceIndex) &&
+      (scores[kSilenceIndex] >= settings_.sparse_silence_score)) {
+    if (score_stride_ < settings_.max_inference_stride) {
+      ++score_stride_;
+    }
+  } else {
+    score_stride_ = settings_.min_inference_stride;
+  }
+}
+
+void InferenceScheduler::Report(tflite::ErrorReporter* error_reporter) const {
+  error_reporter->Report(
+      "scheduler: %d passes, %d slices, backlog %d now and %d at most",
+      static_cast<int>(stats_.passes), static_cast<int>(stats_.slices),
+      backlog_slices_, static_cast<int>(stats_.max_backlog_slices));
+  error_reporter->Report("scheduler: %d inferences, one every %d slices now",
+                         static_cast<int>(stats_.inferences),
+                         inference_stride());
+  error_reporter->Report(
+      "scheduler: %d missed deadlines, %d skipped inferences, %d lost slices",
+      static_cast<int>(stats_.missed_deadlines),
+      static_cast<int>(stats_.skipped_inferences),
+      static_cast<int>(stats_.lost_slices));
+}
@@ -0,0 +1,151 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_INFERENCE_SCHEDULER_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_INFERENCE_SCHEDULER_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/c_api_internal.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+
+// Decides what each pass of the main loop should do when it has fallen behind
+// the audio, for example after a stall writing to Serial or an unusually slow
+// Invoke(). Without it, a pass that finds a second's worth of new audio
+// computes every slice of the spectrogram in one go and then runs the model,
+// which makes the next pass late too.
+//
+// Every slice has a deadline: the first inference that sees it should finish
+// within deadline_ms of its audio being complete. The backlog is the number of
+// slices whose audio has arrived but whose features haven't been computed. If
+// the oldest of those has already missed its deadline, the loop is behind,
+// and the policy chooses how to get back on time. Whatever the policy, the
+// pass never leaves slices uncomputed whose audio is about to be overwritten.
+//
+// The model doesn't have to run for every slice either. Features are always
+// computed as the audio arrives, but inference runs once every stride slices,
+// where the stride moves between min_inference_stride and
+// max_inference_stride. It widens by one slice after each result where silence
+// wins with at least sparse_silence_score, and drops straight back to the
+// minimum once anything else looks likely, so quiet rooms cost little and
+// keywords are still followed closely. It also widens while inferences are
+// finishing more than half a deadline after their newest slice, and narrows
+// again once there's headroom. A slice waiting for the next inference at the
+// current stride isn't counted as late.
+enum OverloadPolicy {
+  // Computes every new slice and runs the model on every pass, however far
+  // behind. This is what the loop did before there was a scheduler.
+  kProcessEverySlice,
+  // Computes every new slice, but doesn't run the model while behind. The
+  // features then take a pass to catch up, and the next pass runs the model
+  // on the up-to-date spectrogram.
+  kSkipInferenceOnBacklog,
+  // While behind, computes at most max_catch_up_slices slices per pass, oldest
+  // first, and only runs the model once they've caught up. This spreads the
+  // catching up over several passes, so other work in the loop isn't held up.
+  kCatchUpFeaturesOnly,
+};
+
+struct InferenceSchedulerSettings {
+  OverloadPolicy policy = kProcessEverySlice;
+  int32_t deadline_ms = 100;
+  int32_t max_catch_up_slices = 8;
+  int32_t min_inference_stride = 1;
+  int32_t max_inference_stride = 1;
+  uint8_t sparse_silence_score = 200;
+};
+
+// What one pass of the loop should do. The feature provider is asked to bring
+// the spectrogram from start_sample_index up to end_sample_index, which is
+// also the time the pass's result is reported at.
+struct InferencePlan {
+  int64_t start_sample_index;
+  int64_t end_sample_index;
+  // The slices the pass computes, from first_slice to last_slice inclusive.
+  // slice_count is zero if there's nothing new.
+  int64_t first_slice;
+  int64_t last_slice;
+  int slice_count;
+  bool run_inference;
+  // The inference stride the plan was made with.
+  int inference_stride;
+};
+
+struct InferenceSchedulerStats {
+  int64_t passes = 0;
+  int64_t slices = 0;
+  // Slices that weren't seen by an inference within the deadline.
+  int64_t missed_deadlines = 0;
+  int64_t inferences = 0;
+  // Passes that computed slices but didn't run the model, apart from those
+  // waiting for the next inference at the current stride.
+  int64_t skipped_inferences = 0;
+  // Slices computed from audio that the ring could already have overwritten,
+  // in which case they were built from silence instead.
+  int64_t lost_slices = 0;
+  int64_t max_backlog_slices = 0;
+};
+
+class InferenceScheduler {
+ public:
+  explicit InferenceScheduler(const InferenceSchedulerSettings& settings =
+                                  InferenceSchedulerSettings());
+
+  TfLiteStatus CheckSettings(tflite::ErrorReporter* error_reporter) const;
+
+  // Works out what this pass should do. processed_sample_index is the
+  // end_sample_index of the previous plan, or zero before the first.
+  // latest_sample_index is the newest audio, and oldest_safe_sample_index the
+  // oldest that's certain not to be overwritten before the next pass, as given
+  // by AudioBroadcastRing::oldest_safe_index().
+  void Plan(int64_t processed_sample_index, int64_t latest_sample_index,
+            int64_t oldest_safe_sample_index, InferencePlan* plan);
+
+  // Records that the pass planned by Plan() has finished, with the audio clock
+  // at latest_sample_index, and counts any slices that missed their deadline.
+  void Finish(const InferencePlan& plan, int64_t latest_sample_index);
+
+  // Adjusts the inference stride from the model's latest output, which has
+  // kCategoryCount scores.
+  void RecordScores(const uint8_t* scores);
+
+  // Prints the counters.
+  void Report(tflite::ErrorReporter* error_reporter) const;
+
+  const InferenceSchedulerStats& stats() const { return stats_; }
+  // The backlog at the start of the last pass.
+  int backlog_slices() const { return backlog_slices_; }
+  // How many slices apart inferences are being run.
+  int inference_stride() const;
+
+ private:
+  // The deadline, stretched by however long a slice can wait for the next
+  // inference at the given stride.
+  int64_t DeadlineSamples(int inference_stride) const;
+
+  InferenceSchedulerSettings settings_;
+  int64_t deadline_samples_;
+  // The strides wanted because of the recent scores and because of the load.
+  // The wider of the two is used.
+  int score_stride_;
+  int load_stride_;
+  bool is_started_;
+  // The oldest slice that's been computed but not yet seen by an inference.
+  int64_t first_unanswered_slice_;
+  int backlog_slices_;
+  InferenceSchedulerStats stats_;
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_INFERENCE_SCHEDULER_H_
@@ -0,0 +1,31 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// A cheaper version of tiny_conv for ModelVariants to fall back on when the
+// CPU is busy, trained on the same spectrogram and labels with fewer or
+// narrower layers. None is checked in. To build with one, convert it like the
+// main model:
+// xxd -i light.tflite > light_model_data.cpp
+// renaming the arrays to match the declarations below, and add
+//   -DMICRO_SPEECH_LIGHT_MODEL
+// to build_flags in platformio.ini.
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_LIGHT_MODEL_DATA_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_LIGHT_MODEL_DATA_H_
+
+extern const unsigned char g_light_model_data[];
+extern const int g_light_model_data_len;
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_LIGHT_MODEL_DATA_H_
@@ -0,0 +1,191 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "memory_report.h"
+
+#include <cstring>
+
+#if defined(ARDUINO)
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <soc/soc_memory_layout.h>
+#endif
+
+namespace {
+
+constexpr uint8_t kPaintPattern = 0xa5;
+
+enum MemoryKind {
+  kInternalMemory,
+  kExternalMemory,
+  kFlashMemory,
+  kMemoryKindCount,
+};
+
+const char* kMemoryKindNames[kMemoryKindCount] = {
+#if defined(ARDUINO)
+    "SRAM",
+    "PSRAM",
+    "flash",
+#else
+    "RAM",
+    "RAM",
+    "RAM",
+#endif
+};
+
+MemoryKind KindOf(const void* address) {
+#if defined(ARDUINO)
+  if (esp_ptr_external_ram(address)) {
+    return kExternalMemory;
+  }
+  if (esp_ptr_internal(address)) {
+    return kInternalMemory;
+  }
+  return kFlashMemory;
+#else
+  return kInternalMemory;
+#endif
+}
+
+// The number of bytes between the first and last ones that have changed since
+// the region was painted, which is as much of it as has been used.
+size_t PaintedBytesUsed(const uint8_t* start, size_t size) {
+  size_t first = 0;
+  while ((first < size) && (start[first] == kPaintPattern)) {
+    ++first;
+  }
+  size_t end = size;
+  while ((end > first) && (start[end - 1] == kPaintPattern)) {
+    --end;
+  }
+  return end - first;
+}
+
+}  // namespace
+
+MemoryReport::MemoryReport()
+    : region_count_(0), task_count_(0), overflow_count_(0) {}
+
+void MemoryReport::Paint(void* start, size_t size) {
+  memset(start, kPaintPattern, size);
+}
+
+void MemoryReport::AddRegion(const char* name, const void* start, size_t size,
+                             bool is_painted) {
+  if (region_count_ >= kMaxRegions) {
+    ++overflow_count_;
+    return;
+  }
+  Region& region = regions_[region_count_];
+  region.name = name;
+  region.start = static_cast<const uint8_t*>(start);
+  region.size = size;
+  region.is_painted = is_painted;
+  region.parent = -1;
+  for (int i = 0; i < region_count_; ++i) {
+    const Region& other = regions_[i];
+    if ((other.parent < 0) && (region.start >= other.start) &&
+        (region.start + size <= other.start + other.size)) {
+      region.parent = i;
+      break;
+    }
+  }
+  ++region_count_;
+}
+
+void MemoryReport::AddTask(const char* name, void* task, size_t stack_size) {
+#if defined(ARDUINO)
+  if ((task == nullptr) || (task_count_ >= kMaxTasks)) {
+    return;
+  }
+  tasks_[task_count_].name = name;
+  tasks_[task_count_].handle = task;
+  tasks_[task_count_].stack_size = stack_size;
+  ++task_count_;
+#endif
+}
+
+void MemoryReport::Report(tflite::ErrorReporter* error_reporter) const {
+  // MicroErrorReporter has no padding or 64-bit specifiers, so every size is
+  // cast to int, and nested regions are marked with a '+' instead of indented.
+  size_t totals[kMemoryKindCount] = {};
+  for (int i = 0; i < region_count_; ++i) {
+    const Region& region = regions_[i];
+    const MemoryKind kind = KindOf(region.start);
+    const char* prefix = (region.parent < 0) ? "" : "+ ";
+    if (region.parent < 0) {
+      totals[kind] += region.size;
+    }
+    if (region.is_painted) {
+      const size_t used = PaintedBytesUsed(region.start, region.size);
+      error_reporter->Report("memory: %s%s %d bytes in %s, %d used",
+                             prefix, region.name,
+                             static_cast<int>(region.size),
+                             kMemoryKindNames[kind], static_cast<int>(used));
+    } else {
+      error_reporter->Report("memory: %s%s %d bytes in %s", prefix,
+                             region.name, static_cast<int>(region.size),
+                             kMemoryKindNames[kind]);
+    }
+  }
+  if (overflow_count_ > 0) {
+    error_reporter->Report("memory: %d more regions didn't fit in the report",
+                           overflow_count_);
+  }
+#if defined(ARDUINO)
+  for (int i = 0; i < task_count_; ++i) {
+    const Task& task = tasks_[i];
+    // On the ESP32 the high-water mark is the least free stack there has been,
+    // in bytes rather than words.
+    const size_t least_free = uxTaskGetStackHighWaterMark(
+        static_cast<TaskHandle_t>(task.handle));
+    const size_t most_used =
+        (least_free < task.stack_size) ? task.stack_size - least_free : 0;
+    error_reporter->Report("memory: task %s stack %d bytes, %d used",
+                           task.name, static_cast<int>(task.stack_size),
+                           static_cast<int>(most_used));
+  }
+  for (int kind = 0; kind < kMemoryKindCount; ++kind) {
+    if (totals[kind] > 0) {
+      error_reporter->Report("memory: %d bytes of %s in the regions above",
+                             static_cast<int>(totals[kind]),
+                             kMemoryKindNames[kind]);
+    }
+  }
+  const uint32_t heap_caps[] = {MALLOC_CAP_INTERNAL, MALLOC_CAP_SPIRAM};
+  const char* heap_names[] = {"SRAM", "PSRAM"};
+  for (int i = 0; i < 2; ++i) {
+    const size_t total = heap_caps_get_total_size(heap_caps[i]);
+    if (total == 0) {
+      continue;
+    }
+    error_reporter->Report(
+        "memory: %s heap %d bytes, %d free, %d at least, %d largest block",
+        heap_names[i], static_cast<int>(total),
+        static_cast<int>(heap_caps_get_free_size(heap_caps[i])),
+        static_cast<int>(heap_caps_get_minimum_free_size(heap_caps[i])),
+        static_cast<int>(heap_caps_get_largest_free_block(heap_caps[i])));
+  }
+#else
+  size_t total = 0;
+  for (int kind = 0; kind < kMemoryKindCount; ++kind) {
+    total += totals[kind];
+  }
+  error_reporter->Report("memory: %d bytes in the regions above",
+                         static_cast<int>(total));
+#endif
+}
@@ -0,0 +1,83 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MEMORY_REPORT_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MEMORY_REPORT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+
+// Attributes memory to the parts of the pipeline that own it, so buffers can
+// be resized or moved between internal SRAM and PSRAM knowing what each one
+// costs and how much of it is really used. Each subsystem adds its own regions
+// and tasks, and Report() prints one line for each, followed by the state of
+// the heaps on the device.
+//
+// Some regions can also say how much of them has been touched. A painted region
+// is filled with a known pattern before it's handed over, and the report counts
+// the span of bytes that no longer hold it. Task stacks are painted by FreeRTOS
+// already, so their high-water marks come from there.
+class MemoryReport {
+ public:
+  MemoryReport();
+
+  // Fills a region with the pattern that painted regions are checked for. This
+  // has to happen before anything else writes to it.
+  static void Paint(void* start, size_t size);
+
+  // Records a region of memory. The name must stay valid for as long as the
+  // report is used, so string literals are the best choice. A region that lies
+  // inside one added earlier, like a tensor inside the arena, is listed under
+  // it but not counted twice in the totals. Regions past kMaxRegions are left
+  // out, and the report says how many.
+  void AddRegion(const char* name, const void* start, size_t size,
+                 bool is_painted = false);
+
+  // Records a task's stack, so its high-water mark is shown. task is the
+  // FreeRTOS handle, and stack_size is in bytes, as xTaskCreate() takes it on
+  // the ESP32. There are no tasks on a host, so this does nothing there.
+  void AddTask(const char* name, void* task, size_t stack_size);
+
+  // Prints every region and task, the totals for each kind of memory, and the
+  // free space left in the heaps. Nothing is allocated, so this can be called
+  // from loop() to watch the high-water marks over time.
+  void Report(tflite::ErrorReporter* error_reporter) const;
+
+ private:
+  struct Region {
+    const char* name;
+    const uint8_t* start;
+    size_t size;
+    bool is_painted;
+    int parent;
+  };
+  struct Task {
+    const char* name;
+    void* handle;
+    size_t stack_size;
+  };
+
+  static constexpr int kMaxRegions = 24;
+  static constexpr int kMaxTasks = 4;
+  Region regions_[kMaxRegions];
+  int region_count_;
+  Task tasks_[kMaxTasks];
+  int task_count_;
+  int overflow_count_;
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MEMORY_REPORT_H_
@@ -0,0 +1,203 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "micro_features_channels.h"
+
+#include "micro_model_settings.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/bits.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/log_lut.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/noise_reduction.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/pcan_gain_control.h"
+
+namespace {
+
+// The log is taken of the filterbank outputs scaled up by this, the same
+// correction FrontendProcessSamples() works out from the FFT size.
+constexpr int kLogCorrectionBits = 3;
+static_assert(kMicroFeaturesFftSize == 512,
+              "kLogCorrectionBits is for a 512-point FFT");
+
+// Sqrt32() and Sqrt64() from filterbank.c folded together. Their rounding
+// differs slightly, and the features depend on it.
+uint32_t Sqrt64(uint64_t num) {
+  if (num == 0) {
+    return 0;
+  }
+  const bool is_32_bit = ((num >> 32) == 0);
+  const int width = is_32_bit ? 32 : 64;
+  int max_bit_number =
+      width - (is_32_bit ? MostSignificantBit32(static_cast<uint32_t>(num))
+                         : MostSignificantBit64(num));
+  max_bit_number |= 1;
+  uint64_t res = 0;
+  uint64_t bit = 1ULL << ((width - 1) - max_bit_number);
+  int iterations = (((width - 1) - max_bit_number) / 2) + 1;
+  while (iterations--) {
+    if (num >= res + bit) {
+      num -= res + bit;
+      res = (res >> 1U) + bit;
+    } else {
+      res >>= 1U;
+    }
+    bit >>= 2U;
+  }
+  const uint64_t res_max = is_32_bit ? 0xFFFF : 0xFFFFFFFF;
+  if ((num > res) && (res != res_max)) {
+    ++res;
+  }
+  return static_cast<uint32_t>(res);
+}
+
+// The PCAN gain for a noise level, interpolated from the gain table as
+// WideDynamicFunction() does.
+uint32_t PcanGain(uint32_t x) {
+  if (x <= 2) {
+    return static_cast<uint32_t>(g_micro_features_pcan_gain_lut[x]);
+  }
+  const int16_t interval = MostSignificantBit32(x);
+  const int16_t* lut = g_micro_features_pcan_gain_lut + ((4 * interval) - 6);
+  const int16_t frac =
+      ((interval < 11) ? (x << (11 - interval)) : (x >> (interval - 11))) &
+      0x3FF;
+  int32_t result = (static_cast<int32_t>(lut[2]) * frac) >> 5;
+  result += static_cast<int32_t>(static_cast<uint32_t>(lut[1]) << 5);
+  result *= frac;
+  result = (result + (1 << 14)) >> 15;
+  result += lut[0];
+  return static_cast<uint32_t>(static_cast<int16_t>(result));
+}
+
+uint32_t PcanShrink(uint32_t x) {
+  if (x < (2 << kPcanSnrBits)) {
+    return (x * x) >> (2 + (2 * kPcanSnrBits) - kPcanOutputBits);
+  }
+  return (x >> (kPcanSnrBits - kPcanOutputBits)) - (1 << kPcanOutputBits);
+}
+
+// Natural log scaled by 2^kLogScaleShift, from log_scale.c. x must be more
+// than one.
+uint32_t ScaledLog(uint32_t x) {
+  const uint32_t integer = MostSignificantBit32(x) - 1;
+  int32_t frac = x - (1LL << integer);
+  if (integer < kLogScaleLog2) {
+    frac <<= kLogScaleLog2 - integer;
+  } else {
+    frac >>= integer - kLogScaleLog2;
+  }
+  const uint32_t base_seg = frac >> (kLogScaleLog2 - kLogSegmentsLog2);
+  const uint32_t seg_unit =
+      (static_cast<uint32_t>(1) << kLogScaleLog2) >> kLogSegmentsLog2;
+  const int32_t c0 = kLogLut[base_seg];
+  const int32_t c1 = kLogLut[base_seg + 1];
+  const int32_t seg_base = seg_unit * base_seg;
+  const int32_t rel_pos = ((c1 - c0) * (frac - seg_base)) >> kLogScaleLog2;
+  const uint32_t fraction = frac + c0 + rel_pos;
+
+  const uint32_t log2 = (integer << kLogScaleLog2) + fraction;
+  const uint32_t round = kLogScale / 2;
+  const uint32_t loge =
+      ((static_cast<uint64_t>(kLogCoeff) * log2) + round) >> kLogScaleLog2;
+  return ((loge << kLogScaleShift) + round) >> kLogScaleLog2;
+}
+
+}  // namespace
+
+uint8_t QuantizeMicroFeature(uint16_t value) {
+  // These scaling values are derived from those used in input_data.py in the
+  // training pipeline.
+  constexpr int32_t value_scale = (10 * 255);
+  constexpr int32_t value_div = (256 * 26);
+  int32_t scaled = ((value * value_scale) + (value_div / 2)) / value_div;
+  if (scaled < 0) {
+    scaled = 0;
+  }
+  if (scaled > 255) {
+    scaled = 255;
+  }
+  return scaled;
+}
+
+void ComputeMicroFeaturesChannels(const complex_int16_t* spectrum,
+                                  int input_shift, uint32_t* noise_estimate,
+                                  uint8_t* features) {
+  constexpr uint32_t kOne = 1 << kNoiseReductionBits;
+  const uint32_t smoothing[2] = {
+      g_micro_features_noise_reduction_even_smoothing,
+      g_micro_features_noise_reduction_odd_smoothing};
+
+  // Each channel's unweighted sum tapers into the one after it, so the
+  // filterbank output of a channel is only complete once the next has been
+  // accumulated. Channel zero exists only to taper into the first feature.
+  uint64_t weighted_sum = 0;
+  for (int channel = 0; channel <= kFeatureSliceSize; ++channel) {
+    const complex_int16_t* bins =
+        spectrum + g_micro_features_filterbank_channel_frequency_starts[channel];
+    const int weight_start =
+        g_micro_features_filterbank_channel_weight_starts[channel];
+    const int16_t* weights = g_micro_features_filterbank_weights + weight_start;
+    const int16_t* unweights =
+        g_micro_features_filterbank_unweights + weight_start;
+    const int width = g_micro_features_filterbank_channel_widths[channel];
+    uint64_t unweighted_sum = 0;
+    for (int j = 0; j < width; ++j) {
+      const int32_t real = bins[j].real;
+      const int32_t imag = bins[j].imag;
+      // The library keeps the energy in an int32_t, which this has to match
+      // for a full-scale bin.
+      const uint32_t energy_bits = static_cast<uint32_t>(real * real) +
+                                   static_cast<uint32_t>(imag * imag);
+      const uint64_t energy =
+          static_cast<uint64_t>(static_cast<int32_t>(energy_bits));
+      weighted_sum += static_cast<uint64_t>(weights[j]) * energy;
+      unweighted_sum += static_cast<uint64_t>(unweights[j]) * energy;
+    }
+    if (channel == 0) {
+      weighted_sum = unweighted_sum;
+      continue;
+    }
+    const int i = channel - 1;
+    const uint32_t signal = Sqrt64(weighted_sum) >> input_shift;
+    weighted_sum = unweighted_sum;
+
+    // Noise reduction.
+    const uint32_t signal_scaled_up = signal << kNoiseReductionSmoothingBits;
+    uint32_t estimate =
+        ((static_cast<uint64_t>(signal_scaled_up) * smoothing[i & 1]) +
+         (static_cast<uint64_t>(noise_estimate[i]) * (kOne - smoothing[i & 1]))) >>
+        kNoiseReductionBits;
+    noise_estimate[i] = estimate;
+    if (estimate > signal_scaled_up) {
+      estimate = signal_scaled_up;
+    }
+    const uint32_t floor =
+        (static_cast<uint64_t>(signal) *
+         g_micro_features_noise_reduction_min_signal_remaining) >>
+        kNoiseReductionBits;
+    const uint32_t subtracted =
+        (signal_scaled_up - estimate) >> kNoiseReductionSmoothingBits;
+    const uint32_t reduced = (subtracted > floor) ? subtracted : floor;
+
+    // PCAN gain control, against the estimate just updated.
+    const uint32_t snr =
+        (static_cast<uint64_t>(reduced) * PcanGain(noise_estimate[i])) >>
+        g_micro_features_pcan_snr_shift;
+    const uint32_t gained = PcanShrink(snr) << kLogCorrectionBits;
+
+    // Log scale, and the scaling to a feature.
+    const uint32_t logged = (gained > 1) ? ScaledLog(gained) : 0;
+    features[i] =
+        QuantizeMicroFeature((logged < 0xFFFF) ? logged : 0xFFFF);
+  }
+}
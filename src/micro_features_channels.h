@@ -0,0 +1,44 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MICRO_FEATURES_CHANNELS_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MICRO_FEATURES_CHANNELS_H_
+
+#include <cstdint>
+
+#include "micro_features_tables.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft.h"
+
+// Everything the frontend does after the FFT, in one pass over the channels.
+// The library makes a pass each for the bin energies, the filterbank, the
+// square roots, noise reduction, PCAN gain control and the log scale, with
+// the settings held in its state structs. Here each channel is taken all the
+// way from FFT bins to its final uint8_t feature before moving on to the next,
+// with the settings from micro_model_settings.h and the generated tables built
+// in as constants. The results are the same as the library's, bit for bit.
+
+// Turns the kMicroFeaturesFftComplexSize + 1 bins of the spectrum into
+// kFeatureSliceSize features, scaled to 0-255 as the model was trained with.
+// input_shift is the shift the FFT's input was scaled up by. noise_estimate
+// holds the running noise level of each channel, and is updated.
+void ComputeMicroFeaturesChannels(const complex_int16_t* spectrum,
+                                  int input_shift, uint32_t* noise_estimate,
+                                  uint8_t* features);
+
+// Scales one of the library's log-scaled filterbank outputs to a feature, as
+// input_data.py does in the training pipeline.
+uint8_t QuantizeMicroFeature(uint16_t value);
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MICRO_FEATURES_CHANNELS_H_
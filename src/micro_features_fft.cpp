@@ -0,0 +1,318 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "micro_features_fft.h"
+
+#include <cstring>
+
+#include "simd_int16.h"
+
+namespace {
+
+// kFrontendWindowBits, the fixed-point precision of the window coefficients.
+constexpr int kWindowBits = 12;
+constexpr int kComplexSize = kMicroFeaturesFftComplexSize;
+// kissfft divides by 4 before each radix-4 stage, and by 2 before splitting
+// the spectrum, by multiplying with these Q15 fractions.
+constexpr int16_t kQuarter = 32767 / 4;
+constexpr int16_t kHalf = 32767 / 2;
+
+static_assert(kMicroFeaturesWindowSize % 2 == 0,
+              "The window is read as pairs of samples");
+static_assert(kComplexSize % 16 == 0,
+              "The first stage is done four butterflies at a time");
+
+inline int16_t RoundQ15(int32_t value) {
+  return static_cast<int16_t>((value + (1 << 14)) >> 15);
+}
+
+inline int16_t MulQ15Round(int16_t a, int16_t b) {
+  return RoundQ15(static_cast<int32_t>(a) * b);
+}
+
+// kissfft's recursion reads its input in base-4 digit-reversed order, so the
+// iterative version here starts by putting the samples in that order.
+inline int DigitReverse(int index) {
+  int reversed = 0;
+  for (int remaining = kComplexSize; remaining > 1; remaining >>= 2) {
+    reversed = (reversed << 2) | (index & 3);
+    index >>= 2;
+  }
+  return reversed;
+}
+
+// The real samples are treated as complex values made from pairs of them, and
+// everything past the end of the window is zero.
+void LoadFftInput(const int16_t* windowed, int16_t* work) {
+  constexpr int kWindowedPairs = kMicroFeaturesWindowSize / 2;
+  for (int i = 0; i < kComplexSize; ++i) {
+    const int pair = DigitReverse(i);
+    if (pair < kWindowedPairs) {
+      memcpy(work + (2 * i), windowed + (2 * pair), 2 * sizeof(int16_t));
+    } else {
+      work[2 * i] = 0;
+      work[(2 * i) + 1] = 0;
+    }
+  }
+}
+
+// One radix-4 stage of length m, the same butterfly as kf_bfly4() with the
+// same rounding. The twiddles are laid out as micro_features_tables.h
+// describes.
+void RadixFourStageScalar(int16_t* data, int m, const int16_t* twiddles) {
+  for (int group = 0; group < kComplexSize; group += 4 * m) {
+    for (int k = 0; k < m; ++k) {
+      int16_t* f[4];
+      int16_t real[4];
+      int16_t imag[4];
+      for (int j = 0; j < 4; ++j) {
+        f[j] = data + (2 * (group + (j * m) + k));
+        real[j] = MulQ15Round(f[j][0], kQuarter);
+        imag[j] = MulQ15Round(f[j][1], kQuarter);
+      }
+      int16_t product_real[4];
+      int16_t product_imag[4];
+      for (int j = 1; j < 4; ++j) {
+        const int16_t* real_terms = twiddles + ((j - 1) * 4 * m) + (2 * k);
+        const int16_t* imag_terms = real_terms + (2 * m);
+        product_real[j] =
+            RoundQ15((real[j] * real_terms[0]) + (imag[j] * real_terms[1]));
+        product_imag[j] =
+            RoundQ15((real[j] * imag_terms[0]) + (imag[j] * imag_terms[1]));
+      }
+      const int16_t difference_real = real[0] - product_real[2];
+      const int16_t difference_imag = imag[0] - product_imag[2];
+      const int16_t sum_real = real[0] + product_real[2];
+      const int16_t sum_imag = imag[0] + product_imag[2];
+      const int16_t odd_sum_real = product_real[1] + product_real[3];
+      const int16_t odd_sum_imag = product_imag[1] + product_imag[3];
+      const int16_t odd_difference_real = product_real[1] - product_real[3];
+      const int16_t odd_difference_imag = product_imag[1] - product_imag[3];
+      f[2][0] = sum_real - odd_sum_real;
+      f[2][1] = sum_imag - odd_sum_imag;
+      f[0][0] = sum_real + odd_sum_real;
+      f[0][1] = sum_imag + odd_sum_imag;
+      f[1][0] = difference_real + odd_difference_imag;
+      f[1][1] = difference_imag - odd_difference_real;
+      f[3][0] = difference_real - odd_difference_imag;
+      f[3][1] = difference_imag + odd_difference_real;
+    }
+  }
+}
+
+// Turns the complex FFT of the sample pairs into the spectrum of the real
+// samples, as the second half of kiss_fftr() does.
+void SplitRealSpectrum(const int16_t* data, complex_int16_t* output) {
+  const int16_t dc_real = MulQ15Round(data[0], kHalf);
+  const int16_t dc_imag = MulQ15Round(data[1], kHalf);
+  output[0].real = dc_real + dc_imag;
+  output[0].imag = 0;
+  output[kComplexSize].real = dc_real - dc_imag;
+  output[kComplexSize].imag = 0;
+  for (int k = 1; k <= kComplexSize / 2; ++k) {
+    const int16_t* bin = data + (2 * k);
+    const int16_t* mirror = data + (2 * (kComplexSize - k));
+    const int16_t bin_real = MulQ15Round(bin[0], kHalf);
+    const int16_t bin_imag = MulQ15Round(bin[1], kHalf);
+    const int16_t mirror_real = MulQ15Round(mirror[0], kHalf);
+    const int16_t mirror_imag =
+        MulQ15Round(static_cast<int16_t>(-mirror[1]), kHalf);
+    const int16_t sum_real = bin_real + mirror_real;
+    const int16_t sum_imag = bin_imag + mirror_imag;
+    const int16_t difference_real = bin_real - mirror_real;
+    const int16_t difference_imag = bin_imag - mirror_imag;
+    const int16_t* twiddle = g_micro_features_fft_split_twiddles + (2 * (k - 1));
+    const int16_t twisted_real = RoundQ15((difference_real * twiddle[0]) -
+                                          (difference_imag * twiddle[1]));
+    const int16_t twisted_imag = RoundQ15((difference_real * twiddle[1]) +
+                                          (difference_imag * twiddle[0]));
+    output[k].real = (sum_real + twisted_real) >> 1;
+    output[k].imag = (sum_imag + twisted_imag) >> 1;
+    output[kComplexSize - k].real = (sum_real - twisted_real) >> 1;
+    output[kComplexSize - k].imag = (twisted_imag - sum_imag) >> 1;
+  }
+}
+
+#if defined(MICRO_SPEECH_SIMD_INT16X8)
+
+// The butterfly from RadixFourStageScalar() on a vector's worth of complex
+// values at once. f holds the four inputs, and is overwritten with the
+// outputs. twiddles holds the real and imaginary terms of the three twiddles.
+template <typename V>
+inline void RadixFourButterflies(V* f, const V* twiddles) {
+  const V quarter = V::Splat(kQuarter);
+  const V input0 = MulQ15Round(f[0], quarter);
+  const V product1 =
+      ComplexMulQ15(MulQ15Round(f[1], quarter), twiddles[0], twiddles[1]);
+  const V product2 =
+      ComplexMulQ15(MulQ15Round(f[2], quarter), twiddles[2], twiddles[3]);
+  const V product3 =
+      ComplexMulQ15(MulQ15Round(f[3], quarter), twiddles[4], twiddles[5]);
+  const V difference = input0 - product2;
+  const V sum = input0 + product2;
+  const V odd_sum = product1 + product3;
+  const V odd_difference = ComplexMulMinusI(product1 - product3);
+  f[2] = sum - odd_sum;
+  f[0] = sum + odd_sum;
+  f[1] = difference + odd_difference;
+  f[3] = difference - odd_difference;
+}
+
+// Stages of length m, with a vector's worth of butterflies from the same
+// group done together. m must be a multiple of the complex values per vector.
+template <typename V>
+void RadixFourStage(int16_t* data, int m, const int16_t* twiddles) {
+  for (int group = 0; group < kComplexSize; group += 4 * m) {
+    for (int k = 0; k < m; k += V::kLanes / 2) {
+      int16_t* base = data + (2 * (group + k));
+      V f[4];
+      V twiddle_terms[6];
+      for (int j = 0; j < 4; ++j) {
+        f[j] = V::Load(base + (2 * j * m));
+      }
+      for (int j = 0; j < 6; ++j) {
+        twiddle_terms[j] = V::Load(twiddles + (2 * j * m) + (2 * k));
+      }
+      RadixFourButterflies(f, twiddle_terms);
+      for (int j = 0; j < 4; ++j) {
+        f[j].Store(base + (2 * j * m));
+      }
+    }
+  }
+}
+
+// The first stage has length one, so each group is a single butterfly. Four
+// groups at a time are transposed, so each vector holds the same input from
+// each of them.
+void FirstRadixFourStage(int16_t* data) {
+  simd::Int16x8 twiddle_terms[6];
+  for (int j = 0; j < 6; ++j) {
+    twiddle_terms[j] =
+        simd::Int16x8::SplatPair(g_micro_features_fft_stage_twiddles + (2 * j));
+  }
+  for (int group = 0; group < kComplexSize; group += 16) {
+    simd::Int16x8 f[4];
+    for (int j = 0; j < 4; ++j) {
+      f[j] = simd::Int16x8::Load(data + (2 * (group + (4 * j))));
+    }
+    simd::TransposeComplex4x4(f);
+    RadixFourButterflies(f, twiddle_terms);
+    simd::TransposeComplex4x4(f);
+    for (int j = 0; j < 4; ++j) {
+      f[j].Store(data + (2 * (group + (4 * j))));
+    }
+  }
+}
+
+template <typename V>
+int16_t ApplyWindowVectorized(const int16_t* input, int16_t* output) {
+  V max = V::Splat(0);
+  int i = 0;
+  for (; i + V::kLanes <= kMicroFeaturesWindowSize; i += V::kLanes) {
+    const V value = simd::MulShiftRight<kWindowBits>(
+        V::Load(input + i), V::Load(g_micro_features_window_coefficients + i));
+    value.Store(output + i);
+    max = Max(max, Abs(value));
+  }
+  int16_t max_abs_value = ReduceMax(max);
+  if (i < kMicroFeaturesWindowSize) {
+    const int16_t tail_max = ApplyMicroFeaturesWindowScalar(input, output);
+    max_abs_value = (tail_max > max_abs_value) ? tail_max : max_abs_value;
+  }
+  return max_abs_value;
+}
+
+#endif  // defined(MICRO_SPEECH_SIMD_INT16X8)
+
+}  // namespace
+
+int16_t ApplyMicroFeaturesWindowScalar(const int16_t* input, int16_t* output) {
+  int16_t max_abs_value = 0;
+  for (int i = 0; i < kMicroFeaturesWindowSize; ++i) {
+    int16_t value =
+        (static_cast<int32_t>(input[i]) * g_micro_features_window_coefficients[i]) >>
+        kWindowBits;
+    output[i] = value;
+    // As in the library, -32768 has no positive int16 and is left negative.
+    if (value < 0) {
+      value = -value;
+    }
+    if (value > max_abs_value) {
+      max_abs_value = value;
+    }
+  }
+  return max_abs_value;
+}
+
+int16_t ApplyMicroFeaturesWindow(const int16_t* input, int16_t* output) {
+#if defined(MICRO_SPEECH_SIMD_INT16X16)
+  return ApplyWindowVectorized<simd::Int16x16>(input, output);
+#elif defined(MICRO_SPEECH_SIMD_INT16X8)
+  return ApplyWindowVectorized<simd::Int16x8>(input, output);
+#else
+  return ApplyMicroFeaturesWindowScalar(input, output);
+#endif
+}
+
+void ComputeMicroFeaturesFftScalar(const int16_t* windowed, int input_shift,
+                                   int16_t* work, complex_int16_t* output) {
+  LoadFftInput(windowed, work);
+  for (int i = 0; i < kMicroFeaturesFftSize; ++i) {
+    work[i] = static_cast<int16_t>(static_cast<uint16_t>(work[i])
+                                   << input_shift);
+  }
+  for (int m = 1; m < kComplexSize; m *= 4) {
+    RadixFourStageScalar(work, m,
+                         g_micro_features_fft_stage_twiddles + (4 * (m - 1)));
+  }
+  SplitRealSpectrum(work, output);
+}
+
+void ComputeMicroFeaturesFft(const int16_t* windowed, int input_shift,
+                             int16_t* work, complex_int16_t* output) {
+#if defined(MICRO_SPEECH_SIMD_INT16X8)
+  LoadFftInput(windowed, work);
+  for (int i = 0; i < kMicroFeaturesFftSize; i += simd::Int16x8::kLanes) {
+    ShiftLeft(simd::Int16x8::Load(work + i), input_shift).Store(work + i);
+  }
+  FirstRadixFourStage(work);
+  for (int m = 4; m < kComplexSize; m *= 4) {
+    const int16_t* twiddles =
+        g_micro_features_fft_stage_twiddles + (4 * (m - 1));
+#if defined(MICRO_SPEECH_SIMD_INT16X16)
+    if (m % (simd::Int16x16::kLanes / 2) == 0) {
+      RadixFourStage<simd::Int16x16>(work, m, twiddles);
+      continue;
+    }
+#endif  // defined(MICRO_SPEECH_SIMD_INT16X16)
+    RadixFourStage<simd::Int16x8>(work, m, twiddles);
+  }
+  SplitRealSpectrum(work, output);
+#else   // defined(MICRO_SPEECH_SIMD_INT16X8)
+  ComputeMicroFeaturesFftScalar(windowed, input_shift, work, output);
+#endif  // defined(MICRO_SPEECH_SIMD_INT16X8)
+}
+
+const char* MicroFeaturesFftBackend() {
+#if defined(MICRO_SPEECH_SIMD_INT16X16)
+  return "AVX2";
+#elif defined(__SSE4_1__)
+  return "SSE4.1";
+#elif defined(__ARM_NEON)
+  return "NEON";
+#else
+  return "scalar";
+#endif
+}
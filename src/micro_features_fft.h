@@ -0,0 +1,49 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MICRO_FEATURES_FFT_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MICRO_FEATURES_FFT_H_
+
+#include <cstdint>
+
+#include "micro_features_tables.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft.h"
+
+// The window and FFT from the feature generation frontend. The library runs
+// these through WindowProcessSamples() and a general-purpose kissfft, which is
+// most of the cost of each slice. These versions are specialized for the one
+// size the model uses, read their twiddles from flash, and are vectorized with
+// simd_int16.h where the target allows, while producing exactly the same
+// numbers as the library's FIXED_POINT 16 code.
+
+// Multiplies kMicroFeaturesWindowSize samples by the window into output, and
+// returns the largest absolute value in the result, as WindowProcessSamples()
+// does.
+int16_t ApplyMicroFeaturesWindow(const int16_t* input, int16_t* output);
+int16_t ApplyMicroFeaturesWindowScalar(const int16_t* input, int16_t* output);
+
+// Does what FftCompute() does for the windowed samples: shifts them left by
+// input_shift, pads them with zeros to kMicroFeaturesFftSize, and writes the
+// kMicroFeaturesFftSize / 2 + 1 bins of their real FFT to output. work must
+// hold kMicroFeaturesFftSize values and can't overlap output.
+void ComputeMicroFeaturesFft(const int16_t* windowed, int input_shift,
+                             int16_t* work, complex_int16_t* output);
+void ComputeMicroFeaturesFftScalar(const int16_t* windowed, int input_shift,
+                                   int16_t* work, complex_int16_t* output);
+
+// Names the instruction set the non-scalar functions above use.
+const char* MicroFeaturesFftBackend();
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MICRO_FEATURES_FFT_H_
@@ -18,53 +18,305 @@ limitations under the License.
 #include <cmath>
 #include <cstring>
 
+#include "micro_features_channels.h"
+#include "micro_features_fft.h"
+#include "micro_features_tables.h"
 #include "micro_model_settings.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/bits.h"
+
+#ifdef MICRO_FEATURES_VERIFY_TABLES
 #include "tensorflow/lite/experimental/microfrontend/lib/frontend.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/frontend_util.h"
-
-// Configure FFT to output 16 bit fixed point.
-#define FIXED_POINT 16
+#endif  // MICRO_FEATURES_VERIFY_TABLES
 
 namespace {
 
-FrontendState g_micro_features_state;
 bool g_is_first_time = true;
 
-}  // namespace
+// The parts of the frontend state that change as audio is processed. The
+// read-only tables they work with live in micro_features_tables.cpp.
+int16_t g_window_input[kMicroFeaturesWindowSize];
+size_t g_window_input_used = 0;
+MicroFeaturesWorkspace g_workspace;
 
-TfLiteStatus InitializeMicroFeatures(tflite::ErrorReporter* error_reporter) {
+// Turns one window of samples into a slice of features, with the stages from
+// micro_features_fft.h and micro_features_channels.h.
+void ComputeMicroFeaturesSlice(const int16_t* samples,
+                               MicroFeaturesWorkspace* workspace,
+                               uint8_t* features) {
+  const int16_t max_abs_value =
+      ApplyMicroFeaturesWindow(samples, workspace->windowed);
+  // Scale the FFT's input up so the fixed-point math keeps as much resolution
+  // as possible.
+  const int input_shift = 15 - MostSignificantBit32(max_abs_value);
+  ComputeMicroFeaturesFft(workspace->windowed, input_shift,
+                          workspace->fft_work, workspace->spectrum);
+  ComputeMicroFeaturesChannels(workspace->spectrum, input_shift,
+                               workspace->noise_estimate, features);
+}
+
+// Does what FrontendProcessSamples() does, with the buffering of
+// WindowProcessSamples(). Returns false if more samples are needed to fill the
+// window, in which case features is left alone.
+bool ProcessMicroFeaturesSamples(const int16_t* samples, size_t num_samples,
+                                 size_t* num_samples_read, uint8_t* features) {
+  size_t samples_to_copy = kMicroFeaturesWindowSize - g_window_input_used;
+  if (samples_to_copy > num_samples) {
+    samples_to_copy = num_samples;
+  }
+  memcpy(g_window_input + g_window_input_used, samples,
+         samples_to_copy * sizeof(*samples));
+  *num_samples_read = samples_to_copy;
+  g_window_input_used += samples_to_copy;
+  if (g_window_input_used < kMicroFeaturesWindowSize) {
+    return false;
+  }
+  ComputeMicroFeaturesSlice(g_window_input, &g_workspace, features);
+  memmove(g_window_input, g_window_input + kMicroFeaturesWindowStep,
+          sizeof(*g_window_input) *
+              (kMicroFeaturesWindowSize - kMicroFeaturesWindowStep));
+  g_window_input_used -= kMicroFeaturesWindowStep;
+  return true;
+}
+
+#ifdef MICRO_FEATURES_VERIFY_TABLES
+// Builds the configuration the tables were generated from, so the library can
+// recreate them for comparison.
+void FillFrontendConfig(FrontendConfig* config) {
+  config->window.size_ms = kFeatureSliceDurationMs;
+  config->window.step_size_ms = kFeatureSliceStrideMs;
+  config->filterbank.num_channels = kFeatureSliceSize;
+  config->filterbank.lower_band_limit = kFilterbankLowerBandLimit;
+  config->filterbank.upper_band_limit = kFilterbankUpperBandLimit;
+  config->noise_reduction.smoothing_bits = kNoiseReductionSmoothingBits;
+  config->noise_reduction.even_smoothing = kNoiseReductionEvenSmoothing;
+  config->noise_reduction.odd_smoothing = kNoiseReductionOddSmoothing;
+  config->noise_reduction.min_signal_remaining =
+      kNoiseReductionMinSignalRemaining;
+  config->pcan_gain_control.enable_pcan = 1;
+  config->pcan_gain_control.strength = kPcanGainControlStrength;
+  config->pcan_gain_control.offset = kPcanGainControlOffset;
+  config->pcan_gain_control.gain_bits = kPcanGainControlGainBits;
+  config->log_scale.enable_log = 1;
+  config->log_scale.scale_shift = kLogScaleShift;
+}
+
+int CountMismatches(const int16_t* expected, const int16_t* actual, int size) {
+  int mismatches = 0;
+  for (int i = 0; i < size; ++i) {
+    if (expected[i] != actual[i]) {
+      ++mismatches;
+    }
+  }
+  return mismatches;
+}
+
+// Fills windowed with noise at the given level, passed through the window,
+// and returns the FFT input shift that goes with it.
+int MakeTestWindow(uint32_t* random, int level, int16_t* windowed) {
+  int16_t samples[kMicroFeaturesWindowSize];
+  for (int i = 0; i < kMicroFeaturesWindowSize; ++i) {
+    *random = (*random * 1664525u) + 1013904223u;
+    samples[i] = static_cast<int16_t>(*random >> 16) >> level;
+  }
+  const int16_t max_abs_value = ApplyMicroFeaturesWindow(samples, windowed);
+  return 15 - MostSignificantBit32(max_abs_value);
+}
+
+// Runs windows of noise at a range of levels through both the library's FFT
+// and ComputeMicroFeaturesFft(), and counts the bins that differ.
+int CountFftMismatches(FftState* reference) {
+  int16_t windowed[kMicroFeaturesWindowSize];
+  uint32_t random = 12345;
+  int mismatches = 0;
+  for (int level = 0; level < 16; ++level) {
+    const int input_shift = MakeTestWindow(&random, level, windowed);
+    FftCompute(reference, windowed, input_shift);
+    ComputeMicroFeaturesFft(windowed, input_shift, g_workspace.fft_work,
+                            g_workspace.spectrum);
+    for (int i = 0; i <= kMicroFeaturesFftComplexSize; ++i) {
+      mismatches +=
+          (reference->output[i].real != g_workspace.spectrum[i].real) ||
+          (reference->output[i].imag != g_workspace.spectrum[i].imag);
+    }
+  }
+  return mismatches;
+}
+
+// Runs a sequence of spectra through the library's filterbank, noise
+// reduction, PCAN and log scale, and through ComputeMicroFeaturesChannels(),
+// and counts the features and noise estimates that differ. This updates the
+// reference's noise estimates.
+int CountChannelMismatches(FrontendState* reference) {
+  int16_t windowed[kMicroFeaturesWindowSize];
+  uint32_t noise_estimate[kFeatureSliceSize] = {};
+  uint8_t features[kFeatureSliceSize];
+  uint32_t random = 54321;
+  int mismatches = 0;
+  for (int slice = 0; slice < 64; ++slice) {
+    const int input_shift = MakeTestWindow(&random, slice % 16, windowed);
+    FftCompute(&reference->fft, windowed, input_shift);
+    memcpy(g_workspace.spectrum, reference->fft.output,
+           sizeof(g_workspace.spectrum));
+    ComputeMicroFeaturesChannels(g_workspace.spectrum, input_shift,
+                                 noise_estimate, features);
+
+    int32_t* energy = reinterpret_cast<int32_t*>(reference->fft.output);
+    FilterbankConvertFftComplexToEnergy(&reference->filterbank,
+                                        reference->fft.output, energy);
+    FilterbankAccumulateChannels(&reference->filterbank, energy);
+    uint32_t* scaled_filterbank =
+        FilterbankSqrt(&reference->filterbank, input_shift);
+    NoiseReductionApply(&reference->noise_reduction, scaled_filterbank);
+    PcanGainControlApply(&reference->pcan_gain_control, scaled_filterbank);
+    const int correction_bits = MostSignificantBit32(reference->fft.fft_size) -
+                                1 - (kFilterbankBits / 2);
+    const uint16_t* logged_filterbank =
+        LogScaleApply(&reference->log_scale, scaled_filterbank,
+                      kFeatureSliceSize, correction_bits);
+    for (int i = 0; i < kFeatureSliceSize; ++i) {
+      mismatches += (features[i] != QuantizeMicroFeature(logged_filterbank[i]));
+      mismatches +=
+          (noise_estimate[i] != reference->noise_reduction.estimate[i]);
+    }
+  }
+  return mismatches;
+}
+
+// Checks the generated tables against the ones FrontendPopulateState() builds
+// at runtime, to catch settings that changed without the tables being
+// regenerated.
+TfLiteStatus VerifyMicroFeaturesTables(tflite::ErrorReporter* error_reporter) {
   FrontendConfig config;
-  config.window.size_ms = kFeatureSliceDurationMs;
-  config.window.step_size_ms = kFeatureSliceStrideMs;
-  config.noise_reduction.smoothing_bits = 10;
-  config.filterbank.num_channels = kFeatureSliceSize;
-  config.filterbank.lower_band_limit = 125.0;
-  config.filterbank.upper_band_limit = 7500.0;
-  config.noise_reduction.smoothing_bits = 10;
-  config.noise_reduction.even_smoothing = 0.025;
-  config.noise_reduction.odd_smoothing = 0.06;
-  config.noise_reduction.min_signal_remaining = 0.05;
-  config.pcan_gain_control.enable_pcan = 1;
-  config.pcan_gain_control.strength = 0.95;
-  config.pcan_gain_control.offset = 80.0;
-  config.pcan_gain_control.gain_bits = 21;
-  config.log_scale.enable_log = 1;
-  config.log_scale.scale_shift = 6;
-  if (!FrontendPopulateState(&config, &g_micro_features_state,
-                             kAudioSampleFrequency)) {
+  FillFrontendConfig(&config);
+  FrontendState reference;
+  if (!FrontendPopulateState(&config, &reference, kAudioSampleFrequency)) {
     error_reporter->Report("FrontendPopulateState() failed");
     return kTfLiteError;
   }
+
+  int mismatches = 0;
+  mismatches += (reference.window.size != kMicroFeaturesWindowSize);
+  mismatches += (reference.window.step != kMicroFeaturesWindowStep);
+  if (reference.window.size == kMicroFeaturesWindowSize) {
+    mismatches += CountMismatches(reference.window.coefficients,
+                                  g_micro_features_window_coefficients,
+                                  kMicroFeaturesWindowSize);
+  }
+  const FilterbankState& filterbank = reference.filterbank;
+  mismatches +=
+      (filterbank.start_index != g_micro_features_filterbank_start_index);
+  mismatches += (filterbank.end_index != g_micro_features_filterbank_end_index);
+  mismatches += CountMismatches(
+      filterbank.channel_frequency_starts,
+      g_micro_features_filterbank_channel_frequency_starts,
+      kFeatureSliceSize + 1);
+  mismatches += CountMismatches(filterbank.channel_weight_starts,
+                                g_micro_features_filterbank_channel_weight_starts,
+                                kFeatureSliceSize + 1);
+  mismatches += CountMismatches(filterbank.channel_widths,
+                                g_micro_features_filterbank_channel_widths,
+                                kFeatureSliceSize + 1);
+  if (mismatches == 0) {
+    mismatches += CountMismatches(filterbank.weights,
+                                  g_micro_features_filterbank_weights,
+                                  g_micro_features_filterbank_weight_count);
+    mismatches += CountMismatches(filterbank.unweights,
+                                  g_micro_features_filterbank_unweights,
+                                  g_micro_features_filterbank_weight_count);
+  }
+  const NoiseReductionState& noise_reduction = reference.noise_reduction;
+  mismatches += (noise_reduction.even_smoothing !=
+                 g_micro_features_noise_reduction_even_smoothing);
+  mismatches += (noise_reduction.odd_smoothing !=
+                 g_micro_features_noise_reduction_odd_smoothing);
+  mismatches += (noise_reduction.min_signal_remaining !=
+                 g_micro_features_noise_reduction_min_signal_remaining);
+  mismatches += (reference.pcan_gain_control.snr_shift !=
+                 g_micro_features_pcan_snr_shift);
+  mismatches += CountMismatches(reference.pcan_gain_control.gain_lut,
+                                g_micro_features_pcan_gain_lut,
+                                kMicroFeaturesPcanGainLutSize);
+  if (reference.fft.fft_size == kMicroFeaturesFftSize) {
+    mismatches += CountFftMismatches(&reference.fft);
+    mismatches += CountChannelMismatches(&reference);
+  } else {
+    ++mismatches;
+  }
+  FrontendFreeStateContents(&reference);
+
+  if (mismatches != 0) {
+    error_reporter->Report(
+        "%d frontend table entries or results differ from the library's, "
+        "rerun tools/generate_micro_features_tables.cpp",
+        mismatches);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+#endif  // MICRO_FEATURES_VERIFY_TABLES
+
+}  // namespace
+
+TfLiteStatus InitializeMicroFeatures(tflite::ErrorReporter* error_reporter) {
+#ifdef MICRO_FEATURES_VERIFY_TABLES
+  TfLiteStatus verify_status = VerifyMicroFeaturesTables(error_reporter);
+  if (verify_status != kTfLiteOk) {
+    return verify_status;
+  }
+#endif  // MICRO_FEATURES_VERIFY_TABLES
+
+  memset(g_window_input, 0, sizeof(g_window_input));
+  g_window_input_used = 0;
+  ResetMicroFeaturesWorkspace(&g_workspace);
   g_is_first_time = true;
   return kTfLiteOk;
 }
 
-// This is not exposed in any header, and is only used for testing, to ensure
-// that the state is correctly set up before generating results.
-void SetMicroFeaturesNoiseEstimates(const uint32_t* estimate_presets) {
-  for (int i = 0; i < g_micro_features_state.filterbank.num_channels; ++i) {
-    g_micro_features_state.noise_reduction.estimate[i] = estimate_presets[i];
+void AddMicroFeaturesMemoryRegions(MemoryReport* report) {
+  report->AddRegion("frontend window", g_window_input, sizeof(g_window_input));
+  report->AddRegion("frontend workspace", &g_workspace, sizeof(g_workspace));
+}
+
+void ResetMicroFeaturesWorkspace(MicroFeaturesWorkspace* workspace) {
+  memset(workspace->noise_estimate, 0, sizeof(workspace->noise_estimate));
+}
+
+int MicroFeaturesSliceCount(size_t sample_count) {
+  if (sample_count < kMicroFeaturesWindowSize) {
+    return 0;
+  }
+  return static_cast<int>((sample_count - kMicroFeaturesWindowSize) /
+                          kMicroFeaturesWindowStep) +
+         1;
+}
+
+TfLiteStatus ComputeSpectrogram(tflite::ErrorReporter* error_reporter,
+                                const int16_t* samples, size_t sample_count,
+                                MicroFeaturesWorkspace* workspace,
+                                uint8_t* output, size_t output_size) {
+  const int slice_count = MicroFeaturesSliceCount(sample_count);
+  if (output_size < static_cast<size_t>(slice_count) * kFeatureSliceSize) {
+    error_reporter->Report("Spectrogram of %d slices needs %d bytes, got %d",
+                           slice_count, slice_count * kFeatureSliceSize,
+                           static_cast<int>(output_size));
+    return kTfLiteError;
+  }
+  for (int slice = 0; slice < slice_count; ++slice) {
+    ComputeMicroFeaturesSlice(samples + (slice * kMicroFeaturesWindowStep),
+                              workspace, output + (slice * kFeatureSliceSize));
   }
+  return kTfLiteOk;
+}
+
+void GetMicroFeaturesNoiseEstimates(uint32_t* estimates) {
+  memcpy(estimates, g_workspace.noise_estimate,
+         sizeof(g_workspace.noise_estimate));
+}
+
+void SetMicroFeaturesNoiseEstimates(const uint32_t* estimate_presets) {
+  memcpy(g_workspace.noise_estimate, estimate_presets,
+         sizeof(g_workspace.noise_estimate));
 }
 
 TfLiteStatus GenerateMicroFeatures(tflite::ErrorReporter* error_reporter,
@@ -78,25 +330,7 @@ TfLiteStatus GenerateMicroFeatures(tflite::ErrorReporter* error_reporter,
   } else {
     frontend_input = input + 160;
   }
-  FrontendOutput frontend_output = FrontendProcessSamples(
-      &g_micro_features_state, frontend_input, input_size, num_samples_read);
-
-  for (int i = 0; i < frontend_output.size; ++i) {
-    // These scaling values are derived from those used in input_data.py in the
-    // training pipeline.
-    constexpr int32_t value_scale = (10 * 255);
-    constexpr int32_t value_div = (256 * 26);
-    int32_t value =
-        ((frontend_output.values[i] * value_scale) + (value_div / 2)) /
-        value_div;
-    if (value < 0) {
-      value = 0;
-    }
-    if (value > 255) {
-      value = 255;
-    }
-    output[i] = value;
-  }
-
+  ProcessMicroFeaturesSamples(frontend_input, input_size, num_samples_read,
+                              output);
   return kTfLiteOk;
 }
@@ -16,8 +16,25 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MICRO_FEATURES_MICRO_FEATURES_GENERATOR_H_
 #define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MICRO_FEATURES_MICRO_FEATURES_GENERATOR_H_
 
+#include <cstddef>
+#include <cstdint>
+
+#include "memory_report.h"
+#include "micro_features_tables.h"
 #include "tensorflow/lite/c/c_api_internal.h"
 #include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft.h"
+
+// Everything a run of the frontend changes as it goes. The device's pipeline
+// has one of its own, and each ComputeSpectrogram() caller supplies another,
+// so separate threads can featurize audio at the same time.
+struct MicroFeaturesWorkspace {
+  int16_t windowed[kMicroFeaturesWindowSize];
+  int16_t fft_work[kMicroFeaturesFftSize];
+  complex_int16_t spectrum[kMicroFeaturesFftComplexSize + 1];
+  // The noise-reduction estimates, which carry from one slice to the next.
+  uint32_t noise_estimate[kFeatureSliceSize];
+};
 
 // Sets up any resources needed for the feature generation pipeline.
 TfLiteStatus InitializeMicroFeatures(tflite::ErrorReporter* error_reporter);
@@ -29,4 +46,39 @@ TfLiteStatus GenerateMicroFeatures(tflite::ErrorReporter* error_reporter,
                                    int output_size, uint8_t* output,
                                    size_t* num_samples_read);
 
+// Adds the frontend's window buffer and the device pipeline's workspace, which
+// holds the noise estimates, to a memory report.
+void AddMicroFeaturesMemoryRegions(MemoryReport* report);
+
+// Clears a workspace's noise estimates, as InitializeMicroFeatures() does for
+// the device's.
+void ResetMicroFeaturesWorkspace(MicroFeaturesWorkspace* workspace);
+
+// How many slices of features ComputeSpectrogram() makes from sample_count
+// samples: one for every kFeatureSliceStrideSamples that a whole
+// kFeatureSliceDurationSamples window fits in.
+int MicroFeaturesSliceCount(size_t sample_count);
+
+// Runs the frontend over a whole buffer of audio at kAudioSampleFrequency, and
+// writes MicroFeaturesSliceCount(sample_count) slices of kFeatureSliceSize
+// features to output, oldest first. This is the same computation
+// GenerateMicroFeatures() does a slice at a time for the feature provider, so
+// after ResetMicroFeaturesWorkspace() a one second clip gives exactly the
+// spectrogram the device would build from hearing it after a reset. The
+// workspace's noise estimates are left as the last slice updated them, which
+// lets a long recording be processed in consecutive pieces.
+TfLiteStatus ComputeSpectrogram(tflite::ErrorReporter* error_reporter,
+                                const int16_t* samples, size_t sample_count,
+                                MicroFeaturesWorkspace* workspace,
+                                uint8_t* output, size_t output_size);
+
+// Copies the frontend's current noise-reduction estimates, one per feature
+// channel, into estimates. These adapt slowly to the background level, so they
+// are worth keeping across a restart.
+void GetMicroFeaturesNoiseEstimates(uint32_t* estimates);
+
+// Overwrites the noise-reduction estimates, for example with values saved by
+// GetMicroFeaturesNoiseEstimates() before a reboot, or presets for testing.
+void SetMicroFeaturesNoiseEstimates(const uint32_t* estimate_presets);
+
 #endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MICRO_FEATURES_MICRO_FEATURES_GENERATOR_H_
@@ -0,0 +1,298 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// File automatically created by tools/generate_micro_features_tables.cpp,
+// see that file for how to regenerate it.
+
+#include "micro_features_tables.h"
+
+// The tables below were calculated from these settings.
+static_assert((kAudioSampleFrequency == 16000) &&
+                  (kFeatureSliceDurationMs == 30) &&
+                  (kFeatureSliceSize == 40) &&
+                  (kFilterbankLowerBandLimit == 125.000000f) &&
+                  (kFilterbankUpperBandLimit == 7500.00000f) &&
+                  (kNoiseReductionSmoothingBits == 10) &&
+                  (kNoiseReductionEvenSmoothing == 0.0250000004f) &&
+                  (kNoiseReductionOddSmoothing == 0.0599999987f) &&
+                  (kNoiseReductionMinSignalRemaining == 0.0500000007f) &&
+                  (kPcanGainControlStrength == 0.949999988f) &&
+                  (kPcanGainControlOffset == 80.0000000f) &&
+                  (kPcanGainControlGainBits == 21),
+              "micro_model_settings.h has changed, rerun "
+              "tools/generate_micro_features_tables.cpp");
+
+const int16_t g_micro_features_window_coefficients[480] = {
+    0, 0, 1, 2, 4, 5, 7, 10, 13, 16, 19, 23, 27, 32, 37, 42, 48, 53, 60, 66, 73,
+    81, 88, 96, 104, 113, 122, 131, 141, 151, 161, 172, 183, 194, 205, 217, 229,
+    242, 255, 268, 281, 295, 309, 323, 338, 353, 368, 383, 399, 415, 431, 448,
+    465, 482, 499, 517, 535, 553, 572, 590, 609, 629, 648, 668, 688, 708, 728,
+    749, 770, 791, 812, 833, 855, 877, 899, 921, 944, 967, 989, 1012, 1036,
+    1059, 1083, 1106, 1130, 1154, 1178, 1203, 1227, 1252, 1277, 1302, 1327,
+    1352, 1377, 1402, 1428, 1453, 1479, 1505, 1531, 1557, 1583, 1609, 1635,
+    1662, 1688, 1714, 1741, 1767, 1794, 1821, 1847, 1874, 1901, 1927, 1954,
+    1981, 2008, 2035, 2061, 2088, 2115, 2142, 2169, 2195, 2222, 2249, 2275,
+    2302, 2329, 2355, 2382, 2408, 2434, 2461, 2487, 2513, 2539, 2565, 2591,
+    2617, 2643, 2668, 2694, 2719, 2744, 2769, 2794, 2819, 2844, 2869, 2893,
+    2918, 2942, 2966, 2990, 3013, 3037, 3060, 3084, 3107, 3129, 3152, 3175,
+    3197, 3219, 3241, 3263, 3284, 3305, 3326, 3347, 3368, 3388, 3408, 3428,
+    3448, 3467, 3487, 3506, 3524, 3543, 3561, 3579, 3597, 3614, 3631, 3648,
+    3665, 3681, 3697, 3713, 3728, 3743, 3758, 3773, 3787, 3801, 3815, 3828,
+    3841, 3854, 3867, 3879, 3891, 3902, 3913, 3924, 3935, 3945, 3955, 3965,
+    3974, 3983, 3992, 4000, 4008, 4015, 4023, 4030, 4036, 4043, 4048, 4054,
+    4059, 4064, 4069, 4073, 4077, 4080, 4083, 4086, 4089, 4091, 4092, 4094,
+    4095, 4096, 4096, 4096, 4096, 4095, 4094, 4092, 4091, 4089, 4086, 4083,
+    4080, 4077, 4073, 4069, 4064, 4059, 4054, 4048, 4043, 4036, 4030, 4023,
+    4015, 4008, 4000, 3992, 3983, 3974, 3965, 3955, 3945, 3935, 3924, 3913,
+    3902, 3891, 3879, 3867, 3854, 3841, 3828, 3815, 3801, 3787, 3773, 3758,
+    3743, 3728, 3713, 3697, 3681, 3665, 3648, 3631, 3614, 3597, 3579, 3561,
+    3543, 3524, 3506, 3487, 3467, 3448, 3428, 3408, 3388, 3368, 3347, 3326,
+    3305, 3284, 3263, 3241, 3219, 3197, 3175, 3152, 3129, 3107, 3084, 3060,
+    3037, 3013, 2990, 2966, 2942, 2918, 2893, 2869, 2844, 2819, 2794, 2769,
+    2744, 2719, 2694, 2668, 2643, 2617, 2591, 2565, 2539, 2513, 2487, 2461,
+    2434, 2408, 2382, 2355, 2329, 2302, 2275, 2249, 2222, 2195, 2169, 2142,
+    2115, 2088, 2061, 2035, 2008, 1981, 1954, 1927, 1901, 1874, 1847, 1821,
+    1794, 1767, 1741, 1714, 1688, 1662, 1635, 1609, 1583, 1557, 1531, 1505,
+    1479, 1453, 1428, 1402, 1377, 1352, 1327, 1302, 1277, 1252, 1227, 1203,
+    1178, 1154, 1130, 1106, 1083, 1059, 1036, 1012, 989, 967, 944, 921, 899,
+    877, 855, 833, 812, 791, 770, 749, 728, 708, 688, 668, 648, 629, 609, 590,
+    572, 553, 535, 517, 499, 482, 465, 448, 431, 415, 399, 383, 368, 353, 338,
+    323, 309, 295, 281, 268, 255, 242, 229, 217, 205, 194, 183, 172, 161, 151,
+    141, 131, 122, 113, 104, 96, 88, 81, 73, 66, 60, 53, 48, 42, 37, 32, 27, 23,
+    19, 16, 13, 10, 7, 5, 4, 2, 1, 0, 0,
+};
+
+const int g_micro_features_filterbank_start_index = 5;
+const int g_micro_features_filterbank_end_index = 241;
+
+const int16_t g_micro_features_filterbank_channel_frequency_starts[41] = {
+    4, 6, 8, 8, 10, 12, 14, 16, 18, 22, 24, 26, 30, 32, 36, 38, 42, 46, 50, 54,
+    58, 64, 68, 74, 78, 84, 90, 98, 104, 112, 120, 128, 136, 146, 154, 166, 176,
+    188, 200, 212, 226,
+};
+
+const int16_t g_micro_features_filterbank_channel_weight_starts[41] = {
+    0, 4, 8, 12, 16, 20, 24, 28, 32, 36, 40, 44, 48, 52, 56, 60, 68, 76, 80, 88,
+    96, 104, 112, 120, 128, 136, 144, 152, 160, 168, 176, 184, 196, 208, 220,
+    232, 244, 256, 268, 284, 300,
+};
+
+const int16_t g_micro_features_filterbank_channel_widths[41] = {
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 8, 8, 4, 8, 8, 8, 8, 8, 8, 8,
+    8, 8, 8, 8, 8, 8, 12, 12, 12, 12, 12, 12, 12, 16, 16, 16,
+};
+
+const int g_micro_features_filterbank_weight_count = 316;
+
+const int16_t g_micro_features_filterbank_weights[] = {
+    0, 1377, 0, 0, 2852, 321, 0, 0, 1971, 0, 0, 0, 0, 3701, 1408, 0, 0, 3281,
+    1124, 0, 0, 3124, 1087, 0, 0, 3201, 1272, 0, 0, 3488, 1655, 0, 0, 3963,
+    2218, 513, 2943, 1314, 0, 0, 3817, 2258, 731, 0, 0, 3332, 1866, 430, 3117,
+    1734, 377, 0, 0, 3141, 1833, 548, 3381, 2139, 918, 0, 0, 3814, 2632, 1470,
+    325, 0, 0, 0, 0, 3294, 2185, 1092, 15, 0, 0, 0, 0, 3049, 2003, 972, 4051,
+    3048, 2058, 1082, 118, 0, 0, 0, 0, 3263, 2324, 1398, 482, 0, 0, 0, 0, 3674,
+    2782, 1899, 1028, 167, 0, 0, 3411, 2570, 1738, 915, 102, 0, 0, 0, 0, 3393,
+    2598, 1810, 1032, 261, 0, 0, 3594, 2840, 2093, 1353, 621, 0, 0, 0, 0, 3993,
+    3275, 2564, 1861, 1163, 473, 0, 0, 3885, 3207, 2536, 1870, 1211, 557, 0, 0,
+    4006, 3364, 2727, 2096, 1471, 850, 235, 3721, 3117, 2517, 1922, 1331, 746,
+    165, 0, 0, 3685, 3113, 2546, 1983, 1424, 870, 320, 3869, 3327, 2789, 2255,
+    1725, 1198, 676, 157, 3737, 3226, 2717, 2213, 1711, 1214, 719, 228, 3836,
+    3352, 2870, 2392, 1917, 1445, 976, 510, 46, 0, 0, 0, 0, 3682, 3225, 2770,
+    2319, 1870, 1424, 980, 539, 101, 0, 0, 3762, 3329, 2898, 2470, 2045, 1622,
+    1202, 784, 368, 0, 0, 0, 0, 4050, 3639, 3231, 2824, 2420, 2018, 1618, 1220,
+    825, 432, 40, 3747, 3360, 2975, 2592, 2211, 1832, 1455, 1079, 706, 335, 0,
+    0, 4061, 3693, 3328, 2964, 2601, 2241, 1882, 1526, 1170, 817, 465, 115,
+    3863, 3516, 3171, 2827, 2486, 2145, 1807, 1469, 1134, 800, 467, 136, 3903,
+    3575, 3248, 2923, 2599, 2277, 1956, 1636, 1318, 1002, 686, 372, 60, 0, 0, 0,
+    0, 3844, 3534, 3226, 2918, 2612, 2307, 2004, 1702, 1400, 1101, 802, 505,
+    208, 0, 0, 4010, 3716, 3423, 3132, 2841, 2552, 2264, 1977, 1692, 1407, 1123,
+    841, 560, 279, 0, 0,
+};
+
+const int16_t g_micro_features_filterbank_unweights[] = {
+    0, 2719, 0, 0, 1244, 3775, 0, 0, 2125, 0, 0, 0, 0, 395, 2688, 0, 0, 815,
+    2972, 0, 0, 972, 3009, 0, 0, 895, 2824, 0, 0, 608, 2441, 0, 0, 133, 1878,
+    3583, 1153, 2782, 0, 0, 279, 1838, 3365, 0, 0, 764, 2230, 3666, 979, 2362,
+    3719, 0, 0, 955, 2263, 3548, 715, 1957, 3178, 0, 0, 282, 1464, 2626, 3771,
+    0, 0, 0, 0, 802, 1911, 3004, 4081, 0, 0, 0, 0, 1047, 2093, 3124, 45, 1048,
+    2038, 3014, 3978, 0, 0, 0, 0, 833, 1772, 2698, 3614, 0, 0, 0, 0, 422, 1314,
+    2197, 3068, 3929, 0, 0, 685, 1526, 2358, 3181, 3994, 0, 0, 0, 0, 703, 1498,
+    2286, 3064, 3835, 0, 0, 502, 1256, 2003, 2743, 3475, 0, 0, 0, 0, 103, 821,
+    1532, 2235, 2933, 3623, 0, 0, 211, 889, 1560, 2226, 2885, 3539, 0, 0, 90,
+    732, 1369, 2000, 2625, 3246, 3861, 375, 979, 1579, 2174, 2765, 3350, 3931,
+    0, 0, 411, 983, 1550, 2113, 2672, 3226, 3776, 227, 769, 1307, 1841, 2371,
+    2898, 3420, 3939, 359, 870, 1379, 1883, 2385, 2882, 3377, 3868, 260, 744,
+    1226, 1704, 2179, 2651, 3120, 3586, 4050, 0, 0, 0, 0, 414, 871, 1326, 1777,
+    2226, 2672, 3116, 3557, 3995, 0, 0, 334, 767, 1198, 1626, 2051, 2474, 2894,
+    3312, 3728, 0, 0, 0, 0, 46, 457, 865, 1272, 1676, 2078, 2478, 2876, 3271,
+    3664, 4056, 349, 736, 1121, 1504, 1885, 2264, 2641, 3017, 3390, 3761, 0, 0,
+    35, 403, 768, 1132, 1495, 1855, 2214, 2570, 2926, 3279, 3631, 3981, 233,
+    580, 925, 1269, 1610, 1951, 2289, 2627, 2962, 3296, 3629, 3960, 193, 521,
+    848, 1173, 1497, 1819, 2140, 2460, 2778, 3094, 3410, 3724, 4036, 0, 0, 0, 0,
+    252, 562, 870, 1178, 1484, 1789, 2092, 2394, 2696, 2995, 3294, 3591, 3888,
+    0, 0, 86, 380, 673, 964, 1255, 1544, 1832, 2119, 2404, 2689, 2973, 3255,
+    3536, 3817, 4096, 0,
+};
+
+const uint16_t g_micro_features_noise_reduction_even_smoothing = 409;
+const uint16_t g_micro_features_noise_reduction_odd_smoothing = 983;
+const uint16_t g_micro_features_noise_reduction_min_signal_remaining = 819;
+
+const int32_t g_micro_features_pcan_snr_shift = 6;
+
+const int16_t g_micro_features_pcan_gain_lut[125] = {
+    32636, 32633, 32630, -6, 0, 0, 32624, -12, 0, 0, 32612, -23, -2, 0, 32587,
+    -48, 0, 0, 32539, -96, 0, 0, 32443, -190, 0, 0, 32253, -378, 4, 0, 31879,
+    -739, 18, 0, 31158, -1409, 62, 0, 29811, -2567, 202, 0, 27446, -4301, 562,
+    0, 23707, -6265, 1230, 0, 18672, -7458, 1952, 0, 13166, -7030, 2212, 0,
+    8348, -5342, 1868, 0, 4874, -3459, 1282, 0, 2697, -2025, 774, 0, 1446,
+    -1120, 436, 0, 762, -596, 232, 0, 398, -313, 122, 0, 207, -164, 64, 0, 107,
+    -85, 34, 0, 56, -45, 18, 0, 29, -22, 8, 0, 15, -13, 6, 0, 8, -8, 4, 0, 4,
+    -2, 0, 0, 2, -3, 2, 0, 1, 0, 0, 0, 1, -3, 2, 0, 0, 0, 0,
+};
+
+const int16_t g_micro_features_fft_stage_twiddles[1020] = {
+    32767, 0, 0, 32767, 32767, 0, 0, 32767, 32767, 0, 0, 32767, 32767, 0, 30273,
+    12539, 23170, 23170, 12539, 30273, 0, 32767, -12539, 30273, -23170, 23170,
+    -30273, 12539, 32767, 0, 23170, 23170, 0, 32767, -23170, 23170, 0, 32767,
+    -23170, 23170, -32767, 0, -23170, -23170, 32767, 0, 12539, 30273, -23170,
+    23170, -30273, -12539, 0, 32767, -30273, 12539, -23170, -23170, 12539,
+    -30273, 32767, 0, 32609, 3212, 32137, 6393, 31356, 9512, 30273, 12539,
+    28898, 15446, 27245, 18204, 25329, 20787, 23170, 23170, 20787, 25329, 18204,
+    27245, 15446, 28898, 12539, 30273, 9512, 31356, 6393, 32137, 3212, 32609, 0,
+    32767, -3212, 32609, -6393, 32137, -9512, 31356, -12539, 30273, -15446,
+    28898, -18204, 27245, -20787, 25329, -23170, 23170, -25329, 20787, -27245,
+    18204, -28898, 15446, -30273, 12539, -31356, 9512, -32137, 6393, -32609,
+    3212, 32767, 0, 32137, 6393, 30273, 12539, 27245, 18204, 23170, 23170,
+    18204, 27245, 12539, 30273, 6393, 32137, 0, 32767, -6393, 32137, -12539,
+    30273, -18204, 27245, -23170, 23170, -27245, 18204, -30273, 12539, -32137,
+    6393, 0, 32767, -6393, 32137, -12539, 30273, -18204, 27245, -23170, 23170,
+    -27245, 18204, -30273, 12539, -32137, 6393, -32767, 0, -32137, -6393,
+    -30273, -12539, -27245, -18204, -23170, -23170, -18204, -27245, -12539,
+    -30273, -6393, -32137, 32767, 0, 31356, 9512, 27245, 18204, 20787, 25329,
+    12539, 30273, 3212, 32609, -6393, 32137, -15446, 28898, -23170, 23170,
+    -28898, 15446, -32137, 6393, -32609, -3212, -30273, -12539, -25329, -20787,
+    -18204, -27245, -9512, -31356, 0, 32767, -9512, 31356, -18204, 27245,
+    -25329, 20787, -30273, 12539, -32609, 3212, -32137, -6393, -28898, -15446,
+    -23170, -23170, -15446, -28898, -6393, -32137, 3212, -32609, 12539, -30273,
+    20787, -25329, 27245, -18204, 31356, -9512, 32767, 0, 32757, 804, 32728,
+    1608, 32678, 2410, 32609, 3212, 32521, 4011, 32412, 4808, 32285, 5602,
+    32137, 6393, 31971, 7179, 31785, 7962, 31580, 8739, 31356, 9512, 31113,
+    10278, 30852, 11039, 30571, 11793, 30273, 12539, 29956, 13279, 29621, 14010,
+    29268, 14732, 28898, 15446, 28510, 16151, 28105, 16846, 27683, 17530, 27245,
+    18204, 26790, 18868, 26319, 19519, 25832, 20159, 25329, 20787, 24811, 21403,
+    24279, 22005, 23731, 22594, 23170, 23170, 22594, 23731, 22005, 24279, 21403,
+    24811, 20787, 25329, 20159, 25832, 19519, 26319, 18868, 26790, 18204, 27245,
+    17530, 27683, 16846, 28105, 16151, 28510, 15446, 28898, 14732, 29268, 14010,
+    29621, 13279, 29956, 12539, 30273, 11793, 30571, 11039, 30852, 10278, 31113,
+    9512, 31356, 8739, 31580, 7962, 31785, 7179, 31971, 6393, 32137, 5602,
+    32285, 4808, 32412, 4011, 32521, 3212, 32609, 2410, 32678, 1608, 32728, 804,
+    32757, 0, 32767, -804, 32757, -1608, 32728, -2410, 32678, -3212, 32609,
+    -4011, 32521, -4808, 32412, -5602, 32285, -6393, 32137, -7179, 31971, -7962,
+    31785, -8739, 31580, -9512, 31356, -10278, 31113, -11039, 30852, -11793,
+    30571, -12539, 30273, -13279, 29956, -14010, 29621, -14732, 29268, -15446,
+    28898, -16151, 28510, -16846, 28105, -17530, 27683, -18204, 27245, -18868,
+    26790, -19519, 26319, -20159, 25832, -20787, 25329, -21403, 24811, -22005,
+    24279, -22594, 23731, -23170, 23170, -23731, 22594, -24279, 22005, -24811,
+    21403, -25329, 20787, -25832, 20159, -26319, 19519, -26790, 18868, -27245,
+    18204, -27683, 17530, -28105, 16846, -28510, 16151, -28898, 15446, -29268,
+    14732, -29621, 14010, -29956, 13279, -30273, 12539, -30571, 11793, -30852,
+    11039, -31113, 10278, -31356, 9512, -31580, 8739, -31785, 7962, -31971,
+    7179, -32137, 6393, -32285, 5602, -32412, 4808, -32521, 4011, -32609, 3212,
+    -32678, 2410, -32728, 1608, -32757, 804, 32767, 0, 32728, 1608, 32609, 3212,
+    32412, 4808, 32137, 6393, 31785, 7962, 31356, 9512, 30852, 11039, 30273,
+    12539, 29621, 14010, 28898, 15446, 28105, 16846, 27245, 18204, 26319, 19519,
+    25329, 20787, 24279, 22005, 23170, 23170, 22005, 24279, 20787, 25329, 19519,
+    26319, 18204, 27245, 16846, 28105, 15446, 28898, 14010, 29621, 12539, 30273,
+    11039, 30852, 9512, 31356, 7962, 31785, 6393, 32137, 4808, 32412, 3212,
+    32609, 1608, 32728, 0, 32767, -1608, 32728, -3212, 32609, -4808, 32412,
+    -6393, 32137, -7962, 31785, -9512, 31356, -11039, 30852, -12539, 30273,
+    -14010, 29621, -15446, 28898, -16846, 28105, -18204, 27245, -19519, 26319,
+    -20787, 25329, -22005, 24279, -23170, 23170, -24279, 22005, -25329, 20787,
+    -26319, 19519, -27245, 18204, -28105, 16846, -28898, 15446, -29621, 14010,
+    -30273, 12539, -30852, 11039, -31356, 9512, -31785, 7962, -32137, 6393,
+    -32412, 4808, -32609, 3212, -32728, 1608, 0, 32767, -1608, 32728, -3212,
+    32609, -4808, 32412, -6393, 32137, -7962, 31785, -9512, 31356, -11039,
+    30852, -12539, 30273, -14010, 29621, -15446, 28898, -16846, 28105, -18204,
+    27245, -19519, 26319, -20787, 25329, -22005, 24279, -23170, 23170, -24279,
+    22005, -25329, 20787, -26319, 19519, -27245, 18204, -28105, 16846, -28898,
+    15446, -29621, 14010, -30273, 12539, -30852, 11039, -31356, 9512, -31785,
+    7962, -32137, 6393, -32412, 4808, -32609, 3212, -32728, 1608, -32767, 0,
+    -32728, -1608, -32609, -3212, -32412, -4808, -32137, -6393, -31785, -7962,
+    -31356, -9512, -30852, -11039, -30273, -12539, -29621, -14010, -28898,
+    -15446, -28105, -16846, -27245, -18204, -26319, -19519, -25329, -20787,
+    -24279, -22005, -23170, -23170, -22005, -24279, -20787, -25329, -19519,
+    -26319, -18204, -27245, -16846, -28105, -15446, -28898, -14010, -29621,
+    -12539, -30273, -11039, -30852, -9512, -31356, -7962, -31785, -6393, -32137,
+    -4808, -32412, -3212, -32609, -1608, -32728, 32767, 0, 32678, 2410, 32412,
+    4808, 31971, 7179, 31356, 9512, 30571, 11793, 29621, 14010, 28510, 16151,
+    27245, 18204, 25832, 20159, 24279, 22005, 22594, 23731, 20787, 25329, 18868,
+    26790, 16846, 28105, 14732, 29268, 12539, 30273, 10278, 31113, 7962, 31785,
+    5602, 32285, 3212, 32609, 804, 32757, -1608, 32728, -4011, 32521, -6393,
+    32137, -8739, 31580, -11039, 30852, -13279, 29956, -15446, 28898, -17530,
+    27683, -19519, 26319, -21403, 24811, -23170, 23170, -24811, 21403, -26319,
+    19519, -27683, 17530, -28898, 15446, -29956, 13279, -30852, 11039, -31580,
+    8739, -32137, 6393, -32521, 4011, -32728, 1608, -32757, -804, -32609, -3212,
+    -32285, -5602, -31785, -7962, -31113, -10278, -30273, -12539, -29268,
+    -14732, -28105, -16846, -26790, -18868, -25329, -20787, -23731, -22594,
+    -22005, -24279, -20159, -25832, -18204, -27245, -16151, -28510, -14010,
+    -29621, -11793, -30571, -9512, -31356, -7179, -31971, -4808, -32412, -2410,
+    -32678, 0, 32767, -2410, 32678, -4808, 32412, -7179, 31971, -9512, 31356,
+    -11793, 30571, -14010, 29621, -16151, 28510, -18204, 27245, -20159, 25832,
+    -22005, 24279, -23731, 22594, -25329, 20787, -26790, 18868, -28105, 16846,
+    -29268, 14732, -30273, 12539, -31113, 10278, -31785, 7962, -32285, 5602,
+    -32609, 3212, -32757, 804, -32728, -1608, -32521, -4011, -32137, -6393,
+    -31580, -8739, -30852, -11039, -29956, -13279, -28898, -15446, -27683,
+    -17530, -26319, -19519, -24811, -21403, -23170, -23170, -21403, -24811,
+    -19519, -26319, -17530, -27683, -15446, -28898, -13279, -29956, -11039,
+    -30852, -8739, -31580, -6393, -32137, -4011, -32521, -1608, -32728, 804,
+    -32757, 3212, -32609, 5602, -32285, 7962, -31785, 10278, -31113, 12539,
+    -30273, 14732, -29268, 16846, -28105, 18868, -26790, 20787, -25329, 22594,
+    -23731, 24279, -22005, 25832, -20159, 27245, -18204, 28510, -16151, 29621,
+    -14010, 30571, -11793, 31356, -9512, 31971, -7179, 32412, -4808, 32678,
+    -2410,
+};
+
+const int16_t g_micro_features_fft_split_twiddles[256] = {
+    -402, -32765, -804, -32757, -1206, -32745, -1608, -32728, -2009, -32705,
+    -2410, -32678, -2811, -32646, -3212, -32609, -3612, -32567, -4011, -32521,
+    -4410, -32469, -4808, -32412, -5205, -32351, -5602, -32285, -5998, -32213,
+    -6393, -32137, -6786, -32057, -7179, -31971, -7571, -31880, -7962, -31785,
+    -8351, -31685, -8739, -31580, -9126, -31470, -9512, -31356, -9896, -31237,
+    -10278, -31113, -10659, -30985, -11039, -30852, -11417, -30714, -11793,
+    -30571, -12167, -30424, -12539, -30273, -12910, -30117, -13279, -29956,
+    -13645, -29791, -14010, -29621, -14372, -29447, -14732, -29268, -15090,
+    -29085, -15446, -28898, -15800, -28706, -16151, -28510, -16499, -28310,
+    -16846, -28105, -17189, -27896, -17530, -27683, -17869, -27466, -18204,
+    -27245, -18537, -27019, -18868, -26790, -19195, -26556, -19519, -26319,
+    -19841, -26077, -20159, -25832, -20475, -25582, -20787, -25329, -21096,
+    -25072, -21403, -24811, -21705, -24547, -22005, -24279, -22301, -24007,
+    -22594, -23731, -22884, -23452, -23170, -23170, -23452, -22884, -23731,
+    -22594, -24007, -22301, -24279, -22005, -24547, -21705, -24811, -21403,
+    -25072, -21096, -25329, -20787, -25582, -20475, -25832, -20159, -26077,
+    -19841, -26319, -19519, -26556, -19195, -26790, -18868, -27019, -18537,
+    -27245, -18204, -27466, -17869, -27683, -17530, -27896, -17189, -28105,
+    -16846, -28310, -16499, -28510, -16151, -28706, -15800, -28898, -15446,
+    -29085, -15090, -29268, -14732, -29447, -14372, -29621, -14010, -29791,
+    -13645, -29956, -13279, -30117, -12910, -30273, -12539, -30424, -12167,
+    -30571, -11793, -30714, -11417, -30852, -11039, -30985, -10659, -31113,
+    -10278, -31237, -9896, -31356, -9512, -31470, -9126, -31580, -8739, -31685,
+    -8351, -31785, -7962, -31880, -7571, -31971, -7179, -32057, -6786, -32137,
+    -6393, -32213, -5998, -32285, -5602, -32351, -5205, -32412, -4808, -32469,
+    -4410, -32521, -4011, -32567, -3612, -32609, -3212, -32646, -2811, -32678,
+    -2410, -32705, -2009, -32728, -1608, -32745, -1206, -32757, -804, -32765,
+    -402, -32767, 0,
+};
+
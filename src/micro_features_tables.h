@@ -0,0 +1,79 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Lookup tables for the feature generation frontend. FrontendPopulateState()
+// computes these with float math and stores them on the heap, but since every
+// input is a constant they're generated ahead of time instead, by
+// tools/generate_micro_features_tables.cpp, and kept in read-only memory. The
+// FFT's twiddle factors are here too, in the layout micro_features_fft.cpp
+// wants.
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MICRO_FEATURES_TABLES_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MICRO_FEATURES_TABLES_H_
+
+#include <cstdint>
+
+#include "micro_model_settings.h"
+
+// Samples in each analysis window, and how far the window moves each slice.
+constexpr int kMicroFeaturesWindowSize = kFeatureSliceDurationSamples;
+constexpr int kMicroFeaturesWindowStep = kFeatureSliceStrideSamples;
+// The window is zero-padded up to the FFT size.
+constexpr int kMicroFeaturesFftSize = kMaxAudioSampleSize;
+// Size of the piecewise-polynomial gain table used by PCAN.
+constexpr int kMicroFeaturesPcanGainLutSize = 125;
+// The real FFT is done as a complex FFT of half the size, which is made up of
+// radix-4 stages of length 1, 4, 16 and so on. Each stage has three twiddles
+// per butterfly, stored as two pairs of int16 values apiece.
+constexpr int kMicroFeaturesFftComplexSize = kMicroFeaturesFftSize / 2;
+constexpr int kMicroFeaturesFftStageTwiddleSize =
+    4 * (kMicroFeaturesFftComplexSize - 1);
+
+extern const int16_t g_micro_features_window_coefficients
+    [kMicroFeaturesWindowSize];
+
+// The filterbank has an extra leading channel that is only used to taper the
+// first real channel, so its per-channel arrays have one more entry.
+extern const int g_micro_features_filterbank_start_index;
+extern const int g_micro_features_filterbank_end_index;
+extern const int16_t g_micro_features_filterbank_channel_frequency_starts
+    [kFeatureSliceSize + 1];
+extern const int16_t g_micro_features_filterbank_channel_weight_starts
+    [kFeatureSliceSize + 1];
+extern const int16_t g_micro_features_filterbank_channel_widths
+    [kFeatureSliceSize + 1];
+extern const int g_micro_features_filterbank_weight_count;
+extern const int16_t g_micro_features_filterbank_weights[];
+extern const int16_t g_micro_features_filterbank_unweights[];
+
+extern const uint16_t g_micro_features_noise_reduction_even_smoothing;
+extern const uint16_t g_micro_features_noise_reduction_odd_smoothing;
+extern const uint16_t g_micro_features_noise_reduction_min_signal_remaining;
+
+extern const int32_t g_micro_features_pcan_snr_shift;
+extern const int16_t g_micro_features_pcan_gain_lut
+    [kMicroFeaturesPcanGainLutSize];
+
+// For a stage of length m, its twiddles start at offset 4 * (m - 1). For each
+// of the three twiddles (r, i) of a butterfly there's a run of m pairs of
+// (r, -i) followed by m pairs of (i, r), so a complex product is two
+// multiply-adds of adjacent values.
+extern const int16_t g_micro_features_fft_stage_twiddles
+    [kMicroFeaturesFftStageTwiddleSize];
+// (r, i) pairs used to split the complex FFT's output into the real spectrum.
+extern const int16_t g_micro_features_fft_split_twiddles
+    [kMicroFeaturesFftComplexSize];
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MICRO_FEATURES_TABLES_H_
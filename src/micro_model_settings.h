@@ -33,6 +33,30 @@ constexpr int kFeatureElementCount = (kFeatureSliceSize * kFeatureSliceCount);
 constexpr int kFeatureSliceStrideMs = 20;
 constexpr int kFeatureSliceDurationMs = 30;
 
+// The pipeline keeps time as a count of audio samples since capture started,
+// and these are the values above expressed on that clock.
+constexpr int kAudioSamplesPerMs = kAudioSampleFrequency / 1000;
+constexpr int kFeatureSliceStrideSamples =
+    kFeatureSliceStrideMs * kAudioSamplesPerMs;
+constexpr int kFeatureSliceDurationSamples =
+    kFeatureSliceDurationMs * kAudioSamplesPerMs;
+
+// Settings for the feature generation frontend, applied in
+// InitializeMicroFeatures(). Like the values above these have to match what
+// the model was trained with. The frontend's lookup tables are generated from
+// them into micro_features_tables.cpp, so after changing any of these, rerun
+// tools/generate_micro_features_tables.cpp to regenerate that file.
+constexpr float kFilterbankLowerBandLimit = 125.0f;
+constexpr float kFilterbankUpperBandLimit = 7500.0f;
+constexpr int kNoiseReductionSmoothingBits = 10;
+constexpr float kNoiseReductionEvenSmoothing = 0.025f;
+constexpr float kNoiseReductionOddSmoothing = 0.06f;
+constexpr float kNoiseReductionMinSignalRemaining = 0.05f;
+constexpr float kPcanGainControlStrength = 0.95f;
+constexpr float kPcanGainControlOffset = 80.0f;
+constexpr int kPcanGainControlGainBits = 21;
+constexpr int kLogScaleShift = 6;
+
 constexpr int kCategoryCount = 4;
 constexpr int kSilenceIndex = 0;
 constexpr int kUnknownIndex = 1;
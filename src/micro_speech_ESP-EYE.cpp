@@ -14,15 +14,29 @@
   ==============================================================================*/
 #include <Arduino.h>
 #include <TensorFlowLite_ESP32.h>
+#include <sys/time.h>
 
 #include "main_functions.h"
 
+#include "adpcm_history.h"
+#include "allocation_guard.h"
 #include "audio_provider.h"
 #include "command_responder.h"
 #include "feature_provider.h"
+#include "inference_scheduler.h"
+#include "memory_report.h"
+#include "micro_features_generator.h"
 #include "micro_model_settings.h"
+#include "model_cascade.h"
+#include "model_swapper.h"
+#include "model_updater.h"
+#include "model_variants.h"
+#include "profiler.h"
+#include "spectrogram_change_gate.h"
 #include "tiny_conv_micro_features_model_data.h"
 #include "recognize_commands.h"
+#include "warm_state.h"
+#include "warm_state_storage.h"
 #include "tensorflow/lite/experimental/micro/kernels/micro_ops.h"
 #include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
 #include "tensorflow/lite/experimental/micro/micro_interpreter.h"
@@ -30,69 +44,142 @@
 #include "tensorflow/lite/schema/schema_generated.h"
 #include "tensorflow/lite/version.h"
 
+#ifdef MICRO_SPEECH_FIRST_STAGE_MODEL
+#include "first_stage_model_data.h"
+#endif
+#ifdef MICRO_SPEECH_LIGHT_MODEL
+#include "light_model_data.h"
+#endif
+
 // Globals, used for compatibility with Arduino-style sketches.
 namespace {
 tflite::ErrorReporter* error_reporter = nullptr;
-const tflite::Model* model = nullptr;
 tflite::MicroInterpreter* interpreter = nullptr;
+ModelSwapper* model_swapper = nullptr;
+ModelCascade* model_cascade = nullptr;
+ModelVariants* model_variants = nullptr;
 TfLiteTensor* model_input = nullptr;
 FeatureProvider* feature_provider = nullptr;
 RecognizeCommands* recognizer = nullptr;
-int32_t previous_time = 0;
+InferenceScheduler* inference_scheduler = nullptr;
+SpectrogramChangeGate* change_gate = nullptr;
+int64_t previous_sample_index = 0;
+
+// The keyword spotter's place in the shared capture ring. It reads overlapping
+// windows by index rather than through the cursor, but moving the cursor along
+// behind it means its lag and any lost audio show up like any other reader's.
+int keyword_spotter_cursor = -1;
+int64_t keyword_spotter_reported_drops = 0;
+
+// A longer, compressed copy of the captured audio in PSRAM, so the seconds
+// leading up to a detection can still be pulled out with
+// AdpcmHistory::Read() once the capture ring has moved on. Setting the length
+// to zero leaves it out.
+constexpr int kPreRollHistorySeconds = 30;
+AdpcmHistory pre_roll_history;
+int pre_roll_cursor = -1;
+
+// Block envelopes taken from the capture task for drawWave().
+AudioEnvelope envelope_batch[AudioEnvelopeChannel::kCapacity];
+
+// How often the frontend and recognizer state is written to flash, so a
+// restarted node picks up where it left off. NVS spreads writes across its
+// partition, but this is still kept infrequent to limit flash wear.
+constexpr int64_t kWarmStateSaveIntervalSamples =
+    int64_t{5 * 60} * kAudioSampleFrequency;
+int64_t last_warm_state_save_sample_index = 0;
+uint8_t warm_state_buffer[kWarmStateMaxSize];
+
+// Milliseconds on the system clock, which the RTC keeps running through a
+// software or watchdog reset, so it can tell how old a warm state is. After a
+// power cycle it starts again from zero, which makes older snapshots look like
+// they're from the future, and so they're treated as stale.
+int64_t PersistentTimeMs() {
+  struct timeval now;
+  gettimeofday(&now, nullptr);
+  return (int64_t{now.tv_sec} * 1000) + (now.tv_usec / 1000);
+}
+
+// Times each step of setup() and the path to the first inference.
+StartupProfiler startup_profiler;
+
+// Where the memory goes, printed with the startup timings and then again every
+// so often, along with the scheduler's counters, so the stack and arena
+// high-water marks and any overload can be watched as the node runs.
+constexpr int64_t kMemoryReportIntervalSamples =
+    int64_t{60} * kAudioSampleFrequency;
+int64_t last_memory_report_sample_index = 0;
+MemoryReport memory_report;
+
+// Once the first inference is out, loop() shouldn't touch the heap. Builds with
+// MICRO_SPEECH_ALLOCATION_GUARD count any allocations it makes, and report
+// them on the next pass.
+bool loop_is_steady = false;
+int64_t loop_allocation_count = 0;
+int64_t reported_loop_allocation_count = 0;
 
 // Create an area of memory to use for input, output, and intermediate arrays.
 // The size of this will depend on the model you're using, and may need to be
 // determined by experimentation.
 constexpr int kTensorArenaSize = 10 * 1024;
 uint8_t tensor_arena[kTensorArenaSize];
-}  // namespace
+// A new main model is built here while the old one goes on running in
+// tensor_arena, and the two arenas then trade places.
+uint8_t spare_tensor_arena[kTensorArenaSize];
+// Since the main model's arena can be rebuilt, the spectrogram is kept apart
+// from it, unless the cascade's first stage can hold it.
+uint8_t spectrogram_buffer[kFeatureElementCount];
 
-QueueHandle_t xQueueAudioWave;
-#define QueueAudioWaveSize 32
+#ifdef MICRO_SPEECH_FIRST_STAGE_MODEL
+// The first stage of the cascade runs on every inference, and the main model
+// above only when the first stage thinks a keyword is likely. It has an arena
+// of its own, so both can stay allocated.
+constexpr int kFirstStageTensorArenaSize = 4 * 1024;
+constexpr uint8_t kFirstStageKeywordThreshold = 64;
+uint8_t first_stage_tensor_arena[kFirstStageTensorArenaSize];
+#endif
+
+#ifdef MICRO_SPEECH_LIGHT_MODEL
+// A cheaper variant of the main model, used while other work leaves the loop
+// short of time. Every variant keeps its own allocated arena, so switching
+// between them never calls AllocateTensors().
+constexpr int kLightTensorArenaSize = 6 * 1024;
+uint8_t light_tensor_arena[kLightTensorArenaSize];
+#endif
+}  // namespace
 
 // The name of this function is important for Arduino compatibility.
 void setup() {
+  // Big enough to keep receiving a model while flash is being erased.
+  Serial.setRxBufferSize(kModelUpdaterSerialBufferSize);
   Serial.begin(115200);
-  // 指示各种内存系统能力的标志
-  Serial.printf("Default free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_DEFAULT));
-  Serial.printf("PSRAM free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
-
-Serial.printf("MALLOC_CAP_EXEC free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_EXEC));
-Serial.printf("MALLOC_CAP_32BIT free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_32BIT));
-Serial.printf("MALLOC_CAP_8BIT free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_8BIT));
-Serial.printf("MALLOC_CAP_DMA free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_DMA));
-
-Serial.printf("MALLOC_CAP_PID2 free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_PID2));
-Serial.printf("MALLOC_CAP_PID3 free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_PID3));
-Serial.printf("MALLOC_CAP_PID4 free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_PID4));
-Serial.printf("MALLOC_CAP_PID5 free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_PID5));
-Serial.printf("MALLOC_CAP_PID6 free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_PID6));
-Serial.printf("MALLOC_CAP_PID7 free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_PID7));
-
-
-Serial.printf("MALLOC_CAP_INTERNAL free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_INTERNAL));
-Serial.printf("MALLOC_CAP_IRAM_8BIT free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_IRAM_8BIT));
-Serial.printf("MALLOC_CAP_RETENTION free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_RETENTION));
-Serial.printf("MALLOC_CAP_RTCRAM free size: %d\n", heap_caps_get_free_size(MALLOC_CAP_RTCRAM));
-
-  xQueueAudioWave = xQueueCreate(QueueAudioWaveSize, sizeof(int16_t));
-  
+  startup_profiler.Mark("Serial.begin()");
+
   // Set up logging. Google style is to avoid globals or statics because of
   // lifetime uncertainty, but since this has a trivial destructor it's okay.
   // NOLINTNEXTLINE(runtime-global-variables)
   static tflite::MicroErrorReporter micro_error_reporter;
   error_reporter = &micro_error_reporter;
 
-  // Map the model into a usable data structure. This doesn't involve any
-  // copying or parsing, it's a very lightweight operation.
-  model = tflite::GetModel(g_tiny_conv_micro_features_model_data);
-  if (model->version() != TFLITE_SCHEMA_VERSION) {
-    error_reporter->Report(
-      "Model provided is schema version %d not equal "
-      "to supported version %d.",
-      model->version(), TFLITE_SCHEMA_VERSION);
+  // Start capturing audio before anything else. The I2S DMA and the recording
+  // task on the other core fill the ring buffer while the model and frontend
+  // are being set up below, so the first inference doesn't have to wait for
+  // audio to arrive.
+  if (InitAudioRecording(error_reporter) != kTfLiteOk) {
+    error_reporter->Report("InitAudioRecording() failed");
     return;
   }
+  startup_profiler.Mark("audio bring-up");
+
+  // The breakdown is printed after the first inference, once the arena and
+  // stacks have seen some use.
+  AddAudioMemoryRegions(&memory_report);
+  AddMicroFeaturesMemoryRegions(&memory_report);
+  memory_report.AddTask("loopTask", xTaskGetCurrentTaskHandle(),
+                        getArduinoLoopTaskStackSize());
+
+  memory_report.AddRegion("model", g_tiny_conv_micro_features_model_data,
+                          g_tiny_conv_micro_features_model_data_len);
 
   // Pull in only the operation implementations we need.
   // This relies on a complete list of all the ops needed by this graph.
@@ -111,108 +198,374 @@ Serial.printf("MALLOC_CAP_RTCRAM free size: %d\n", heap_caps_get_free_size(MALLO
     tflite::ops::micro::Register_FULLY_CONNECTED());
   micro_mutable_op_resolver.AddBuiltin(tflite::BuiltinOperator_SOFTMAX,
                                        tflite::ops::micro::Register_SOFTMAX());
+  startup_profiler.Mark("op resolver");
+
+  // Build an interpreter to run the model with. It's mapped straight from the
+  // model partition written by the last update, if there is one, and
+  // otherwise is the compiled-in model. Neither is copied into RAM. Arenas are
+  // painted as models are built, so the memory report can tell how much of
+  // them each model needs.
+  MemoryReport::Paint(spare_tensor_arena, kTensorArenaSize);
+  memory_report.AddRegion("tensor arena", tensor_arena, kTensorArenaSize, true);
+  memory_report.AddRegion("spare tensor arena", spare_tensor_arena,
+                          kTensorArenaSize, true);
+  static ModelSwapper static_model_swapper(
+    micro_mutable_op_resolver, tensor_arena, spare_tensor_arena,
+    kTensorArenaSize);
+  model_swapper = &static_model_swapper;
+  if ((PrepareStoredModel(error_reporter, model_swapper) != kTfLiteOk) &&
+      (model_swapper->Prepare(error_reporter, "compiled-in",
+                              g_tiny_conv_micro_features_model_data,
+                              g_tiny_conv_micro_features_model_data_len,
+                              nullptr) != kTfLiteOk)) {
+    return;
+  }
+  interpreter = model_swapper->TakePrepared();
+  Serial.printf("Using the %s model\n", model_swapper->active_name());
+  startup_profiler.Mark("AllocateTensors()");
 
-  // Build an interpreter to run the model with.
-  static tflite::MicroInterpreter static_interpreter(
-    model, micro_mutable_op_resolver, tensor_arena, kTensorArenaSize,
-    error_reporter);
-  interpreter = &static_interpreter;
+  tflite::MicroInterpreter* first_stage_interpreter = nullptr;
+  uint8_t keyword_threshold = 0;
+#ifdef MICRO_SPEECH_FIRST_STAGE_MODEL
+  const tflite::Model* first_stage_model =
+    tflite::GetModel(g_first_stage_model_data);
+  if (first_stage_model->version() != TFLITE_SCHEMA_VERSION) {
+    error_reporter->Report(
+      "First-stage model provided is schema version %d not equal "
+      "to supported version %d.",
+      first_stage_model->version(), TFLITE_SCHEMA_VERSION);
+    return;
+  }
+  memory_report.AddRegion("first-stage model", g_first_stage_model_data,
+                          g_first_stage_model_data_len);
+  MemoryReport::Paint(first_stage_tensor_arena, kFirstStageTensorArenaSize);
+  memory_report.AddRegion("first-stage tensor arena", first_stage_tensor_arena,
+                          kFirstStageTensorArenaSize, true);
+  static tflite::MicroInterpreter static_first_stage_interpreter(
+    first_stage_model, micro_mutable_op_resolver, first_stage_tensor_arena,
+    kFirstStageTensorArenaSize, error_reporter);
+  if (static_first_stage_interpreter.AllocateTensors() != kTfLiteOk) {
+    error_reporter->Report("First-stage AllocateTensors() failed");
+    return;
+  }
+  first_stage_interpreter = &static_first_stage_interpreter;
+  keyword_threshold = kFirstStageKeywordThreshold;
+  startup_profiler.Mark("first stage");
+#endif
 
-  // Allocate memory from the tensor_arena for the model's tensors.
-  TfLiteStatus allocate_status = interpreter->AllocateTensors();
-  if (allocate_status != kTfLiteOk) {
-    error_reporter->Report("AllocateTensors() failed");
+  // Both stages' tensors are checked here, so results can go to the
+  // recognizer as plain scores.
+  static ModelCascade static_model_cascade(keyword_threshold);
+  if (static_model_cascade.Initialize(
+        error_reporter, first_stage_interpreter, interpreter,
+        (first_stage_interpreter != nullptr) ? nullptr : spectrogram_buffer) !=
+      kTfLiteOk) {
     return;
   }
+  model_cascade = &static_model_cascade;
 
-  // Get information about the memory area to use for the model's input.
-  model_input = interpreter->input(0);
-  if ((model_input->dims->size != 4) || (model_input->dims->data[0] != 1) ||
-      (model_input->dims->data[1] != kFeatureSliceCount) ||
-      (model_input->dims->data[2] != kFeatureSliceSize) ||
-      (model_input->type != kTfLiteUInt8)) {
-    error_reporter->Report("Bad input tensor parameters in model");
+  // The main model is the first variant, and any cheaper ones follow it.
+  static ModelVariants static_model_variants;
+  if ((static_model_variants.CheckSettings(error_reporter) != kTfLiteOk) ||
+      (static_model_variants.AddVariant(error_reporter, "tiny_conv",
+                                        interpreter) != kTfLiteOk)) {
+    return;
+  }
+#ifdef MICRO_SPEECH_LIGHT_MODEL
+  const tflite::Model* light_model = tflite::GetModel(g_light_model_data);
+  if (light_model->version() != TFLITE_SCHEMA_VERSION) {
+    error_reporter->Report(
+      "Light model provided is schema version %d not equal "
+      "to supported version %d.",
+      light_model->version(), TFLITE_SCHEMA_VERSION);
+    return;
+  }
+  memory_report.AddRegion("light model", g_light_model_data,
+                          g_light_model_data_len);
+  MemoryReport::Paint(light_tensor_arena, kLightTensorArenaSize);
+  memory_report.AddRegion("light tensor arena", light_tensor_arena,
+                          kLightTensorArenaSize, true);
+  static tflite::MicroInterpreter static_light_interpreter(
+    light_model, micro_mutable_op_resolver, light_tensor_arena,
+    kLightTensorArenaSize, error_reporter);
+  if ((static_light_interpreter.AllocateTensors() != kTfLiteOk) ||
+      (static_model_variants.AddVariant(error_reporter, "light",
+                                        &static_light_interpreter) !=
+       kTfLiteOk)) {
+    error_reporter->Report("Light model setup failed");
     return;
   }
+  startup_profiler.Mark("light model");
+#endif
+  model_variants = &static_model_variants;
+
+  // Get information about the memory area to use for the model's input. With
+  // a cascade, the spectrogram is the first stage's input, and otherwise it's
+  // kept in its own buffer. Either way it's copied to the main model only when
+  // it runs.
+  model_input = (first_stage_interpreter != nullptr)
+                ? first_stage_interpreter->input(0) : interpreter->input(0);
+  memory_report.AddRegion("spectrogram", model_cascade->input_data(),
+                          kFeatureElementCount);
 
   // Prepare to access the audio spectrograms from a microphone or other source
   // that will provide the inputs to the neural network.
   // NOLINTNEXTLINE(runtime-global-variables)
   static FeatureProvider static_feature_provider(kFeatureElementCount,
-      model_input->data.uint8);
+      model_cascade->input_data());
   feature_provider = &static_feature_provider;
+  // Build the frontend's tables now rather than inside the first loop().
+  if (feature_provider->InitializeFrontend(error_reporter) != kTfLiteOk) {
+    error_reporter->Report("Frontend initialization failed");
+    return;
+  }
+  startup_profiler.Mark("frontend");
+
+  // After a stall, the spectrogram is caught up a few slices per pass before
+  // the model runs again, rather than all at once. While it's quiet, or the
+  // CPU is short of time, the model only runs every few slices.
+  InferenceSchedulerSettings scheduler_settings;
+  scheduler_settings.policy = kCatchUpFeaturesOnly;
+  scheduler_settings.max_inference_stride = 5;
+  static InferenceScheduler static_inference_scheduler(scheduler_settings);
+  if (static_inference_scheduler.CheckSettings(error_reporter) != kTfLiteOk) {
+    return;
+  }
+  inference_scheduler = &static_inference_scheduler;
+
+  // While the spectrogram hardly changes, as with steady background noise,
+  // the last scores are reused for up to 200ms instead of running the model.
+  SpectrogramChangeGateSettings gate_settings;
+  gate_settings.max_skip_ms = 200;
+  static SpectrogramChangeGate static_change_gate(gate_settings);
+  change_gate = &static_change_gate;
+  memory_report.AddRegion("change gate", &static_change_gate,
+                          sizeof(static_change_gate));
 
   static RecognizeCommands static_recognizer(error_reporter);
   recognizer = &static_recognizer;
+  memory_report.AddRegion("recognizer results queue", &static_recognizer,
+                          sizeof(static_recognizer));
 
-  previous_time = 0;
+  previous_sample_index = 0;
+  keyword_spotter_cursor = GetAudioRing()->AddCursor("keyword spotter");
+
+  if (kPreRollHistorySeconds > 0) {
+    const size_t pre_roll_size =
+      ((kPreRollHistorySeconds * kAudioSampleFrequency / kAdpcmBlockSamples) +
+       1) * kAdpcmBlockSize;
+    uint8_t* pre_roll_memory = AllocateAdpcmHistoryMemory(pre_roll_size);
+    if (pre_roll_memory == nullptr) {
+      error_reporter->Report("No PSRAM for %d bytes of pre-roll history",
+                             static_cast<int>(pre_roll_size));
+    } else if (pre_roll_history.Initialize(error_reporter, pre_roll_memory,
+                                           pre_roll_size) == kTfLiteOk) {
+      pre_roll_history.Reset(LatestAudioSampleIndex());
+      pre_roll_cursor = GetAudioRing()->AddCursor("pre-roll history");
+      memory_report.AddRegion("pre-roll history", pre_roll_memory,
+                              pre_roll_size);
+    }
+  }
+  startup_profiler.Mark("pre-roll history");
+
+  // Pick up the noise estimates, spectrogram and smoothing history from before
+  // the last restart, if there are any that match this build. The audio clock
+  // is already running, and saved times are rebased onto it. Snapshots are only
+  // written every few minutes, so usually only the noise estimates are recent
+  // enough to use.
+  size_t warm_state_size = 0;
+  if (LoadWarmStateBlob(error_reporter, warm_state_buffer,
+                        sizeof(warm_state_buffer),
+                        &warm_state_size) == kTfLiteOk) {
+    if (RestoreWarmState(error_reporter, warm_state_buffer, warm_state_size,
+                         LatestAudioSampleIndex(), PersistentTimeMs(),
+                         model_swapper->active_fingerprint(),
+                         feature_provider, recognizer) == kTfLiteOk) {
+      Serial.printf("Restored %u bytes of warm state\n",
+                    static_cast<unsigned>(warm_state_size));
+    }
+  }
+  last_warm_state_save_sample_index = LatestAudioSampleIndex();
+  memory_report.AddRegion("warm state buffer", warm_state_buffer,
+                          sizeof(warm_state_buffer));
+  memory_report.AddRegion("envelope batch", envelope_batch,
+                          sizeof(envelope_batch));
+  startup_profiler.Mark("warm state");
 
   InitResponder();
 
   Serial.printf("model_input->name          : %s\n", model_input->name);
   Serial.printf("model_input->type          : %d\n", model_input->type);
-  Serial.printf("model_input->bytes         : %d\n", model_input->bytes);
+  Serial.printf("model_input->bytes         : %u\n",
+                static_cast<unsigned>(model_input->bytes));
   Serial.printf("model_input->dims->size    : %d\n", model_input->dims->size);
   Serial.printf("model_input->dims->data[0] : %d\n", model_input->dims->data[0]); // 1
   Serial.printf("model_input->dims->data[1] : %d\n", model_input->dims->data[1]); // kFeatureSliceCount
   Serial.printf("model_input->dims->data[2] : %d\n", model_input->dims->data[2]); // kFeatureSliceSize
+  startup_profiler.Mark("responder");
+
+  // From here on a new model can arrive over Serial at any time, and is
+  // swapped in by loop() once it's ready.
+  if (StartModelUpdater(error_reporter, model_swapper) == kTfLiteOk) {
+    AddModelUpdaterMemoryRegions(&memory_report);
+  }
+  startup_profiler.Mark("model updater");
 }
 
 // The name of this function is important for Arduino compatibility.
 void loop() {
-  int16_t wave = 0;
-  for (int i = 0; i < QueueAudioWaveSize; i++) {
-    if (xQueueReceive(xQueueAudioWave, &wave, 0) == pdTRUE) {
-      drawWave(wave);
-    }
-  }  
+  const int64_t pass_start_us = ProfilerNowMicros();
+  if (loop_allocation_count > reported_loop_allocation_count) {
+    error_reporter->Report("loop() has made %d heap allocations since setup()",
+                           static_cast<int>(loop_allocation_count));
+    reported_loop_allocation_count = loop_allocation_count;
+  }
+  ScopedAllocationGuard allocation_guard(loop_is_steady, kCountAllocations,
+                                         &loop_allocation_count);
 
-  // Fetch the spectrogram for the current time.
-  const int32_t current_time = LatestAudioTimestamp();
+  // Take every block envelope that's waiting in one go, rather than a queue
+  // operation per item.
+  const int envelope_count = GetAudioEnvelopeChannel()->Receive(
+                               envelope_batch, AudioEnvelopeChannel::kCapacity);
+  if (envelope_count > 0) {
+    drawWave(envelope_batch, envelope_count);
+  }
+
+  // Bring the spectrogram up to the current time, or as far towards it as the
+  // scheduler thinks this pass should go if the loop has fallen behind.
+  AudioBroadcastRing* audio_ring = GetAudioRing();
+  InferencePlan plan;
+  inference_scheduler->Plan(previous_sample_index, LatestAudioSampleIndex(),
+                            audio_ring->oldest_safe_index(), &plan);
+  const int64_t current_sample_index = plan.end_sample_index;
   int how_many_new_slices = 0;
-  TfLiteStatus feature_status = feature_provider->PopulateFeatureData(
-                                  error_reporter, previous_time, current_time, &how_many_new_slices);
+  TfLiteStatus feature_status = feature_provider->PopulateFeatureDataForSamples(
+                                  error_reporter, plan.start_sample_index, current_sample_index, &how_many_new_slices);
   if (feature_status != kTfLiteOk) {
     error_reporter->Report("Feature generation failed");
     delay(1);
     return;
   }
-  previous_time = current_time;
-  // If no new audio samples have been received since last time, don't bother
-  // running the network model.
-  if (how_many_new_slices == 0) {
-    delay(1);
-    return;
-  }
+  previous_sample_index = current_sample_index;
 
-  // Run the model on the spectrogram input and make sure it succeeds.
-  TfLiteStatus invoke_status = interpreter->Invoke();
-  if (invoke_status != kTfLiteOk) {
-    error_reporter->Report("Invoke failed");
+  // Only the newest slice's worth of audio can still be needed by the next
+  // slice, so the cursor follows that far behind. Peeking first catches it up
+  // and counts the loss if the capture task lapped it.
+  AudioRingView unused_view;
+  audio_ring->Peek(keyword_spotter_cursor, 0, &unused_view);
+  const int64_t consumed = current_sample_index -
+                           kFeatureSliceDurationSamples -
+                           audio_ring->read_index(keyword_spotter_cursor);
+  if (consumed > 0) {
+    audio_ring->Consume(keyword_spotter_cursor, static_cast<int>(consumed));
+  }
+  if (audio_ring->dropped(keyword_spotter_cursor) >
+      keyword_spotter_reported_drops) {
+    keyword_spotter_reported_drops = audio_ring->dropped(keyword_spotter_cursor);
+    error_reporter->Report("Keyword spotter fell behind, %d samples lost so far",
+                           static_cast<int>(keyword_spotter_reported_drops));
+  }
+  // Compressing as we go keeps this cursor close behind the capture task.
+  if (pre_roll_cursor >= 0) {
+    pre_roll_history.AppendFromRing(audio_ring, pre_roll_cursor);
+  }
+  // If no new audio samples have been received since last time, or the
+  // scheduler is catching up, don't run the network model.
+  if (!plan.run_inference) {
+    inference_scheduler->Finish(plan, LatestAudioSampleIndex());
+    model_variants->RecordPass(pass_start_us, ProfilerNowMicros());
     delay(1);
     return;
   }
 
-  // Obtain a pointer to the output tensor
-  TfLiteTensor* output = interpreter->output(0);
+  // Run the model on the spectrogram input and make sure it succeeds, unless
+  // the input has barely changed since the last run, in which case its scores
+  // still stand.
+  const uint8_t* scores = change_gate->previous_scores();
+  if (change_gate->ShouldInvoke(feature_provider->feature_data(),
+                                current_sample_index)) {
+    // A model update is picked up here, between two inferences, once the
+    // updater task has built it.
+    tflite::MicroInterpreter* updated_interpreter =
+      model_swapper->TakePrepared();
+    if (updated_interpreter != nullptr) {
+      interpreter = updated_interpreter;
+      model_variants->set_interpreter(0, interpreter);
+      error_reporter->Report("Swapped to the %s model",
+                             model_swapper->active_name());
+    }
+    // Switching variants only swaps the interpreter the cascade uses, which
+    // is already allocated, so it's safe to do at any slice.
+    model_cascade->set_second_stage(
+      model_variants->Select(current_sample_index));
+    const int64_t invoke_start_us = ProfilerNowMicros();
+    TfLiteStatus invoke_status = model_cascade->Invoke(
+                                   error_reporter, model_cascade->input_data(), &scores);
+    if (invoke_status != kTfLiteOk) {
+      inference_scheduler->Finish(plan, LatestAudioSampleIndex());
+      model_variants->RecordPass(pass_start_us, ProfilerNowMicros());
+      delay(1);
+      return;
+    }
+    model_variants->RecordInvoke(invoke_start_us, ProfilerNowMicros());
+    change_gate->RecordOutput(feature_provider->feature_data(), scores,
+                              current_sample_index);
+  }
+  inference_scheduler->RecordScores(scores);
   // Determine whether a command was recognized based on the output of inference
   const char* found_command = nullptr;
   uint8_t score = 0;
   bool is_new_command = false;
-  TfLiteStatus process_status = recognizer->ProcessLatestResults(
-                                  output, current_time, &found_command, &score, &is_new_command);
+  TfLiteStatus process_status = recognizer->ProcessLatestScoresAtSample(
+                                  scores, current_sample_index, &found_command, &score, &is_new_command);
   if (process_status != kTfLiteOk) {
-    error_reporter->Report("RecognizeCommands::ProcessLatestResults() failed");
+    error_reporter->Report("RecognizeCommands::ProcessLatestScoresAtSample() failed");
+    inference_scheduler->Finish(plan, LatestAudioSampleIndex());
+    model_variants->RecordPass(pass_start_us, ProfilerNowMicros());
     delay(1);
     return;
   }
   // Do something based on the recognized command. The default implementation
   // just prints to the error console, but you should replace this with your
   // own function for a real application.
-  RespondToCommand(error_reporter, current_time, found_command, score,
-                   is_new_command);
+  RespondToCommandAtSample(error_reporter, current_sample_index, found_command,
+                           score, is_new_command);
+  inference_scheduler->Finish(plan, LatestAudioSampleIndex());
+
+  // Startup timings are only printed once the first result is out, so the
+  // printing doesn't delay it.
+  if (startup_profiler.MarkFirstInference()) {
+    startup_profiler.Report(error_reporter);
+    memory_report.Report(error_reporter);
+    last_memory_report_sample_index = current_sample_index;
+  } else if (current_sample_index - last_memory_report_sample_index >=
+             kMemoryReportIntervalSamples) {
+    memory_report.Report(error_reporter);
+    inference_scheduler->Report(error_reporter);
+    change_gate->Report(error_reporter);
+    model_cascade->Report(error_reporter);
+    model_variants->Report(error_reporter);
+    last_memory_report_sample_index = current_sample_index;
+  }
+  loop_is_steady = true;
+
+  drawInput(model_cascade->input_data());
 
-  drawInput(model_input->data.uint8);
+  if (current_sample_index - last_warm_state_save_sample_index >=
+      kWarmStateSaveIntervalSamples) {
+    // NVS allocates while writing, but this only happens every few minutes.
+    allocation_guard.Release();
+    size_t warm_state_size = 0;
+    if (SaveWarmState(error_reporter, *feature_provider, recognizer,
+                      current_sample_index, PersistentTimeMs(),
+                      model_swapper->active_fingerprint(), warm_state_buffer,
+                      sizeof(warm_state_buffer),
+                      &warm_state_size) == kTfLiteOk) {
+      StoreWarmStateBlob(error_reporter, warm_state_buffer, warm_state_size);
+    }
+    last_warm_state_save_sample_index = current_sample_index;
+  }
 
+  model_variants->RecordPass(pass_start_us, ProfilerNowMicros());
   delay(1);
 }
@@ -0,0 +1,130 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "model_cascade.h"
+
+#include <cstring>
+
+#include "micro_model_settings.h"
+
+namespace {
+
+TfLiteStatus InvokeStage(tflite::ErrorReporter* error_reporter,
+                         tflite::MicroInterpreter* stage,
+                         const uint8_t* spectrogram, const uint8_t** scores) {
+  uint8_t* input_data = stage->input(0)->data.uint8;
+  if (input_data != spectrogram) {
+    memcpy(input_data, spectrogram, kFeatureElementCount);
+  }
+  if (stage->Invoke() != kTfLiteOk) {
+    error_reporter->Report("Invoke failed");
+    return kTfLiteError;
+  }
+  *scores = stage->output(0)->data.uint8;
+  return kTfLiteOk;
+}
+
+// The scores are quantized probabilities, so whatever silence and unknown
+// don't take is the chance that one of the keywords was spoken.
+int KeywordScore(const uint8_t* scores) {
+  const int score = 255 - scores[kSilenceIndex] - scores[kUnknownIndex];
+  return (score > 0) ? score : 0;
+}
+
+}  // namespace
+
+ModelCascade::ModelCascade(uint8_t keyword_threshold)
+    : keyword_threshold_(keyword_threshold),
+      first_stage_(nullptr),
+      second_stage_(nullptr),
+      input_data_(nullptr),
+      first_stage_count_(0),
+      second_stage_count_(0) {}
+
+TfLiteStatus ModelCascade::Initialize(tflite::ErrorReporter* error_reporter,
+                                      tflite::MicroInterpreter* first_stage,
+                                      tflite::MicroInterpreter* second_stage,
+                                      uint8_t* spectrogram) {
+  if ((first_stage != nullptr) &&
+      (CheckStage(error_reporter, first_stage, "first-stage") != kTfLiteOk)) {
+    return kTfLiteError;
+  }
+  if (CheckStage(error_reporter, second_stage, "second-stage") != kTfLiteOk) {
+    return kTfLiteError;
+  }
+  first_stage_ = first_stage;
+  second_stage_ = second_stage;
+  tflite::MicroInterpreter* input_stage =
+      (first_stage != nullptr) ? first_stage : second_stage;
+  input_data_ = (spectrogram != nullptr) ? spectrogram
+                                         : input_stage->input(0)->data.uint8;
+  return kTfLiteOk;
+}
+
+TfLiteStatus ModelCascade::CheckStage(tflite::ErrorReporter* error_reporter,
+                                      tflite::MicroInterpreter* stage,
+                                      const char* name) {
+  TfLiteTensor* input = stage->input(0);
+  if ((input->dims->size != 4) || (input->dims->data[0] != 1) ||
+      (input->dims->data[1] != kFeatureSliceCount) ||
+      (input->dims->data[2] != kFeatureSliceSize) ||
+      (input->type != kTfLiteUInt8)) {
+    error_reporter->Report("Bad input tensor parameters in %s model", name);
+    return kTfLiteError;
+  }
+  TfLiteTensor* output = stage->output(0);
+  if ((output->dims->size != 2) || (output->dims->data[0] != 1) ||
+      (output->dims->data[1] != kCategoryCount) ||
+      (output->type != kTfLiteUInt8)) {
+    error_reporter->Report("Bad output tensor parameters in %s model", name);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus ModelCascade::Invoke(tflite::ErrorReporter* error_reporter,
+                                  const uint8_t* spectrogram,
+                                  const uint8_t** scores) {
+  if (first_stage_ != nullptr) {
+    TfLiteStatus first_status =
+        InvokeStage(error_reporter, first_stage_, spectrogram, scores);
+    if (first_status != kTfLiteOk) {
+      return first_status;
+    }
+    ++first_stage_count_;
+    if (KeywordScore(*scores) < keyword_threshold_) {
+      return kTfLiteOk;
+    }
+  }
+  TfLiteStatus second_status =
+      InvokeStage(error_reporter, second_stage_, spectrogram, scores);
+  if (second_status != kTfLiteOk) {
+    return second_status;
+  }
+  ++second_stage_count_;
+  return kTfLiteOk;
+}
+
+void ModelCascade::Report(tflite::ErrorReporter* error_reporter) const {
+  if (first_stage_ == nullptr) {
+    error_reporter->Report("cascade: no first stage, %d inferences",
+                           static_cast<int>(second_stage_count_));
+    return;
+  }
+  error_reporter->Report(
+      "cascade: %d first-stage inferences, %d passed to the second stage",
+      static_cast<int>(first_stage_count_),
+      static_cast<int>(second_stage_count_));
+}
@@ -0,0 +1,93 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MODEL_CASCADE_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MODEL_CASCADE_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/c_api_internal.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+#include "tensorflow/lite/experimental/micro/micro_interpreter.h"
+
+// Runs the keyword model as a cascade of two stages. A much smaller first
+// stage runs on every inference, and only when it gives the keywords a
+// combined score of at least keyword_threshold does the full second-stage
+// model run, with its result replacing the first stage's. Otherwise the first
+// stage's scores are the result. The threshold should be well below the
+// recognizer's detection threshold, so a first-stage result that doesn't pass
+// it can't cause a detection on its own.
+//
+// Each stage has its own interpreter and arena, and both take the same
+// [1, kFeatureSliceCount, kFeatureSliceSize] spectrogram and give
+// [1, kCategoryCount] uint8 scores with the labels in kCategoryLabels. The
+// spectrogram is copied into a stage's input tensor only if it isn't already
+// there, so the feature provider should write straight into the first stage's
+// input. Without a first stage, the second runs every time and nothing is
+// copied.
+//
+// The second stage can be swapped for another pre-allocated interpreter
+// between inferences, as ModelVariants does under load. The spectrogram then
+// stays where it was, and is copied into the new stage's input when it runs.
+class ModelCascade {
+ public:
+  explicit ModelCascade(uint8_t keyword_threshold = 64);
+
+  // Checks the stages' tensors against the settings in micro_model_settings.h.
+  // first_stage can be null, to run the second stage alone. If spectrogram is
+  // given, the feature provider should write there instead of into a stage's
+  // input, which is needed if that stage's arena can be rebuilt, as
+  // ModelSwapper does.
+  TfLiteStatus Initialize(tflite::ErrorReporter* error_reporter,
+                          tflite::MicroInterpreter* first_stage,
+                          tflite::MicroInterpreter* second_stage,
+                          uint8_t* spectrogram = nullptr);
+
+  // Replaces the second stage, which must already have passed CheckStage().
+  // This only swaps a pointer, so it's safe to call from the loop.
+  void set_second_stage(tflite::MicroInterpreter* second_stage) {
+    second_stage_ = second_stage;
+  }
+
+  // Checks that a stage's tensors match the settings in micro_model_settings.h.
+  // name is used in the error message.
+  static TfLiteStatus CheckStage(tflite::ErrorReporter* error_reporter,
+                                 tflite::MicroInterpreter* stage,
+                                 const char* name);
+
+  // Runs the cascade on spectrogram, and points scores at the kCategoryCount
+  // scores of whichever stage ran last. They stay valid until the next call.
+  TfLiteStatus Invoke(tflite::ErrorReporter* error_reporter,
+                      const uint8_t* spectrogram, const uint8_t** scores);
+
+  // Where the feature provider should write the spectrogram.
+  uint8_t* input_data() const { return input_data_; }
+
+  int64_t first_stage_count() const { return first_stage_count_; }
+  int64_t second_stage_count() const { return second_stage_count_; }
+
+  // Prints how often the second stage was needed.
+  void Report(tflite::ErrorReporter* error_reporter) const;
+
+ private:
+  uint8_t keyword_threshold_;
+  tflite::MicroInterpreter* first_stage_;
+  tflite::MicroInterpreter* second_stage_;
+  uint8_t* input_data_;
+  int64_t first_stage_count_;
+  int64_t second_stage_count_;
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MODEL_CASCADE_H_
@@ -0,0 +1,203 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "model_storage.h"
+
+#include "tensorflow/lite/schema/schema_generated.h"
+
+#if defined(ARDUINO)
+#include <esp_partition.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#if defined(ARDUINO)
+// How long to rest between sector erases, so the capture task can empty the
+// I2S DMA buffers and the loop can catch up with the audio.
+constexpr int kEraseRestMs = 100;
+#endif  // defined(ARDUINO)
+
+TfLiteStatus VerifyModel(tflite::ErrorReporter* error_reporter,
+                         const char* name, const MappedModel& model) {
+  flatbuffers::Verifier verifier(model.data, model.size);
+  if (!tflite::VerifyModelBuffer(verifier)) {
+    error_reporter->Report("'%s' doesn't hold a valid model", name);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+#if defined(ARDUINO)
+const esp_partition_t* FindModelPartition(
+    tflite::ErrorReporter* error_reporter, const char* label) {
+  const esp_partition_t* partition = esp_partition_find_first(
+      ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+  if (partition == nullptr) {
+    error_reporter->Report("No data partition named '%s'", label);
+  }
+  return partition;
+}
+#endif  // defined(ARDUINO)
+
+}  // namespace
+
+#if defined(ARDUINO)
+
+TfLiteStatus MapModel(tflite::ErrorReporter* error_reporter, const char* name,
+                      MappedModel* model) {
+  const esp_partition_t* partition = FindModelPartition(error_reporter, name);
+  if (partition == nullptr) {
+    return kTfLiteError;
+  }
+  const void* data = nullptr;
+  spi_flash_mmap_handle_t handle;
+  const esp_err_t err = esp_partition_mmap(
+      partition, 0, partition->size, ESP_PARTITION_MMAP_DATA, &data, &handle);
+  if (err != ESP_OK) {
+    error_reporter->Report("Couldn't map partition '%s': %s", name,
+                           esp_err_to_name(err));
+    return kTfLiteError;
+  }
+  MappedModel mapped;
+  mapped.data = static_cast<const uint8_t*>(data);
+  mapped.size = partition->size;
+  mapped.handle = handle;
+  if (VerifyModel(error_reporter, name, mapped) != kTfLiteOk) {
+    UnmapModel(&mapped);
+    return kTfLiteError;
+  }
+  *model = mapped;
+  return kTfLiteOk;
+}
+
+void UnmapModel(MappedModel* model) {
+  if (model->data != nullptr) {
+    spi_flash_munmap(model->handle);
+  }
+  *model = MappedModel();
+}
+
+TfLiteStatus CheckModelPartitionSize(tflite::ErrorReporter* error_reporter,
+                                     const char* label, size_t size) {
+  const esp_partition_t* partition = FindModelPartition(error_reporter, label);
+  if (partition == nullptr) {
+    return kTfLiteError;
+  }
+  if (size > partition->size) {
+    error_reporter->Report("A %d byte model won't fit in '%s' of %d bytes",
+                           size, label, partition->size);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus EraseModelPartition(tflite::ErrorReporter* error_reporter,
+                                 const char* label, size_t offset,
+                                 size_t size) {
+  const esp_partition_t* partition = FindModelPartition(error_reporter, label);
+  if (partition == nullptr) {
+    return kTfLiteError;
+  }
+  // Erases have to cover whole sectors.
+  const size_t end = (offset + size + kModelPartitionSectorSize - 1) &
+                     ~static_cast<size_t>(kModelPartitionSectorSize - 1);
+  if (((offset % kModelPartitionSectorSize) != 0) || (end > partition->size)) {
+    error_reporter->Report("Can't erase %d bytes at %d in '%s' of %d bytes",
+                           size, offset, label, partition->size);
+    return kTfLiteError;
+  }
+  // A single call would erase 64 KB blocks where it could, each of which
+  // stalls both cores for longer than the I2S DMA can buffer.
+  for (size_t sector = offset; sector < end;
+       sector += kModelPartitionSectorSize) {
+    if (sector > offset) {
+      vTaskDelay(pdMS_TO_TICKS(kEraseRestMs));
+    }
+    const esp_err_t err =
+        esp_partition_erase_range(partition, sector, kModelPartitionSectorSize);
+    if (err != ESP_OK) {
+      error_reporter->Report("Erasing '%s' failed: %s", label,
+                             esp_err_to_name(err));
+      return kTfLiteError;
+    }
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus WriteModelPartition(tflite::ErrorReporter* error_reporter,
+                                 const char* label, size_t offset,
+                                 const uint8_t* data, size_t size) {
+  const esp_partition_t* partition = FindModelPartition(error_reporter, label);
+  if (partition == nullptr) {
+    return kTfLiteError;
+  }
+  const esp_err_t err = esp_partition_write(partition, offset, data, size);
+  if (err != ESP_OK) {
+    error_reporter->Report("Writing to '%s' failed: %s", label,
+                           esp_err_to_name(err));
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+#else  // defined(ARDUINO)
+
+TfLiteStatus MapModel(tflite::ErrorReporter* error_reporter, const char* name,
+                      MappedModel* model) {
+  const int fd = open(name, O_RDONLY);
+  if (fd < 0) {
+    error_reporter->Report("Couldn't open model '%s'", name);
+    return kTfLiteError;
+  }
+  struct stat file_stat;
+  if ((fstat(fd, &file_stat) != 0) || (file_stat.st_size == 0)) {
+    error_reporter->Report("Model '%s' is empty", name);
+    close(fd);
+    return kTfLiteError;
+  }
+  void* data =
+      mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid once the file is closed.
+  close(fd);
+  if (data == MAP_FAILED) {
+    error_reporter->Report("Couldn't map model '%s'", name);
+    return kTfLiteError;
+  }
+  MappedModel mapped;
+  mapped.data = static_cast<const uint8_t*>(data);
+  mapped.size = file_stat.st_size;
+  if (VerifyModel(error_reporter, name, mapped) != kTfLiteOk) {
+    UnmapModel(&mapped);
+    return kTfLiteError;
+  }
+  *model = mapped;
+  return kTfLiteOk;
+}
+
+void UnmapModel(MappedModel* model) {
+  if (model->data != nullptr) {
+    munmap(const_cast<uint8_t*>(model->data), model->size);
+  }
+  *model = MappedModel();
+}
+
+#endif  // defined(ARDUINO)
@@ -0,0 +1,79 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MODEL_STORAGE_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MODEL_STORAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensorflow/lite/c/c_api_internal.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+
+// Gives access to a model flatbuffer kept outside the firmware, so it can be
+// changed without a rebuild. Nothing is copied: the interpreter reads the
+// model's weights straight from where they're stored. On the device the model
+// lives in a data partition, mapped through the flash cache the same way the
+// compiled-in model is, and elsewhere it's a file mapped with mmap().
+//
+// The partition holds a plain .tflite file, written with for example:
+//   parttool.py write_partition --partition-name=model_a --input=model.tflite
+// or with WriteModelPartition() while the sketch is running. The whole
+// partition is mapped, and the flatbuffer is verified before it's used, so an
+// empty or half-written partition is rejected rather than crashing.
+struct MappedModel {
+  const uint8_t* data = nullptr;
+  // On the device this is the size of the partition, so it may be larger than
+  // the model itself.
+  size_t size = 0;
+  uint32_t handle = 0;
+};
+
+// Maps the model in the data partition with the given label, or on the host
+// the file with the given path, and checks that it's a TensorFlow Lite model.
+TfLiteStatus MapModel(tflite::ErrorReporter* error_reporter, const char* name,
+                      MappedModel* model);
+
+// Releases a mapping made by MapModel(). Nothing may use the model afterwards.
+// Does nothing if the model isn't mapped.
+void UnmapModel(MappedModel* model);
+
+#if defined(ARDUINO)
+// Flash is erased in sectors of this many bytes.
+constexpr size_t kModelPartitionSectorSize = 4096;
+
+// Checks that a model of size bytes fits in the partition with the given
+// label, before any of it is erased.
+TfLiteStatus CheckModelPartitionSize(tflite::ErrorReporter* error_reporter,
+                                     const char* label, size_t size);
+
+// Erases the sectors holding size bytes at offset, which must be a multiple of
+// kModelPartitionSectorSize, ready for WriteModelPartition() to fill in.
+// Erasing and writing flash pause the caches, and so both cores, while they
+// run. A sector erase typically takes around 45 ms, not far short of the 64 ms
+// of audio the I2S DMA buffers hold, so larger ranges are erased a sector at a
+// time with a rest in between. Writes take a few milliseconds per KB, so
+// should be kept to small chunks. Both should only be called from a low
+// priority task, and never on a partition that's still mapped.
+TfLiteStatus EraseModelPartition(tflite::ErrorReporter* error_reporter,
+                                 const char* label, size_t offset, size_t size);
+
+// Writes size bytes of a model at offset into an erased partition.
+TfLiteStatus WriteModelPartition(tflite::ErrorReporter* error_reporter,
+                                 const char* label, size_t offset,
+                                 const uint8_t* data, size_t size);
+#endif  // defined(ARDUINO)
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MODEL_STORAGE_H_
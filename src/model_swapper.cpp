@@ -0,0 +1,142 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "model_swapper.h"
+
+#include <cstring>
+#include <new>
+
+#include "frontend_fingerprint.h"
+#include "memory_report.h"
+#include "model_cascade.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+#include "tensorflow/lite/version.h"
+
+ModelSwapper::ModelSwapper(const tflite::OpResolver& op_resolver,
+                           uint8_t* first_arena, uint8_t* second_arena,
+                           size_t arena_size)
+    : op_resolver_(op_resolver),
+      arena_size_(arena_size),
+      active_slot_(-1),
+      pending_slot_(-1),
+      swap_count_(0) {
+  uint8_t* arenas[2] = {first_arena, second_arena};
+  for (int i = 0; i < 2; ++i) {
+    slots_[i].arena = arenas[i];
+    slots_[i].interpreter = nullptr;
+    slots_[i].name[0] = '\0';
+    slots_[i].fingerprint = 0;
+  }
+}
+
+ModelSwapper::~ModelSwapper() {
+  for (Slot& slot : slots_) {
+    ReleaseSlot(&slot);
+  }
+}
+
+void ModelSwapper::ReleaseSlot(Slot* slot) {
+  if (slot->interpreter != nullptr) {
+    slot->interpreter->~MicroInterpreter();
+    slot->interpreter = nullptr;
+  }
+  UnmapModel(&slot->mapping);
+  slot->name[0] = '\0';
+  slot->fingerprint = 0;
+}
+
+TfLiteStatus ModelSwapper::Prepare(tflite::ErrorReporter* error_reporter,
+                                   const char* name, const uint8_t* model_data,
+                                   size_t model_size,
+                                   const MappedModel* mapping) {
+  MappedModel owned_mapping;
+  if (mapping != nullptr) {
+    owned_mapping = *mapping;
+  }
+  if (pending_slot_.load(std::memory_order_acquire) >= 0) {
+    error_reporter->Report("Model '%s' is still waiting to be swapped in",
+                           slots_[pending_slot_.load()].name);
+    UnmapModel(&owned_mapping);
+    return kTfLiteError;
+  }
+  const int spare_index =
+      (active_slot_.load(std::memory_order_acquire) == 0) ? 1 : 0;
+  Slot* slot = &slots_[spare_index];
+  ReleaseSlot(slot);
+  slot->mapping = owned_mapping;
+  strncpy(slot->name, name, kMaxNameLength);
+  slot->name[kMaxNameLength] = '\0';
+
+  const tflite::Model* model = tflite::GetModel(model_data);
+  if (model->version() != TFLITE_SCHEMA_VERSION) {
+    error_reporter->Report(
+        "Model '%s' is schema version %d not equal to supported version %d.",
+        name, model->version(), TFLITE_SCHEMA_VERSION);
+    ReleaseSlot(slot);
+    return kTfLiteError;
+  }
+  // The arena is painted so the memory report can tell how much of it the new
+  // model needs.
+  MemoryReport::Paint(slot->arena, arena_size_);
+  slot->interpreter = new (slot->interpreter_storage) tflite::MicroInterpreter(
+      model, op_resolver_, slot->arena, arena_size_, error_reporter);
+  if (slot->interpreter->AllocateTensors() != kTfLiteOk) {
+    error_reporter->Report("AllocateTensors() failed for model '%s'", name);
+    ReleaseSlot(slot);
+    return kTfLiteError;
+  }
+  if (ModelCascade::CheckStage(error_reporter, slot->interpreter, name) !=
+      kTfLiteOk) {
+    ReleaseSlot(slot);
+    return kTfLiteError;
+  }
+  slot->fingerprint = Fnv1a64(model_data, model_size);
+  pending_slot_.store(spare_index, std::memory_order_release);
+  return kTfLiteOk;
+}
+
+tflite::MicroInterpreter* ModelSwapper::TakePrepared() {
+  const int pending_index = pending_slot_.load(std::memory_order_acquire);
+  if (pending_index < 0) {
+    return nullptr;
+  }
+  // The active slot has to change before the pending one is cleared, so that
+  // Prepare() never picks the new model's slot as the spare.
+  active_slot_.store(pending_index, std::memory_order_release);
+  pending_slot_.store(-1, std::memory_order_release);
+  ++swap_count_;
+  return slots_[pending_index].interpreter;
+}
+
+TfLiteStatus ModelSwapper::ReleaseSpare(tflite::ErrorReporter* error_reporter) {
+  if (pending_slot_.load(std::memory_order_acquire) >= 0) {
+    error_reporter->Report("Can't release a model waiting to be swapped in");
+    return kTfLiteError;
+  }
+  const int spare_index =
+      (active_slot_.load(std::memory_order_acquire) == 0) ? 1 : 0;
+  ReleaseSlot(&slots_[spare_index]);
+  return kTfLiteOk;
+}
+
+const char* ModelSwapper::active_name() const {
+  const int active_index = active_slot_.load(std::memory_order_acquire);
+  return (active_index < 0) ? "" : slots_[active_index].name;
+}
+
+uint64_t ModelSwapper::active_fingerprint() const {
+  const int active_index = active_slot_.load(std::memory_order_acquire);
+  return (active_index < 0) ? 0 : slots_[active_index].fingerprint;
+}
@@ -0,0 +1,98 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MODEL_SWAPPER_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MODEL_SWAPPER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "model_storage.h"
+#include "tensorflow/lite/c/c_api_internal.h"
+#include "tensorflow/lite/core/api/op_resolver.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+#include "tensorflow/lite/experimental/micro/micro_interpreter.h"
+
+// Replaces the running model without holding up detection. There are two
+// slots, each with its own arena and interpreter: one holds the model in use,
+// and a new model is built in the other one, AllocateTensors() and all, while
+// the loop carries on running inferences with the old one. Once it's ready,
+// the loop picks it up with TakePrepared() between two inferences, and the
+// old slot becomes the spare for the next update.
+//
+// Prepare() and ReleaseSpare() can be called from a different task to the
+// loop's, but only from one task at a time. The handover is a pair of atomic
+// slot indexes, so neither side ever waits for the other.
+class ModelSwapper {
+ public:
+  static constexpr int kMaxNameLength = 31;
+
+  // Both arenas must be big enough for any model that will be loaded.
+  ModelSwapper(const tflite::OpResolver& op_resolver, uint8_t* first_arena,
+               uint8_t* second_arena, size_t arena_size);
+  ~ModelSwapper();
+
+  // Builds an interpreter for the model_size bytes of a model in the spare
+  // slot, and checks its tensors. The model is either compiled in, in which
+  // case mapping is null, or was mapped by MapModel(), in which case the
+  // swapper takes over the mapping and releases it once the slot is reused.
+  // Fails without changing anything in use if the model is bad, or if the last
+  // prepared model hasn't been taken yet.
+  TfLiteStatus Prepare(tflite::ErrorReporter* error_reporter, const char* name,
+                       const uint8_t* model_data, size_t model_size,
+                       const MappedModel* mapping);
+
+  // Called by the loop between inferences. Returns the interpreter for a newly
+  // prepared model once, after which the loop should use it instead of the
+  // old one, or null if nothing is waiting.
+  tflite::MicroInterpreter* TakePrepared();
+
+  // Destroys the spare slot's interpreter and releases its mapping, so the
+  // storage it came from can be rewritten. Fails if a prepared model is still
+  // waiting to be taken.
+  TfLiteStatus ReleaseSpare(tflite::ErrorReporter* error_reporter);
+
+  // The name the model in use was prepared with, or an empty string before
+  // the first TakePrepared().
+  const char* active_name() const;
+  // A hash of the bytes of the model in use, so state that depends on the
+  // model's outputs can tell when it has changed. Zero before the first
+  // TakePrepared().
+  uint64_t active_fingerprint() const;
+  int64_t swap_count() const { return swap_count_; }
+
+ private:
+  struct Slot {
+    uint8_t* arena;
+    alignas(tflite::MicroInterpreter) uint8_t
+        interpreter_storage[sizeof(tflite::MicroInterpreter)];
+    tflite::MicroInterpreter* interpreter;
+    MappedModel mapping;
+    char name[kMaxNameLength + 1];
+    uint64_t fingerprint;
+  };
+
+  void ReleaseSlot(Slot* slot);
+
+  const tflite::OpResolver& op_resolver_;
+  size_t arena_size_;
+  Slot slots_[2];
+  std::atomic<int> active_slot_;
+  std::atomic<int> pending_slot_;
+  int64_t swap_count_;
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MODEL_SWAPPER_H_
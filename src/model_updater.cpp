@@ -0,0 +1,185 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "model_updater.h"
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#include "audio_provider.h"
+#include "model_storage.h"
+#include "profiler.h"
+
+namespace {
+
+constexpr int kModelUpdaterTaskStackSize = 4096;
+// NVS namespace and key names are limited to 15 characters.
+constexpr char kModelNamespace[] = "micro_speech";
+constexpr char kModelPartitionKey[] = "model_partition";
+const char* const kModelPartitions[] = {"model_a", "model_b"};
+// How long to wait for the rest of a model once it has started arriving.
+constexpr unsigned long kReceiveTimeoutMs = 5000;
+
+tflite::ErrorReporter* g_error_reporter = nullptr;
+ModelSwapper* g_swapper = nullptr;
+TaskHandle_t g_model_updater_task = nullptr;
+uint8_t g_receive_buffer[1024];
+
+const char* InactivePartition(const char* active_name) {
+  return (strcmp(active_name, kModelPartitions[0]) == 0) ? kModelPartitions[1]
+                                                         : kModelPartitions[0];
+}
+
+// Samples lost by every reader of the capture ring so far, to check that an
+// update doesn't hold up the audio.
+int64_t DroppedAudioSamples() {
+  const AudioBroadcastRing* ring = GetAudioRing();
+  int64_t dropped = 0;
+  for (int i = 0; i < AudioBroadcastRing::kMaxCursors; ++i) {
+    dropped += ring->dropped(i);
+  }
+  return dropped;
+}
+
+void RememberPartition(const char* label) {
+  Preferences preferences;
+  if (preferences.begin(kModelNamespace, false)) {
+    preferences.putString(kModelPartitionKey, label);
+    preferences.end();
+  }
+}
+
+TfLiteStatus PreparePartition(const char* label) {
+  MappedModel mapped;
+  if (MapModel(g_error_reporter, label, &mapped) != kTfLiteOk) {
+    return kTfLiteError;
+  }
+  return g_swapper->Prepare(g_error_reporter, label, mapped.data, mapped.size,
+                            &mapped);
+}
+
+// Copies size bytes from Serial into the partition, a buffer at a time. Each
+// sector is erased just before the first chunk that lands in it, so the sender
+// never has to wait long, and what arrives meanwhile fits in Serial's receive
+// buffer.
+TfLiteStatus ReceiveModel(const char* label, size_t size) {
+  if ((g_swapper->ReleaseSpare(g_error_reporter) != kTfLiteOk) ||
+      (CheckModelPartitionSize(g_error_reporter, label, size) != kTfLiteOk)) {
+    return kTfLiteError;
+  }
+  Serial.setTimeout(kReceiveTimeoutMs);
+  size_t offset = 0;
+  while (offset < size) {
+    if (((offset % kModelPartitionSectorSize) == 0) &&
+        (EraseModelPartition(g_error_reporter, label, offset,
+                             kModelPartitionSectorSize) != kTfLiteOk)) {
+      return kTfLiteError;
+    }
+    size_t chunk_size = size - offset;
+    if (chunk_size > sizeof(g_receive_buffer)) {
+      chunk_size = sizeof(g_receive_buffer);
+    }
+    const size_t received = Serial.readBytes(g_receive_buffer, chunk_size);
+    if (received != chunk_size) {
+      g_error_reporter->Report("Model stopped arriving after %d of %d bytes",
+                               offset + received, size);
+      return kTfLiteError;
+    }
+    if (WriteModelPartition(g_error_reporter, label, offset, g_receive_buffer,
+                            chunk_size) != kTfLiteOk) {
+      return kTfLiteError;
+    }
+    offset += chunk_size;
+  }
+  return kTfLiteOk;
+}
+
+void ModelUpdaterTask(void* parameters) {
+  char line[32];
+  while (true) {
+    if (Serial.available() == 0) {
+      vTaskDelay(pdMS_TO_TICKS(100));
+      continue;
+    }
+    Serial.setTimeout(kReceiveTimeoutMs);
+    const size_t length = Serial.readBytesUntil('\n', line, sizeof(line) - 1);
+    line[length] = '\0';
+    if (strncmp(line, "model ", 6) != 0) {
+      continue;
+    }
+    const size_t size = strtoul(line + 6, nullptr, 10);
+    const char* label = InactivePartition(g_swapper->active_name());
+    const int64_t start_us = ProfilerNowMicros();
+    const int64_t start_dropped = DroppedAudioSamples();
+    if ((size == 0) || (ReceiveModel(label, size) != kTfLiteOk) ||
+        (PreparePartition(label) != kTfLiteOk)) {
+      g_error_reporter->Report("Model update failed, keeping '%s'",
+                               g_swapper->active_name());
+      continue;
+    }
+    RememberPartition(label);
+    g_error_reporter->Report(
+        "Model in '%s' ready after %d ms with %d audio samples dropped, "
+        "swapping at the next inference",
+        label, static_cast<int>((ProfilerNowMicros() - start_us) / 1000),
+        static_cast<int>(DroppedAudioSamples() - start_dropped));
+  }
+}
+
+}  // namespace
+
+TfLiteStatus PrepareStoredModel(tflite::ErrorReporter* error_reporter,
+                                ModelSwapper* swapper) {
+  g_error_reporter = error_reporter;
+  g_swapper = swapper;
+  char label[16];
+  Preferences preferences;
+  if (!preferences.begin(kModelNamespace, true)) {
+    // The namespace only exists once something has been stored.
+    return kTfLiteError;
+  }
+  const size_t length =
+      preferences.getString(kModelPartitionKey, label, sizeof(label));
+  preferences.end();
+  if (length == 0) {
+    return kTfLiteError;
+  }
+  return PreparePartition(label);
+}
+
+TfLiteStatus StartModelUpdater(tflite::ErrorReporter* error_reporter,
+                               ModelSwapper* swapper) {
+  g_error_reporter = error_reporter;
+  g_swapper = swapper;
+  // Core 0 is shared with the audio task, which preempts this one, and the
+  // loop on core 1 isn't slowed down by a model being built.
+  if (xTaskCreatePinnedToCore(ModelUpdaterTask, "ModelUpdaterTask",
+                              kModelUpdaterTaskStackSize, nullptr, 1,
+                              &g_model_updater_task, 0) != pdPASS) {
+    error_reporter->Report("Couldn't start the model updater task");
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+void AddModelUpdaterMemoryRegions(MemoryReport* report) {
+  report->AddRegion("model receive buffer", g_receive_buffer,
+                    sizeof(g_receive_buffer));
+  report->AddTask("ModelUpdaterTask", g_model_updater_task,
+                  kModelUpdaterTaskStackSize);
+}
@@ -0,0 +1,63 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MODEL_UPDATER_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MODEL_UPDATER_H_
+
+#include <cstddef>
+
+#include "memory_report.h"
+#include "model_swapper.h"
+#include "tensorflow/lite/c/c_api_internal.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+
+// Keeps the keyword model in one of two flash partitions, model_a and model_b,
+// so a new one can be sent to a running node without reflashing it. The
+// updater task listens on Serial for a line of the form
+//   model <size in bytes>
+// followed by the raw .tflite file, for example with:
+//   (echo "model $(stat -c %s new.tflite)"; cat new.tflite) > /dev/ttyACM0
+// It writes the model to whichever partition isn't in use, maps it, and has
+// the ModelSwapper build an interpreter for it, all on the other core at low
+// priority, so detection goes on with the old model meanwhile. The loop then
+// swaps to it between two inferences. The partition is remembered in NVS, so
+// the same model is loaded after a restart. The report at the end of an update
+// includes how many samples the capture ring's readers lost while it ran,
+// which should be none.
+//
+// This needs a partition table with both partitions, such as
+// partitions_16MB_models.csv.
+//
+// The sender doesn't wait for anything, so while a flash sector is erased the
+// model keeps arriving into Serial's receive buffer. The default of 256 bytes
+// only covers about 20 ms at 115200 baud, so the sketch should call
+// Serial.setRxBufferSize(kModelUpdaterSerialBufferSize) before Serial.begin().
+// This size holds about 350 ms, several sector erases' worth.
+constexpr size_t kModelUpdaterSerialBufferSize = 4096;
+
+// Prepares the model from the partition that was in use before the last
+// restart, if there is one and it's valid. Returns kTfLiteError otherwise, in
+// which case the compiled-in model should be prepared instead.
+TfLiteStatus PrepareStoredModel(tflite::ErrorReporter* error_reporter,
+                                ModelSwapper* swapper);
+
+// Starts the task that receives new models.
+TfLiteStatus StartModelUpdater(tflite::ErrorReporter* error_reporter,
+                               ModelSwapper* swapper);
+
+// Adds the updater task's stack to a memory report.
+void AddModelUpdaterMemoryRegions(MemoryReport* report);
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MODEL_UPDATER_H_
@@ -0,0 +1,172 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "model_variants.h"
+
+#include "micro_model_settings.h"
+#include "model_cascade.h"
+
+namespace {
+
+// Each new Invoke() time moves a variant's average 1/2^this of the way.
+constexpr int kInvokeAverageShift = 3;
+
+}  // namespace
+
+ModelVariants::ModelVariants(const ModelVariantSettings& settings)
+    : settings_(settings),
+      names_(),
+      interpreters_(),
+      active_samples_(),
+      average_invoke_us_(),
+      variant_count_(0),
+      active_index_(0),
+      switch_count_(0),
+      last_switch_sample_index_(0),
+      last_select_sample_index_(0),
+      has_selected_(false),
+      window_start_us_(-1),
+      window_busy_us_(0),
+      window_invoke_us_(0),
+      window_invoke_count_(0),
+      load_percent_(0),
+      last_window_us_(0),
+      last_other_busy_us_(0),
+      last_invoke_count_(0) {}
+
+TfLiteStatus ModelVariants::CheckSettings(
+    tflite::ErrorReporter* error_reporter) const {
+  if ((settings_.low_load_percent < 0) ||
+      (settings_.low_load_percent >= settings_.high_load_percent) ||
+      (settings_.high_load_percent > 100)) {
+    error_reporter->Report(
+        "Variant load limits of %d and %d percent should be in order and "
+        "between 0 and 100",
+        settings_.low_load_percent, settings_.high_load_percent);
+    return kTfLiteError;
+  }
+  if ((settings_.load_window_ms < 1) || (settings_.min_dwell_ms < 0)) {
+    error_reporter->Report(
+        "Variant load window of %d ms and dwell of %d ms aren't valid",
+        settings_.load_window_ms, settings_.min_dwell_ms);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus ModelVariants::AddVariant(tflite::ErrorReporter* error_reporter,
+                                       const char* name,
+                                       tflite::MicroInterpreter* interpreter) {
+  if (variant_count_ >= kMaxVariants) {
+    error_reporter->Report("Too many model variants, %d at most", kMaxVariants);
+    return kTfLiteError;
+  }
+  if (ModelCascade::CheckStage(error_reporter, interpreter, name) !=
+      kTfLiteOk) {
+    return kTfLiteError;
+  }
+  names_[variant_count_] = name;
+  interpreters_[variant_count_] = interpreter;
+  ++variant_count_;
+  return kTfLiteOk;
+}
+
+void ModelVariants::RecordPass(int64_t start_us, int64_t end_us) {
+  if (window_start_us_ < 0) {
+    window_start_us_ = start_us;
+  }
+  const int64_t window_us = start_us - window_start_us_;
+  if (window_us >= int64_t{settings_.load_window_ms} * 1000) {
+    const int64_t load = (100 * window_busy_us_) / window_us;
+    load_percent_ = static_cast<int>((load < 100) ? load : 100);
+    last_window_us_ = window_us;
+    last_other_busy_us_ = window_busy_us_ - window_invoke_us_;
+    last_invoke_count_ = window_invoke_count_;
+    window_start_us_ = start_us;
+    window_busy_us_ = 0;
+    window_invoke_us_ = 0;
+    window_invoke_count_ = 0;
+  }
+  window_busy_us_ += end_us - start_us;
+}
+
+void ModelVariants::RecordInvoke(int64_t start_us, int64_t end_us) {
+  const int32_t invoke_us = static_cast<int32_t>(end_us - start_us);
+  int32_t* average_us = &average_invoke_us_[active_index_];
+  if (*average_us == 0) {
+    *average_us = invoke_us;
+  } else {
+    *average_us += (invoke_us - *average_us) >> kInvokeAverageShift;
+  }
+  window_invoke_us_ += invoke_us;
+  ++window_invoke_count_;
+}
+
+int ModelVariants::PredictLoadPercent(int index) const {
+  if (last_window_us_ <= 0) {
+    return load_percent_;
+  }
+  const int64_t busy_us =
+      last_other_busy_us_ +
+      (int64_t{last_invoke_count_} * average_invoke_us_[index]);
+  const int64_t load = (100 * busy_us) / last_window_us_;
+  return static_cast<int>((load < 100) ? load : 100);
+}
+
+tflite::MicroInterpreter* ModelVariants::Select(int64_t current_sample_index) {
+  if (!has_selected_) {
+    last_switch_sample_index_ = current_sample_index;
+    last_select_sample_index_ = current_sample_index;
+    has_selected_ = true;
+  }
+  active_samples_[active_index_] +=
+      current_sample_index - last_select_sample_index_;
+  last_select_sample_index_ = current_sample_index;
+
+  const int64_t min_dwell_samples =
+      int64_t{settings_.min_dwell_ms} * kAudioSamplesPerMs;
+  if (current_sample_index - last_switch_sample_index_ >= min_dwell_samples) {
+    int next_index = active_index_;
+    if ((load_percent_ > settings_.high_load_percent) &&
+        (active_index_ + 1 < variant_count_)) {
+      next_index = active_index_ + 1;
+    } else if ((load_percent_ < settings_.low_load_percent) &&
+               (active_index_ > 0) &&
+               (PredictLoadPercent(active_index_ - 1) <
+                settings_.high_load_percent)) {
+      next_index = active_index_ - 1;
+    }
+    if (next_index != active_index_) {
+      active_index_ = next_index;
+      last_switch_sample_index_ = current_sample_index;
+      ++switch_count_;
+    }
+  }
+  return interpreters_[active_index_];
+}
+
+void ModelVariants::Report(tflite::ErrorReporter* error_reporter) const {
+  if (variant_count_ == 0) {
+    return;
+  }
+  error_reporter->Report("variants: using %s at %d percent load, %d switches",
+                         names_[active_index_], load_percent_,
+                         static_cast<int>(switch_count_));
+  for (int i = 0; i < variant_count_; ++i) {
+    error_reporter->Report(
+        "variants: %s in use for %d s", names_[i],
+        static_cast<int>(active_samples_[i] / kAudioSampleFrequency));
+  }
+}
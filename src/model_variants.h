@@ -0,0 +1,126 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MODEL_VARIANTS_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MODEL_VARIANTS_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/c/c_api_internal.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+#include "tensorflow/lite/experimental/micro/micro_interpreter.h"
+
+// Chooses between several compiled-in versions of the keyword model that trade
+// accuracy for cost, depending on how busy the loop is. Variants are added
+// most accurate first, each with an interpreter that has already had
+// AllocateTensors() called, so switching only changes which one runs next.
+//
+// The load is the share of the time between passes that the loop spends
+// working, measured over windows of load_window_ms. If another task takes the
+// CPU away, the loop's passes take longer and the load goes up. Above
+// high_load_percent the next cheaper variant is chosen. Part of the load is
+// the running variant's own inferences, so a cheap variant makes the load look
+// low. Below low_load_percent the next more accurate variant is only chosen
+// if the load predicted for it, with its average Invoke() time in place of the
+// current one's, would still be under high_load_percent. Otherwise it would
+// just be switched back out again. Neither happens sooner than min_dwell_ms
+// after the last switch.
+struct ModelVariantSettings {
+  int32_t high_load_percent = 80;
+  int32_t low_load_percent = 50;
+  int32_t load_window_ms = 250;
+  int32_t min_dwell_ms = 2000;
+};
+
+class ModelVariants {
+ public:
+  static constexpr int kMaxVariants = 4;
+
+  explicit ModelVariants(
+      const ModelVariantSettings& settings = ModelVariantSettings());
+
+  TfLiteStatus CheckSettings(tflite::ErrorReporter* error_reporter) const;
+
+  // Adds a variant, which must be cheaper than the ones added before it. The
+  // name must stay valid for as long as this object, so string literals are
+  // the best choice. The first variant is the one used to begin with.
+  TfLiteStatus AddVariant(tflite::ErrorReporter* error_reporter,
+                          const char* name,
+                          tflite::MicroInterpreter* interpreter);
+
+  // Replaces a variant's interpreter with another for the same model, such as
+  // one that ModelSwapper has just built. It must already have been checked.
+  void set_interpreter(int index, tflite::MicroInterpreter* interpreter) {
+    interpreters_[index] = interpreter;
+  }
+
+  // Records one pass of the loop, which started at start_us and finished its
+  // work at end_us, both from ProfilerNowMicros().
+  void RecordPass(int64_t start_us, int64_t end_us);
+
+  // Records the time an inference with the variant Select() last returned
+  // took, as part of the current pass.
+  void RecordInvoke(int64_t start_us, int64_t end_us);
+
+  // Picks the variant to use for an inference at current_sample_index, and
+  // returns its interpreter. Call this once per inference, before running
+  // it, so a switch only ever happens between slices.
+  tflite::MicroInterpreter* Select(int64_t current_sample_index);
+
+  int variant_count() const { return variant_count_; }
+  int active_index() const { return active_index_; }
+  const char* active_name() const { return names_[active_index_]; }
+  // The load over the last complete window, in percent.
+  int load_percent() const { return load_percent_; }
+  // What the load over the last window would have been with the given
+  // variant running instead, in percent.
+  int PredictLoadPercent(int index) const;
+  // A running average of the variant's Invoke() time, or zero before it has
+  // run.
+  int32_t average_invoke_us(int index) const {
+    return average_invoke_us_[index];
+  }
+  int64_t switch_count() const { return switch_count_; }
+  // How long each variant has been in use, on the audio clock.
+  int64_t active_samples(int index) const { return active_samples_[index]; }
+
+  // Prints the variant in use, the load, and the time spent in each variant.
+  void Report(tflite::ErrorReporter* error_reporter) const;
+
+ private:
+  ModelVariantSettings settings_;
+  const char* names_[kMaxVariants];
+  tflite::MicroInterpreter* interpreters_[kMaxVariants];
+  int64_t active_samples_[kMaxVariants];
+  int32_t average_invoke_us_[kMaxVariants];
+  int variant_count_;
+  int active_index_;
+  int64_t switch_count_;
+  int64_t last_switch_sample_index_;
+  int64_t last_select_sample_index_;
+  bool has_selected_;
+  int64_t window_start_us_;
+  int64_t window_busy_us_;
+  int64_t window_invoke_us_;
+  int32_t window_invoke_count_;
+  int load_percent_;
+  // The last complete window's length, the part of its busy time that wasn't
+  // inference, and how many inferences ran in it.
+  int64_t last_window_us_;
+  int64_t last_other_busy_us_;
+  int32_t last_invoke_count_;
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_MODEL_VARIANTS_H_
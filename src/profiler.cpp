@@ -0,0 +1,81 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "profiler.h"
+
+#if defined(ARDUINO)
+#include <esp_timer.h>
+#else
+#include <chrono>
+#endif
+
+#if defined(ARDUINO)
+
+int64_t ProfilerNowMicros() { return esp_timer_get_time(); }
+
+#else  // defined(ARDUINO)
+
+namespace {
+const std::chrono::steady_clock::time_point g_program_start =
+    std::chrono::steady_clock::now();
+}  // namespace
+
+int64_t ProfilerNowMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - g_program_start)
+      .count();
+}
+
+#endif  // defined(ARDUINO)
+
+StartupProfiler::StartupProfiler()
+    : step_count_(0), first_inference_time_(-1) {}
+
+void StartupProfiler::Mark(const char* step_name) {
+  if (step_count_ >= kMaxSteps) {
+    return;
+  }
+  step_names_[step_count_] = step_name;
+  step_end_times_[step_count_] = ProfilerNowMicros();
+  ++step_count_;
+}
+
+bool StartupProfiler::MarkFirstInference() {
+  if (first_inference_time_ >= 0) {
+    return false;
+  }
+  first_inference_time_ = ProfilerNowMicros();
+  return true;
+}
+
+void StartupProfiler::Report(tflite::ErrorReporter* error_reporter) const {
+  // The first step is measured from boot, since that's what matters for how
+  // quickly the node starts listening after a reset. MicroErrorReporter only
+  // understands plain format specifiers, so there's no column alignment.
+  int64_t previous_time = 0;
+  for (int i = 0; i < step_count_; ++i) {
+    const int64_t duration = step_end_times_[i] - previous_time;
+    error_reporter->Report("startup: %s took %d us, done at %d ms",
+                           step_names_[i], static_cast<int>(duration),
+                           static_cast<int>(step_end_times_[i] / 1000));
+    previous_time = step_end_times_[i];
+  }
+  if (first_inference_time_ >= 0) {
+    error_reporter->Report(
+        "startup: time to first inference %d ms, %d ms after setup()",
+        static_cast<int>(first_inference_time_ / 1000),
+        static_cast<int>((first_inference_time_ - previous_time) / 1000));
+  }
+}
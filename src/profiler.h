@@ -0,0 +1,55 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_PROFILER_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_PROFILER_H_
+
+#include <cstdint>
+
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+
+// Returns a monotonic time in microseconds. On the device this counts from
+// boot, elsewhere from when the program started.
+int64_t ProfilerNowMicros();
+
+// Records how long each step of bringing the pipeline up takes, and the time
+// from reset until the first inference has finished. Steps are recorded by
+// calling Mark() as each one completes, so the duration of a step is the time
+// since the previous mark. Nothing is printed until Report() is called, so the
+// profiling doesn't slow down the startup it's measuring.
+class StartupProfiler {
+ public:
+  StartupProfiler();
+
+  // Records that the named step has just finished. The name must stay valid
+  // until Report() has been called, so string literals are the best choice.
+  void Mark(const char* step_name);
+
+  // Records that the first inference has finished, once. Returns true the
+  // first time it's called, so the caller knows when to report.
+  bool MarkFirstInference();
+
+  // Prints each step's duration and the time to first inference.
+  void Report(tflite::ErrorReporter* error_reporter) const;
+
+ private:
+  static constexpr int kMaxSteps = 16;
+  const char* step_names_[kMaxSteps];
+  int64_t step_end_times_[kMaxSteps];
+  int step_count_;
+  int64_t first_inference_time_;
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_PROFILER_H_
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "recognize_commands.h"
 
+#include <cstring>
 #include <limits>
 
 RecognizeCommands::RecognizeCommands(tflite::ErrorReporter* error_reporter,
@@ -23,18 +24,65 @@ RecognizeCommands::RecognizeCommands(tflite::ErrorReporter* error_reporter,
                                      int32_t suppression_ms,
                                      int32_t minimum_count)
     : error_reporter_(error_reporter),
-      average_window_duration_ms_(average_window_duration_ms),
+      average_window_duration_samples_(
+          static_cast<int64_t>(average_window_duration_ms) *
+          kAudioSamplesPerMs),
       detection_threshold_(detection_threshold),
-      suppression_ms_(suppression_ms),
+      suppression_samples_(static_cast<int64_t>(suppression_ms) *
+                           kAudioSamplesPerMs),
       minimum_count_(minimum_count),
-      previous_results_(error_reporter) {
+      previous_results_(error_reporter),
+      score_sums_(),
+      weight_sum_(0),
+      last_result_time_(std::numeric_limits<int64_t>::min()) {
   previous_top_label_ = "silence";
-  previous_top_label_time_ = std::numeric_limits<int32_t>::min();
+  previous_top_label_time_ = std::numeric_limits<int64_t>::min();
+}
+
+void RecognizeCommands::PushResult(const PreviousResultsQueue::Result& result) {
+  // The first result stands for one slice's worth of audio, as if the model
+  // were being run for every slice.
+  int64_t weight = kFeatureSliceStrideSamples;
+  if (last_result_time_ != std::numeric_limits<int64_t>::min()) {
+    weight = result.time_ - last_result_time_;
+  }
+  const int64_t max_weight = average_window_duration_samples_ / 4;
+  if (weight > max_weight) {
+    weight = max_weight;
+  }
+  if (weight < 1) {
+    weight = 1;
+  }
+  previous_results_.push_back(result);
+  PreviousResultsQueue::Result& pushed = previous_results_.back();
+  pushed.weight_ = static_cast<int32_t>(weight);
+  for (int i = 0; i < kCategoryCount; ++i) {
+    score_sums_[i] += pushed.scores_[i] * pushed.weight_;
+  }
+  weight_sum_ += pushed.weight_;
+  last_result_time_ = result.time_;
+}
+
+void RecognizeCommands::PopResult() {
+  const PreviousResultsQueue::Result& result = previous_results_.front();
+  for (int i = 0; i < kCategoryCount; ++i) {
+    score_sums_[i] -= result.scores_[i] * result.weight_;
+  }
+  weight_sum_ -= result.weight_;
+  previous_results_.pop_front();
 }
 
 TfLiteStatus RecognizeCommands::ProcessLatestResults(
     const TfLiteTensor* latest_results, const int32_t current_time_ms,
     const char** found_command, uint8_t* score, bool* is_new_command) {
+  return ProcessLatestResultsAtSample(
+      latest_results, static_cast<int64_t>(current_time_ms) * kAudioSamplesPerMs,
+      found_command, score, is_new_command);
+}
+
+TfLiteStatus RecognizeCommands::ProcessLatestResultsAtSample(
+    const TfLiteTensor* latest_results, const int64_t current_sample_index,
+    const char** found_command, uint8_t* score, bool* is_new_command) {
   if ((latest_results->dims->size != 2) ||
       (latest_results->dims->data[0] != 1) ||
       (latest_results->dims->data[1] != kCategoryCount)) {
@@ -53,54 +101,59 @@ TfLiteStatus RecognizeCommands::ProcessLatestResults(
     return kTfLiteError;
   }
 
-  if ((!previous_results_.empty()) &&
-      (current_time_ms < previous_results_.front().time_)) {
+  return ProcessLatestScoresAtSample(latest_results->data.uint8,
+                                     current_sample_index, found_command,
+                                     score, is_new_command);
+}
+
+TfLiteStatus RecognizeCommands::ProcessLatestScoresAtSample(
+    const uint8_t* scores, const int64_t current_sample_index,
+    const char** found_command, uint8_t* score, bool* is_new_command) {
+  if ((last_result_time_ != std::numeric_limits<int64_t>::min()) &&
+      (current_sample_index < last_result_time_)) {
+    // The error reporter can't print 64-bit values, so these are in ms.
     error_reporter_->Report(
         "Results must be fed in increasing time order, but received a "
-        "timestamp of %d that was earlier than the previous one of %d",
-        current_time_ms, previous_results_.front().time_);
+        "timestamp of %dms that was earlier than the previous one of %dms",
+        static_cast<int32_t>(current_sample_index / kAudioSamplesPerMs),
+        static_cast<int32_t>(last_result_time_ / kAudioSamplesPerMs));
     return kTfLiteError;
   }
 
-  // Add the latest results to the head of the queue.
-  previous_results_.push_back({current_time_ms, latest_results->data.uint8});
-
   // Prune any earlier results that are too old for the averaging window.
-  const int64_t time_limit = current_time_ms - average_window_duration_ms_;
+  const int64_t time_limit =
+      current_sample_index - average_window_duration_samples_;
   while ((!previous_results_.empty()) &&
          previous_results_.front().time_ < time_limit) {
-    previous_results_.pop_front();
+    PopResult();
+  }
+  // With an inference for every 20ms slice, a one second window holds one
+  // more result than the queue has room for, so the oldest makes way.
+  if (previous_results_.size() >= PreviousResultsQueue::kMaxResults) {
+    PopResult();
   }
 
+  // Add the latest results to the head of the queue.
+  PushResult({current_sample_index, scores});
+
   // If there are too few results, assume the result will be unreliable and
   // bail.
   const int64_t how_many_results = previous_results_.size();
   const int64_t earliest_time = previous_results_.front().time_;
-  const int64_t samples_duration = current_time_ms - earliest_time;
+  const int64_t samples_duration = current_sample_index - earliest_time;
   if ((how_many_results < minimum_count_) ||
-      (samples_duration < (average_window_duration_ms_ / 4))) {
+      (samples_duration < (average_window_duration_samples_ / 4))) {
     *found_command = previous_top_label_;
     *score = 0;
     *is_new_command = false;
     return kTfLiteOk;
   }
 
-  // Calculate the average score across all the results in the window.
+  // Calculate the average score across all the results in the window,
+  // weighted by how much time each one stands for.
   int32_t average_scores[kCategoryCount];
-  for (int offset = 0; offset < previous_results_.size(); ++offset) {
-    PreviousResultsQueue::Result previous_result =
-        previous_results_.from_front(offset);
-    const uint8_t* scores = previous_result.scores_;
-    for (int i = 0; i < kCategoryCount; ++i) {
-      if (offset == 0) {
-        average_scores[i] = scores[i];
-      } else {
-        average_scores[i] += scores[i];
-      }
-    }
-  }
   for (int i = 0; i < kCategoryCount; ++i) {
-    average_scores[i] /= how_many_results;
+    average_scores[i] = score_sums_[i] / weight_sum_;
   }
 
   // Find the current highest scoring category.
@@ -118,16 +171,16 @@ TfLiteStatus RecognizeCommands::ProcessLatestResults(
   // soon afterwards is a bad result.
   int64_t time_since_last_top;
   if ((previous_top_label_ == kCategoryLabels[0]) ||
-      (previous_top_label_time_ == std::numeric_limits<int32_t>::min())) {
-    time_since_last_top = std::numeric_limits<int32_t>::max();
+      (previous_top_label_time_ == std::numeric_limits<int64_t>::min())) {
+    time_since_last_top = std::numeric_limits<int64_t>::max();
   } else {
-    time_since_last_top = current_time_ms - previous_top_label_time_;
+    time_since_last_top = current_sample_index - previous_top_label_time_;
   }
   if ((current_top_score > detection_threshold_) &&
       ((current_top_label != previous_top_label_) ||
-       (time_since_last_top > suppression_ms_))) {
+       (time_since_last_top > suppression_samples_))) {
     previous_top_label_ = current_top_label;
-    previous_top_label_time_ = current_time_ms;
+    previous_top_label_time_ = current_sample_index;
     *is_new_command = true;
   } else {
     *is_new_command = false;
@@ -137,3 +190,58 @@ TfLiteStatus RecognizeCommands::ProcessLatestResults(
 
   return kTfLiteOk;
 }
+
+int RecognizeCommands::SaveState(PreviousResultsQueue::Result* results,
+                                 int* top_label_index,
+                                 int64_t* top_label_sample_index) {
+  const int results_count = previous_results_.size();
+  for (int offset = 0; offset < results_count; ++offset) {
+    results[offset] = previous_results_.from_front(offset);
+  }
+  // The label is stored as a pointer, which won't mean anything after a
+  // restart, so convert it to its category index.
+  *top_label_index = kSilenceIndex;
+  for (int i = 0; i < kCategoryCount; ++i) {
+    if (strcmp(previous_top_label_, kCategoryLabels[i]) == 0) {
+      *top_label_index = i;
+      break;
+    }
+  }
+  *top_label_sample_index = previous_top_label_time_;
+  return results_count;
+}
+
+TfLiteStatus RecognizeCommands::RestoreState(
+    const PreviousResultsQueue::Result* results, int results_count,
+    int top_label_index, int64_t top_label_sample_index) {
+  if ((results_count < 0) ||
+      (results_count > PreviousResultsQueue::kMaxResults)) {
+    error_reporter_->Report("Can't restore %d results, the limit is %d",
+                            results_count, PreviousResultsQueue::kMaxResults);
+    return kTfLiteError;
+  }
+  if ((top_label_index < 0) || (top_label_index >= kCategoryCount)) {
+    error_reporter_->Report("Bad category index %d in saved state",
+                            top_label_index);
+    return kTfLiteError;
+  }
+  for (int i = 1; i < results_count; ++i) {
+    if (results[i].time_ < results[i - 1].time_) {
+      error_reporter_->Report("Saved results must be in increasing time order");
+      return kTfLiteError;
+    }
+  }
+
+  previous_results_.clear();
+  for (int i = 0; i < kCategoryCount; ++i) {
+    score_sums_[i] = 0;
+  }
+  weight_sum_ = 0;
+  last_result_time_ = std::numeric_limits<int64_t>::min();
+  for (int i = 0; i < results_count; ++i) {
+    PushResult(results[i]);
+  }
+  previous_top_label_ = kCategoryLabels[top_label_index];
+  previous_top_label_time_ = top_label_sample_index;
+  return kTfLiteOk;
+}
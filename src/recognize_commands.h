@@ -34,16 +34,19 @@ class PreviousResultsQueue {
       : error_reporter_(error_reporter), front_index_(0), size_(0) {}
 
   // Data structure that holds an inference result, and the time when it
-  // was recorded.
+  // was recorded, as an index on the audio sample clock. The weight is how
+  // many samples of audio the result stands for in the average, which
+  // RecognizeCommands works out from the time since the result before.
   struct Result {
-    Result() : time_(0), scores_() {}
-    Result(int32_t time, uint8_t* scores) : time_(time) {
+    Result() : time_(0), scores_(), weight_(0) {}
+    Result(int64_t time, const uint8_t* scores) : time_(time), weight_(0) {
       for (int i = 0; i < kCategoryCount; ++i) {
         scores_[i] = scores[i];
       }
     }
-    int32_t time_;
+    int64_t time_;
     uint8_t scores_[kCategoryCount];
+    int32_t weight_;
   };
 
   int size() { return size_; }
@@ -96,15 +99,30 @@ class PreviousResultsQueue {
     return results_[index];
   }
 
+  void clear() {
+    front_index_ = 0;
+    size_ = 0;
+  }
+
+  static constexpr int kMaxResults = 50;
+
  private:
   tflite::ErrorReporter* error_reporter_;
-  static constexpr int kMaxResults = 50;
   Result results_[kMaxResults];
 
   int front_index_;
   int size_;
 };
 
+// The constructor arguments of RecognizeCommands, gathered together for tools
+// that try out different ones. The defaults are the constructor's.
+struct RecognizerSettings {
+  int32_t average_window_duration_ms = 1000;
+  uint8_t detection_threshold = 200;
+  int32_t suppression_ms = 1500;
+  int32_t minimum_count = 3;
+};
+
 // This class is designed to apply a very primitive decoding model on top of the
 // instantaneous results from running an audio recognition model on a single
 // window of samples. It applies smoothing over time so that noisy individual
@@ -114,7 +132,10 @@ class PreviousResultsQueue {
 // want, and then feed results from running a TensorFlow model into the
 // processing method. The timestamp for each subsequent call should be
 // increasing from the previous, since the class is designed to process a stream
-// of data over time.
+// of data over time. Results don't have to be evenly spaced: each one counts
+// towards the average in proportion to the time since the one before, up to a
+// quarter of the averaging window, so a burst of closely spaced results
+// doesn't outweigh sparser ones from earlier in the window.
 class RecognizeCommands {
  public:
   // labels should be a list of the strings associated with each one-hot score.
@@ -139,18 +160,63 @@ class RecognizeCommands {
                                     const char** found_command, uint8_t* score,
                                     bool* is_new_command);
 
+  // Same as ProcessLatestResults(), but with the time given as an index on the
+  // LatestAudioSampleIndex() clock, which is what's used internally.
+  TfLiteStatus ProcessLatestResultsAtSample(const TfLiteTensor* latest_results,
+                                            const int64_t current_sample_index,
+                                            const char** found_command,
+                                            uint8_t* score,
+                                            bool* is_new_command);
+
+  // Same as ProcessLatestResultsAtSample(), but given the kCategoryCount
+  // scores directly, for results that don't come straight from an output
+  // tensor, like an earlier one that's being reused.
+  TfLiteStatus ProcessLatestScoresAtSample(const uint8_t* scores,
+                                           const int64_t current_sample_index,
+                                           const char** found_command,
+                                           uint8_t* score,
+                                           bool* is_new_command);
+
+  // Copies the smoothing history, oldest first, into results, which must have
+  // room for PreviousResultsQueue::kMaxResults entries, and returns how many
+  // were written. The category index and sample index of the last reported
+  // command are also returned, with std::numeric_limits<int64_t>::min() if
+  // nothing has been reported yet. Together with RestoreState() this lets the
+  // averaging window survive a restart.
+  int SaveState(PreviousResultsQueue::Result* results, int* top_label_index,
+                int64_t* top_label_sample_index);
+
+  // Replaces the smoothing history and the last reported command with values
+  // captured by SaveState(). Results must be in increasing time order.
+  TfLiteStatus RestoreState(const PreviousResultsQueue::Result* results,
+                            int results_count, int top_label_index,
+                            int64_t top_label_sample_index);
+
  private:
-  // Configuration
+  // Configuration, with durations converted to audio samples.
   tflite::ErrorReporter* error_reporter_;
-  int32_t average_window_duration_ms_;
+  int64_t average_window_duration_samples_;
   uint8_t detection_threshold_;
-  int32_t suppression_ms_;
+  int64_t suppression_samples_;
   int32_t minimum_count_;
 
+  // Adds to or removes from the averaging window, keeping score_sums_ and
+  // weight_sum_ in step. PushResult() sets the result's weight.
+  void PushResult(const PreviousResultsQueue::Result& result);
+  void PopResult();
+
   // Working variables
   PreviousResultsQueue previous_results_;
+  // The weighted total of each category's scores over previous_results_, and
+  // the total of the weights, so the average doesn't have to be summed from
+  // scratch for every result.
+  int32_t score_sums_[kCategoryCount];
+  int32_t weight_sum_;
+  // When the newest result was recorded, which stays known after it has been
+  // pruned, or std::numeric_limits<int64_t>::min() before the first.
+  int64_t last_result_time_;
   const char* previous_top_label_;
-  int32_t previous_top_label_time_;
+  int64_t previous_top_label_time_;
 };
 
 #endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_RECOGNIZE_COMMANDS_H_
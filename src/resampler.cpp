@@ -0,0 +1,116 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "resampler.h"
+
+#include <cstring>
+
+namespace {
+
+// The accumulator is 64 bits because the sum of a phase's absolute
+// coefficients is about twice 1 << kResamplerCoefficientBits, so full-scale
+// input with the worst signs would overflow 32 bits before it saturates.
+int16_t ApplyPhase(const int16_t* window, const int16_t* coefficients,
+                   int taps) {
+  int64_t accumulator = 1 << (kResamplerCoefficientBits - 1);
+  for (int i = 0; i < taps; ++i) {
+    accumulator += static_cast<int32_t>(window[i]) * coefficients[i];
+  }
+  int64_t value = accumulator >> kResamplerCoefficientBits;
+  if (value > INT16_MAX) {
+    value = INT16_MAX;
+  } else if (value < INT16_MIN) {
+    value = INT16_MIN;
+  }
+  return static_cast<int16_t>(value);
+}
+
+}  // namespace
+
+PolyphaseResampler::PolyphaseResampler()
+    : input_rate_(kAudioSampleFrequency), bank_(nullptr) {
+  Reset();
+}
+
+TfLiteStatus PolyphaseResampler::Initialize(
+    tflite::ErrorReporter* error_reporter, int input_rate) {
+  const ResamplerFilterBank* bank = nullptr;
+  if (input_rate != kAudioSampleFrequency) {
+    for (int i = 0; i < g_resampler_filter_bank_count; ++i) {
+      if (g_resampler_filter_banks[i].input_rate == input_rate) {
+        bank = &g_resampler_filter_banks[i];
+        break;
+      }
+    }
+    if (bank == nullptr) {
+      error_reporter->Report("Can't resample %dHz audio to %dHz", input_rate,
+                             kAudioSampleFrequency);
+      return kTfLiteError;
+    }
+  }
+  input_rate_ = input_rate;
+  bank_ = bank;
+  Reset();
+  return kTfLiteOk;
+}
+
+void PolyphaseResampler::Reset() {
+  memset(history_, 0, sizeof(history_));
+  history_index_ = 0;
+  phase_ = 0;
+  inputs_needed_ = 1;
+}
+
+int PolyphaseResampler::MaxOutputCount(int input_count) const {
+  if (bank_ == nullptr) {
+    return input_count;
+  }
+  return ((static_cast<int64_t>(input_count) * bank_->interpolation) /
+          bank_->decimation) +
+         1;
+}
+
+int PolyphaseResampler::Process(const int16_t* input, int input_count,
+                                int16_t* output) {
+  if (bank_ == nullptr) {
+    memcpy(output, input, input_count * sizeof(int16_t));
+    return input_count;
+  }
+  const int taps = bank_->taps;
+  const int interpolation = bank_->interpolation;
+  const int decimation = bank_->decimation;
+  int output_count = 0;
+  for (int i = 0; i < input_count; ++i) {
+    history_[history_index_] = input[i];
+    history_[history_index_ + taps] = input[i];
+    ++history_index_;
+    if (history_index_ == taps) {
+      history_index_ = 0;
+    }
+    --inputs_needed_;
+    // With every supported rate there's less than one output per input, but
+    // this keeps the bookkeeping right either way.
+    while (inputs_needed_ == 0) {
+      output[output_count] =
+          ApplyPhase(history_ + history_index_,
+                     bank_->coefficients + (phase_ * taps), taps);
+      ++output_count;
+      phase_ += decimation;
+      inputs_needed_ = phase_ / interpolation;
+      phase_ %= interpolation;
+    }
+  }
+  return output_count;
+}
@@ -0,0 +1,71 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_RESAMPLER_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_RESAMPLER_H_
+
+#include <cstdint>
+
+#include "resampler_tables.h"
+#include "tensorflow/lite/c/c_api_internal.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+
+// Streams audio from a source at 32, 44.1 or 48KHz down to the
+// kAudioSampleFrequency the frontend expects, so sources like USB microphones
+// and recorded archives can be fed in directly. Audio that's already at the
+// right rate is passed through untouched.
+//
+// It's a polyphase FIR, using the banks in resampler_tables.cpp. Only the
+// output samples that are needed are ever calculated, each as a single dot
+// product of the recent input against one phase of the filter, and the history
+// is stored twice over so that product is always on contiguous memory. Blocks
+// can be any size, and the filter state carries across them.
+class PolyphaseResampler {
+ public:
+  PolyphaseResampler();
+
+  // Picks the filter bank for input_rate, and clears any history.
+  TfLiteStatus Initialize(tflite::ErrorReporter* error_reporter,
+                          int input_rate);
+
+  // Forgets the input seen so far, as though the stream were starting again.
+  void Reset();
+
+  // The most samples Process() can produce from input_count inputs, for
+  // sizing output buffers.
+  int MaxOutputCount(int input_count) const;
+
+  // Consumes input_count samples and writes the resampled audio to output,
+  // which must have room for MaxOutputCount(input_count) samples. Returns how
+  // many samples were written.
+  int Process(const int16_t* input, int input_count, int16_t* output);
+
+  int input_rate() const { return input_rate_; }
+  bool is_passthrough() const { return bank_ == nullptr; }
+
+ private:
+  int input_rate_;
+  // Null when the input is already at kAudioSampleFrequency.
+  const ResamplerFilterBank* bank_;
+  // The last taps inputs, written at both i and i + taps.
+  int16_t history_[2 * kResamplerMaxTaps];
+  int history_index_;
+  // The phase to use for the next output, and how many more inputs have to
+  // arrive before it can be calculated.
+  int phase_;
+  int inputs_needed_;
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_RESAMPLER_H_
@@ -0,0 +1,935 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// File automatically created by tools/generate_resampler_tables.cpp,
+// see that file for how to regenerate it.
+
+#include "resampler_tables.h"
+
+// The banks below resample to this rate.
+static_assert(kAudioSampleFrequency == 16000,
+              "micro_model_settings.h has changed, rerun "
+              "tools/generate_resampler_tables.cpp");
+
+namespace {
+
+const int16_t g_resampler_32000_coefficients[64] = {
+    -5, -8, 11, 16, -22, -29, 37, 47, -59, -73, 89, 107, -128, -152, 179, 211,
+    -246, -287, 334, 388, -451, -525, 612, 718, -849, -1017, 1240, 1555, -2042,
+    -2903, 4889, 14750, 14744, 4889, -2903, -2042, 1555, 1240, -1017, -849, 718,
+    612, -525, -451, 388, 334, -287, -246, 211, 179, -152, -128, 107, 89, -73,
+    -59, 47, 37, -29, -22, 16, 11, -8, -5,
+};
+
+const int16_t g_resampler_44100_coefficients[12800] = {
+    4, -7, -14, -4, 19, 26, -3, -42, -38, 23, 75, 43, -61, -117, -31, 125, 160,
+    -11, -217, -191, 97, 334, 191, -244, -471, -135, 471, 616, -19, -814, -755,
+    350, 1365, 870, -1099, -2511, -951, 3916, 9448, 11891, 9477, 3952, -929,
+    -2513, -1112, 861, 1368, 359, -750, -817, -25, 615, 474, -131, -471, -246,
+    189, 335, 99, -190, -217, -12, 159, 126, -30, -117, -62, 42, 75, 23, -38,
+    -42, -3, 26, 20, -4, -14, -7, 4, 5, 4, -7, -14, -4, 19, 26, -3, -42, -38,
+    22, 75, 43, -61, -117, -32, 124, 160, -9, -216, -192, 95, 334, 194, -241,
+    -472, -139, 468, 618, -14, -811, -759, 342, 1362, 879, -1085, -2510, -972,
+    3879, 9420, 11895, 9505, 3989, -908, -2514, -1125, 852, 1370, 367, -746,
+    -821, -31, 613, 477, -128, -471, -249, 187, 335, 101, -189, -218, -14, 159,
+    127, -29, -117, -63, 42, 76, 23, -37, -42, -4, 26, 20, -3, -14, -7, 3, 5, 4,
+    -7, -14, -4, 19, 26, -2, -42, -38, 22, 75, 44, -60, -117, -32, 124, 161, -8,
+    -215, -193, 93, 333, 196, -238, -472, -142, 465, 620, -8, -808, -763, 334,
+    1359, 888, -1072, -2508, -993, 3843, 9391, 11888, 9533, 4025, -886, -2515,
+    -1139, 843, 1373, 375, -742, -824, -36, 611, 480, -124, -471, -252, 185,
+    336, 103, -187, -219, -15, 158, 128, -28, -117, -63, 41, 76, 24, -37, -43,
+    -4, 26, 20, -3, -14, -7, 3, 5, 4, -6, -14, -4, 19, 26, -2, -42, -38, 21, 75,
+    44, -59, -117, -33, 123, 161, -7, -214, -194, 91, 333, 198, -236, -472,
+    -146, 462, 621, -3, -805, -767, 325, 1357, 896, -1058, -2506, -1014, 3807,
+    9362, 11887, 9561, 4062, -864, -2516, -1152, 834, 1375, 384, -737, -827,
+    -42, 610, 483, -120, -470, -254, 183, 336, 105, -186, -220, -17, 158, 128,
+    -27, -117, -64, 41, 76, 24, -37, -43, -4, 26, 20, -3, -14, -7, 3, 5, 4, -6,
+    -14, -4, 19, 26, -2, -41, -39, 21, 75, 45, -59, -117, -34, 122, 161, -5,
+    -213, -195, 89, 332, 200, -233, -472, -149, 459, 623, 3, -801, -771, 317,
+    1354, 905, -1045, -2505, -1035, 3770, 9334, 11885, 9589, 4099, -842, -2517,
+    -1165, 825, 1377, 392, -733, -830, -47, 608, 486, -117, -470, -257, 180,
+    337, 107, -185, -220, -18, 157, 129, -26, -117, -65, 40, 76, 25, -37, -43,
+    -4, 26, 20, -3, -14, -7, 3, 5, 4, -6, -14, -4, 19, 26, -2, -41, -39, 20, 75,
+    45, -58, -117, -35, 121, 162, -4, -213, -196, 86, 332, 202, -230, -472,
+    -153, 455, 624, 8, -798, -775, 309, 1351, 914, -1031, -2503, -1056, 3734,
+    9305, 11888, 9616, 4135, -820, -2518, -1179, 815, 1380, 400, -729, -833,
+    -53, 606, 489, -113, -469, -259, 178, 337, 109, -184, -221, -20, 157, 130,
+    -25, -116, -65, 40, 76, 25, -36, -43, -5, 26, 20, -3, -14, -7, 3, 5, 4, -6,
+    -14, -4, 19, 26, -1, -41, -39, 20, 75, 46, -57, -117, -36, 120, 162, -2,
+    -212, -198, 84, 331, 204, -227, -473, -156, 452, 626, 14, -795, -779, 300,
+    1348, 922, -1018, -2501, -1077, 3698, 9276, 11884, 9644, 4172, -798, -2518,
+    -1192, 806, 1382, 409, -724, -836, -58, 604, 492, -109, -469, -262, 176,
+    337, 111, -182, -222, -21, 156, 131, -24, -116, -66, 39, 76, 26, -36, -43,
+    -5, 26, 20, -3, -14, -7, 3, 5, 4, -6, -14, -5, 19, 27, -1, -41, -39, 19, 74,
+    46, -57, -117, -37, 120, 163, -1, -211, -199, 82, 330, 206, -225, -473,
+    -160, 449, 627, 19, -791, -783, 292, 1345, 931, -1004, -2498, -1097, 3661,
+    9246, 11889, 9671, 4209, -775, -2519, -1205, 797, 1384, 417, -720, -838,
+    -64, 602, 495, -106, -469, -265, 174, 338, 113, -181, -223, -23, 156, 131,
+    -23, -116, -67, 38, 76, 26, -36, -43, -5, 25, 20, -3, -14, -7, 3, 5, 4, -6,
+    -14, -5, 18, 27, -1, -41, -40, 19, 74, 47, -56, -117, -38, 119, 163, 1,
+    -210, -200, 80, 330, 209, -222, -473, -163, 446, 629, 25, -788, -787, 284,
+    1342, 939, -991, -2496, -1117, 3625, 9217, 11882, 9698, 4245, -753, -2519,
+    -1218, 787, 1386, 425, -715, -841, -70, 600, 498, -102, -468, -267, 171,
+    338, 116, -180, -223, -24, 155, 132, -22, -116, -67, 38, 76, 27, -36, -43,
+    -5, 25, 21, -3, -14, -7, 3, 5, 4, -6, -14, -5, 18, 27, -1, -41, -40, 18, 74,
+    47, -56, -117, -39, 118, 164, 2, -209, -201, 78, 329, 211, -219, -473, -167,
+    443, 630, 30, -784, -790, 275, 1338, 947, -977, -2493, -1138, 3589, 9188,
+    11883, 9726, 4282, -730, -2519, -1232, 778, 1388, 433, -710, -844, -75, 598,
+    501, -98, -468, -270, 169, 338, 118, -179, -224, -26, 155, 133, -21, -116,
+    -68, 37, 76, 27, -35, -44, -6, 25, 21, -2, -14, -7, 3, 5, 4, -6, -14, -5,
+    18, 27, 0, -40, -40, 18, 74, 48, -55, -117, -40, 117, 164, 4, -208, -202,
+    76, 329, 213, -216, -473, -170, 439, 632, 36, -781, -794, 267, 1335, 956,
+    -964, -2491, -1158, 3553, 9158, 11874, 9753, 4319, -707, -2519, -1245, 768,
+    1390, 442, -706, -847, -81, 596, 504, -94, -467, -272, 167, 339, 120, -177,
+    -225, -27, 154, 134, -20, -116, -68, 37, 76, 27, -35, -44, -6, 25, 21, -2,
+    -14, -8, 3, 5, 4, -6, -14, -5, 18, 27, 0, -40, -40, 18, 74, 48, -54, -117,
+    -41, 116, 164, 5, -207, -203, 74, 328, 215, -214, -473, -174, 436, 633, 41,
+    -777, -798, 259, 1332, 964, -950, -2488, -1178, 3517, 9128, 11879, 9779,
+    4355, -684, -2519, -1258, 759, 1392, 450, -701, -850, -87, 594, 507, -91,
+    -467, -275, 164, 339, 122, -176, -225, -29, 153, 134, -19, -116, -69, 36,
+    76, 28, -35, -44, -6, 25, 21, -2, -14, -8, 3, 5, 4, -6, -14, -5, 18, 27, 0,
+    -40, -40, 17, 74, 49, -54, -117, -42, 115, 165, 7, -207, -204, 72, 327, 217,
+    -211, -473, -177, 433, 634, 47, -774, -801, 250, 1328, 972, -936, -2485,
+    -1197, 3481, 9098, 11873, 9806, 4392, -661, -2519, -1271, 749, 1394, 458,
+    -696, -852, -92, 592, 510, -87, -466, -277, 162, 339, 124, -175, -226, -30,
+    153, 135, -18, -116, -70, 36, 77, 28, -35, -44, -7, 25, 21, -2, -14, -8, 3,
+    5, 4, -6, -14, -5, 18, 27, 0, -40, -41, 17, 74, 49, -53, -117, -42, 115,
+    165, 8, -206, -205, 70, 327, 219, -208, -473, -181, 429, 635, 52, -770,
+    -805, 242, 1325, 980, -923, -2482, -1217, 3445, 9068, 11872, 9833, 4429,
+    -638, -2519, -1284, 739, 1396, 466, -692, -855, -98, 590, 512, -83, -465,
+    -280, 160, 339, 126, -174, -227, -32, 152, 136, -17, -115, -70, 35, 77, 29,
+    -34, -44, -7, 25, 21, -2, -14, -8, 3, 5, 4, -6, -14, -5, 18, 27, 1, -40,
+    -41, 16, 73, 49, -52, -117, -43, 114, 165, 9, -205, -206, 68, 326, 221,
+    -205, -473, -184, 426, 637, 58, -766, -809, 234, 1321, 988, -909, -2479,
+    -1236, 3409, 9038, 11866, 9859, 4466, -614, -2518, -1297, 729, 1398, 475,
+    -687, -858, -104, 587, 515, -79, -465, -283, 157, 340, 128, -172, -227, -33,
+    152, 136, -16, -115, -71, 35, 77, 29, -34, -44, -7, 25, 21, -2, -14, -8, 3,
+    6, 4, -6, -14, -5, 17, 27, 1, -39, -41, 16, 73, 50, -51, -117, -44, 113,
+    166, 11, -204, -207, 66, 325, 223, -203, -473, -188, 423, 638, 63, -763,
+    -812, 226, 1318, 996, -896, -2476, -1256, 3373, 9008, 11863, 9886, 4503,
+    -591, -2518, -1310, 720, 1399, 483, -682, -860, -109, 585, 518, -76, -464,
+    -285, 155, 340, 130, -171, -228, -35, 151, 137, -15, -115, -72, 34, 77, 30,
+    -34, -44, -7, 25, 21, -2, -14, -8, 3, 6, 4, -6, -14, -6, 17, 27, 1, -39,
+    -41, 15, 73, 50, -51, -117, -45, 112, 166, 12, -203, -208, 63, 324, 225,
+    -200, -472, -191, 419, 639, 68, -759, -816, 217, 1314, 1004, -882, -2473,
+    -1275, 3337, 8978, 11864, 9912, 4539, -567, -2517, -1323, 710, 1401, 491,
+    -677, -863, -115, 583, 521, -72, -463, -288, 153, 340, 132, -170, -228, -36,
+    150, 138, -14, -115, -72, 33, 77, 30, -34, -44, -8, 25, 22, -1, -14, -8, 3,
+    6, 4, -5, -14, -6, 17, 27, 1, -39, -41, 15, 73, 51, -50, -117, -46, 111,
+    166, 14, -202, -209, 61, 324, 227, -197, -472, -195, 416, 640, 74, -755,
+    -819, 209, 1311, 1011, -868, -2470, -1294, 3301, 8948, 11855, 9938, 4576,
+    -543, -2516, -1336, 700, 1402, 499, -672, -865, -120, 581, 523, -68, -463,
+    -290, 150, 340, 134, -168, -229, -38, 150, 139, -13, -115, -73, 33, 77, 31,
+    -33, -45, -8, 25, 22, -1, -14, -8, 3, 6, 4, -5, -14, -6, 17, 27, 2, -39,
+    -42, 14, 73, 51, -49, -117, -47, 110, 167, 15, -201, -210, 59, 323, 229,
+    -194, -472, -198, 413, 641, 79, -752, -822, 201, 1307, 1019, -855, -2466,
+    -1313, 3265, 8917, 11855, 9964, 4613, -519, -2516, -1349, 690, 1404, 508,
+    -667, -868, -126, 578, 526, -64, -462, -293, 148, 341, 136, -167, -230, -39,
+    149, 139, -12, -115, -73, 32, 77, 31, -33, -45, -8, 24, 22, -1, -14, -8, 3,
+    6, 4, -5, -14, -6, 17, 27, 2, -39, -42, 14, 73, 52, -49, -117, -48, 109,
+    167, 17, -200, -211, 57, 322, 231, -192, -472, -201, 409, 642, 84, -748,
+    -826, 192, 1303, 1027, -841, -2462, -1332, 3230, 8886, 11852, 9989, 4650,
+    -495, -2514, -1362, 679, 1405, 516, -662, -870, -132, 576, 529, -60, -461,
+    -295, 145, 341, 138, -166, -230, -41, 149, 140, -11, -114, -74, 32, 77, 31,
+    -33, -45, -8, 24, 22, -1, -14, -8, 3, 6, 4, -5, -14, -6, 17, 27, 2, -39,
+    -42, 14, 72, 52, -48, -117, -49, 108, 167, 18, -199, -211, 55, 321, 232,
+    -189, -472, -205, 406, 643, 90, -744, -829, 184, 1299, 1034, -827, -2459,
+    -1350, 3194, 8856, 11848, 10015, 4687, -471, -2513, -1375, 669, 1406, 524,
+    -657, -872, -137, 574, 531, -56, -461, -297, 143, 341, 140, -164, -231, -42,
+    148, 141, -10, -114, -75, 31, 77, 32, -32, -45, -9, 24, 22, -1, -14, -8, 3,
+    6, 4, -5, -14, -6, 17, 27, 2, -38, -42, 13, 72, 53, -47, -117, -49, 108,
+    167, 19, -198, -212, 53, 321, 234, -186, -471, -208, 402, 644, 95, -740,
+    -832, 176, 1295, 1042, -814, -2455, -1369, 3158, 8825, 11845, 10040, 4724,
+    -447, -2512, -1388, 659, 1408, 532, -652, -875, -143, 571, 534, -53, -460,
+    -300, 140, 341, 142, -163, -231, -44, 147, 141, -9, -114, -75, 31, 77, 32,
+    -32, -45, -9, 24, 22, -1, -14, -8, 3, 6, 4, -5, -14, -6, 16, 27, 3, -38,
+    -42, 13, 72, 53, -47, -117, -50, 107, 168, 21, -197, -213, 51, 320, 236,
+    -183, -471, -211, 399, 645, 101, -736, -835, 168, 1291, 1049, -800, -2451,
+    -1387, 3123, 8794, 11832, 10066, 4761, -422, -2510, -1400, 649, 1409, 540,
+    -646, -877, -149, 569, 537, -49, -459, -302, 138, 341, 144, -161, -232, -45,
+    147, 142, -9, -114, -76, 30, 77, 33, -32, -45, -9, 24, 22, -1, -14, -8, 3,
+    6, 4, -5, -14, -6, 16, 27, 3, -38, -42, 12, 72, 54, -46, -117, -51, 106,
+    168, 22, -196, -214, 49, 319, 238, -180, -471, -215, 395, 646, 106, -732,
+    -838, 159, 1287, 1057, -786, -2447, -1405, 3087, 8763, 11831, 10091, 4798,
+    -398, -2509, -1413, 638, 1410, 549, -641, -879, -154, 566, 539, -45, -458,
+    -305, 136, 341, 146, -160, -232, -47, 146, 143, -8, -113, -76, 29, 77, 33,
+    -32, -45, -9, 24, 22, 0, -14, -8, 2, 6, 4, -5, -14, -7, 16, 27, 3, -38, -43,
+    12, 72, 54, -45, -117, -52, 105, 168, 24, -195, -215, 47, 318, 240, -177,
+    -471, -218, 392, 647, 111, -728, -841, 151, 1283, 1064, -772, -2443, -1423,
+    3052, 8732, 11829, 10116, 4834, -373, -2507, -1426, 628, 1411, 557, -636,
+    -882, -160, 564, 542, -41, -457, -307, 133, 341, 148, -159, -233, -48, 145,
+    143, -7, -113, -77, 29, 77, 34, -31, -45, -10, 24, 22, 0, -14, -9, 2, 6, 4,
+    -5, -14, -7, 16, 27, 3, -38, -43, 11, 71, 54, -45, -117, -53, 104, 169, 25,
+    -194, -216, 45, 317, 242, -175, -470, -221, 388, 648, 116, -724, -845, 143,
+    1279, 1071, -759, -2438, -1441, 3016, 8700, 11828, 10141, 4871, -348, -2505,
+    -1438, 618, 1412, 565, -631, -884, -166, 561, 544, -37, -456, -310, 131,
+    341, 150, -157, -233, -50, 145, 144, -6, -113, -77, 28, 77, 34, -31, -46,
+    -10, 24, 23, 0, -14, -9, 2, 6, 5, -5, -14, -7, 16, 27, 4, -37, -43, 11, 71,
+    55, -44, -117, -54, 103, 169, 26, -193, -217, 43, 316, 244, -172, -470,
+    -224, 385, 649, 122, -720, -847, 134, 1275, 1078, -745, -2434, -1459, 2981,
+    8669, 11816, 10165, 4908, -323, -2503, -1451, 607, 1413, 573, -625, -886,
+    -171, 559, 547, -33, -455, -312, 128, 341, 152, -156, -234, -51, 144, 145,
+    -5, -113, -78, 28, 77, 35, -31, -46, -10, 24, 23, 0, -14, -9, 2, 6, 5, -5,
+    -14, -7, 16, 27, 4, -37, -43, 10, 71, 55, -43, -117, -54, 102, 169, 28,
+    -192, -218, 40, 315, 245, -169, -469, -228, 381, 649, 127, -716, -850, 126,
+    1270, 1085, -731, -2429, -1476, 2945, 8638, 11817, 10190, 4945, -298, -2501,
+    -1464, 597, 1413, 581, -620, -888, -177, 556, 549, -29, -455, -314, 126,
+    341, 154, -154, -234, -53, 143, 145, -4, -113, -79, 27, 77, 35, -30, -46,
+    -11, 24, 23, 0, -14, -9, 2, 6, 5, -5, -14, -7, 16, 27, 4, -37, -43, 10, 71,
+    56, -43, -117, -55, 101, 169, 29, -191, -218, 38, 314, 247, -166, -469,
+    -231, 378, 650, 132, -712, -853, 118, 1266, 1092, -718, -2425, -1494, 2910,
+    8606, 11814, 10214, 4982, -273, -2499, -1476, 586, 1414, 589, -615, -890,
+    -183, 554, 552, -26, -454, -317, 123, 341, 156, -153, -235, -54, 142, 146,
+    -3, -112, -79, 27, 77, 35, -30, -46, -11, 23, 23, 0, -14, -9, 2, 6, 5, -5,
+    -14, -7, 15, 27, 4, -37, -43, 9, 71, 56, -42, -116, -56, 100, 169, 31, -190,
+    -219, 36, 313, 249, -163, -469, -234, 374, 651, 137, -708, -856, 110, 1262,
+    1099, -704, -2420, -1511, 2875, 8574, 11805, 10239, 5019, -247, -2496,
+    -1489, 575, 1415, 597, -609, -892, -188, 551, 554, -22, -453, -319, 121,
+    341, 158, -151, -235, -56, 142, 146, -2, -112, -80, 26, 77, 36, -30, -46,
+    -11, 23, 23, 0, -14, -9, 2, 6, 5, -4, -14, -7, 15, 27, 5, -37, -44, 9, 70,
+    56, -41, -116, -57, 99, 170, 32, -189, -220, 34, 313, 251, -160, -468, -237,
+    370, 651, 143, -704, -859, 102, 1257, 1106, -690, -2415, -1528, 2840, 8543,
+    11798, 10263, 5056, -222, -2494, -1501, 565, 1415, 605, -604, -894, -194,
+    548, 557, -18, -452, -321, 118, 341, 160, -150, -236, -57, 141, 147, -1,
+    -112, -80, 25, 77, 36, -30, -46, -11, 23, 23, 0, -14, -9, 2, 6, 5, -4, -14,
+    -7, 15, 28, 5, -36, -44, 9, 70, 57, -41, -116, -58, 98, 170, 33, -188, -221,
+    32, 312, 252, -158, -468, -240, 367, 652, 148, -700, -862, 93, 1253, 1113,
+    -677, -2410, -1545, 2805, 8511, 11790, 10287, 5093, -196, -2491, -1514, 554,
+    1416, 613, -598, -896, -200, 546, 559, -14, -451, -324, 115, 341, 162, -148,
+    -236, -59, 140, 148, 1, -112, -81, 25, 77, 37, -29, -46, -12, 23, 23, 1,
+    -14, -9, 2, 6, 5, -4, -14, -7, 15, 28, 5, -36, -44, 8, 70, 57, -40, -116,
+    -59, 98, 170, 35, -187, -222, 30, 311, 254, -155, -467, -244, 363, 653, 153,
+    -695, -864, 85, 1248, 1120, -663, -2405, -1562, 2770, 8479, 11781, 10311,
+    5130, -170, -2488, -1526, 543, 1416, 621, -592, -898, -205, 543, 561, -10,
+    -449, -326, 113, 341, 164, -147, -237, -60, 139, 148, 2, -111, -82, 24, 77,
+    37, -29, -46, -12, 23, 23, 1, -14, -9, 2, 6, 5, -4, -14, -7, 15, 28, 5, -36,
+    -44, 8, 70, 58, -39, -116, -59, 97, 170, 36, -186, -222, 28, 310, 256, -152,
+    -467, -247, 360, 653, 158, -691, -867, 77, 1244, 1126, -649, -2400, -1579,
+    2735, 8447, 11770, 10334, 5167, -145, -2485, -1538, 532, 1417, 629, -587,
+    -900, -211, 540, 564, -6, -448, -328, 110, 341, 166, -145, -237, -61, 139,
+    149, 3, -111, -82, 24, 77, 38, -29, -46, -12, 23, 23, 1, -14, -9, 2, 6, 5,
+    -4, -14, -8, 15, 28, 6, -36, -44, 7, 69, 58, -38, -116, -60, 96, 170, 38,
+    -185, -223, 26, 309, 258, -149, -466, -250, 356, 654, 163, -687, -870, 69,
+    1239, 1133, -636, -2395, -1595, 2700, 8414, 11770, 10358, 5204, -119, -2482,
+    -1551, 521, 1417, 637, -581, -901, -217, 537, 566, -2, -447, -331, 108, 341,
+    168, -144, -238, -63, 138, 149, 4, -111, -83, 23, 77, 38, -28, -46, -13, 23,
+    23, 1, -14, -9, 2, 6, 5, -4, -14, -8, 15, 28, 6, -35, -44, 7, 69, 58, -38,
+    -116, -61, 95, 170, 39, -184, -224, 24, 308, 259, -146, -466, -253, 352,
+    654, 168, -683, -872, 61, 1234, 1139, -622, -2389, -1612, 2665, 8382, 11762,
+    10381, 5241, -92, -2479, -1563, 510, 1417, 645, -575, -903, -222, 534, 568,
+    2, -446, -333, 105, 341, 170, -142, -238, -64, 137, 150, 5, -110, -83, 22,
+    77, 38, -28, -46, -13, 23, 24, 1, -14, -9, 2, 6, 5, -4, -14, -8, 14, 28, 6,
+    -35, -44, 6, 69, 59, -37, -116, -62, 94, 171, 40, -183, -224, 22, 307, 261,
+    -143, -465, -256, 349, 655, 174, -678, -875, 53, 1230, 1146, -608, -2384,
+    -1628, 2630, 8350, 11751, 10404, 5278, -66, -2476, -1575, 499, 1418, 653,
+    -570, -905, -228, 531, 571, 6, -445, -335, 103, 341, 172, -141, -238, -66,
+    136, 151, 6, -110, -84, 22, 77, 39, -28, -47, -13, 22, 24, 1, -14, -9, 2, 6,
+    5, -4, -14, -8, 14, 28, 6, -35, -45, 6, 69, 59, -36, -115, -62, 93, 171, 42,
+    -181, -225, 20, 305, 263, -140, -464, -259, 345, 655, 179, -674, -877, 44,
+    1225, 1152, -594, -2378, -1644, 2595, 8317, 11743, 10427, 5314, -40, -2472,
+    -1587, 488, 1418, 661, -564, -907, -234, 529, 573, 10, -444, -337, 100, 341,
+    174, -139, -239, -67, 136, 151, 7, -110, -84, 21, 77, 39, -27, -47, -13, 22,
+    24, 1, -14, -9, 2, 6, 5, -4, -14, -8, 14, 28, 7, -35, -45, 5, 68, 60, -36,
+    -115, -63, 92, 171, 43, -180, -226, 18, 304, 264, -137, -464, -262, 341,
+    655, 184, -670, -879, 36, 1220, 1158, -581, -2372, -1660, 2561, 8285, 11739,
+    10450, 5351, -13, -2468, -1599, 477, 1418, 669, -558, -908, -239, 526, 575,
+    14, -443, -340, 97, 340, 176, -138, -239, -69, 135, 152, 8, -110, -85, 20,
+    77, 40, -27, -47, -14, 22, 24, 2, -14, -9, 2, 6, 5, -4, -14, -8, 14, 28, 7,
+    -35, -45, 5, 68, 60, -35, -115, -64, 91, 171, 44, -179, -227, 15, 303, 266,
+    -135, -463, -265, 338, 656, 189, -665, -882, 28, 1215, 1165, -567, -2367,
+    -1676, 2526, 8252, 11732, 10473, 5388, 13, -2465, -1612, 466, 1418, 677,
+    -552, -910, -245, 523, 577, 18, -441, -342, 95, 340, 177, -136, -239, -70,
+    134, 152, 9, -109, -85, 20, 77, 40, -27, -47, -14, 22, 24, 2, -13, -10, 2,
+    6, 5, -4, -14, -8, 14, 28, 7, -34, -45, 5, 68, 60, -34, -115, -65, 90, 171,
+    46, -178, -227, 13, 302, 267, -132, -462, -268, 334, 656, 194, -661, -884,
+    20, 1210, 1171, -553, -2361, -1692, 2491, 8219, 11725, 10495, 5425, 40,
+    -2461, -1624, 454, 1417, 685, -546, -911, -251, 520, 579, 22, -440, -344,
+    92, 340, 179, -134, -240, -72, 133, 153, 10, -109, -86, 19, 77, 41, -26,
+    -47, -14, 22, 24, 2, -13, -10, 2, 6, 5, -4, -14, -8, 14, 28, 7, -34, -45, 4,
+    68, 61, -34, -115, -66, 89, 171, 47, -177, -228, 11, 301, 269, -129, -462,
+    -271, 330, 656, 199, -656, -886, 12, 1205, 1177, -540, -2355, -1707, 2457,
+    8186, 11716, 10518, 5462, 67, -2457, -1636, 443, 1417, 693, -540, -913,
+    -256, 517, 582, 26, -439, -346, 90, 340, 181, -133, -240, -73, 132, 153, 11,
+    -109, -86, 19, 77, 41, -26, -47, -14, 22, 24, 2, -13, -10, 1, 6, 5, -4, -13,
+    -8, 14, 28, 8, -34, -45, 4, 67, 61, -33, -115, -66, 88, 171, 48, -176, -229,
+    9, 300, 271, -126, -461, -274, 327, 657, 204, -652, -888, 4, 1200, 1183,
+    -526, -2348, -1722, 2423, 8153, 11702, 10540, 5499, 94, -2452, -1647, 432,
+    1417, 701, -534, -914, -262, 513, 584, 30, -438, -348, 87, 340, 183, -131,
+    -240, -75, 131, 154, 12, -108, -87, 18, 77, 41, -26, -47, -15, 22, 24, 2,
+    -13, -10, 1, 6, 5, -4, -13, -8, 13, 28, 8, -34, -45, 3, 67, 61, -32, -114,
+    -67, 87, 171, 50, -175, -229, 7, 299, 272, -123, -460, -277, 323, 657, 209,
+    -647, -891, -4, 1195, 1189, -512, -2342, -1738, 2388, 8120, 11698, 10562,
+    5536, 121, -2448, -1659, 420, 1417, 708, -528, -916, -268, 510, 586, 34,
+    -436, -351, 84, 339, 185, -130, -241, -76, 131, 154, 13, -108, -87, 17, 77,
+    42, -25, -47, -15, 22, 24, 2, -13, -10, 1, 6, 5, -3, -13, -9, 13, 28, 8,
+    -33, -45, 3, 67, 62, -32, -114, -68, 86, 171, 51, -174, -230, 5, 298, 274,
+    -120, -459, -280, 319, 657, 214, -643, -893, -12, 1190, 1195, -499, -2336,
+    -1753, 2354, 8087, 11689, 10584, 5572, 148, -2444, -1671, 409, 1416, 716,
+    -522, -917, -273, 507, 588, 38, -435, -353, 82, 339, 187, -128, -241, -78,
+    130, 155, 14, -108, -88, 17, 77, 42, -25, -47, -15, 21, 24, 3, -13, -10, 1,
+    6, 5, -3, -13, -9, 13, 28, 8, -33, -46, 2, 67, 62, -31, -114, -69, 85, 172,
+    52, -172, -230, 3, 297, 275, -117, -459, -283, 315, 657, 219, -638, -895,
+    -20, 1184, 1200, -485, -2330, -1768, 2320, 8054, 11680, 10606, 5609, 176,
+    -2439, -1683, 397, 1416, 724, -516, -918, -279, 504, 590, 42, -433, -355,
+    79, 339, 189, -126, -241, -79, 129, 155, 15, -107, -89, 16, 77, 43, -25,
+    -47, -16, 21, 24, 3, -13, -10, 1, 6, 5, -3, -13, -9, 13, 28, 8, -33, -46, 2,
+    66, 62, -30, -114, -69, 84, 172, 54, -171, -231, 1, 295, 277, -114, -458,
+    -286, 311, 657, 224, -634, -897, -28, 1179, 1206, -472, -2323, -1782, 2286,
+    8021, 11672, 10627, 5646, 203, -2434, -1695, 386, 1415, 732, -510, -920,
+    -284, 501, 592, 46, -432, -357, 76, 338, 191, -125, -242, -81, 128, 156, 16,
+    -107, -89, 15, 77, 43, -24, -47, -16, 21, 25, 3, -13, -10, 1, 6, 5, -3, -13,
+    -9, 13, 28, 9, -33, -46, 2, 66, 63, -29, -114, -70, 83, 172, 55, -170, -232,
+    -1, 294, 278, -111, -457, -289, 308, 657, 229, -629, -899, -36, 1174, 1212,
+    -458, -2316, -1797, 2252, 7987, 11658, 10649, 5683, 231, -2429, -1706, 374,
+    1415, 739, -504, -921, -290, 498, 594, 50, -431, -359, 74, 338, 193, -123,
+    -242, -82, 127, 156, 17, -106, -90, 15, 76, 43, -24, -47, -16, 21, 25, 3,
+    -13, -10, 1, 6, 5, -3, -13, -9, 13, 28, 9, -33, -46, 1, 66, 63, -29, -113,
+    -71, 82, 172, 56, -169, -232, -3, 293, 280, -108, -456, -292, 304, 657, 234,
+    -624, -901, -44, 1168, 1217, -444, -2310, -1811, 2218, 7954, 11649, 10670,
+    5720, 259, -2424, -1718, 363, 1414, 747, -498, -922, -296, 494, 596, 54,
+    -429, -361, 71, 338, 194, -121, -242, -84, 126, 157, 18, -106, -90, 14, 76,
+    44, -24, -47, -16, 21, 25, 3, -13, -10, 1, 6, 5, -3, -13, -9, 13, 28, 9,
+    -32, -46, 1, 66, 64, -28, -113, -72, 81, 172, 58, -168, -233, -5, 292, 281,
+    -106, -455, -294, 300, 657, 238, -620, -902, -52, 1163, 1223, -431, -2303,
+    -1826, 2184, 7920, 11641, 10691, 5756, 286, -2419, -1729, 351, 1413, 755,
+    -491, -923, -301, 491, 598, 58, -428, -363, 68, 337, 196, -120, -242, -85,
+    125, 157, 19, -106, -91, 14, 76, 44, -23, -47, -17, 21, 25, 3, -13, -10, 1,
+    6, 5, -3, -13, -9, 12, 28, 9, -32, -46, 0, 65, 64, -27, -113, -72, 80, 172,
+    59, -166, -233, -7, 291, 283, -103, -454, -297, 296, 657, 243, -615, -904,
+    -60, 1157, 1228, -417, -2296, -1840, 2150, 7887, 11631, 10712, 5793, 314,
+    -2414, -1741, 339, 1412, 762, -485, -924, -307, 488, 600, 62, -426, -365,
+    65, 337, 198, -118, -243, -87, 124, 158, 20, -105, -91, 13, 76, 45, -23,
+    -47, -17, 21, 25, 3, -13, -10, 1, 6, 5, -3, -13, -9, 12, 28, 10, -32, -46,
+    0, 65, 64, -27, -113, -73, 79, 172, 60, -165, -234, -9, 289, 284, -100,
+    -453, -300, 292, 657, 248, -610, -906, -68, 1152, 1233, -404, -2289, -1854,
+    2116, 7853, 11625, 10733, 5830, 342, -2408, -1752, 327, 1411, 770, -479,
+    -925, -312, 484, 601, 66, -425, -367, 63, 336, 200, -116, -243, -88, 124,
+    158, 21, -105, -92, 12, 76, 45, -23, -48, -17, 20, 25, 4, -13, -10, 1, 6, 5,
+    -3, -13, -9, 12, 28, 10, -32, -46, -1, 65, 64, -26, -112, -74, 78, 172, 61,
+    -164, -234, -11, 288, 285, -97, -452, -303, 289, 657, 253, -606, -908, -76,
+    1146, 1239, -390, -2282, -1868, 2083, 7819, 11612, 10753, 5866, 371, -2403,
+    -1764, 315, 1410, 778, -472, -926, -318, 481, 603, 70, -423, -369, 60, 336,
+    202, -115, -243, -90, 123, 159, 22, -105, -92, 12, 76, 46, -22, -48, -17,
+    20, 25, 4, -13, -10, 1, 6, 5, -3, -13, -9, 12, 28, 10, -31, -46, -1, 64, 65,
+    -25, -112, -74, 77, 172, 63, -163, -235, -13, 287, 287, -94, -451, -306,
+    285, 657, 258, -601, -909, -84, 1141, 1244, -377, -2275, -1882, 2049, 7785,
+    11599, 10774, 5903, 399, -2397, -1775, 304, 1409, 785, -466, -927, -324,
+    478, 605, 74, -422, -371, 57, 336, 204, -113, -243, -91, 122, 159, 23, -104,
+    -93, 11, 76, 46, -22, -48, -18, 20, 25, 4, -13, -10, 1, 6, 5, -3, -13, -10,
+    12, 28, 10, -31, -46, -2, 64, 65, -25, -112, -75, 76, 172, 64, -162, -235,
+    -15, 286, 288, -91, -450, -308, 281, 657, 263, -596, -911, -91, 1135, 1249,
+    -363, -2267, -1895, 2015, 7751, 11587, 10794, 5940, 427, -2391, -1786, 292,
+    1408, 793, -459, -928, -329, 474, 607, 78, -420, -373, 55, 335, 206, -111,
+    -243, -92, 121, 160, 24, -104, -93, 10, 76, 46, -22, -48, -18, 20, 25, 4,
+    -13, -11, 1, 6, 5, -3, -13, -10, 12, 28, 10, -31, -47, -2, 64, 65, -24,
+    -112, -76, 75, 172, 65, -160, -236, -17, 284, 290, -88, -449, -311, 277,
+    657, 267, -591, -913, -99, 1129, 1254, -350, -2260, -1909, 1982, 7717,
+    11581, 10814, 5976, 456, -2385, -1798, 280, 1407, 800, -453, -929, -335,
+    471, 609, 82, -418, -375, 52, 335, 207, -110, -243, -94, 120, 160, 25, -103,
+    -94, 10, 76, 47, -21, -48, -18, 20, 25, 4, -13, -11, 1, 6, 5, -3, -13, -10,
+    11, 28, 11, -31, -47, -2, 64, 66, -23, -111, -77, 74, 172, 66, -159, -236,
+    -19, 283, 291, -85, -448, -314, 273, 657, 272, -587, -914, -107, 1124, 1259,
+    -336, -2253, -1922, 1949, 7683, 11570, 10834, 6013, 485, -2379, -1809, 268,
+    1405, 808, -447, -930, -340, 467, 610, 86, -417, -377, 49, 334, 209, -108,
+    -244, -95, 119, 161, 26, -103, -94, 9, 76, 47, -21, -48, -19, 20, 25, 4,
+    -13, -11, 1, 6, 5, -2, -13, -10, 11, 28, 11, -30, -47, -3, 63, 66, -22,
+    -111, -77, 73, 172, 68, -158, -237, -21, 282, 292, -82, -447, -316, 269,
+    656, 277, -582, -915, -115, 1118, 1264, -323, -2245, -1935, 1915, 7649,
+    11557, 10854, 6049, 513, -2372, -1820, 256, 1404, 815, -440, -930, -346,
+    464, 612, 90, -415, -379, 46, 334, 211, -106, -244, -97, 118, 161, 27, -102,
+    -94, 8, 75, 48, -21, -48, -19, 19, 25, 4, -13, -11, 1, 6, 5, -2, -13, -10,
+    11, 28, 11, -30, -47, -3, 63, 66, -22, -111, -78, 72, 172, 69, -157, -237,
+    -23, 280, 294, -79, -446, -319, 265, 656, 281, -577, -917, -123, 1112, 1268,
+    -309, -2237, -1948, 1882, 7615, 11544, 10873, 6086, 542, -2366, -1831, 244,
+    1403, 823, -433, -931, -351, 460, 614, 94, -413, -381, 44, 333, 213, -104,
+    -244, -98, 117, 161, 28, -102, -95, 8, 75, 48, -20, -48, -19, 19, 26, 5,
+    -13, -11, 0, 6, 5, -2, -13, -10, 11, 28, 11, -30, -47, -4, 63, 67, -21,
+    -111, -79, 71, 171, 70, -155, -238, -25, 279, 295, -76, -445, -322, 262,
+    656, 286, -572, -918, -130, 1106, 1273, -296, -2230, -1961, 1849, 7581,
+    11537, 10893, 6123, 571, -2359, -1842, 231, 1401, 830, -427, -932, -357,
+    456, 615, 98, -412, -383, 41, 333, 214, -103, -244, -100, 116, 162, 29,
+    -102, -95, 7, 75, 48, -20, -48, -19, 19, 26, 5, -13, -11, 0, 6, 5, -2, -13,
+    -10, 11, 28, 12, -30, -47, -4, 62, 67, -20, -110, -79, 70, 171, 72, -154,
+    -238, -27, 278, 296, -74, -444, -324, 258, 655, 291, -567, -920, -138, 1100,
+    1278, -282, -2222, -1974, 1816, 7546, 11521, 10912, 6159, 600, -2352, -1853,
+    219, 1399, 838, -420, -932, -362, 453, 617, 102, -410, -385, 38, 332, 216,
+    -101, -244, -101, 115, 162, 30, -101, -96, 6, 75, 49, -19, -48, -20, 19, 26,
+    5, -13, -11, 0, 6, 5, -2, -13, -10, 11, 27, 12, -29, -47, -4, 62, 67, -20,
+    -110, -80, 69, 171, 73, -153, -238, -29, 276, 297, -71, -443, -327, 254,
+    655, 295, -562, -921, -146, 1094, 1282, -269, -2214, -1986, 1783, 7512,
+    11514, 10931, 6195, 630, -2346, -1864, 207, 1398, 845, -414, -933, -368,
+    449, 618, 106, -408, -387, 35, 331, 218, -99, -244, -103, 114, 163, 31,
+    -101, -96, 6, 75, 49, -19, -48, -20, 19, 26, 5, -13, -11, 0, 6, 5, -2, -13,
+    -10, 11, 27, 12, -29, -47, -5, 62, 68, -19, -110, -81, 68, 171, 74, -152,
+    -239, -31, 275, 299, -68, -442, -330, 250, 655, 300, -557, -922, -154, 1088,
+    1287, -256, -2206, -1998, 1750, 7477, 11498, 10950, 6232, 659, -2338, -1874,
+    195, 1396, 852, -407, -934, -373, 446, 620, 110, -406, -389, 32, 331, 220,
+    -97, -244, -104, 113, 163, 32, -100, -97, 5, 75, 49, -19, -48, -20, 19, 26,
+    5, -13, -11, 0, 6, 5, -2, -13, -10, 10, 27, 12, -29, -47, -5, 61, 68, -18,
+    -110, -81, 67, 171, 75, -150, -239, -33, 273, 300, -65, -441, -332, 246,
+    654, 305, -552, -923, -161, 1082, 1291, -242, -2198, -2011, 1717, 7443,
+    11486, 10969, 6268, 688, -2331, -1885, 183, 1394, 860, -400, -934, -379,
+    442, 621, 114, -405, -390, 30, 330, 221, -96, -244, -105, 112, 163, 33,
+    -100, -97, 4, 75, 50, -18, -48, -20, 18, 26, 5, -12, -11, 0, 6, 5, -2, -13,
+    -10, 10, 27, 12, -29, -47, -6, 61, 68, -18, -109, -82, 66, 171, 76, -149,
+    -239, -35, 272, 301, -62, -439, -335, 242, 654, 309, -547, -924, -169, 1076,
+    1296, -229, -2190, -2023, 1685, 7408, 11473, 10987, 6305, 718, -2324, -1896,
+    170, 1392, 867, -393, -935, -384, 438, 623, 118, -403, -392, 27, 330, 223,
+    -94, -244, -107, 111, 164, 34, -99, -98, 4, 75, 50, -18, -48, -21, 18, 26,
+    6, -12, -11, 0, 6, 5, -2, -13, -10, 10, 27, 13, -28, -47, -6, 61, 68, -17,
+    -109, -83, 65, 171, 78, -148, -240, -37, 271, 302, -59, -438, -337, 238,
+    653, 314, -542, -925, -177, 1070, 1300, -216, -2181, -2035, 1652, 7373,
+    11459, 11006, 6341, 748, -2316, -1906, 158, 1390, 874, -387, -935, -390,
+    434, 624, 122, -401, -394, 24, 329, 225, -92, -244, -108, 110, 164, 35, -99,
+    -98, 3, 74, 51, -18, -48, -21, 18, 26, 6, -12, -11, 0, 6, 5, -2, -13, -11,
+    10, 27, 13, -28, -47, -7, 61, 69, -16, -109, -83, 64, 171, 79, -146, -240,
+    -39, 269, 303, -56, -437, -340, 234, 653, 318, -537, -926, -184, 1064, 1304,
+    -202, -2173, -2047, 1620, 7338, 11445, 11024, 6377, 777, -2309, -1917, 145,
+    1388, 882, -380, -935, -395, 431, 626, 126, -399, -396, 21, 328, 227, -90,
+    -244, -110, 109, 164, 37, -98, -99, 2, 74, 51, -17, -48, -21, 18, 26, 6,
+    -12, -11, 0, 6, 5, -2, -13, -11, 10, 27, 13, -28, -47, -7, 60, 69, -15,
+    -108, -84, 63, 171, 80, -145, -240, -41, 268, 304, -53, -436, -342, 230,
+    652, 323, -532, -927, -192, 1057, 1308, -189, -2164, -2058, 1587, 7303,
+    11434, 11042, 6413, 807, -2301, -1927, 133, 1386, 889, -373, -936, -401,
+    427, 627, 130, -397, -398, 18, 328, 228, -89, -244, -111, 108, 165, 38, -98,
+    -99, 2, 74, 51, -17, -48, -22, 18, 26, 6, -12, -11, 0, 6, 5, -2, -12, -11,
+    10, 27, 13, -28, -47, -7, 60, 69, -15, -108, -84, 62, 171, 81, -144, -241,
+    -43, 266, 306, -50, -434, -345, 226, 651, 327, -527, -928, -199, 1051, 1312,
+    -176, -2156, -2070, 1555, 7269, 11417, 11060, 6449, 837, -2293, -1938, 120,
+    1384, 896, -366, -936, -406, 423, 629, 134, -395, -399, 16, 327, 230, -87,
+    -244, -112, 107, 165, 39, -97, -99, 1, 74, 52, -17, -48, -22, 18, 26, 6,
+    -12, -11, 0, 6, 5, -2, -12, -11, 9, 27, 13, -27, -48, -8, 60, 69, -14, -108,
+    -85, 61, 170, 82, -143, -241, -45, 265, 307, -47, -433, -347, 222, 651, 332,
+    -522, -929, -207, 1045, 1316, -163, -2147, -2081, 1522, 7234, 11408, 11077,
+    6486, 867, -2285, -1948, 108, 1382, 903, -359, -936, -412, 419, 630, 138,
+    -393, -401, 13, 326, 232, -85, -244, -114, 106, 165, 40, -97, -100, 0, 74,
+    52, -16, -48, -22, 17, 26, 6, -12, -11, 0, 6, 5, -2, -12, -11, 9, 27, 14,
+    -27, -48, -8, 59, 70, -13, -107, -86, 60, 170, 84, -141, -241, -47, 263,
+    308, -45, -432, -350, 218, 650, 336, -517, -930, -214, 1038, 1320, -150,
+    -2139, -2092, 1490, 7198, 11394, 11095, 6522, 897, -2277, -1958, 95, 1379,
+    910, -352, -936, -417, 415, 631, 142, -391, -403, 10, 325, 233, -83, -244,
+    -115, 105, 166, 41, -96, -100, 0, 74, 53, -16, -48, -22, 17, 26, 6, -12,
+    -11, 0, 6, 6, -2, -12, -11, 9, 27, 14, -27, -48, -9, 59, 70, -13, -107, -86,
+    59, 170, 85, -140, -242, -49, 262, 309, -42, -430, -352, 214, 649, 340,
+    -512, -931, -222, 1032, 1324, -136, -2130, -2103, 1458, 7163, 11377, 11112,
+    6558, 928, -2268, -1968, 83, 1377, 917, -345, -936, -422, 411, 633, 146,
+    -389, -404, 7, 325, 235, -81, -244, -117, 104, 166, 42, -96, -101, -1, 73,
+    53, -15, -48, -23, 17, 26, 7, -12, -11, 0, 6, 6, -1, -12, -11, 9, 27, 14,
+    -27, -48, -9, 59, 70, -12, -107, -87, 58, 170, 86, -139, -242, -51, 260,
+    310, -39, -429, -354, 210, 649, 345, -507, -931, -229, 1025, 1327, -123,
+    -2121, -2114, 1426, 7128, 11365, 11129, 6594, 958, -2260, -1978, 70, 1374,
+    924, -338, -936, -428, 407, 634, 150, -387, -406, 4, 324, 237, -79, -244,
+    -118, 103, 166, 43, -95, -101, -2, 73, 53, -15, -48, -23, 17, 26, 7, -12,
+    -12, 0, 6, 6, -1, -12, -11, 9, 27, 14, -26, -48, -9, 58, 70, -11, -106, -88,
+    57, 170, 87, -137, -242, -53, 259, 311, -36, -428, -357, 206, 648, 349,
+    -502, -932, -237, 1019, 1331, -110, -2112, -2125, 1394, 7093, 11349, 11146,
+    6630, 989, -2251, -1988, 57, 1372, 931, -331, -936, -433, 403, 635, 154,
+    -385, -408, 1, 323, 238, -78, -244, -119, 102, 167, 44, -95, -102, -2, 73,
+    54, -15, -48, -23, 17, 27, 7, -12, -12, 0, 6, 6, -1, -12, -11, 9, 27, 14,
+    -26, -48, -10, 58, 71, -11, -106, -88, 56, 170, 88, -136, -242, -55, 257,
+    312, -33, -426, -359, 202, 647, 353, -496, -933, -244, 1012, 1335, -97,
+    -2103, -2135, 1363, 7058, 11332, 11163, 6666, 1019, -2242, -1998, 45, 1369,
+    938, -324, -936, -439, 399, 636, 158, -383, -409, -1, 322, 240, -76, -244,
+    -121, 101, 167, 45, -94, -102, -3, 73, 54, -14, -48, -23, 17, 27, 7, -12,
+    -12, -1, 6, 6, -1, -12, -11, 9, 27, 15, -26, -48, -10, 58, 71, -10, -106,
+    -89, 55, 169, 89, -135, -243, -57, 256, 313, -30, -425, -361, 198, 646, 358,
+    -491, -933, -252, 1006, 1338, -84, -2094, -2146, 1331, 7022, 11323, 11179,
+    6702, 1050, -2233, -2008, 32, 1366, 945, -317, -936, -444, 395, 637, 162,
+    -381, -411, -4, 321, 242, -74, -244, -122, 100, 167, 46, -94, -102, -4, 73,
+    54, -14, -48, -24, 16, 27, 7, -12, -12, -1, 6, 6, -1, -12, -11, 8, 27, 15,
+    -26, -48, -11, 57, 71, -9, -105, -89, 54, 169, 91, -133, -243, -59, 254,
+    314, -27, -423, -364, 194, 645, 362, -486, -934, -259, 999, 1342, -71,
+    -2085, -2156, 1299, 6987, 11309, 11196, 6737, 1081, -2224, -2018, 19, 1363,
+    952, -310, -936, -449, 391, 638, 166, -379, -413, -7, 321, 243, -72, -244,
+    -124, 98, 167, 47, -93, -103, -4, 73, 55, -13, -48, -24, 16, 27, 7, -12,
+    -12, -1, 6, 6, -1, -12, -11, 8, 27, 15, -25, -48, -11, 57, 71, -9, -105,
+    -90, 53, 169, 92, -132, -243, -61, 253, 315, -24, -422, -366, 190, 644, 366,
+    -481, -934, -266, 993, 1345, -58, -2075, -2166, 1268, 6951, 11291, 11212,
+    6773, 1112, -2215, -2028, 6, 1361, 959, -302, -936, -455, 387, 640, 170,
+    -377, -414, -10, 320, 245, -70, -244, -125, 97, 168, 48, -93, -103, -5, 72,
+    55, -13, -48, -24, 16, 27, 7, -12, -12, -1, 6, 6, -1, -12, -11, 8, 27, 15,
+    -25, -48, -11, 56, 71, -8, -105, -90, 52, 169, 93, -130, -243, -63, 251,
+    316, -21, -420, -368, 186, 644, 370, -476, -935, -274, 986, 1348, -45,
+    -2066, -2176, 1236, 6916, 11274, 11228, 6809, 1143, -2206, -2037, -6, 1358,
+    966, -295, -936, -460, 383, 641, 174, -375, -416, -13, 319, 247, -68, -244,
+    -126, 96, 168, 49, -92, -103, -6, 72, 55, -13, -48, -24, 16, 27, 8, -12,
+    -12, -1, 6, 6, -1, -12, -11, 8, 27, 15, -25, -48, -12, 56, 72, -7, -104,
+    -91, 51, 169, 94, -129, -243, -64, 250, 317, -19, -419, -370, 182, 643, 375,
+    -470, -935, -281, 979, 1351, -32, -2057, -2186, 1205, 6880, 11255, 11244,
+    6845, 1174, -2196, -2047, -19, 1355, 972, -288, -935, -465, 379, 642, 178,
+    -372, -417, -16, 318, 248, -66, -243, -128, 95, 168, 50, -92, -104, -6, 72,
+    56, -12, -48, -25, 16, 27, 8, -12, -12, -1, 6, 6, -1, -12, -12, 8, 27, 16,
+    -25, -48, -12, 56, 72, -6, -104, -92, 50, 168, 95, -128, -243, -66, 248,
+    318, -16, -417, -372, 178, 642, 379, -465, -935, -288, 972, 1355, -19,
+    -2047, -2196, 1174, 6845, 11244, 11255, 6880, 1205, -2186, -2057, -32, 1351,
+    979, -281, -935, -470, 375, 643, 182, -370, -419, -19, 317, 250, -64, -243,
+    -129, 94, 169, 51, -91, -104, -7, 72, 56, -12, -48, -25, 15, 27, 8, -11,
+    -12, -1, 6, 6, -1, -12, -12, 8, 27, 16, -24, -48, -13, 55, 72, -6, -103,
+    -92, 49, 168, 96, -126, -244, -68, 247, 319, -13, -416, -375, 174, 641, 383,
+    -460, -936, -295, 966, 1358, -6, -2037, -2206, 1143, 6809, 11228, 11274,
+    6916, 1236, -2176, -2066, -45, 1348, 986, -274, -935, -476, 370, 644, 186,
+    -368, -420, -21, 316, 251, -63, -243, -130, 93, 169, 52, -90, -105, -8, 71,
+    56, -11, -48, -25, 15, 27, 8, -11, -12, -1, 6, 6, -1, -12, -12, 7, 27, 16,
+    -24, -48, -13, 55, 72, -5, -103, -93, 48, 168, 97, -125, -244, -70, 245,
+    320, -10, -414, -377, 170, 640, 387, -455, -936, -302, 959, 1361, 6, -2028,
+    -2215, 1112, 6773, 11212, 11291, 6951, 1268, -2166, -2075, -58, 1345, 993,
+    -266, -934, -481, 366, 644, 190, -366, -422, -24, 315, 253, -61, -243, -132,
+    92, 169, 53, -90, -105, -9, 71, 57, -11, -48, -25, 15, 27, 8, -11, -12, -1,
+    6, 6, -1, -12, -12, 7, 27, 16, -24, -48, -13, 55, 73, -4, -103, -93, 47,
+    167, 98, -124, -244, -72, 243, 321, -7, -413, -379, 166, 638, 391, -449,
+    -936, -310, 952, 1363, 19, -2018, -2224, 1081, 6737, 11196, 11309, 6987,
+    1299, -2156, -2085, -71, 1342, 999, -259, -934, -486, 362, 645, 194, -364,
+    -423, -27, 314, 254, -59, -243, -133, 91, 169, 54, -89, -105, -9, 71, 57,
+    -11, -48, -26, 15, 27, 8, -11, -12, -1, 6, 6, -1, -12, -12, 7, 27, 16, -24,
+    -48, -14, 54, 73, -4, -102, -94, 46, 167, 100, -122, -244, -74, 242, 321,
+    -4, -411, -381, 162, 637, 395, -444, -936, -317, 945, 1366, 32, -2008,
+    -2233, 1050, 6702, 11179, 11323, 7022, 1331, -2146, -2094, -84, 1338, 1006,
+    -252, -933, -491, 358, 646, 198, -361, -425, -30, 313, 256, -57, -243, -135,
+    89, 169, 55, -89, -106, -10, 71, 58, -10, -48, -26, 15, 27, 9, -11, -12, -1,
+    6, 6, -1, -12, -12, 7, 27, 17, -23, -48, -14, 54, 73, -3, -102, -94, 45,
+    167, 101, -121, -244, -76, 240, 322, -1, -409, -383, 158, 636, 399, -439,
+    -936, -324, 938, 1369, 45, -1998, -2242, 1019, 6666, 11163, 11332, 7058,
+    1363, -2135, -2103, -97, 1335, 1012, -244, -933, -496, 353, 647, 202, -359,
+    -426, -33, 312, 257, -55, -242, -136, 88, 170, 56, -88, -106, -11, 71, 58,
+    -10, -48, -26, 14, 27, 9, -11, -12, -1, 6, 6, 0, -12, -12, 7, 27, 17, -23,
+    -48, -15, 54, 73, -2, -102, -95, 44, 167, 102, -119, -244, -78, 238, 323, 1,
+    -408, -385, 154, 635, 403, -433, -936, -331, 931, 1372, 57, -1988, -2251,
+    989, 6630, 11146, 11349, 7093, 1394, -2125, -2112, -110, 1331, 1019, -237,
+    -932, -502, 349, 648, 206, -357, -428, -36, 311, 259, -53, -242, -137, 87,
+    170, 57, -88, -106, -11, 70, 58, -9, -48, -26, 14, 27, 9, -11, -12, -1, 6,
+    6, 0, -12, -12, 7, 26, 17, -23, -48, -15, 53, 73, -2, -101, -95, 43, 166,
+    103, -118, -244, -79, 237, 324, 4, -406, -387, 150, 634, 407, -428, -936,
+    -338, 924, 1374, 70, -1978, -2260, 958, 6594, 11129, 11365, 7128, 1426,
+    -2114, -2121, -123, 1327, 1025, -229, -931, -507, 345, 649, 210, -354, -429,
+    -39, 310, 260, -51, -242, -139, 86, 170, 58, -87, -107, -12, 70, 59, -9,
+    -48, -27, 14, 27, 9, -11, -12, -1, 6, 6, 0, -11, -12, 7, 26, 17, -23, -48,
+    -15, 53, 73, -1, -101, -96, 42, 166, 104, -117, -244, -81, 235, 325, 7,
+    -404, -389, 146, 633, 411, -422, -936, -345, 917, 1377, 83, -1968, -2268,
+    928, 6558, 11112, 11377, 7163, 1458, -2103, -2130, -136, 1324, 1032, -222,
+    -931, -512, 340, 649, 214, -352, -430, -42, 309, 262, -49, -242, -140, 85,
+    170, 59, -86, -107, -13, 70, 59, -9, -48, -27, 14, 27, 9, -11, -12, -2, 6,
+    6, 0, -11, -12, 6, 26, 17, -22, -48, -16, 53, 74, 0, -100, -96, 41, 166,
+    105, -115, -244, -83, 233, 325, 10, -403, -391, 142, 631, 415, -417, -936,
+    -352, 910, 1379, 95, -1958, -2277, 897, 6522, 11095, 11394, 7198, 1490,
+    -2092, -2139, -150, 1320, 1038, -214, -930, -517, 336, 650, 218, -350, -432,
+    -45, 308, 263, -47, -241, -141, 84, 170, 60, -86, -107, -13, 70, 59, -8,
+    -48, -27, 14, 27, 9, -11, -12, -2, 5, 6, 0, -11, -12, 6, 26, 17, -22, -48,
+    -16, 52, 74, 0, -100, -97, 40, 165, 106, -114, -244, -85, 232, 326, 13,
+    -401, -393, 138, 630, 419, -412, -936, -359, 903, 1382, 108, -1948, -2285,
+    867, 6486, 11077, 11408, 7234, 1522, -2081, -2147, -163, 1316, 1045, -207,
+    -929, -522, 332, 651, 222, -347, -433, -47, 307, 265, -45, -241, -143, 82,
+    170, 61, -85, -108, -14, 69, 60, -8, -48, -27, 13, 27, 9, -11, -12, -2, 5,
+    6, 0, -11, -12, 6, 26, 18, -22, -48, -17, 52, 74, 1, -99, -97, 39, 165, 107,
+    -112, -244, -87, 230, 327, 16, -399, -395, 134, 629, 423, -406, -936, -366,
+    896, 1384, 120, -1938, -2293, 837, 6449, 11060, 11417, 7269, 1555, -2070,
+    -2156, -176, 1312, 1051, -199, -928, -527, 327, 651, 226, -345, -434, -50,
+    306, 266, -43, -241, -144, 81, 171, 62, -84, -108, -15, 69, 60, -7, -47,
+    -28, 13, 27, 10, -11, -12, -2, 5, 6, 0, -11, -12, 6, 26, 18, -22, -48, -17,
+    51, 74, 2, -99, -98, 38, 165, 108, -111, -244, -89, 228, 328, 18, -398,
+    -397, 130, 627, 427, -401, -936, -373, 889, 1386, 133, -1927, -2301, 807,
+    6413, 11042, 11434, 7303, 1587, -2058, -2164, -189, 1308, 1057, -192, -927,
+    -532, 323, 652, 230, -342, -436, -53, 304, 268, -41, -240, -145, 80, 171,
+    63, -84, -108, -15, 69, 60, -7, -47, -28, 13, 27, 10, -11, -13, -2, 5, 6, 0,
+    -11, -12, 6, 26, 18, -21, -48, -17, 51, 74, 2, -99, -98, 37, 164, 109, -110,
+    -244, -90, 227, 328, 21, -396, -399, 126, 626, 431, -395, -935, -380, 882,
+    1388, 145, -1917, -2309, 777, 6377, 11024, 11445, 7338, 1620, -2047, -2173,
+    -202, 1304, 1064, -184, -926, -537, 318, 653, 234, -340, -437, -56, 303,
+    269, -39, -240, -146, 79, 171, 64, -83, -109, -16, 69, 61, -7, -47, -28, 13,
+    27, 10, -11, -13, -2, 5, 6, 0, -11, -12, 6, 26, 18, -21, -48, -18, 51, 74,
+    3, -98, -99, 35, 164, 110, -108, -244, -92, 225, 329, 24, -394, -401, 122,
+    624, 434, -390, -935, -387, 874, 1390, 158, -1906, -2316, 748, 6341, 11006,
+    11459, 7373, 1652, -2035, -2181, -216, 1300, 1070, -177, -925, -542, 314,
+    653, 238, -337, -438, -59, 302, 271, -37, -240, -148, 78, 171, 65, -83,
+    -109, -17, 68, 61, -6, -47, -28, 13, 27, 10, -10, -13, -2, 5, 6, 0, -11,
+    -12, 6, 26, 18, -21, -48, -18, 50, 75, 4, -98, -99, 34, 164, 111, -107,
+    -244, -94, 223, 330, 27, -392, -403, 118, 623, 438, -384, -935, -393, 867,
+    1392, 170, -1896, -2324, 718, 6305, 10987, 11473, 7408, 1685, -2023, -2190,
+    -229, 1296, 1076, -169, -924, -547, 309, 654, 242, -335, -439, -62, 301,
+    272, -35, -239, -149, 76, 171, 66, -82, -109, -18, 68, 61, -6, -47, -29, 12,
+    27, 10, -10, -13, -2, 5, 6, 0, -11, -12, 5, 26, 18, -20, -48, -18, 50, 75,
+    4, -97, -100, 33, 163, 112, -105, -244, -96, 221, 330, 30, -390, -405, 114,
+    621, 442, -379, -934, -400, 860, 1394, 183, -1885, -2331, 688, 6268, 10969,
+    11486, 7443, 1717, -2011, -2198, -242, 1291, 1082, -161, -923, -552, 305,
+    654, 246, -332, -441, -65, 300, 273, -33, -239, -150, 75, 171, 67, -81,
+    -110, -18, 68, 61, -5, -47, -29, 12, 27, 10, -10, -13, -2, 5, 6, 0, -11,
+    -13, 5, 26, 19, -20, -48, -19, 49, 75, 5, -97, -100, 32, 163, 113, -104,
+    -244, -97, 220, 331, 32, -389, -406, 110, 620, 446, -373, -934, -407, 852,
+    1396, 195, -1874, -2338, 659, 6232, 10950, 11498, 7477, 1750, -1998, -2206,
+    -256, 1287, 1088, -154, -922, -557, 300, 655, 250, -330, -442, -68, 299,
+    275, -31, -239, -152, 74, 171, 68, -81, -110, -19, 68, 62, -5, -47, -29, 12,
+    27, 11, -10, -13, -2, 5, 6, 0, -11, -13, 5, 26, 19, -20, -48, -19, 49, 75,
+    6, -96, -101, 31, 163, 114, -103, -244, -99, 218, 331, 35, -387, -408, 106,
+    618, 449, -368, -933, -414, 845, 1398, 207, -1864, -2346, 630, 6195, 10931,
+    11514, 7512, 1783, -1986, -2214, -269, 1282, 1094, -146, -921, -562, 295,
+    655, 254, -327, -443, -71, 297, 276, -29, -238, -153, 73, 171, 69, -80,
+    -110, -20, 67, 62, -4, -47, -29, 12, 27, 11, -10, -13, -2, 5, 6, 0, -11,
+    -13, 5, 26, 19, -20, -48, -19, 49, 75, 6, -96, -101, 30, 162, 115, -101,
+    -244, -101, 216, 332, 38, -385, -410, 102, 617, 453, -362, -932, -420, 838,
+    1399, 219, -1853, -2352, 600, 6159, 10912, 11521, 7546, 1816, -1974, -2222,
+    -282, 1278, 1100, -138, -920, -567, 291, 655, 258, -324, -444, -74, 296,
+    278, -27, -238, -154, 72, 171, 70, -79, -110, -20, 67, 62, -4, -47, -30, 12,
+    28, 11, -10, -13, -2, 5, 6, 0, -11, -13, 5, 26, 19, -19, -48, -20, 48, 75,
+    7, -95, -102, 29, 162, 116, -100, -244, -103, 214, 333, 41, -383, -412, 98,
+    615, 456, -357, -932, -427, 830, 1401, 231, -1842, -2359, 571, 6123, 10893,
+    11537, 7581, 1849, -1961, -2230, -296, 1273, 1106, -130, -918, -572, 286,
+    656, 262, -322, -445, -76, 295, 279, -25, -238, -155, 70, 171, 71, -79,
+    -111, -21, 67, 63, -4, -47, -30, 11, 28, 11, -10, -13, -2, 5, 6, 0, -11,
+    -13, 5, 26, 19, -19, -48, -20, 48, 75, 8, -95, -102, 28, 161, 117, -98,
+    -244, -104, 213, 333, 44, -381, -413, 94, 614, 460, -351, -931, -433, 823,
+    1403, 244, -1831, -2366, 542, 6086, 10873, 11544, 7615, 1882, -1948, -2237,
+    -309, 1268, 1112, -123, -917, -577, 281, 656, 265, -319, -446, -79, 294,
+    280, -23, -237, -157, 69, 172, 72, -78, -111, -22, 66, 63, -3, -47, -30, 11,
+    28, 11, -10, -13, -2, 5, 6, 1, -11, -13, 4, 25, 19, -19, -48, -21, 48, 75,
+    8, -94, -102, 27, 161, 118, -97, -244, -106, 211, 334, 46, -379, -415, 90,
+    612, 464, -346, -930, -440, 815, 1404, 256, -1820, -2372, 513, 6049, 10854,
+    11557, 7649, 1915, -1935, -2245, -323, 1264, 1118, -115, -915, -582, 277,
+    656, 269, -316, -447, -82, 292, 282, -21, -237, -158, 68, 172, 73, -77,
+    -111, -22, 66, 63, -3, -47, -30, 11, 28, 11, -10, -13, -2, 5, 6, 1, -11,
+    -13, 4, 25, 20, -19, -48, -21, 47, 76, 9, -94, -103, 26, 161, 119, -95,
+    -244, -108, 209, 334, 49, -377, -417, 86, 610, 467, -340, -930, -447, 808,
+    1405, 268, -1809, -2379, 485, 6013, 10834, 11570, 7683, 1949, -1922, -2253,
+    -336, 1259, 1124, -107, -914, -587, 272, 657, 273, -314, -448, -85, 291,
+    283, -19, -236, -159, 66, 172, 74, -77, -111, -23, 66, 64, -2, -47, -31, 11,
+    28, 11, -10, -13, -3, 5, 6, 1, -11, -13, 4, 25, 20, -18, -48, -21, 47, 76,
+    10, -94, -103, 25, 160, 120, -94, -243, -110, 207, 335, 52, -375, -418, 82,
+    609, 471, -335, -929, -453, 800, 1407, 280, -1798, -2385, 456, 5976, 10814,
+    11581, 7717, 1982, -1909, -2260, -350, 1254, 1129, -99, -913, -591, 267,
+    657, 277, -311, -449, -88, 290, 284, -17, -236, -160, 65, 172, 75, -76,
+    -112, -24, 65, 64, -2, -47, -31, 10, 28, 12, -10, -13, -3, 5, 6, 1, -11,
+    -13, 4, 25, 20, -18, -48, -22, 46, 76, 10, -93, -104, 24, 160, 121, -92,
+    -243, -111, 206, 335, 55, -373, -420, 78, 607, 474, -329, -928, -459, 793,
+    1408, 292, -1786, -2391, 427, 5940, 10794, 11587, 7751, 2015, -1895, -2267,
+    -363, 1249, 1135, -91, -911, -596, 263, 657, 281, -308, -450, -91, 288, 286,
+    -15, -235, -162, 64, 172, 76, -75, -112, -25, 65, 64, -2, -46, -31, 10, 28,
+    12, -10, -13, -3, 5, 6, 1, -10, -13, 4, 25, 20, -18, -48, -22, 46, 76, 11,
+    -93, -104, 23, 159, 122, -91, -243, -113, 204, 336, 57, -371, -422, 74, 605,
+    478, -324, -927, -466, 785, 1409, 304, -1775, -2397, 399, 5903, 10774,
+    11599, 7785, 2049, -1882, -2275, -377, 1244, 1141, -84, -909, -601, 258,
+    657, 285, -306, -451, -94, 287, 287, -13, -235, -163, 63, 172, 77, -74,
+    -112, -25, 65, 64, -1, -46, -31, 10, 28, 12, -9, -13, -3, 5, 6, 1, -10, -13,
+    4, 25, 20, -17, -48, -22, 46, 76, 12, -92, -105, 22, 159, 123, -90, -243,
+    -115, 202, 336, 60, -369, -423, 70, 603, 481, -318, -926, -472, 778, 1410,
+    315, -1764, -2403, 371, 5866, 10753, 11612, 7819, 2083, -1868, -2282, -390,
+    1239, 1146, -76, -908, -606, 253, 657, 289, -303, -452, -97, 285, 288, -11,
+    -234, -164, 61, 172, 78, -74, -112, -26, 64, 65, -1, -46, -32, 10, 28, 12,
+    -9, -13, -3, 5, 6, 1, -10, -13, 4, 25, 20, -17, -48, -23, 45, 76, 12, -92,
+    -105, 21, 158, 124, -88, -243, -116, 200, 336, 63, -367, -425, 66, 601, 484,
+    -312, -925, -479, 770, 1411, 327, -1752, -2408, 342, 5830, 10733, 11625,
+    7853, 2116, -1854, -2289, -404, 1233, 1152, -68, -906, -610, 248, 657, 292,
+    -300, -453, -100, 284, 289, -9, -234, -165, 60, 172, 79, -73, -113, -27, 64,
+    65, 0, -46, -32, 10, 28, 12, -9, -13, -3, 5, 6, 1, -10, -13, 3, 25, 21, -17,
+    -47, -23, 45, 76, 13, -91, -105, 20, 158, 124, -87, -243, -118, 198, 337,
+    65, -365, -426, 62, 600, 488, -307, -924, -485, 762, 1412, 339, -1741,
+    -2414, 314, 5793, 10712, 11631, 7887, 2150, -1840, -2296, -417, 1228, 1157,
+    -60, -904, -615, 243, 657, 296, -297, -454, -103, 283, 291, -7, -233, -166,
+    59, 172, 80, -72, -113, -27, 64, 65, 0, -46, -32, 9, 28, 12, -9, -13, -3, 5,
+    6, 1, -10, -13, 3, 25, 21, -17, -47, -23, 44, 76, 14, -91, -106, 19, 157,
+    125, -85, -242, -120, 196, 337, 68, -363, -428, 58, 598, 491, -301, -923,
+    -491, 755, 1413, 351, -1729, -2419, 286, 5756, 10691, 11641, 7920, 2184,
+    -1826, -2303, -431, 1223, 1163, -52, -902, -620, 238, 657, 300, -294, -455,
+    -106, 281, 292, -5, -233, -168, 58, 172, 81, -72, -113, -28, 64, 66, 1, -46,
+    -32, 9, 28, 13, -9, -13, -3, 5, 6, 1, -10, -13, 3, 25, 21, -16, -47, -24,
+    44, 76, 14, -90, -106, 18, 157, 126, -84, -242, -121, 194, 338, 71, -361,
+    -429, 54, 596, 494, -296, -922, -498, 747, 1414, 363, -1718, -2424, 259,
+    5720, 10670, 11649, 7954, 2218, -1811, -2310, -444, 1217, 1168, -44, -901,
+    -624, 234, 657, 304, -292, -456, -108, 280, 293, -3, -232, -169, 56, 172,
+    82, -71, -113, -29, 63, 66, 1, -46, -33, 9, 28, 13, -9, -13, -3, 5, 6, 1,
+    -10, -13, 3, 25, 21, -16, -47, -24, 43, 76, 15, -90, -106, 17, 156, 127,
+    -82, -242, -123, 193, 338, 74, -359, -431, 50, 594, 498, -290, -921, -504,
+    739, 1415, 374, -1706, -2429, 231, 5683, 10649, 11658, 7987, 2252, -1797,
+    -2316, -458, 1212, 1174, -36, -899, -629, 229, 657, 308, -289, -457, -111,
+    278, 294, -1, -232, -170, 55, 172, 83, -70, -114, -29, 63, 66, 2, -46, -33,
+    9, 28, 13, -9, -13, -3, 5, 6, 1, -10, -13, 3, 25, 21, -16, -47, -24, 43, 77,
+    15, -89, -107, 16, 156, 128, -81, -242, -125, 191, 338, 76, -357, -432, 46,
+    592, 501, -284, -920, -510, 732, 1415, 386, -1695, -2434, 203, 5646, 10627,
+    11672, 8021, 2286, -1782, -2323, -472, 1206, 1179, -28, -897, -634, 224,
+    657, 311, -286, -458, -114, 277, 295, 1, -231, -171, 54, 172, 84, -69, -114,
+    -30, 62, 66, 2, -46, -33, 8, 28, 13, -9, -13, -3, 5, 6, 1, -10, -13, 3, 24,
+    21, -16, -47, -25, 43, 77, 16, -89, -107, 15, 155, 129, -79, -241, -126,
+    189, 339, 79, -355, -433, 42, 590, 504, -279, -918, -516, 724, 1416, 397,
+    -1683, -2439, 176, 5609, 10606, 11680, 8054, 2320, -1768, -2330, -485, 1200,
+    1184, -20, -895, -638, 219, 657, 315, -283, -459, -117, 275, 297, 3, -230,
+    -172, 52, 172, 85, -69, -114, -31, 62, 67, 2, -46, -33, 8, 28, 13, -9, -13,
+    -3, 5, 6, 1, -10, -13, 3, 24, 21, -15, -47, -25, 42, 77, 17, -88, -108, 14,
+    155, 130, -78, -241, -128, 187, 339, 82, -353, -435, 38, 588, 507, -273,
+    -917, -522, 716, 1416, 409, -1671, -2444, 148, 5572, 10584, 11689, 8087,
+    2354, -1753, -2336, -499, 1195, 1190, -12, -893, -643, 214, 657, 319, -280,
+    -459, -120, 274, 298, 5, -230, -174, 51, 171, 86, -68, -114, -32, 62, 67, 3,
+    -45, -33, 8, 28, 13, -9, -13, -3, 5, 6, 1, -10, -13, 2, 24, 22, -15, -47,
+    -25, 42, 77, 17, -87, -108, 13, 154, 131, -76, -241, -130, 185, 339, 84,
+    -351, -436, 34, 586, 510, -268, -916, -528, 708, 1417, 420, -1659, -2448,
+    121, 5536, 10562, 11698, 8120, 2388, -1738, -2342, -512, 1189, 1195, -4,
+    -891, -647, 209, 657, 323, -277, -460, -123, 272, 299, 7, -229, -175, 50,
+    171, 87, -67, -114, -32, 61, 67, 3, -45, -34, 8, 28, 13, -8, -13, -4, 5, 6,
+    1, -10, -13, 2, 24, 22, -15, -47, -26, 41, 77, 18, -87, -108, 12, 154, 131,
+    -75, -240, -131, 183, 340, 87, -348, -438, 30, 584, 513, -262, -914, -534,
+    701, 1417, 432, -1647, -2452, 94, 5499, 10540, 11702, 8153, 2423, -1722,
+    -2348, -526, 1183, 1200, 4, -888, -652, 204, 657, 327, -274, -461, -126,
+    271, 300, 9, -229, -176, 48, 171, 88, -66, -115, -33, 61, 67, 4, -45, -34,
+    8, 28, 14, -8, -13, -4, 5, 6, 1, -10, -13, 2, 24, 22, -14, -47, -26, 41, 77,
+    19, -86, -109, 11, 153, 132, -73, -240, -133, 181, 340, 90, -346, -439, 26,
+    582, 517, -256, -913, -540, 693, 1417, 443, -1636, -2457, 67, 5462, 10518,
+    11716, 8186, 2457, -1707, -2355, -540, 1177, 1205, 12, -886, -656, 199, 656,
+    330, -271, -462, -129, 269, 301, 11, -228, -177, 47, 171, 89, -66, -115,
+    -34, 61, 68, 4, -45, -34, 7, 28, 14, -8, -14, -4, 5, 6, 2, -10, -13, 2, 24,
+    22, -14, -47, -26, 41, 77, 19, -86, -109, 10, 153, 133, -72, -240, -134,
+    179, 340, 92, -344, -440, 22, 579, 520, -251, -911, -546, 685, 1417, 454,
+    -1624, -2461, 40, 5425, 10495, 11725, 8219, 2491, -1692, -2361, -553, 1171,
+    1210, 20, -884, -661, 194, 656, 334, -268, -462, -132, 267, 302, 13, -227,
+    -178, 46, 171, 90, -65, -115, -34, 60, 68, 5, -45, -34, 7, 28, 14, -8, -14,
+    -4, 5, 6, 2, -10, -13, 2, 24, 22, -14, -47, -27, 40, 77, 20, -85, -109, 9,
+    152, 134, -70, -239, -136, 177, 340, 95, -342, -441, 18, 577, 523, -245,
+    -910, -552, 677, 1418, 466, -1612, -2465, 13, 5388, 10473, 11732, 8252,
+    2526, -1676, -2367, -567, 1165, 1215, 28, -882, -665, 189, 656, 338, -265,
+    -463, -135, 266, 303, 15, -227, -179, 44, 171, 91, -64, -115, -35, 60, 68,
+    5, -45, -35, 7, 28, 14, -8, -14, -4, 5, 6, 2, -9, -14, 2, 24, 22, -14, -47,
+    -27, 40, 77, 20, -85, -110, 8, 152, 135, -69, -239, -138, 176, 340, 97,
+    -340, -443, 14, 575, 526, -239, -908, -558, 669, 1418, 477, -1599, -2468,
+    -13, 5351, 10450, 11739, 8285, 2561, -1660, -2372, -581, 1158, 1220, 36,
+    -879, -670, 184, 655, 341, -262, -464, -137, 264, 304, 18, -226, -180, 43,
+    171, 92, -63, -115, -36, 60, 68, 5, -45, -35, 7, 28, 14, -8, -14, -4, 5, 6,
+    2, -9, -14, 1, 24, 22, -13, -47, -27, 39, 77, 21, -84, -110, 7, 151, 136,
+    -67, -239, -139, 174, 341, 100, -337, -444, 10, 573, 529, -234, -907, -564,
+    661, 1418, 488, -1587, -2472, -40, 5314, 10427, 11743, 8317, 2595, -1644,
+    -2378, -594, 1152, 1225, 44, -877, -674, 179, 655, 345, -259, -464, -140,
+    263, 305, 20, -225, -181, 42, 171, 93, -62, -115, -36, 59, 69, 6, -45, -35,
+    6, 28, 14, -8, -14, -4, 5, 6, 2, -9, -14, 1, 24, 22, -13, -47, -28, 39, 77,
+    22, -84, -110, 6, 151, 136, -66, -238, -141, 172, 341, 103, -335, -445, 6,
+    571, 531, -228, -905, -570, 653, 1418, 499, -1575, -2476, -66, 5278, 10404,
+    11751, 8350, 2630, -1628, -2384, -608, 1146, 1230, 53, -875, -678, 174, 655,
+    349, -256, -465, -143, 261, 307, 22, -224, -183, 40, 171, 94, -62, -116,
+    -37, 59, 69, 6, -44, -35, 6, 28, 14, -8, -14, -4, 5, 6, 2, -9, -14, 1, 24,
+    23, -13, -46, -28, 38, 77, 22, -83, -110, 5, 150, 137, -64, -238, -142, 170,
+    341, 105, -333, -446, 2, 568, 534, -222, -903, -575, 645, 1417, 510, -1563,
+    -2479, -92, 5241, 10381, 11762, 8382, 2665, -1612, -2389, -622, 1139, 1234,
+    61, -872, -683, 168, 654, 352, -253, -466, -146, 259, 308, 24, -224, -184,
+    39, 170, 95, -61, -116, -38, 58, 69, 7, -44, -35, 6, 28, 15, -8, -14, -4, 5,
+    6, 2, -9, -14, 1, 23, 23, -13, -46, -28, 38, 77, 23, -83, -111, 4, 149, 138,
+    -63, -238, -144, 168, 341, 108, -331, -447, -2, 566, 537, -217, -901, -581,
+    637, 1417, 521, -1551, -2482, -119, 5204, 10358, 11770, 8414, 2700, -1595,
+    -2395, -636, 1133, 1239, 69, -870, -687, 163, 654, 356, -250, -466, -149,
+    258, 309, 26, -223, -185, 38, 170, 96, -60, -116, -38, 58, 69, 7, -44, -36,
+    6, 28, 15, -8, -14, -4, 5, 6, 2, -9, -14, 1, 23, 23, -12, -46, -29, 38, 77,
+    24, -82, -111, 3, 149, 139, -61, -237, -145, 166, 341, 110, -328, -448, -6,
+    564, 540, -211, -900, -587, 629, 1417, 532, -1538, -2485, -145, 5167, 10334,
+    11770, 8447, 2735, -1579, -2400, -649, 1126, 1244, 77, -867, -691, 158, 653,
+    360, -247, -467, -152, 256, 310, 28, -222, -186, 36, 170, 97, -59, -116,
+    -39, 58, 70, 8, -44, -36, 5, 28, 15, -7, -14, -4, 5, 6, 2, -9, -14, 1, 23,
+    23, -12, -46, -29, 37, 77, 24, -82, -111, 2, 148, 139, -60, -237, -147, 164,
+    341, 113, -326, -449, -10, 561, 543, -205, -898, -592, 621, 1416, 543,
+    -1526, -2488, -170, 5130, 10311, 11781, 8479, 2770, -1562, -2405, -663,
+    1120, 1248, 85, -864, -695, 153, 653, 363, -244, -467, -155, 254, 311, 30,
+    -222, -187, 35, 170, 98, -59, -116, -40, 57, 70, 8, -44, -36, 5, 28, 15, -7,
+    -14, -4, 5, 6, 2, -9, -14, 1, 23, 23, -12, -46, -29, 37, 77, 25, -81, -112,
+    1, 148, 140, -59, -236, -148, 162, 341, 115, -324, -451, -14, 559, 546,
+    -200, -896, -598, 613, 1416, 554, -1514, -2491, -196, 5093, 10287, 11790,
+    8511, 2805, -1545, -2410, -677, 1113, 1253, 93, -862, -700, 148, 652, 367,
+    -240, -468, -158, 252, 312, 32, -221, -188, 33, 170, 98, -58, -116, -41, 57,
+    70, 9, -44, -36, 5, 28, 15, -7, -14, -4, 5, 6, 2, -9, -14, 0, 23, 23, -11,
+    -46, -30, 36, 77, 25, -80, -112, -1, 147, 141, -57, -236, -150, 160, 341,
+    118, -321, -452, -18, 557, 548, -194, -894, -604, 605, 1415, 565, -1501,
+    -2494, -222, 5056, 10263, 11798, 8543, 2840, -1528, -2415, -690, 1106, 1257,
+    102, -859, -704, 143, 651, 370, -237, -468, -160, 251, 313, 34, -220, -189,
+    32, 170, 99, -57, -116, -41, 56, 70, 9, -44, -37, 5, 27, 15, -7, -14, -4, 5,
+    6, 2, -9, -14, 0, 23, 23, -11, -46, -30, 36, 77, 26, -80, -112, -2, 146,
+    142, -56, -235, -151, 158, 341, 121, -319, -453, -22, 554, 551, -188, -892,
+    -609, 597, 1415, 575, -1489, -2496, -247, 5019, 10239, 11805, 8574, 2875,
+    -1511, -2420, -704, 1099, 1262, 110, -856, -708, 137, 651, 374, -234, -469,
+    -163, 249, 313, 36, -219, -190, 31, 169, 100, -56, -116, -42, 56, 71, 9,
+    -43, -37, 4, 27, 15, -7, -14, -5, 5, 6, 2, -9, -14, 0, 23, 23, -11, -46,
+    -30, 35, 77, 27, -79, -112, -3, 146, 142, -54, -235, -153, 156, 341, 123,
+    -317, -454, -26, 552, 554, -183, -890, -615, 589, 1414, 586, -1476, -2499,
+    -273, 4982, 10214, 11814, 8606, 2910, -1494, -2425, -718, 1092, 1266, 118,
+    -853, -712, 132, 650, 378, -231, -469, -166, 247, 314, 38, -218, -191, 29,
+    169, 101, -55, -117, -43, 56, 71, 10, -43, -37, 4, 27, 16, -7, -14, -5, 5,
+    6, 2, -9, -14, 0, 23, 24, -11, -46, -30, 35, 77, 27, -79, -113, -4, 145,
+    143, -53, -234, -154, 154, 341, 126, -314, -455, -29, 549, 556, -177, -888,
+    -620, 581, 1413, 597, -1464, -2501, -298, 4945, 10190, 11817, 8638, 2945,
+    -1476, -2429, -731, 1085, 1270, 126, -850, -716, 127, 649, 381, -228, -469,
+    -169, 245, 315, 40, -218, -192, 28, 169, 102, -54, -117, -43, 55, 71, 10,
+    -43, -37, 4, 27, 16, -7, -14, -5, 5, 6, 2, -9, -14, 0, 23, 24, -10, -46,
+    -31, 35, 77, 28, -78, -113, -5, 145, 144, -51, -234, -156, 152, 341, 128,
+    -312, -455, -33, 547, 559, -171, -886, -625, 573, 1413, 607, -1451, -2503,
+    -323, 4908, 10165, 11816, 8669, 2981, -1459, -2434, -745, 1078, 1275, 134,
+    -847, -720, 122, 649, 385, -224, -470, -172, 244, 316, 43, -217, -193, 26,
+    169, 103, -54, -117, -44, 55, 71, 11, -43, -37, 4, 27, 16, -7, -14, -5, 5,
+    6, 2, -9, -14, 0, 23, 24, -10, -46, -31, 34, 77, 28, -77, -113, -6, 144,
+    145, -50, -233, -157, 150, 341, 131, -310, -456, -37, 544, 561, -166, -884,
+    -631, 565, 1412, 618, -1438, -2505, -348, 4871, 10141, 11828, 8700, 3016,
+    -1441, -2438, -759, 1071, 1279, 143, -845, -724, 116, 648, 388, -221, -470,
+    -175, 242, 317, 45, -216, -194, 25, 169, 104, -53, -117, -45, 54, 71, 11,
+    -43, -38, 3, 27, 16, -7, -14, -5, 4, 6, 2, -9, -14, 0, 22, 24, -10, -45,
+    -31, 34, 77, 29, -77, -113, -7, 143, 145, -48, -233, -159, 148, 341, 133,
+    -307, -457, -41, 542, 564, -160, -882, -636, 557, 1411, 628, -1426, -2507,
+    -373, 4834, 10116, 11829, 8732, 3052, -1423, -2443, -772, 1064, 1283, 151,
+    -841, -728, 111, 647, 392, -218, -471, -177, 240, 318, 47, -215, -195, 24,
+    168, 105, -52, -117, -45, 54, 72, 12, -43, -38, 3, 27, 16, -7, -14, -5, 4,
+    6, 2, -8, -14, 0, 22, 24, -9, -45, -32, 33, 77, 29, -76, -113, -8, 143, 146,
+    -47, -232, -160, 146, 341, 136, -305, -458, -45, 539, 566, -154, -879, -641,
+    549, 1410, 638, -1413, -2509, -398, 4798, 10091, 11831, 8763, 3087, -1405,
+    -2447, -786, 1057, 1287, 159, -838, -732, 106, 646, 395, -215, -471, -180,
+    238, 319, 49, -214, -196, 22, 168, 106, -51, -117, -46, 54, 72, 12, -42,
+    -38, 3, 27, 16, -6, -14, -5, 4, 6, 3, -8, -14, -1, 22, 24, -9, -45, -32, 33,
+    77, 30, -76, -114, -9, 142, 147, -45, -232, -161, 144, 341, 138, -302, -459,
+    -49, 537, 569, -149, -877, -646, 540, 1409, 649, -1400, -2510, -422, 4761,
+    10066, 11832, 8794, 3123, -1387, -2451, -800, 1049, 1291, 168, -835, -736,
+    101, 645, 399, -211, -471, -183, 236, 320, 51, -213, -197, 21, 168, 107,
+    -50, -117, -47, 53, 72, 13, -42, -38, 3, 27, 16, -6, -14, -5, 4, 6, 3, -8,
+    -14, -1, 22, 24, -9, -45, -32, 32, 77, 31, -75, -114, -9, 141, 147, -44,
+    -231, -163, 142, 341, 140, -300, -460, -53, 534, 571, -143, -875, -652, 532,
+    1408, 659, -1388, -2512, -447, 4724, 10040, 11845, 8825, 3158, -1369, -2455,
+    -814, 1042, 1295, 176, -832, -740, 95, 644, 402, -208, -471, -186, 234, 321,
+    53, -212, -198, 19, 167, 108, -49, -117, -47, 53, 72, 13, -42, -38, 2, 27,
+    17, -6, -14, -5, 4, 6, 3, -8, -14, -1, 22, 24, -9, -45, -32, 32, 77, 31,
+    -75, -114, -10, 141, 148, -42, -231, -164, 140, 341, 143, -297, -461, -56,
+    531, 574, -137, -872, -657, 524, 1406, 669, -1375, -2513, -471, 4687, 10015,
+    11848, 8856, 3194, -1350, -2459, -827, 1034, 1299, 184, -829, -744, 90, 643,
+    406, -205, -472, -189, 232, 321, 55, -211, -199, 18, 167, 108, -49, -117,
+    -48, 52, 72, 14, -42, -39, 2, 27, 17, -6, -14, -5, 4, 6, 3, -8, -14, -1, 22,
+    24, -8, -45, -33, 31, 77, 32, -74, -114, -11, 140, 149, -41, -230, -166,
+    138, 341, 145, -295, -461, -60, 529, 576, -132, -870, -662, 516, 1405, 679,
+    -1362, -2514, -495, 4650, 9989, 11852, 8886, 3230, -1332, -2462, -841, 1027,
+    1303, 192, -826, -748, 84, 642, 409, -201, -472, -192, 231, 322, 57, -211,
+    -200, 17, 167, 109, -48, -117, -49, 52, 73, 14, -42, -39, 2, 27, 17, -6,
+    -14, -5, 4, 6, 3, -8, -14, -1, 22, 24, -8, -45, -33, 31, 77, 32, -73, -115,
+    -12, 139, 149, -39, -230, -167, 136, 341, 148, -293, -462, -64, 526, 578,
+    -126, -868, -667, 508, 1404, 690, -1349, -2516, -519, 4613, 9964, 11855,
+    8917, 3265, -1313, -2466, -855, 1019, 1307, 201, -822, -752, 79, 641, 413,
+    -198, -472, -194, 229, 323, 59, -210, -201, 15, 167, 110, -47, -117, -49,
+    51, 73, 14, -42, -39, 2, 27, 17, -6, -14, -5, 4, 6, 3, -8, -14, -1, 22, 25,
+    -8, -45, -33, 31, 77, 33, -73, -115, -13, 139, 150, -38, -229, -168, 134,
+    340, 150, -290, -463, -68, 523, 581, -120, -865, -672, 499, 1402, 700,
+    -1336, -2516, -543, 4576, 9938, 11855, 8948, 3301, -1294, -2470, -868, 1011,
+    1311, 209, -819, -755, 74, 640, 416, -195, -472, -197, 227, 324, 61, -209,
+    -202, 14, 166, 111, -46, -117, -50, 51, 73, 15, -41, -39, 1, 27, 17, -6,
+    -14, -5, 4, 6, 3, -8, -14, -1, 22, 25, -8, -44, -34, 30, 77, 33, -72, -115,
+    -14, 138, 150, -36, -228, -170, 132, 340, 153, -288, -463, -72, 521, 583,
+    -115, -863, -677, 491, 1401, 710, -1323, -2517, -567, 4539, 9912, 11864,
+    8978, 3337, -1275, -2473, -882, 1004, 1314, 217, -816, -759, 68, 639, 419,
+    -191, -472, -200, 225, 324, 63, -208, -203, 12, 166, 112, -45, -117, -51,
+    50, 73, 15, -41, -39, 1, 27, 17, -6, -14, -6, 4, 6, 3, -8, -14, -2, 21, 25,
+    -7, -44, -34, 30, 77, 34, -72, -115, -15, 137, 151, -35, -228, -171, 130,
+    340, 155, -285, -464, -76, 518, 585, -109, -860, -682, 483, 1399, 720,
+    -1310, -2518, -591, 4503, 9886, 11863, 9008, 3373, -1256, -2476, -896, 996,
+    1318, 226, -812, -763, 63, 638, 423, -188, -473, -203, 223, 325, 66, -207,
+    -204, 11, 166, 113, -44, -117, -51, 50, 73, 16, -41, -39, 1, 27, 17, -5,
+    -14, -6, 4, 6, 3, -8, -14, -2, 21, 25, -7, -44, -34, 29, 77, 35, -71, -115,
+    -16, 136, 152, -33, -227, -172, 128, 340, 157, -283, -465, -79, 515, 587,
+    -104, -858, -687, 475, 1398, 729, -1297, -2518, -614, 4466, 9859, 11866,
+    9038, 3409, -1236, -2479, -909, 988, 1321, 234, -809, -766, 58, 637, 426,
+    -184, -473, -205, 221, 326, 68, -206, -205, 9, 165, 114, -43, -117, -52, 49,
+    73, 16, -41, -40, 1, 27, 18, -5, -14, -6, 4, 5, 3, -8, -14, -2, 21, 25, -7,
+    -44, -34, 29, 77, 35, -70, -115, -17, 136, 152, -32, -227, -174, 126, 339,
+    160, -280, -465, -83, 512, 590, -98, -855, -692, 466, 1396, 739, -1284,
+    -2519, -638, 4429, 9833, 11872, 9068, 3445, -1217, -2482, -923, 980, 1325,
+    242, -805, -770, 52, 635, 429, -181, -473, -208, 219, 327, 70, -205, -206,
+    8, 165, 115, -42, -117, -53, 49, 74, 17, -41, -40, 0, 27, 18, -5, -14, -6,
+    4, 5, 3, -8, -14, -2, 21, 25, -7, -44, -35, 28, 77, 36, -70, -116, -18, 135,
+    153, -30, -226, -175, 124, 339, 162, -277, -466, -87, 510, 592, -92, -852,
+    -696, 458, 1394, 749, -1271, -2519, -661, 4392, 9806, 11873, 9098, 3481,
+    -1197, -2485, -936, 972, 1328, 250, -801, -774, 47, 634, 433, -177, -473,
+    -211, 217, 327, 72, -204, -207, 7, 165, 115, -42, -117, -54, 49, 74, 17,
+    -40, -40, 0, 27, 18, -5, -14, -6, 4, 5, 3, -8, -14, -2, 21, 25, -6, -44,
+    -35, 28, 76, 36, -69, -116, -19, 134, 153, -29, -225, -176, 122, 339, 164,
+    -275, -467, -91, 507, 594, -87, -850, -701, 450, 1392, 759, -1258, -2519,
+    -684, 4355, 9779, 11879, 9128, 3517, -1178, -2488, -950, 964, 1332, 259,
+    -798, -777, 41, 633, 436, -174, -473, -214, 215, 328, 74, -203, -207, 5,
+    164, 116, -41, -117, -54, 48, 74, 18, -40, -40, 0, 27, 18, -5, -14, -6, 4,
+    5, 3, -8, -14, -2, 21, 25, -6, -44, -35, 27, 76, 37, -68, -116, -20, 134,
+    154, -27, -225, -177, 120, 339, 167, -272, -467, -94, 504, 596, -81, -847,
+    -706, 442, 1390, 768, -1245, -2519, -707, 4319, 9753, 11874, 9158, 3553,
+    -1158, -2491, -964, 956, 1335, 267, -794, -781, 36, 632, 439, -170, -473,
+    -216, 213, 329, 76, -202, -208, 4, 164, 117, -40, -117, -55, 48, 74, 18,
+    -40, -40, 0, 27, 18, -5, -14, -6, 4, 5, 3, -7, -14, -2, 21, 25, -6, -44,
+    -35, 27, 76, 37, -68, -116, -21, 133, 155, -26, -224, -179, 118, 338, 169,
+    -270, -468, -98, 501, 598, -75, -844, -710, 433, 1388, 778, -1232, -2519,
+    -730, 4282, 9726, 11883, 9188, 3589, -1138, -2493, -977, 947, 1338, 275,
+    -790, -784, 30, 630, 443, -167, -473, -219, 211, 329, 78, -201, -209, 2,
+    164, 118, -39, -117, -56, 47, 74, 18, -40, -41, -1, 27, 18, -5, -14, -6, 4,
+    5, 3, -7, -14, -3, 21, 25, -5, -43, -36, 27, 76, 38, -67, -116, -22, 132,
+    155, -24, -223, -180, 116, 338, 171, -267, -468, -102, 498, 600, -70, -841,
+    -715, 425, 1386, 787, -1218, -2519, -753, 4245, 9698, 11882, 9217, 3625,
+    -1117, -2496, -991, 939, 1342, 284, -787, -788, 25, 629, 446, -163, -473,
+    -222, 209, 330, 80, -200, -210, 1, 163, 119, -38, -117, -56, 47, 74, 19,
+    -40, -41, -1, 27, 18, -5, -14, -6, 4, 5, 3, -7, -14, -3, 20, 25, -5, -43,
+    -36, 26, 76, 38, -67, -116, -23, 131, 156, -23, -223, -181, 113, 338, 174,
+    -265, -469, -106, 495, 602, -64, -838, -720, 417, 1384, 797, -1205, -2519,
+    -775, 4209, 9671, 11889, 9246, 3661, -1097, -2498, -1004, 931, 1345, 292,
+    -783, -791, 19, 627, 449, -160, -473, -225, 206, 330, 82, -199, -211, -1,
+    163, 120, -37, -117, -57, 46, 74, 19, -39, -41, -1, 27, 19, -5, -14, -6, 4,
+    5, 3, -7, -14, -3, 20, 26, -5, -43, -36, 26, 76, 39, -66, -116, -24, 131,
+    156, -21, -222, -182, 111, 337, 176, -262, -469, -109, 492, 604, -58, -836,
+    -724, 409, 1382, 806, -1192, -2518, -798, 4172, 9644, 11884, 9276, 3698,
+    -1077, -2501, -1018, 922, 1348, 300, -779, -795, 14, 626, 452, -156, -473,
+    -227, 204, 331, 84, -198, -212, -2, 162, 120, -36, -117, -57, 46, 75, 20,
+    -39, -41, -1, 26, 19, -4, -14, -6, 4, 5, 3, -7, -14, -3, 20, 26, -5, -43,
+    -36, 25, 76, 40, -65, -116, -25, 130, 157, -20, -221, -184, 109, 337, 178,
+    -259, -469, -113, 489, 606, -53, -833, -729, 400, 1380, 815, -1179, -2518,
+    -820, 4135, 9616, 11888, 9305, 3734, -1056, -2503, -1031, 914, 1351, 309,
+    -775, -798, 8, 624, 455, -153, -472, -230, 202, 332, 86, -196, -213, -4,
+    162, 121, -35, -117, -58, 45, 75, 20, -39, -41, -2, 26, 19, -4, -14, -6, 4,
+    5, 3, -7, -14, -3, 20, 26, -4, -43, -37, 25, 76, 40, -65, -117, -26, 129,
+    157, -18, -220, -185, 107, 337, 180, -257, -470, -117, 486, 608, -47, -830,
+    -733, 392, 1377, 825, -1165, -2517, -842, 4099, 9589, 11885, 9334, 3770,
+    -1035, -2505, -1045, 905, 1354, 317, -771, -801, 3, 623, 459, -149, -472,
+    -233, 200, 332, 89, -195, -213, -5, 161, 122, -34, -117, -59, 45, 75, 21,
+    -39, -41, -2, 26, 19, -4, -14, -6, 4, 5, 3, -7, -14, -3, 20, 26, -4, -43,
+    -37, 24, 76, 41, -64, -117, -27, 128, 158, -17, -220, -186, 105, 336, 183,
+    -254, -470, -120, 483, 610, -42, -827, -737, 384, 1375, 834, -1152, -2516,
+    -864, 4062, 9561, 11887, 9362, 3807, -1014, -2506, -1058, 896, 1357, 325,
+    -767, -805, -3, 621, 462, -146, -472, -236, 198, 333, 91, -194, -214, -7,
+    161, 123, -33, -117, -59, 44, 75, 21, -38, -42, -2, 26, 19, -4, -14, -6, 4,
+    5, 3, -7, -14, -3, 20, 26, -4, -43, -37, 24, 76, 41, -63, -117, -28, 128,
+    158, -15, -219, -187, 103, 336, 185, -252, -471, -124, 480, 611, -36, -824,
+    -742, 375, 1373, 843, -1139, -2515, -886, 4025, 9533, 11888, 9391, 3843,
+    -993, -2508, -1072, 888, 1359, 334, -763, -808, -8, 620, 465, -142, -472,
+    -238, 196, 333, 93, -193, -215, -8, 161, 124, -32, -117, -60, 44, 75, 22,
+    -38, -42, -2, 26, 19, -4, -14, -7, 4, 5, 3, -7, -14, -3, 20, 26, -4, -42,
+    -37, 23, 76, 42, -63, -117, -29, 127, 159, -14, -218, -189, 101, 335, 187,
+    -249, -471, -128, 477, 613, -31, -821, -746, 367, 1370, 852, -1125, -2514,
+    -908, 3989, 9505, 11895, 9420, 3879, -972, -2510, -1085, 879, 1362, 342,
+    -759, -811, -14, 618, 468, -139, -472, -241, 194, 334, 95, -192, -216, -9,
+    160, 124, -32, -117, -61, 43, 75, 22, -38, -42, -3, 26, 19, -4, -14, -7, 4,
+    5, 4, -7, -14, -4, 20, 26, -3, -42, -38, 23, 75, 42, -62, -117, -30, 126,
+    159, -12, -217, -190, 99, 335, 189, -246, -471, -131, 474, 615, -25, -817,
+    -750, 359, 1368, 861, -1112, -2513, -929, 3952, 9477, 11891, 9448, 3916,
+    -951, -2511, -1099, 870, 1365, 350, -755, -814, -19, 616, 471, -135, -471,
+    -244, 191, 334, 97, -191, -217, -11, 160, 125, -31, -117, -61, 43, 75, 23,
+    -38, -42, -3, 26, 19, -4, -14, -7, 4,
+};
+
+const int16_t g_resampler_48000_coefficients[88] = {
+    5, 3, -5, -13, -8, 10, 25, 15, -18, -43, -26, 30, 70, 40, -47, -107, -61,
+    69, 156, 88, -99, -223, -125, 140, 312, 174, -194, -432, -241, 269, 600,
+    336, -378, -854, -485, 556, 1288, 757, -910, -2255, -1465, 2068, 6932,
+    10434, 10426, 6932, 2068, -1465, -2255, -910, 757, 1288, 556, -485, -854,
+    -378, 336, 600, 269, -241, -432, -194, 174, 312, 140, -125, -223, -99, 88,
+    156, 69, -61, -107, -47, 40, 70, 30, -26, -43, -18, 15, 25, 10, -8, -13, -5,
+    3, 5,
+};
+
+}  // namespace
+
+static_assert(kResamplerMaxTaps >= 88,
+              "kResamplerMaxTaps is too small for these banks");
+
+const ResamplerFilterBank g_resampler_filter_banks[] = {
+    {32000, 1, 2, 64, g_resampler_32000_coefficients},
+    {44100, 160, 441, 80, g_resampler_44100_coefficients},
+    {48000, 1, 3, 88, g_resampler_48000_coefficients},
+};
+
+const int g_resampler_filter_bank_count =
+    sizeof(g_resampler_filter_banks) / sizeof(g_resampler_filter_banks[0]);
@@ -0,0 +1,47 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Polyphase filter banks for PolyphaseResampler. These are generated ahead of
+// time by tools/generate_resampler_tables.cpp and kept in read-only memory,
+// so picking a source rate costs nothing at runtime.
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_RESAMPLER_TABLES_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_RESAMPLER_TABLES_H_
+
+#include <cstdint>
+
+#include "micro_model_settings.h"
+
+// Coefficients are Q15, and every phase sums to exactly 1 << this.
+constexpr int kResamplerCoefficientBits = 15;
+// The longest phase in any bank, which sizes the resampler's history.
+constexpr int kResamplerMaxTaps = 88;
+
+// Resamples input_rate to kAudioSampleFrequency by conceptually
+// interpolating by one factor and decimating by the other. coefficients holds
+// interpolation phases of taps entries each, ordered from the oldest input
+// sample to the newest.
+struct ResamplerFilterBank {
+  int input_rate;
+  int interpolation;
+  int decimation;
+  int taps;
+  const int16_t* coefficients;
+};
+
+extern const ResamplerFilterBank g_resampler_filter_banks[];
+extern const int g_resampler_filter_bank_count;
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_RESAMPLER_TABLES_H_
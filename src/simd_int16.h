@@ -0,0 +1,299 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_SIMD_INT16_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_SIMD_INT16_H_
+
+// A thin layer over the vector instructions the frontend kernels need, so the
+// kernels can be written once and built for whatever the target has. Every
+// operation gives exactly the result of the matching scalar C++, including the
+// wraparound of int16 arithmetic, which is what lets the vectorized paths
+// match the library's fixed-point code bit for bit.
+//
+// Int16x8 holds eight int16 lanes, or four complex values stored as (real,
+// imaginary) pairs, and is available when MICRO_SPEECH_SIMD_INT16X8 is
+// defined, which is for SSE4.1 and NEON builds. AVX2 builds also get Int16x16,
+// with the same operations on twice as many lanes. Anything else, including
+// the ESP32-S3, whose PIE extension the compiler has no intrinsics for, uses
+// the kernels' scalar code.
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#define MICRO_SPEECH_SIMD_INT16X8 1
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MICRO_SPEECH_SIMD_INT16X16 1
+#endif  // defined(__AVX2__)
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MICRO_SPEECH_SIMD_INT16X8 1
+#endif
+
+namespace simd {
+
+#if defined(__SSE4_1__)
+
+struct Int16x8 {
+  static constexpr int kLanes = 8;
+
+  static Int16x8 Load(const int16_t* source) {
+    return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(source))};
+  }
+  static Int16x8 Splat(int16_t value) { return {_mm_set1_epi16(value)}; }
+  // Repeats one complex value in every pair of lanes.
+  static Int16x8 SplatPair(const int16_t* pair) {
+    int32_t bits;
+    memcpy(&bits, pair, sizeof(bits));
+    return {_mm_set1_epi32(bits)};
+  }
+  void Store(int16_t* destination) const {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), v);
+  }
+
+  __m128i v;
+};
+
+inline Int16x8 operator+(Int16x8 a, Int16x8 b) {
+  return {_mm_add_epi16(a.v, b.v)};
+}
+inline Int16x8 operator-(Int16x8 a, Int16x8 b) {
+  return {_mm_sub_epi16(a.v, b.v)};
+}
+
+// (a * b + 2^14) >> 15 in each lane. b must not be -32768.
+inline Int16x8 MulQ15Round(Int16x8 a, Int16x8 b) {
+  return {_mm_mulhrs_epi16(a.v, b.v)};
+}
+
+// Multiplies four complex values by four others, rounding each part as
+// (x + 2^14) >> 15. The second operand comes as real_terms, pairs of (r, -i),
+// and imag_terms, pairs of (i, r).
+inline Int16x8 ComplexMulQ15(Int16x8 a, Int16x8 real_terms,
+                             Int16x8 imag_terms) {
+  const __m128i rounding = _mm_set1_epi32(1 << 14);
+  const __m128i real = _mm_srai_epi32(
+      _mm_add_epi32(_mm_madd_epi16(a.v, real_terms.v), rounding), 15);
+  const __m128i imag = _mm_srai_epi32(
+      _mm_add_epi32(_mm_madd_epi16(a.v, imag_terms.v), rounding), 15);
+  // Keeping only the low half of each part truncates like an int16 cast.
+  return {_mm_blend_epi16(real, _mm_slli_epi32(imag, 16), 0xaa)};
+}
+
+// Multiplies four complex values by -i, turning (r, i) into (i, -r).
+inline Int16x8 ComplexMulMinusI(Int16x8 a) {
+  const __m128i swapped = _mm_shufflehi_epi16(
+      _mm_shufflelo_epi16(a.v, _MM_SHUFFLE(2, 3, 0, 1)),
+      _MM_SHUFFLE(2, 3, 0, 1));
+  return {_mm_sign_epi16(swapped, _mm_set_epi16(-1, 1, -1, 1, -1, 1, -1, 1))};
+}
+
+// (a * b) >> kShift in each lane, keeping the low 16 bits.
+template <int kShift>
+inline Int16x8 MulShiftRight(Int16x8 a, Int16x8 b) {
+  return {_mm_or_si128(_mm_slli_epi16(_mm_mulhi_epi16(a.v, b.v), 16 - kShift),
+                       _mm_srli_epi16(_mm_mullo_epi16(a.v, b.v), kShift))};
+}
+
+// Absolute value, where -32768 stays as it is.
+inline Int16x8 Abs(Int16x8 a) { return {_mm_abs_epi16(a.v)}; }
+inline Int16x8 Max(Int16x8 a, Int16x8 b) { return {_mm_max_epi16(a.v, b.v)}; }
+inline int16_t ReduceMax(Int16x8 a) {
+  __m128i max = _mm_max_epi16(a.v, _mm_srli_si128(a.v, 8));
+  max = _mm_max_epi16(max, _mm_srli_si128(max, 4));
+  max = _mm_max_epi16(max, _mm_srli_si128(max, 2));
+  return static_cast<int16_t>(_mm_extract_epi16(max, 0));
+}
+
+inline Int16x8 ShiftLeft(Int16x8 a, int count) {
+  return {_mm_sll_epi16(a.v, _mm_cvtsi32_si128(count))};
+}
+
+// Treats four vectors as a 4x4 matrix of complex values and transposes it.
+inline void TransposeComplex4x4(Int16x8* rows) {
+  const __m128i t0 = _mm_unpacklo_epi32(rows[0].v, rows[1].v);
+  const __m128i t1 = _mm_unpacklo_epi32(rows[2].v, rows[3].v);
+  const __m128i t2 = _mm_unpackhi_epi32(rows[0].v, rows[1].v);
+  const __m128i t3 = _mm_unpackhi_epi32(rows[2].v, rows[3].v);
+  rows[0].v = _mm_unpacklo_epi64(t0, t1);
+  rows[1].v = _mm_unpackhi_epi64(t0, t1);
+  rows[2].v = _mm_unpacklo_epi64(t2, t3);
+  rows[3].v = _mm_unpackhi_epi64(t2, t3);
+}
+
+#if defined(__AVX2__)
+
+struct Int16x16 {
+  static constexpr int kLanes = 16;
+
+  static Int16x16 Load(const int16_t* source) {
+    return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source))};
+  }
+  static Int16x16 Splat(int16_t value) { return {_mm256_set1_epi16(value)}; }
+  static Int16x16 SplatPair(const int16_t* pair) {
+    int32_t bits;
+    memcpy(&bits, pair, sizeof(bits));
+    return {_mm256_set1_epi32(bits)};
+  }
+  void Store(int16_t* destination) const {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), v);
+  }
+
+  __m256i v;
+};
+
+inline Int16x16 operator+(Int16x16 a, Int16x16 b) {
+  return {_mm256_add_epi16(a.v, b.v)};
+}
+inline Int16x16 operator-(Int16x16 a, Int16x16 b) {
+  return {_mm256_sub_epi16(a.v, b.v)};
+}
+inline Int16x16 MulQ15Round(Int16x16 a, Int16x16 b) {
+  return {_mm256_mulhrs_epi16(a.v, b.v)};
+}
+inline Int16x16 ComplexMulQ15(Int16x16 a, Int16x16 real_terms,
+                              Int16x16 imag_terms) {
+  const __m256i rounding = _mm256_set1_epi32(1 << 14);
+  const __m256i real = _mm256_srai_epi32(
+      _mm256_add_epi32(_mm256_madd_epi16(a.v, real_terms.v), rounding), 15);
+  const __m256i imag = _mm256_srai_epi32(
+      _mm256_add_epi32(_mm256_madd_epi16(a.v, imag_terms.v), rounding), 15);
+  return {_mm256_blend_epi16(real, _mm256_slli_epi32(imag, 16), 0xaa)};
+}
+inline Int16x16 ComplexMulMinusI(Int16x16 a) {
+  const __m256i swapped = _mm256_shufflehi_epi16(
+      _mm256_shufflelo_epi16(a.v, _MM_SHUFFLE(2, 3, 0, 1)),
+      _MM_SHUFFLE(2, 3, 0, 1));
+  return {_mm256_sign_epi16(swapped,
+                            _mm256_set_epi16(-1, 1, -1, 1, -1, 1, -1, 1, -1,
+                                             1, -1, 1, -1, 1, -1, 1))};
+}
+template <int kShift>
+inline Int16x16 MulShiftRight(Int16x16 a, Int16x16 b) {
+  return {_mm256_or_si256(
+      _mm256_slli_epi16(_mm256_mulhi_epi16(a.v, b.v), 16 - kShift),
+      _mm256_srli_epi16(_mm256_mullo_epi16(a.v, b.v), kShift))};
+}
+inline Int16x16 Abs(Int16x16 a) { return {_mm256_abs_epi16(a.v)}; }
+inline Int16x16 Max(Int16x16 a, Int16x16 b) {
+  return {_mm256_max_epi16(a.v, b.v)};
+}
+inline int16_t ReduceMax(Int16x16 a) {
+  return ReduceMax(Int16x8{_mm_max_epi16(_mm256_castsi256_si128(a.v),
+                                         _mm256_extracti128_si256(a.v, 1))});
+}
+inline Int16x16 ShiftLeft(Int16x16 a, int count) {
+  return {_mm256_sll_epi16(a.v, _mm_cvtsi32_si128(count))};
+}
+
+#endif  // defined(__AVX2__)
+
+#elif defined(__ARM_NEON)
+
+struct Int16x8 {
+  static constexpr int kLanes = 8;
+
+  static Int16x8 Load(const int16_t* source) { return {vld1q_s16(source)}; }
+  static Int16x8 Splat(int16_t value) { return {vdupq_n_s16(value)}; }
+  static Int16x8 SplatPair(const int16_t* pair) {
+    int32_t bits;
+    memcpy(&bits, pair, sizeof(bits));
+    return {vreinterpretq_s16_s32(vdupq_n_s32(bits))};
+  }
+  void Store(int16_t* destination) const { vst1q_s16(destination, v); }
+
+  int16x8_t v;
+};
+
+inline Int16x8 operator+(Int16x8 a, Int16x8 b) { return {vaddq_s16(a.v, b.v)}; }
+inline Int16x8 operator-(Int16x8 a, Int16x8 b) { return {vsubq_s16(a.v, b.v)}; }
+
+// vqrdmulh saturates, which only differs from the scalar rounding when both
+// inputs are -32768, and b never is.
+inline Int16x8 MulQ15Round(Int16x8 a, Int16x8 b) {
+  return {vqrdmulhq_s16(a.v, b.v)};
+}
+
+inline Int16x8 ComplexMulQ15(Int16x8 a, Int16x8 real_terms,
+                             Int16x8 imag_terms) {
+  const int16x4x2_t a_parts = vuzp_s16(vget_low_s16(a.v), vget_high_s16(a.v));
+  const int16x4x2_t real_parts =
+      vuzp_s16(vget_low_s16(real_terms.v), vget_high_s16(real_terms.v));
+  const int16x4x2_t imag_parts =
+      vuzp_s16(vget_low_s16(imag_terms.v), vget_high_s16(imag_terms.v));
+  const int32x4_t rounding = vdupq_n_s32(1 << 14);
+  int32x4_t real = vmlal_s16(vmull_s16(a_parts.val[0], real_parts.val[0]),
+                             a_parts.val[1], real_parts.val[1]);
+  int32x4_t imag = vmlal_s16(vmull_s16(a_parts.val[0], imag_parts.val[0]),
+                             a_parts.val[1], imag_parts.val[1]);
+  real = vshrq_n_s32(vaddq_s32(real, rounding), 15);
+  imag = vshrq_n_s32(vaddq_s32(imag, rounding), 15);
+  // vmovn keeps the low half, which truncates like an int16 cast.
+  const int16x4x2_t zipped = vzip_s16(vmovn_s32(real), vmovn_s32(imag));
+  return {vcombine_s16(zipped.val[0], zipped.val[1])};
+}
+
+inline Int16x8 ComplexMulMinusI(Int16x8 a) {
+  static const int16_t kSigns[8] = {1, -1, 1, -1, 1, -1, 1, -1};
+  return {vmulq_s16(vrev32q_s16(a.v), vld1q_s16(kSigns))};
+}
+
+template <int kShift>
+inline Int16x8 MulShiftRight(Int16x8 a, Int16x8 b) {
+  return {vcombine_s16(
+      vshrn_n_s32(vmull_s16(vget_low_s16(a.v), vget_low_s16(b.v)), kShift),
+      vshrn_n_s32(vmull_s16(vget_high_s16(a.v), vget_high_s16(b.v)),
+                  kShift))};
+}
+
+inline Int16x8 Abs(Int16x8 a) { return {vabsq_s16(a.v)}; }
+inline Int16x8 Max(Int16x8 a, Int16x8 b) { return {vmaxq_s16(a.v, b.v)}; }
+inline int16_t ReduceMax(Int16x8 a) {
+#if defined(__aarch64__)
+  return vmaxvq_s16(a.v);
+#else   // defined(__aarch64__)
+  int16x4_t max = vpmax_s16(vget_low_s16(a.v), vget_high_s16(a.v));
+  max = vpmax_s16(max, max);
+  max = vpmax_s16(max, max);
+  return vget_lane_s16(max, 0);
+#endif  // defined(__aarch64__)
+}
+
+inline Int16x8 ShiftLeft(Int16x8 a, int count) {
+  return {vshlq_s16(a.v, vdupq_n_s16(count))};
+}
+
+inline void TransposeComplex4x4(Int16x8* rows) {
+  const int32x4x2_t t01 = vtrnq_s32(vreinterpretq_s32_s16(rows[0].v),
+                                    vreinterpretq_s32_s16(rows[1].v));
+  const int32x4x2_t t23 = vtrnq_s32(vreinterpretq_s32_s16(rows[2].v),
+                                    vreinterpretq_s32_s16(rows[3].v));
+  rows[0].v = vreinterpretq_s16_s32(
+      vcombine_s32(vget_low_s32(t01.val[0]), vget_low_s32(t23.val[0])));
+  rows[1].v = vreinterpretq_s16_s32(
+      vcombine_s32(vget_low_s32(t01.val[1]), vget_low_s32(t23.val[1])));
+  rows[2].v = vreinterpretq_s16_s32(
+      vcombine_s32(vget_high_s32(t01.val[0]), vget_high_s32(t23.val[0])));
+  rows[3].v = vreinterpretq_s16_s32(
+      vcombine_s32(vget_high_s32(t01.val[1]), vget_high_s32(t23.val[1])));
+}
+
+#endif
+
+}  // namespace simd
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_SIMD_INT16_H_
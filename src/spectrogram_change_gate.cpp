@@ -0,0 +1,78 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "spectrogram_change_gate.h"
+
+#include <cstring>
+
+SpectrogramChangeGate::SpectrogramChangeGate(
+    const SpectrogramChangeGateSettings& settings)
+    : settings_(settings),
+      max_skip_samples_(static_cast<int64_t>(settings.max_skip_ms) *
+                        kAudioSamplesPerMs),
+      has_output_(false),
+      last_invoke_sample_index_(0),
+      previous_scores_(),
+      invoked_spectrogram_(),
+      invoked_count_(0),
+      reused_count_(0) {}
+
+bool SpectrogramChangeGate::ShouldInvoke(const uint8_t* spectrogram,
+                                         int64_t current_sample_index) {
+  bool can_reuse =
+      has_output_ && (max_skip_samples_ > 0) &&
+      (current_sample_index - last_invoke_sample_index_ < max_skip_samples_);
+  if (can_reuse) {
+    const int32_t max_sum_change =
+        settings_.max_mean_change * kFeatureElementCount;
+    int32_t sum_change = 0;
+    for (int i = 0; i < kFeatureElementCount; ++i) {
+      const int32_t change =
+          (spectrogram[i] > invoked_spectrogram_[i])
+              ? spectrogram[i] - invoked_spectrogram_[i]
+              : invoked_spectrogram_[i] - spectrogram[i];
+      sum_change += change;
+      if (change > settings_.max_peak_change) {
+        can_reuse = false;
+        break;
+      }
+    }
+    if (sum_change > max_sum_change) {
+      can_reuse = false;
+    }
+  }
+  if (can_reuse) {
+    ++reused_count_;
+  } else {
+    ++invoked_count_;
+  }
+  return !can_reuse;
+}
+
+void SpectrogramChangeGate::RecordOutput(const uint8_t* spectrogram,
+                                         const uint8_t* scores,
+                                         int64_t current_sample_index) {
+  memcpy(invoked_spectrogram_, spectrogram, kFeatureElementCount);
+  memcpy(previous_scores_, scores, kCategoryCount);
+  last_invoke_sample_index_ = current_sample_index;
+  has_output_ = true;
+}
+
+void SpectrogramChangeGate::Report(
+    tflite::ErrorReporter* error_reporter) const {
+  error_reporter->Report("gate: %d inferences run, %d reused",
+                         static_cast<int>(invoked_count_),
+                         static_cast<int>(reused_count_));
+}
@@ -0,0 +1,73 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_SPECTROGRAM_CHANGE_GATE_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_SPECTROGRAM_CHANGE_GATE_H_
+
+#include <cstdint>
+
+#include "micro_model_settings.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+
+// Skips inferences whose input has barely changed since the last one, and
+// hands back that inference's scores instead. The gate keeps a copy of the
+// spectrogram the model last ran on, and compares the current one with it
+// feature by feature, so a sound moving along the window counts as a change
+// even when the newest slices look like the oldest. The model is skipped only
+// while both the mean change per feature and the largest single change are
+// within the limits, and never for longer than max_skip_ms, so a slow drift
+// can't hold back a fresh result for long.
+//
+// A max_skip_ms of zero turns gating off, and every inference runs.
+struct SpectrogramChangeGateSettings {
+  int32_t max_skip_ms = 0;
+  int32_t max_mean_change = 2;
+  int32_t max_peak_change = 24;
+};
+
+class SpectrogramChangeGate {
+ public:
+  explicit SpectrogramChangeGate(const SpectrogramChangeGateSettings& settings =
+                                     SpectrogramChangeGateSettings());
+
+  // Returns true if the model should be run on the kFeatureElementCount
+  // features in spectrogram, or false if previous_scores() can stand in for
+  // its output. The decision is counted either way.
+  bool ShouldInvoke(const uint8_t* spectrogram, int64_t current_sample_index);
+
+  // Keeps copies of the spectrogram an inference has just run on and the
+  // kCategoryCount scores it gave, which later decisions are measured from.
+  void RecordOutput(const uint8_t* spectrogram, const uint8_t* scores,
+                    int64_t current_sample_index);
+
+  const uint8_t* previous_scores() const { return previous_scores_; }
+  int64_t invoked_count() const { return invoked_count_; }
+  int64_t reused_count() const { return reused_count_; }
+
+  // Prints how many inferences were run and how many were reused.
+  void Report(tflite::ErrorReporter* error_reporter) const;
+
+ private:
+  SpectrogramChangeGateSettings settings_;
+  int64_t max_skip_samples_;
+  bool has_output_;
+  int64_t last_invoke_sample_index_;
+  uint8_t previous_scores_[kCategoryCount];
+  uint8_t invoked_spectrogram_[kFeatureElementCount];
+  int64_t invoked_count_;
+  int64_t reused_count_;
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_SPECTROGRAM_CHANGE_GATE_H_
@@ -0,0 +1,280 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "warm_state.h"
+
+#include <cstring>
+#include <limits>
+
+#include "frontend_fingerprint.h"
+#include "micro_features_generator.h"
+
+namespace {
+
+constexpr uint32_t kWarmStateMagic = 0x5357534d;  // "MSWS"
+constexpr size_t kHeaderSize = 16;
+
+// FNV-1a, used both for the settings fingerprint and the trailing checksum.
+uint32_t Fnv1a(const uint8_t* data, size_t size, uint32_t hash = 2166136261u) {
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= data[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Any change to these invalidates saved spectrograms and results, so they're
+// folded into every snapshot and compared on restore. The frontend's own
+// fingerprint covers its settings and tables, and the model's covers what the
+// recognizer's scores came from.
+uint32_t SettingsFingerprint(uint64_t model_fingerprint) {
+  const int32_t settings[] = {
+      kAudioSampleFrequency, kFeatureSliceSize,     kFeatureSliceCount,
+      kFeatureSliceStrideMs, kFeatureSliceDurationMs, kCategoryCount,
+  };
+  const uint64_t frontend_fingerprint = FrontendSettingsFingerprint();
+  uint32_t hash =
+      Fnv1a(reinterpret_cast<const uint8_t*>(settings), sizeof(settings));
+  hash = Fnv1a(reinterpret_cast<const uint8_t*>(&frontend_fingerprint),
+               sizeof(frontend_fingerprint), hash);
+  return Fnv1a(reinterpret_cast<const uint8_t*>(&model_fingerprint),
+               sizeof(model_fingerprint), hash);
+}
+
+class BlobWriter {
+ public:
+  BlobWriter(uint8_t* buffer, size_t size)
+      : buffer_(buffer), size_(size), offset_(0) {}
+  void Write(const void* data, size_t size) {
+    if (offset_ + size <= size_) {
+      memcpy(buffer_ + offset_, data, size);
+    }
+    offset_ += size;
+  }
+  template <typename T>
+  void Write(T value) {
+    Write(&value, sizeof(value));
+  }
+  bool overflowed() const { return offset_ > size_; }
+  size_t offset() const { return offset_; }
+
+ private:
+  uint8_t* buffer_;
+  size_t size_;
+  size_t offset_;
+};
+
+class BlobReader {
+ public:
+  BlobReader(const uint8_t* buffer, size_t size)
+      : buffer_(buffer), size_(size), offset_(0) {}
+  bool Read(void* data, size_t size) {
+    if (offset_ + size > size_) {
+      return false;
+    }
+    memcpy(data, buffer_ + offset_, size);
+    offset_ += size;
+    return true;
+  }
+  template <typename T>
+  bool Read(T* value) {
+    return Read(value, sizeof(*value));
+  }
+  size_t offset() const { return offset_; }
+
+ private:
+  const uint8_t* buffer_;
+  size_t size_;
+  size_t offset_;
+};
+
+int64_t ToRelativeTime(int64_t sample_index, int64_t origin) {
+  if (sample_index == std::numeric_limits<int64_t>::min()) {
+    return sample_index;
+  }
+  return sample_index - origin;
+}
+
+int64_t FromRelativeTime(int64_t relative_index, int64_t origin) {
+  if (relative_index == std::numeric_limits<int64_t>::min()) {
+    return relative_index;
+  }
+  return relative_index + origin;
+}
+
+}  // namespace
+
+TfLiteStatus SaveWarmState(tflite::ErrorReporter* error_reporter,
+                           const FeatureProvider& feature_provider,
+                           RecognizeCommands* recognizer,
+                           int64_t current_sample_index,
+                           int64_t current_time_ms, uint64_t model_fingerprint,
+                           uint8_t* buffer, size_t buffer_size,
+                           size_t* bytes_written) {
+  if (feature_provider.feature_size() != kFeatureElementCount) {
+    error_reporter->Report("Feature provider size %d doesn't match %d",
+                           feature_provider.feature_size(),
+                           kFeatureElementCount);
+    return kTfLiteError;
+  }
+
+  uint32_t noise_estimates[kFeatureSliceSize];
+  GetMicroFeaturesNoiseEstimates(noise_estimates);
+
+  PreviousResultsQueue::Result results[PreviousResultsQueue::kMaxResults];
+  int top_label_index;
+  int64_t top_label_sample_index;
+  const int32_t results_count = recognizer->SaveState(
+      results, &top_label_index, &top_label_sample_index);
+
+  BlobWriter writer(buffer, buffer_size);
+  writer.Write(kWarmStateMagic);
+  writer.Write(kWarmStateVersion);
+  writer.Write(static_cast<uint16_t>(kHeaderSize));
+  writer.Write(SettingsFingerprint(model_fingerprint));
+  // The total size is patched in once everything else has been written.
+  writer.Write(static_cast<uint32_t>(0));
+  writer.Write(current_time_ms);
+  writer.Write(noise_estimates, sizeof(noise_estimates));
+  writer.Write(feature_provider.feature_data(), kFeatureElementCount);
+  writer.Write(static_cast<int32_t>(top_label_index));
+  writer.Write(ToRelativeTime(top_label_sample_index, current_sample_index));
+  writer.Write(results_count);
+  for (int i = 0; i < results_count; ++i) {
+    writer.Write(ToRelativeTime(results[i].time_, current_sample_index));
+    writer.Write(results[i].scores_, kCategoryCount);
+  }
+  const uint32_t total_size = writer.offset() + sizeof(uint32_t);
+  if (writer.overflowed() || (total_size > buffer_size)) {
+    error_reporter->Report("Warm state needs %d bytes, but only %d available",
+                           total_size, buffer_size);
+    return kTfLiteError;
+  }
+  memcpy(buffer + 12, &total_size, sizeof(total_size));
+  writer.Write(Fnv1a(buffer, writer.offset()));
+
+  *bytes_written = total_size;
+  return kTfLiteOk;
+}
+
+TfLiteStatus RestoreWarmState(tflite::ErrorReporter* error_reporter,
+                              const uint8_t* buffer, size_t buffer_size,
+                              int64_t current_sample_index,
+                              int64_t current_time_ms,
+                              uint64_t model_fingerprint,
+                              FeatureProvider* feature_provider,
+                              RecognizeCommands* recognizer) {
+  if (feature_provider->feature_size() != kFeatureElementCount) {
+    error_reporter->Report("Feature provider size %d doesn't match %d",
+                           feature_provider->feature_size(),
+                           kFeatureElementCount);
+    return kTfLiteError;
+  }
+
+  BlobReader reader(buffer, buffer_size);
+  uint32_t magic;
+  uint16_t version;
+  uint16_t header_size;
+  uint32_t fingerprint;
+  uint32_t total_size;
+  if (!reader.Read(&magic) || !reader.Read(&version) ||
+      !reader.Read(&header_size) || !reader.Read(&fingerprint) ||
+      !reader.Read(&total_size)) {
+    error_reporter->Report("Warm state of %d bytes is too small", buffer_size);
+    return kTfLiteError;
+  }
+  if (magic != kWarmStateMagic) {
+    error_reporter->Report("Warm state has a bad magic number");
+    return kTfLiteError;
+  }
+  if ((version != kWarmStateVersion) || (header_size != kHeaderSize)) {
+    error_reporter->Report("Warm state version %d isn't supported, expected %d",
+                           version, kWarmStateVersion);
+    return kTfLiteError;
+  }
+  if (fingerprint != SettingsFingerprint(model_fingerprint)) {
+    error_reporter->Report(
+        "Warm state was saved with different settings or another model");
+    return kTfLiteError;
+  }
+  if ((total_size > buffer_size) || (total_size < kHeaderSize + 4)) {
+    error_reporter->Report("Warm state claims %d bytes, but %d were given",
+                           total_size, buffer_size);
+    return kTfLiteError;
+  }
+  uint32_t checksum;
+  memcpy(&checksum, buffer + total_size - sizeof(checksum), sizeof(checksum));
+  if (checksum != Fnv1a(buffer, total_size - sizeof(checksum))) {
+    error_reporter->Report("Warm state checksum doesn't match");
+    return kTfLiteError;
+  }
+
+  int64_t saved_time_ms;
+  uint32_t noise_estimates[kFeatureSliceSize];
+  uint8_t feature_data[kFeatureElementCount];
+  int32_t top_label_index;
+  int64_t top_label_sample_index;
+  int32_t results_count;
+  bool read_ok = reader.Read(&saved_time_ms) &&
+                 reader.Read(noise_estimates, sizeof(noise_estimates)) &&
+                 reader.Read(feature_data, sizeof(feature_data)) &&
+                 reader.Read(&top_label_index) &&
+                 reader.Read(&top_label_sample_index) &&
+                 reader.Read(&results_count);
+  if (read_ok && ((results_count < 0) ||
+                  (results_count > PreviousResultsQueue::kMaxResults))) {
+    read_ok = false;
+  }
+  PreviousResultsQueue::Result results[PreviousResultsQueue::kMaxResults];
+  for (int i = 0; read_ok && (i < results_count); ++i) {
+    int64_t relative_index;
+    read_ok = reader.Read(&relative_index) &&
+              reader.Read(results[i].scores_, kCategoryCount);
+    results[i].time_ = FromRelativeTime(relative_index, current_sample_index);
+  }
+  if (!read_ok || (reader.offset() + sizeof(checksum) != total_size)) {
+    error_reporter->Report("Warm state contents are malformed");
+    return kTfLiteError;
+  }
+
+  // The frontend is the only part of the restore that can fail for reasons
+  // other than the snapshot's contents, so it's set up before anything is
+  // changed. After that, RestoreState() checks everything before it modifies
+  // the recognizer, and RestoreFeatureData() can't fail.
+  TfLiteStatus frontend_status =
+      feature_provider->InitializeFrontend(error_reporter);
+  if (frontend_status != kTfLiteOk) {
+    return frontend_status;
+  }
+  const bool is_fresh = (saved_time_ms >= 0) &&
+                        (current_time_ms >= saved_time_ms) &&
+                        (current_time_ms - saved_time_ms <=
+                         kWarmStateMaxFreshAgeMs);
+  if (!is_fresh) {
+    error_reporter->Report(
+        "Warm state is too old to reuse its spectrogram, or of unknown age, "
+        "so only its noise estimates are restored");
+    SetMicroFeaturesNoiseEstimates(noise_estimates);
+    return kTfLiteOk;
+  }
+  TfLiteStatus recognizer_status = recognizer->RestoreState(
+      results, results_count, top_label_index,
+      FromRelativeTime(top_label_sample_index, current_sample_index));
+  if (recognizer_status != kTfLiteOk) {
+    return recognizer_status;
+  }
+  return feature_provider->RestoreFeatureData(error_reporter, feature_data,
+                                              noise_estimates);
+}
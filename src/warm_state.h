@@ -0,0 +1,88 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_WARM_STATE_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_WARM_STATE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "feature_provider.h"
+#include "micro_model_settings.h"
+#include "recognize_commands.h"
+#include "tensorflow/lite/c/c_api_internal.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+
+// A warm-state snapshot holds everything the pipeline has learned about its
+// recent input: the frontend's noise-reduction estimates, the current
+// spectrogram, and the recognizer's averaging window. Restoring one after a
+// reboot means detection works straight away, rather than only once the noise
+// estimates have settled and a full second of audio has been seen.
+//
+// The snapshot is a flat blob in native byte order, with a version number and
+// a fingerprint of the settings in micro_model_settings.h, the frontend's
+// tables and the model, so snapshots written by a different build or for a
+// different model are rejected instead of misread. Times are kept
+// as sample offsets relative to when the snapshot was taken.
+//
+// The spectrogram and averaging window only describe the last second or so of
+// audio, so they're only restored if the snapshot is that recent, going by a
+// clock that keeps running across restarts. An older snapshot, or one whose
+// age can't be known, only restores the noise estimates, which change slowly.
+
+// Bump this whenever the layout written by SaveWarmState() changes.
+constexpr uint16_t kWarmStateVersion = 4;
+
+// The oldest snapshot whose spectrogram and results are still restored.
+constexpr int64_t kWarmStateMaxFreshAgeMs = 1000;
+
+// Upper bound on the number of bytes SaveWarmState() will write.
+constexpr size_t kWarmStateMaxSize =
+    16 + 8 + (kFeatureSliceSize * sizeof(uint32_t)) + kFeatureElementCount +
+    16 +
+    (PreviousResultsQueue::kMaxResults * (sizeof(int64_t) + kCategoryCount)) +
+    4;
+
+// Serializes the state of the feature provider, frontend and recognizer into
+// buffer. current_sample_index is the point on the LatestAudioSampleIndex()
+// clock that the state corresponds to, and current_time_ms the same moment on
+// a clock that survives a restart, or -1 if there isn't one. model_fingerprint
+// identifies the model whose scores the recognizer has seen, for example
+// ModelSwapper::active_fingerprint().
+TfLiteStatus SaveWarmState(tflite::ErrorReporter* error_reporter,
+                           const FeatureProvider& feature_provider,
+                           RecognizeCommands* recognizer,
+                           int64_t current_sample_index,
+                           int64_t current_time_ms, uint64_t model_fingerprint,
+                           uint8_t* buffer, size_t buffer_size,
+                           size_t* bytes_written);
+
+// Checks a snapshot written by SaveWarmState() and, if it's valid and matches
+// this build, loads it into the feature provider and recognizer. Saved times
+// are moved so the moment of the snapshot becomes current_sample_index.
+// current_time_ms is on the same clock as the one given to SaveWarmState(),
+// and if the snapshot is more than kWarmStateMaxFreshAgeMs older than that,
+// only the noise estimates are restored. Snapshots saved with a different
+// model_fingerprint are rejected. Nothing is modified if the snapshot is
+// rejected.
+TfLiteStatus RestoreWarmState(tflite::ErrorReporter* error_reporter,
+                              const uint8_t* buffer, size_t buffer_size,
+                              int64_t current_sample_index,
+                              int64_t current_time_ms,
+                              uint64_t model_fingerprint,
+                              FeatureProvider* feature_provider,
+                              RecognizeCommands* recognizer);
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_WARM_STATE_H_
@@ -0,0 +1,104 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "warm_state_storage.h"
+
+#if defined(ARDUINO)
+#include <Preferences.h>
+#else
+#include <cstdio>
+#endif
+
+namespace {
+// NVS namespace and key names are limited to 15 characters.
+constexpr char kWarmStateNamespace[] = "micro_speech";
+constexpr char kWarmStateKey[] = "warm_state";
+
+const char* g_warm_state_file_path = "micro_speech_warm_state.bin";
+}  // namespace
+
+void SetWarmStateFilePath(const char* path) { g_warm_state_file_path = path; }
+
+#if defined(ARDUINO)
+
+TfLiteStatus StoreWarmStateBlob(tflite::ErrorReporter* error_reporter,
+                                const uint8_t* blob, size_t blob_size) {
+  Preferences preferences;
+  if (!preferences.begin(kWarmStateNamespace, false)) {
+    error_reporter->Report("Couldn't open NVS namespace '%s'",
+                           kWarmStateNamespace);
+    return kTfLiteError;
+  }
+  const size_t written = preferences.putBytes(kWarmStateKey, blob, blob_size);
+  preferences.end();
+  if (written != blob_size) {
+    error_reporter->Report("Only wrote %d of %d warm state bytes to NVS",
+                           written, blob_size);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus LoadWarmStateBlob(tflite::ErrorReporter* error_reporter,
+                               uint8_t* buffer, size_t buffer_size,
+                               size_t* blob_size) {
+  Preferences preferences;
+  if (!preferences.begin(kWarmStateNamespace, true)) {
+    // The namespace only exists once something has been stored.
+    return kTfLiteError;
+  }
+  const size_t stored_size = preferences.getBytesLength(kWarmStateKey);
+  if ((stored_size == 0) || (stored_size > buffer_size)) {
+    preferences.end();
+    return kTfLiteError;
+  }
+  *blob_size = preferences.getBytes(kWarmStateKey, buffer, buffer_size);
+  preferences.end();
+  return (*blob_size == stored_size) ? kTfLiteOk : kTfLiteError;
+}
+
+#else  // defined(ARDUINO)
+
+TfLiteStatus StoreWarmStateBlob(tflite::ErrorReporter* error_reporter,
+                                const uint8_t* blob, size_t blob_size) {
+  FILE* file = fopen(g_warm_state_file_path, "wb");
+  if (file == nullptr) {
+    error_reporter->Report("Couldn't open '%s' for writing",
+                           g_warm_state_file_path);
+    return kTfLiteError;
+  }
+  const size_t written = fwrite(blob, 1, blob_size, file);
+  const bool closed = (fclose(file) == 0);
+  if ((written != blob_size) || !closed) {
+    error_reporter->Report("Writing warm state to '%s' failed",
+                           g_warm_state_file_path);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus LoadWarmStateBlob(tflite::ErrorReporter* error_reporter,
+                               uint8_t* buffer, size_t buffer_size,
+                               size_t* blob_size) {
+  FILE* file = fopen(g_warm_state_file_path, "rb");
+  if (file == nullptr) {
+    return kTfLiteError;
+  }
+  *blob_size = fread(buffer, 1, buffer_size, file);
+  fclose(file);
+  return (*blob_size > 0) ? kTfLiteOk : kTfLiteError;
+}
+
+#endif  // defined(ARDUINO)
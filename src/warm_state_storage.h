@@ -0,0 +1,40 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_WARM_STATE_STORAGE_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_WARM_STATE_STORAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensorflow/lite/c/c_api_internal.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+
+// Persists a warm-state blob (see warm_state.h) somewhere that survives a
+// reboot. On the device this is a blob in the NVS flash partition, elsewhere
+// it's a file, whose location can be changed with SetWarmStateFilePath().
+TfLiteStatus StoreWarmStateBlob(tflite::ErrorReporter* error_reporter,
+                                const uint8_t* blob, size_t blob_size);
+
+// Reads back the blob written by StoreWarmStateBlob(). Returns kTfLiteError if
+// nothing has been stored yet, or if it doesn't fit into buffer.
+TfLiteStatus LoadWarmStateBlob(tflite::ErrorReporter* error_reporter,
+                               uint8_t* buffer, size_t buffer_size,
+                               size_t* blob_size);
+
+// Only used when there's a file system rather than NVS.
+void SetWarmStateFilePath(const char* path);
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_WARM_STATE_STORAGE_H_
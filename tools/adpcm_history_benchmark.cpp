@@ -0,0 +1,180 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Measures how well AdpcmHistory compresses audio, how fast it encodes and
+// decodes, and how much it costs to pull out a window of audio at random. This
+// is a standalone host program, built from the project root with:
+//
+//   TFLM=.pio/libdeps/esp32s3/TensorFlowLite_ESP32/src
+//   g++ -O2 -I src -I tools -I $TFLM -o /tmp/adpcm_history_benchmark
+//       tools/adpcm_history_benchmark.cpp tools/wav_file.cpp
+//       src/adpcm_history.cpp src/audio_broadcast_ring.cpp
+//       $TFLM/tensorflow/lite/experimental/micro/micro_error_reporter.cpp
+//       $TFLM/tensorflow/lite/experimental/micro/debug_log.cpp
+//   /tmp/adpcm_history_benchmark [recording.wav]
+//
+// Without a recording it uses a minute of synthetic voiced audio, a train of
+// harmonics with a wandering pitch over a low noise floor.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "adpcm_history.h"
+#include "micro_model_settings.h"
+#include "wav_file.h"
+
+namespace {
+
+constexpr int kHistorySeconds = 30;
+constexpr int kAppendSize = 512;
+constexpr int kRandomReadCount = 2000;
+constexpr int kRandomReadSamples = kAudioSampleFrequency;
+constexpr int kRepetitions = 5;
+
+std::vector<int16_t> SynthesizeAudio(int sample_count) {
+  std::vector<int16_t> samples(sample_count);
+  double phase = 0.0;
+  srand(1);
+  for (int i = 0; i < sample_count; ++i) {
+    const double t = static_cast<double>(i) / kAudioSampleFrequency;
+    const double pitch = 140.0 + 40.0 * sin(2.0 * M_PI * 0.7 * t);
+    phase += 2.0 * M_PI * pitch / kAudioSampleFrequency;
+    double value = 0.0;
+    for (int harmonic = 1; harmonic <= 20; ++harmonic) {
+      value += sin(harmonic * phase) / harmonic;
+    }
+    const double envelope = 0.5 + 0.5 * sin(2.0 * M_PI * 2.5 * t);
+    const double noise = (rand() / static_cast<double>(RAND_MAX)) - 0.5;
+    samples[i] = static_cast<int16_t>(6000.0 * envelope * value + 200.0 * noise);
+  }
+  return samples;
+}
+
+double SecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  tflite::MicroErrorReporter micro_error_reporter;
+  tflite::ErrorReporter* error_reporter = &micro_error_reporter;
+
+  std::vector<int16_t> audio;
+  int sample_rate = kAudioSampleFrequency;
+  if (argc > 1) {
+    if (ReadWavFile(error_reporter, argv[1], &audio, &sample_rate) !=
+        kTfLiteOk) {
+      return 1;
+    }
+  } else {
+    audio = SynthesizeAudio(60 * kAudioSampleFrequency);
+  }
+  const int sample_count = static_cast<int>(audio.size());
+
+  // Size the history to hold the whole recording, so everything can be
+  // compared, or kHistorySeconds if that's longer.
+  int history_samples = kHistorySeconds * sample_rate;
+  if (history_samples < sample_count) {
+    history_samples = sample_count;
+  }
+  const size_t memory_size =
+      ((history_samples / kAdpcmBlockSamples) + 2) * kAdpcmBlockSize;
+  uint8_t* memory = AllocateAdpcmHistoryMemory(memory_size);
+  AdpcmHistory history;
+  if (history.Initialize(error_reporter, memory, memory_size) != kTfLiteOk) {
+    return 1;
+  }
+
+  double encode_seconds = 0.0;
+  for (int repetition = 0; repetition < kRepetitions; ++repetition) {
+    history.Reset(0);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < sample_count; i += kAppendSize) {
+      const int count =
+          (sample_count - i < kAppendSize) ? sample_count - i : kAppendSize;
+      history.Append(i, audio.data() + i, count);
+    }
+    encode_seconds += SecondsSince(start);
+  }
+  encode_seconds /= kRepetitions;
+
+  std::vector<int16_t> decoded(sample_count);
+  double decode_seconds = 0.0;
+  for (int repetition = 0; repetition < kRepetitions; ++repetition) {
+    const auto start = std::chrono::steady_clock::now();
+    if (history.Read(error_reporter, 0, sample_count, decoded.data()) !=
+        kTfLiteOk) {
+      return 1;
+    }
+    decode_seconds += SecondsSince(start);
+  }
+  decode_seconds /= kRepetitions;
+
+  double signal_energy = 0.0;
+  double error_energy = 0.0;
+  for (int i = 0; i < sample_count; ++i) {
+    const double error = static_cast<double>(audio[i]) - decoded[i];
+    signal_energy += static_cast<double>(audio[i]) * audio[i];
+    error_energy += error * error;
+  }
+
+  // Windows at random offsets, which is what pulling out the audio around a
+  // detection looks like.
+  double random_read_seconds = 0.0;
+  int random_reads = 0;
+  if (sample_count > kRandomReadSamples) {
+    std::vector<int16_t> window(kRandomReadSamples);
+    srand(2);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRandomReadCount; ++i) {
+      const int offset = rand() % (sample_count - kRandomReadSamples);
+      if (history.Read(error_reporter, offset, kRandomReadSamples,
+                       window.data()) != kTfLiteOk) {
+        return 1;
+      }
+      ++random_reads;
+    }
+    random_read_seconds = SecondsSince(start);
+  }
+
+  const double audio_seconds = static_cast<double>(sample_count) / sample_rate;
+  const double pcm_bytes = sample_count * sizeof(int16_t);
+  const double adpcm_bytes =
+      static_cast<double>(sample_count) * kAdpcmBlockSize / kAdpcmBlockSamples;
+  printf("Audio:             %.1f s at %d Hz\n", audio_seconds, sample_rate);
+  printf("Compression ratio: %.2f:1 (%.0f bytes per second)\n",
+         pcm_bytes / adpcm_bytes, adpcm_bytes / audio_seconds);
+  printf("Signal to noise:   %.1f dB\n",
+         10.0 * log10(signal_energy / (error_energy + 1e-9)));
+  printf("Encode:            %.1f Msamples/s, %.0fx real time\n",
+         sample_count / encode_seconds / 1e6, audio_seconds / encode_seconds);
+  printf("Decode:            %.1f Msamples/s, %.0fx real time\n",
+         sample_count / decode_seconds / 1e6, audio_seconds / decode_seconds);
+  if (random_reads > 0) {
+    printf("Random 1 s reads:  %.1f us each\n",
+           random_read_seconds / random_reads * 1e6);
+  }
+  printf("History memory:    %d bytes for %.1f s\n",
+         static_cast<int>(history.memory_used()),
+         static_cast<double>(history.capacity_samples()) / sample_rate);
+
+  free(memory);
+  return 0;
+}
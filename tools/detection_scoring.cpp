@@ -0,0 +1,87 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "detection_scoring.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "micro_model_settings.h"
+
+int FindCategory(const char* label) {
+  for (int i = 0; i < kCategoryCount; ++i) {
+    if (strcmp(label, kCategoryLabels[i]) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void DetectionScore::Add(const DetectionScore& other) {
+  true_accepts += other.true_accepts;
+  false_accepts += other.false_accepts;
+  misses += other.misses;
+  latency_sum += other.latency_sum;
+  max_latency = std::max(max_latency, other.max_latency);
+}
+
+double DetectionScore::Precision() const {
+  const int accepts = true_accepts + false_accepts;
+  return (accepts > 0) ? static_cast<double>(true_accepts) / accepts : 1.0;
+}
+
+double DetectionScore::Recall() const {
+  const int words = true_accepts + misses;
+  return (words > 0) ? static_cast<double>(true_accepts) / words : 1.0;
+}
+
+double DetectionScore::MeanLatencyMs() const {
+  return (true_accepts > 0) ? static_cast<double>(latency_sum) /
+                                  (true_accepts * kAudioSamplesPerMs)
+                            : 0.0;
+}
+
+DetectionScorer::DetectionScorer(const std::vector<LabelledWord>* words,
+                                 int64_t max_latency, DetectionScore* score)
+    : words_(words),
+      max_latency_(max_latency),
+      score_(score),
+      is_matched_(words->size(), false),
+      first_candidate_(0) {}
+
+void DetectionScorer::AddDetection(int64_t sample_index, int category) {
+  const std::vector<LabelledWord>& words = *words_;
+  // Words too old to match this command are too old for any later one too.
+  while ((first_candidate_ < words.size()) &&
+         (words[first_candidate_].sample_index < sample_index - max_latency_)) {
+    ++first_candidate_;
+  }
+  for (size_t i = first_candidate_;
+       (i < words.size()) && (words[i].sample_index <= sample_index); ++i) {
+    if (!is_matched_[i] && (words[i].category == category)) {
+      is_matched_[i] = true;
+      const int64_t latency = sample_index - words[i].sample_index;
+      ++score_->true_accepts;
+      score_->latency_sum += latency;
+      score_->max_latency = std::max(score_->max_latency, latency);
+      return;
+    }
+  }
+  ++score_->false_accepts;
+}
+
+void DetectionScorer::Finish() {
+  score_->misses += std::count(is_matched_.begin(), is_matched_.end(), false);
+}
@@ -0,0 +1,71 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_DETECTION_SCORING_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_DETECTION_SCORING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A keyword spoken in a recording, as the sample at which it starts and its
+// category.
+struct LabelledWord {
+  int64_t sample_index;
+  int category;
+};
+
+// Returns the category with this label, or -1 if there isn't one.
+int FindCategory(const char* label);
+
+// Tallies of how well reported commands matched the labelled words.
+struct DetectionScore {
+  int true_accepts = 0;
+  int false_accepts = 0;
+  int misses = 0;
+  // In samples, over the true accepts.
+  int64_t latency_sum = 0;
+  int64_t max_latency = 0;
+
+  void Add(const DetectionScore& other);
+  double Precision() const;
+  double Recall() const;
+  double MeanLatencyMs() const;
+};
+
+// Scores the commands reported over one recording. A command is a true accept
+// if a word with its category started at most max_latency samples before it
+// and hasn't been matched already, and its latency is the time between the
+// two. Every other command is a false accept, and every word left unmatched
+// by Finish() is a miss.
+class DetectionScorer {
+ public:
+  // words must be sorted by time, and stay alive while the scorer is used.
+  DetectionScorer(const std::vector<LabelledWord>* words, int64_t max_latency,
+                  DetectionScore* score);
+
+  // Commands must be added in time order.
+  void AddDetection(int64_t sample_index, int category);
+  void Finish();
+
+ private:
+  const std::vector<LabelledWord>* words_;
+  int64_t max_latency_;
+  DetectionScore* score_;
+  std::vector<bool> is_matched_;
+  size_t first_candidate_;
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_DETECTION_SCORING_H_
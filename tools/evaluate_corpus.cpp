@@ -0,0 +1,666 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Measures accuracy and speed together over a labelled corpus, by running the
+// device's pipeline on each recording through the file audio provider. This
+// is a standalone host program, built from the project root with:
+//
+//   TFLM=.pio/libdeps/esp32s3/TensorFlowLite_ESP32/src
+//   g++ -std=c++17 -O2 -march=native -pthread -I src -I tools -I $TFLM
+//       -o /tmp/evaluate_corpus tools/evaluate_corpus.cpp
+//       tools/detection_scoring.cpp tools/file_audio_provider.cpp
+//       tools/file_command_responder.cpp tools/wav_file.cpp
+//       src/allocation_guard.cpp src/audio_broadcast_ring.cpp
+//       src/audio_envelope.cpp
+//       src/feature_provider.cpp src/inference_scheduler.cpp
+//       src/memory_report.cpp
+//       src/micro_features_generator.cpp src/model_cascade.cpp
+//       src/model_storage.cpp
+//       src/micro_features_fft.cpp src/micro_features_channels.cpp
+//       src/micro_features_tables.cpp src/micro_model_settings.cpp
+//       src/recognize_commands.cpp src/resampler.cpp src/resampler_tables.cpp
+//       src/spectrogram_change_gate.cpp
+//       src/tiny_conv_micro_features_model_data.cpp
+//       $TFLM/tensorflow/lite/experimental/microfrontend/lib/log_lut.c
+//       $TFLM/tensorflow/lite/experimental/micro/*.cpp
+//       $TFLM/tensorflow/lite/experimental/micro/kernels/*.cpp
+//       $TFLM/tensorflow/lite/core/api/*.cpp
+//       $TFLM/tensorflow/lite/kernels/kernel_util.cpp
+//       $TFLM/tensorflow/lite/kernels/internal/quantization_util.cpp
+//       $TFLM/tensorflow/lite/c/c_api_internal.c
+//   /tmp/evaluate_corpus [--step_ms=MS] [--max_latency_ms=MS] [--verbose]
+//       [--check_allocations] [--overload_policy=every|skip|catch_up]
+//       [--deadline_ms=MS] [--max_inference_stride=N] [--gate_max_skip_ms=MS]
+//       [--gate_mean_change=N] [--gate_peak_change=N]
+//       [--first_stage_model=FILE.tflite] [--first_stage_threshold=N]
+//       [--model=FILE.tflite] manifest.txt
+//
+// Each line of the manifest names a WAV file, relative to the manifest's
+// directory, followed by the keywords spoken in it as pairs of the time in
+// seconds at which the word starts and its label, for example
+// "clips/lights.wav 1.25 on 4.80 off". Lines starting with '#' are ignored.
+//
+// Every recording is played from a fresh frontend, recognizer and audio
+// clock, with the clock moved on --step_ms at a time, one slice by default,
+// as it is on a device that keeps up with the microphone. Each step drains the
+// envelope channel, then does what loop() does until a pass has nothing left
+// to do: it asks the InferenceScheduler what to do, updates the spectrogram
+// with FeatureProvider, runs the model if the plan says to, and passes the
+// result through RecognizeCommands to RespondToCommandAtSample(). The commands
+// the responder acts on are scored as in detection_scoring.h.
+//
+// The clock stands still while a step is processed, so a --step_ms longer
+// than the scheduler's deadline stands in for a device that stalls between
+// passes. --overload_policy and --deadline_ms set how the scheduler copes, as
+// described in inference_scheduler.h, and its counters are included in the
+// report. The default policy is to process every slice.
+// --max_inference_stride lets the scheduler run the model less often while
+// it's quiet, down to once every N slices, so its effect on accuracy can be
+// weighed against the inferences it saves.
+//
+// --gate_max_skip_ms turns on the SpectrogramChangeGate, which reuses the last
+// scores while the spectrogram has moved by no more than --gate_mean_change
+// per feature on average and --gate_peak_change at most. Gating is off by
+// default. To see how the thresholds trade accuracy against CPU time, sweep
+// them and compare the Accuracy and Gating sections of each run:
+//
+//   for mean in 1 2 4 8; do
+//     /tmp/evaluate_corpus --gate_max_skip_ms=200 --gate_mean_change=$mean
+//         --gate_peak_change=$((mean * 12)) manifest.txt
+//   done
+//
+// --model evaluates the given .tflite file instead of the compiled-in model,
+// so a retrained model can be compared without rebuilding. Like any model
+// file given here, it's mapped with MapModel() rather than read into memory.
+//
+// --first_stage_model runs the model as a cascade, as model_cascade.h
+// describes, with the given .tflite file as its first stage. The main model
+// then only runs when the first stage gives the keywords a combined score of
+// at least --first_stage_threshold, 64 by default, and the report adds how
+// often that happened.
+//
+// The report gives the false accepts per hour and miss rate alongside the
+// real-time factor, the CPU time spent in each of those stages, and the
+// process's peak memory, so a change to any part of the pipeline can be judged
+// on both speed and accuracy from one run. It ends with the same memory report
+// the device prints, including how much of the tensor arena the model touched
+// over the whole corpus.
+//
+// --check_allocations makes sure the pipeline's steps stay off the heap, by
+// running each of them inside an allocation guard, and fails if any step
+// allocated. It needs the build flags given in allocation_guard.h, which also
+// make the timings a little slower.
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "allocation_guard.h"
+#include "audio_provider.h"
+#include "detection_scoring.h"
+#include "feature_provider.h"
+#include "file_audio_provider.h"
+#include "file_command_responder.h"
+#include "inference_scheduler.h"
+#include "memory_report.h"
+#include "micro_features_generator.h"
+#include "micro_model_settings.h"
+#include "model_cascade.h"
+#include "model_storage.h"
+#include "recognize_commands.h"
+#include "spectrogram_change_gate.h"
+#include "tiny_conv_micro_features_model_data.h"
+#include "tensorflow/lite/experimental/micro/kernels/micro_ops.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+#include "tensorflow/lite/experimental/micro/micro_interpreter.h"
+#include "tensorflow/lite/experimental/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+#include "tensorflow/lite/version.h"
+
+namespace {
+
+// The same size as the device's arena.
+constexpr int kTensorArenaSize = 10 * 1024;
+uint8_t g_tensor_arena[kTensorArenaSize];
+// The first stage of a cascade gets an arena of its own, as it would on the
+// device. It's given the same room, since its model is only known at run time.
+uint8_t g_first_stage_tensor_arena[kTensorArenaSize];
+
+struct ManifestEntry {
+  std::string path;
+  std::vector<LabelledWord> words;
+};
+
+enum Stage {
+  kAudioStage,
+  kFeatureStage,
+  kInferenceStage,
+  kRecognitionStage,
+  kStageCount,
+};
+
+const char* kStageNames[kStageCount] = {
+    "audio",
+    "features",
+    "inference",
+    "recognition",
+};
+
+struct StageTimes {
+  double seconds[kStageCount] = {};
+  int64_t calls[kStageCount] = {};
+};
+
+double ThreadCpuSeconds() {
+  timespec now;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+  return now.tv_sec + (now.tv_nsec * 1e-9);
+}
+
+// Adds the CPU time since it was constructed, or since the last Next(), to a
+// stage.
+class StageTimer {
+ public:
+  explicit StageTimer(StageTimes* times)
+      : times_(times), start_(ThreadCpuSeconds()) {}
+  void Next(Stage stage) {
+    const double now = ThreadCpuSeconds();
+    times_->seconds[stage] += now - start_;
+    ++times_->calls[stage];
+    start_ = now;
+  }
+
+ private:
+  StageTimes* times_;
+  double start_;
+};
+
+TfLiteStatus ReadManifest(tflite::ErrorReporter* error_reporter,
+                          const char* path,
+                          std::vector<ManifestEntry>* entries) {
+  FILE* file = fopen(path, "r");
+  if (file == nullptr) {
+    error_reporter->Report("Couldn't open '%s'", path);
+    return kTfLiteError;
+  }
+  std::string directory = path;
+  const size_t slash = directory.find_last_of('/');
+  directory = (slash == std::string::npos) ? "" : directory.substr(0, slash + 1);
+
+  char line[4096];
+  int line_number = 0;
+  TfLiteStatus status = kTfLiteOk;
+  while ((status == kTfLiteOk) && (fgets(line, sizeof(line), file) != nullptr)) {
+    ++line_number;
+    const char* kSeparators = " \t\r\n";
+    char* token = strtok(line, kSeparators);
+    if ((token == nullptr) || (token[0] == '#')) {
+      continue;
+    }
+    ManifestEntry entry;
+    entry.path = (token[0] == '/') ? token : directory + token;
+    while ((token = strtok(nullptr, kSeparators)) != nullptr) {
+      char* label = strtok(nullptr, kSeparators);
+      char* end;
+      const double seconds = strtod(token, &end);
+      LabelledWord word;
+      word.sample_index = static_cast<int64_t>(seconds * kAudioSampleFrequency);
+      word.category = (label != nullptr) ? FindCategory(label) : -1;
+      if ((*end != '\0') || (word.category < 0)) {
+        error_reporter->Report(
+            "Line %d of '%s' should have a time and a known label after the "
+            "file name",
+            line_number, path);
+        status = kTfLiteError;
+        break;
+      }
+      entry.words.push_back(word);
+    }
+    entries->push_back(entry);
+  }
+  fclose(file);
+  return status;
+}
+
+// Plays one recording through the pipeline, the way loop() would, and scores
+// the commands that come out of it.
+TfLiteStatus EvaluateRecording(
+    tflite::ErrorReporter* error_reporter, ModelCascade* model_cascade,
+    const ManifestEntry& entry, int step_samples, int64_t max_latency,
+    bool check_allocations, const InferenceSchedulerSettings& scheduler_settings,
+    const SpectrogramChangeGateSettings& gate_settings, StageTimes* times,
+    DetectionScore* score, InferenceSchedulerStats* scheduler_stats,
+    int64_t* invoked_count, int64_t* reused_count, int64_t* allocation_count) {
+  TfLiteStatus load_status = LoadAudioFile(error_reporter, entry.path.c_str());
+  if (load_status != kTfLiteOk) {
+    return load_status;
+  }
+  FeatureProvider feature_provider(kFeatureElementCount,
+                                   model_cascade->input_data());
+  RecognizeCommands recognizer(error_reporter);
+  InferenceScheduler scheduler(scheduler_settings);
+  SpectrogramChangeGate change_gate(gate_settings);
+  InitResponder();
+  AudioEnvelope envelopes[AudioEnvelopeChannel::kCapacity];
+  int64_t previous_sample_index = 0;
+
+  StageTimer timer(times);
+  while (true) {
+    ScopedAllocationGuard allocation_guard(check_allocations, kCountAllocations,
+                                           allocation_count);
+    if (AdvanceAudioClock(step_samples) == 0) {
+      break;
+    }
+    GetAudioEnvelopeChannel()->Receive(envelopes,
+                                       AudioEnvelopeChannel::kCapacity);
+    timer.Next(kAudioStage);
+
+    // The device calls loop() over and over, so passes carry on until one
+    // finds nothing to do.
+    while (true) {
+      InferencePlan plan;
+      scheduler.Plan(previous_sample_index, LatestAudioSampleIndex(),
+                     GetAudioRing()->oldest_safe_index(), &plan);
+      if ((plan.slice_count == 0) && !plan.run_inference) {
+        break;
+      }
+      const int64_t current_sample_index = plan.end_sample_index;
+      int how_many_new_slices = 0;
+      TfLiteStatus feature_status =
+          feature_provider.PopulateFeatureDataForSamples(
+              error_reporter, plan.start_sample_index, current_sample_index,
+              &how_many_new_slices);
+      if (feature_status != kTfLiteOk) {
+        return feature_status;
+      }
+      previous_sample_index = current_sample_index;
+      timer.Next(kFeatureStage);
+      if (!plan.run_inference) {
+        scheduler.Finish(plan, LatestAudioSampleIndex());
+        continue;
+      }
+
+      const uint8_t* scores = change_gate.previous_scores();
+      if (change_gate.ShouldInvoke(feature_provider.feature_data(),
+                                   current_sample_index)) {
+        TfLiteStatus invoke_status = model_cascade->Invoke(
+            error_reporter, feature_provider.feature_data(), &scores);
+        if (invoke_status != kTfLiteOk) {
+          return invoke_status;
+        }
+        change_gate.RecordOutput(feature_provider.feature_data(), scores,
+                                 current_sample_index);
+      }
+      scheduler.RecordScores(scores);
+      timer.Next(kInferenceStage);
+
+      const char* found_command = nullptr;
+      uint8_t command_score = 0;
+      bool is_new_command = false;
+      TfLiteStatus process_status = recognizer.ProcessLatestScoresAtSample(
+          scores, current_sample_index, &found_command, &command_score,
+          &is_new_command);
+      if (process_status != kTfLiteOk) {
+        return process_status;
+      }
+      RespondToCommandAtSample(error_reporter, current_sample_index,
+                               found_command, command_score, is_new_command);
+      scheduler.Finish(plan, LatestAudioSampleIndex());
+      timer.Next(kRecognitionStage);
+    }
+  }
+
+  const InferenceSchedulerStats& stats = scheduler.stats();
+  scheduler_stats->passes += stats.passes;
+  scheduler_stats->slices += stats.slices;
+  scheduler_stats->inferences += stats.inferences;
+  scheduler_stats->missed_deadlines += stats.missed_deadlines;
+  scheduler_stats->skipped_inferences += stats.skipped_inferences;
+  scheduler_stats->lost_slices += stats.lost_slices;
+  if (stats.max_backlog_slices > scheduler_stats->max_backlog_slices) {
+    scheduler_stats->max_backlog_slices = stats.max_backlog_slices;
+  }
+  *invoked_count += change_gate.invoked_count();
+  *reused_count += change_gate.reused_count();
+
+  std::vector<RespondedCommand> commands;
+  TakeRespondedCommands(&commands);
+  DetectionScorer scorer(&entry.words, max_latency, score);
+  for (const RespondedCommand& command : commands) {
+    scorer.AddDetection(command.sample_index, command.category);
+  }
+  scorer.Finish();
+  return kTfLiteOk;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  tflite::MicroErrorReporter micro_error_reporter;
+  tflite::ErrorReporter* error_reporter = &micro_error_reporter;
+
+  int step_ms = kFeatureSliceStrideMs;
+  int max_latency_ms = 1500;
+  bool verbose = false;
+  bool check_allocations = false;
+  InferenceSchedulerSettings scheduler_settings;
+  SpectrogramChangeGateSettings gate_settings;
+  const char* model_path = nullptr;
+  const char* first_stage_model_path = nullptr;
+  int first_stage_threshold = 64;
+  const char* policy_name = "every";
+  const char* manifest_path = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i], "--step_ms=", 10) == 0) {
+      step_ms = atoi(argv[i] + 10);
+    } else if (strncmp(argv[i], "--max_latency_ms=", 17) == 0) {
+      max_latency_ms = atoi(argv[i] + 17);
+    } else if (strcmp(argv[i], "--verbose") == 0) {
+      verbose = true;
+    } else if (strcmp(argv[i], "--check_allocations") == 0) {
+      check_allocations = true;
+    } else if (strncmp(argv[i], "--overload_policy=", 18) == 0) {
+      policy_name = argv[i] + 18;
+    } else if (strncmp(argv[i], "--deadline_ms=", 14) == 0) {
+      scheduler_settings.deadline_ms = atoi(argv[i] + 14);
+    } else if (strncmp(argv[i], "--max_inference_stride=", 23) == 0) {
+      scheduler_settings.max_inference_stride = atoi(argv[i] + 23);
+    } else if (strncmp(argv[i], "--gate_max_skip_ms=", 19) == 0) {
+      gate_settings.max_skip_ms = atoi(argv[i] + 19);
+    } else if (strncmp(argv[i], "--gate_mean_change=", 19) == 0) {
+      gate_settings.max_mean_change = atoi(argv[i] + 19);
+    } else if (strncmp(argv[i], "--gate_peak_change=", 19) == 0) {
+      gate_settings.max_peak_change = atoi(argv[i] + 19);
+    } else if (strncmp(argv[i], "--model=", 8) == 0) {
+      model_path = argv[i] + 8;
+    } else if (strncmp(argv[i], "--first_stage_model=", 20) == 0) {
+      first_stage_model_path = argv[i] + 20;
+    } else if (strncmp(argv[i], "--first_stage_threshold=", 24) == 0) {
+      first_stage_threshold = atoi(argv[i] + 24);
+    } else if (manifest_path == nullptr) {
+      manifest_path = argv[i];
+    } else {
+      manifest_path = nullptr;
+      break;
+    }
+  }
+  if (strcmp(policy_name, "every") == 0) {
+    scheduler_settings.policy = kProcessEverySlice;
+  } else if (strcmp(policy_name, "skip") == 0) {
+    scheduler_settings.policy = kSkipInferenceOnBacklog;
+  } else if (strcmp(policy_name, "catch_up") == 0) {
+    scheduler_settings.policy = kCatchUpFeaturesOnly;
+  } else {
+    manifest_path = nullptr;
+  }
+  if ((manifest_path == nullptr) || (step_ms < 1) ||
+      (first_stage_threshold < 0) || (first_stage_threshold > 255)) {
+    fprintf(stderr,
+            "Usage: %s [--step_ms=MS] [--max_latency_ms=MS] [--verbose] "
+            "[--check_allocations] [--overload_policy=every|skip|catch_up] "
+            "[--deadline_ms=MS] [--max_inference_stride=N] "
+            "[--gate_max_skip_ms=MS] [--gate_mean_change=N] "
+            "[--gate_peak_change=N] [--first_stage_model=FILE.tflite] "
+            "[--first_stage_threshold=N] [--model=FILE.tflite] "
+            "manifest.txt\n",
+            argv[0]);
+    return 1;
+  }
+  if (InferenceScheduler(scheduler_settings).CheckSettings(error_reporter) !=
+      kTfLiteOk) {
+    return 1;
+  }
+
+  if (check_allocations && !kAllocationGuardCompiledIn) {
+    fprintf(stderr,
+            "--check_allocations needs a build with "
+            "MICRO_SPEECH_ALLOCATION_GUARD, see allocation_guard.h\n");
+    return 1;
+  }
+
+  std::vector<ManifestEntry> entries;
+  if (ReadManifest(error_reporter, manifest_path, &entries) != kTfLiteOk) {
+    return 1;
+  }
+
+  MappedModel mapped_model;
+  if ((model_path != nullptr) &&
+      (MapModel(error_reporter, model_path, &mapped_model) != kTfLiteOk)) {
+    return 1;
+  }
+  const tflite::Model* model =
+      tflite::GetModel((model_path != nullptr)
+                           ? mapped_model.data
+                           : g_tiny_conv_micro_features_model_data);
+  if (model->version() != TFLITE_SCHEMA_VERSION) {
+    error_reporter->Report(
+        "Model provided is schema version %d not equal "
+        "to supported version %d.",
+        model->version(), TFLITE_SCHEMA_VERSION);
+    return 1;
+  }
+  tflite::MicroMutableOpResolver op_resolver;
+  op_resolver.AddBuiltin(tflite::BuiltinOperator_DEPTHWISE_CONV_2D,
+                         tflite::ops::micro::Register_DEPTHWISE_CONV_2D());
+  op_resolver.AddBuiltin(tflite::BuiltinOperator_FULLY_CONNECTED,
+                         tflite::ops::micro::Register_FULLY_CONNECTED());
+  op_resolver.AddBuiltin(tflite::BuiltinOperator_SOFTMAX,
+                         tflite::ops::micro::Register_SOFTMAX());
+  MemoryReport::Paint(g_tensor_arena, kTensorArenaSize);
+  tflite::MicroInterpreter interpreter(model, op_resolver, g_tensor_arena,
+                                       kTensorArenaSize, error_reporter);
+  if (interpreter.AllocateTensors() != kTfLiteOk) {
+    error_reporter->Report("AllocateTensors() failed");
+    return 1;
+  }
+
+  MappedModel first_stage_model_data;
+  std::unique_ptr<tflite::MicroInterpreter> first_stage_interpreter;
+  if (first_stage_model_path != nullptr) {
+    if (MapModel(error_reporter, first_stage_model_path,
+                 &first_stage_model_data) != kTfLiteOk) {
+      return 1;
+    }
+    const tflite::Model* first_stage_model =
+        tflite::GetModel(first_stage_model_data.data);
+    if (first_stage_model->version() != TFLITE_SCHEMA_VERSION) {
+      error_reporter->Report(
+          "First-stage model provided is schema version %d not equal "
+          "to supported version %d.",
+          first_stage_model->version(), TFLITE_SCHEMA_VERSION);
+      return 1;
+    }
+    MemoryReport::Paint(g_first_stage_tensor_arena, kTensorArenaSize);
+    first_stage_interpreter.reset(new tflite::MicroInterpreter(
+        first_stage_model, op_resolver, g_first_stage_tensor_arena,
+        kTensorArenaSize, error_reporter));
+    if (first_stage_interpreter->AllocateTensors() != kTfLiteOk) {
+      error_reporter->Report("First-stage AllocateTensors() failed");
+      return 1;
+    }
+  }
+  ModelCascade model_cascade(
+      (first_stage_interpreter != nullptr) ? first_stage_threshold : 0);
+  if (model_cascade.Initialize(error_reporter, first_stage_interpreter.get(),
+                               &interpreter) != kTfLiteOk) {
+    return 1;
+  }
+
+  const int step_samples = step_ms * kAudioSamplesPerMs;
+  const int64_t max_latency =
+      static_cast<int64_t>(max_latency_ms) * kAudioSamplesPerMs;
+  StageTimes times;
+  DetectionScore total_score;
+  int64_t total_samples = 0;
+  int word_count = 0;
+  int failures = 0;
+  int64_t allocation_count = 0;
+  InferenceSchedulerStats scheduler_stats;
+  int64_t invoked_count = 0;
+  int64_t reused_count = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (const ManifestEntry& entry : entries) {
+    DetectionScore score;
+    if (EvaluateRecording(error_reporter, &model_cascade, entry, step_samples,
+                          max_latency, check_allocations, scheduler_settings,
+                          gate_settings, &times, &score, &scheduler_stats,
+                          &invoked_count, &reused_count,
+                          &allocation_count) != kTfLiteOk) {
+      ++failures;
+      continue;
+    }
+    total_score.Add(score);
+    total_samples += AudioDataSampleCount();
+    word_count += entry.words.size();
+    if (verbose) {
+      printf("%s: %d true accepts, %d false accepts, %d misses\n",
+             entry.path.c_str(), score.true_accepts, score.false_accepts,
+             score.misses);
+    }
+  }
+  const double wall_seconds = std::chrono::duration<double>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count();
+
+  const double audio_seconds =
+      static_cast<double>(total_samples) / kAudioSampleFrequency;
+  const double hours = audio_seconds / 3600.0;
+  printf("Corpus: %d recordings, %.2f hours, %d words\n",
+         static_cast<int>(entries.size()) - failures, hours, word_count);
+  if (failures > 0) {
+    printf("%d recordings couldn't be read and were left out\n", failures);
+  }
+  printf("\nAccuracy\n");
+  printf("  true accepts %d, false accepts %d, misses %d\n",
+         total_score.true_accepts, total_score.false_accepts,
+         total_score.misses);
+  printf("  miss rate %.2f%%, false accepts per hour %.2f, precision %.2f%%\n",
+         100.0 * (1.0 - total_score.Recall()),
+         (hours > 0.0) ? total_score.false_accepts / hours : 0.0,
+         100.0 * total_score.Precision());
+  printf("  latency mean %.0f ms, max %.0f ms\n", total_score.MeanLatencyMs(),
+         static_cast<double>(total_score.max_latency) / kAudioSamplesPerMs);
+
+  double cpu_seconds = 0.0;
+  for (int stage = 0; stage < kStageCount; ++stage) {
+    cpu_seconds += times.seconds[stage];
+  }
+  printf("\nThroughput\n");
+  printf("  %.1f s wall, %.1f s CPU in the pipeline, %.0fx real time\n",
+         wall_seconds, cpu_seconds,
+         (wall_seconds > 0.0) ? audio_seconds / wall_seconds : 0.0);
+  for (int stage = 0; stage < kStageCount; ++stage) {
+    printf("  %-12s %8.2f s CPU %5.1f%%  %8.1f us per call\n",
+           kStageNames[stage], times.seconds[stage],
+           (cpu_seconds > 0.0) ? 100.0 * times.seconds[stage] / cpu_seconds
+                               : 0.0,
+           (times.calls[stage] > 0)
+               ? 1e6 * times.seconds[stage] / times.calls[stage]
+               : 0.0);
+  }
+
+  printf("\nScheduling with the %s policy and a %d ms deadline\n", policy_name,
+         scheduler_settings.deadline_ms);
+  printf("  %lld slices, backlog up to %lld slices\n",
+         static_cast<long long>(scheduler_stats.slices),
+         static_cast<long long>(scheduler_stats.max_backlog_slices));
+  printf("  %lld inferences, one every %.2f slices\n",
+         static_cast<long long>(scheduler_stats.inferences),
+         (scheduler_stats.inferences > 0)
+             ? static_cast<double>(scheduler_stats.slices) /
+                   scheduler_stats.inferences
+             : 0.0);
+  printf("  %lld missed deadlines, %lld skipped inferences, %lld lost slices\n",
+         static_cast<long long>(scheduler_stats.missed_deadlines),
+         static_cast<long long>(scheduler_stats.skipped_inferences),
+         static_cast<long long>(scheduler_stats.lost_slices));
+
+  // The inference stage's CPU time above already reflects the reused results,
+  // so this is the other half of the trade-off against the accuracy figures.
+  const int64_t gated_count = invoked_count + reused_count;
+  if (gate_settings.max_skip_ms > 0) {
+    printf("\nGating for up to %d ms, mean change %d, peak change %d\n",
+           gate_settings.max_skip_ms, gate_settings.max_mean_change,
+           gate_settings.max_peak_change);
+  } else {
+    printf("\nGating off\n");
+  }
+  printf("  %lld inferences run, %lld reused (%.1f%%), %.1f us per result\n",
+         static_cast<long long>(invoked_count),
+         static_cast<long long>(reused_count),
+         (gated_count > 0) ? 100.0 * reused_count / gated_count : 0.0,
+         (gated_count > 0) ? 1e6 * times.seconds[kInferenceStage] / gated_count
+                           : 0.0);
+
+  // Accuracy above is end to end, so with a cascade it already includes
+  // anything the first stage turned away.
+  if (first_stage_interpreter != nullptr) {
+    printf("\nCascade with a first-stage threshold of %d\n",
+           first_stage_threshold);
+    printf("  %lld first-stage inferences, %lld passed to the second stage "
+           "(%.1f%%)\n",
+           static_cast<long long>(model_cascade.first_stage_count()),
+           static_cast<long long>(model_cascade.second_stage_count()),
+           (model_cascade.first_stage_count() > 0)
+               ? 100.0 * model_cascade.second_stage_count() /
+                     model_cascade.first_stage_count()
+               : 0.0);
+  } else {
+    printf("\nNo cascade\n");
+    printf("  %lld inferences of the main model\n",
+           static_cast<long long>(model_cascade.second_stage_count()));
+  }
+
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  printf("\nMemory\n");
+  printf("  peak resident %ld KB\n", usage.ru_maxrss);
+  // Each recording had a recognizer of its own, so one is made here for the
+  // report to measure.
+  RecognizeCommands recognizer(error_reporter);
+  MemoryReport memory_report;
+  memory_report.AddRegion("tensor arena", g_tensor_arena, kTensorArenaSize,
+                          true);
+  if (first_stage_interpreter != nullptr) {
+    memory_report.AddRegion("first-stage model", first_stage_model_data.data,
+                            first_stage_model_data.size);
+    memory_report.AddRegion("first-stage tensor arena",
+                            g_first_stage_tensor_arena, kTensorArenaSize, true);
+  }
+  memory_report.AddRegion("spectrogram", model_cascade.input_data(),
+                          kFeatureElementCount);
+  AddAudioMemoryRegions(&memory_report);
+  AddMicroFeaturesMemoryRegions(&memory_report);
+  memory_report.AddRegion("recognizer results queue", &recognizer,
+                          sizeof(recognizer));
+  fflush(stdout);
+  memory_report.Report(error_reporter);
+  if (check_allocations) {
+    printf("  %lld heap allocations in %lld pipeline steps\n",
+           static_cast<long long>(allocation_count),
+           static_cast<long long>(times.calls[kAudioStage]));
+    if (allocation_count > 0) {
+      return 1;
+    }
+  }
+  return 0;
+}
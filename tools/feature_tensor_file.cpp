@@ -0,0 +1,217 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "feature_tensor_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "frontend_fingerprint.h"
+#include "micro_model_settings.h"
+
+namespace {
+
+static_assert(sizeof(FeatureTensorHeader) == kFeatureTensorAlignment,
+              "The header fills exactly one aligned block");
+
+uint64_t AlignUp(uint64_t offset) {
+  return (offset + kFeatureTensorAlignment - 1) &
+         ~static_cast<uint64_t>(kFeatureTensorAlignment - 1);
+}
+
+bool PadTo(FILE* file, uint64_t offset) {
+  static const uint8_t kZeros[kFeatureTensorAlignment] = {};
+  const long position = ftell(file);
+  if (position < 0) {
+    return false;
+  }
+  const size_t padding = offset - position;
+  return fwrite(kZeros, 1, padding, file) == padding;
+}
+
+}  // namespace
+
+FeatureTensorWriter::FeatureTensorWriter()
+    : file_(nullptr), features_size_(0) {}
+
+FeatureTensorWriter::~FeatureTensorWriter() {
+  if (file_ != nullptr) {
+    fclose(file_);
+  }
+}
+
+TfLiteStatus FeatureTensorWriter::Open(tflite::ErrorReporter* error_reporter,
+                                       const char* path) {
+  file_ = fopen(path, "wb");
+  if (file_ == nullptr) {
+    error_reporter->Report("Couldn't open '%s' for writing", path);
+    return kTfLiteError;
+  }
+  features_size_ = 0;
+  clips_.clear();
+  names_.clear();
+  // The header is filled in by Close(), once the offsets are known.
+  if (!PadTo(file_, sizeof(FeatureTensorHeader))) {
+    error_reporter->Report("Couldn't write to '%s'", path);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus FeatureTensorWriter::AppendClip(
+    tflite::ErrorReporter* error_reporter, const std::string& name,
+    const uint8_t* features, int slice_count, int sample_count) {
+  const size_t size = static_cast<size_t>(slice_count) * kFeatureSliceSize;
+  if (fwrite(features, 1, size, file_) != size) {
+    error_reporter->Report("Couldn't write the features of '%s'",
+                           name.c_str());
+    return kTfLiteError;
+  }
+  FeatureTensorClip clip;
+  clip.feature_offset = features_size_;
+  clip.name_offset = names_.size();
+  clip.slice_count = slice_count;
+  clip.sample_count = sample_count;
+  clips_.push_back(clip);
+  names_.append(name.c_str(), name.size() + 1);
+  features_size_ += size;
+  return kTfLiteOk;
+}
+
+TfLiteStatus FeatureTensorWriter::Close(tflite::ErrorReporter* error_reporter) {
+  FeatureTensorHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = kFeatureTensorMagic;
+  header.version = kFeatureTensorVersion;
+  header.settings_fingerprint = FrontendSettingsFingerprint();
+  header.slice_size = kFeatureSliceSize;
+  header.clip_count = clips_.size();
+  header.features_offset = sizeof(FeatureTensorHeader);
+  header.index_offset = AlignUp(header.features_offset + features_size_);
+  header.names_offset =
+      AlignUp(header.index_offset + (clips_.size() * sizeof(FeatureTensorClip)));
+  header.file_size = header.names_offset + names_.size();
+
+  const bool written =
+      PadTo(file_, header.index_offset) &&
+      (fwrite(clips_.data(), sizeof(FeatureTensorClip), clips_.size(),
+              file_) == clips_.size()) &&
+      PadTo(file_, header.names_offset) &&
+      (fwrite(names_.data(), 1, names_.size(), file_) == names_.size()) &&
+      (fseek(file_, 0, SEEK_SET) == 0) &&
+      (fwrite(&header, sizeof(header), 1, file_) == 1);
+  const bool closed = (fclose(file_) == 0);
+  file_ = nullptr;
+  if (!written || !closed) {
+    error_reporter->Report("Couldn't finish writing the feature tensor file");
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+FeatureTensorFile::FeatureTensorFile()
+    : data_(nullptr), size_(0), header_(nullptr), index_(nullptr) {}
+
+FeatureTensorFile::~FeatureTensorFile() { Close(); }
+
+TfLiteStatus FeatureTensorFile::Open(tflite::ErrorReporter* error_reporter,
+                                     const char* path) {
+  Close();
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    error_reporter->Report("Couldn't open '%s'", path);
+    return kTfLiteError;
+  }
+  struct stat file_stat;
+  if ((fstat(fd, &file_stat) != 0) ||
+      (file_stat.st_size < static_cast<off_t>(sizeof(FeatureTensorHeader)))) {
+    close(fd);
+    error_reporter->Report("'%s' is too small to be a feature tensor file",
+                           path);
+    return kTfLiteError;
+  }
+  size_ = file_stat.st_size;
+  void* mapping = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    error_reporter->Report("Couldn't map '%s'", path);
+    return kTfLiteError;
+  }
+  data_ = static_cast<const uint8_t*>(mapping);
+  header_ = reinterpret_cast<const FeatureTensorHeader*>(data_);
+
+  if ((header_->magic != kFeatureTensorMagic) ||
+      (header_->version != kFeatureTensorVersion)) {
+    error_reporter->Report("'%s' isn't a version %d feature tensor file", path,
+                           kFeatureTensorVersion);
+    Close();
+    return kTfLiteError;
+  }
+  if ((header_->settings_fingerprint != FrontendSettingsFingerprint()) ||
+      (header_->slice_size != kFeatureSliceSize)) {
+    error_reporter->Report("'%s' was written with different frontend settings",
+                           path);
+    Close();
+    return kTfLiteError;
+  }
+  if (!IsWellFormed()) {
+    error_reporter->Report("'%s' is truncated or corrupt", path);
+    Close();
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+bool FeatureTensorFile::IsWellFormed() {
+  if ((header_->file_size != size_) ||
+      (header_->features_offset > header_->index_offset) ||
+      (header_->index_offset > header_->names_offset) ||
+      (header_->names_offset > size_) ||
+      ((header_->names_offset - header_->index_offset) /
+           sizeof(FeatureTensorClip) <
+       header_->clip_count) ||
+      ((header_->clip_count > 0) && (data_[size_ - 1] != '\0'))) {
+    return false;
+  }
+  index_ = reinterpret_cast<const FeatureTensorClip*>(data_ +
+                                                      header_->index_offset);
+  const uint64_t features_size =
+      header_->index_offset - header_->features_offset;
+  const uint64_t names_size = size_ - header_->names_offset;
+  for (uint64_t clip = 0; clip < header_->clip_count; ++clip) {
+    const uint64_t clip_size =
+        static_cast<uint64_t>(index_[clip].slice_count) * kFeatureSliceSize;
+    if ((index_[clip].feature_offset > features_size) ||
+        (clip_size > features_size - index_[clip].feature_offset) ||
+        (index_[clip].name_offset >= names_size)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void FeatureTensorFile::Close() {
+  if (data_ != nullptr) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  header_ = nullptr;
+  index_ = nullptr;
+}
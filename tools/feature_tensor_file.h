@@ -0,0 +1,126 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_FEATURE_TENSOR_FILE_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_FEATURE_TENSOR_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/c/c_api_internal.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+
+// A file of spectrograms for a corpus of clips, as the device's frontend
+// computes them, laid out so it can be memory-mapped and used in place by a
+// training pipeline, for example with numpy.memmap. In order, it holds:
+//
+//   header    FeatureTensorHeader, padded to kFeatureTensorAlignment bytes
+//   features  every clip's slices of kFeatureSliceSize uint8_t features, back
+//             to back, oldest slice first
+//   index     header.clip_count FeatureTensorClip entries
+//   names     each clip's path, relative to the corpus root, NUL-terminated
+//
+// Offsets are in bytes from the start of the file, and the sections are
+// aligned to kFeatureTensorAlignment. Integers are in native byte order, which
+// is little-endian on every host this runs on.
+
+constexpr uint32_t kFeatureTensorMagic = 0x5446534d;  // "MSFT"
+constexpr uint32_t kFeatureTensorVersion = 1;
+constexpr size_t kFeatureTensorAlignment = 64;
+
+struct FeatureTensorHeader {
+  uint32_t magic;
+  uint32_t version;
+  // FrontendSettingsFingerprint(), from frontend_fingerprint.h, of the build
+  // that wrote the file.
+  uint64_t settings_fingerprint;
+  uint32_t slice_size;
+  uint32_t reserved;
+  uint64_t clip_count;
+  uint64_t features_offset;
+  uint64_t index_offset;
+  uint64_t names_offset;
+  uint64_t file_size;
+};
+
+struct FeatureTensorClip {
+  uint64_t feature_offset;
+  uint64_t name_offset;
+  uint32_t slice_count;
+  // Length of the audio that was featurized, at kAudioSampleFrequency.
+  uint32_t sample_count;
+};
+
+// Writes a feature tensor file one clip at a time. The features are streamed
+// straight to disk, and the index and names are added by Close().
+class FeatureTensorWriter {
+ public:
+  FeatureTensorWriter();
+  ~FeatureTensorWriter();
+
+  TfLiteStatus Open(tflite::ErrorReporter* error_reporter, const char* path);
+  TfLiteStatus AppendClip(tflite::ErrorReporter* error_reporter,
+                          const std::string& name, const uint8_t* features,
+                          int slice_count, int sample_count);
+  TfLiteStatus Close(tflite::ErrorReporter* error_reporter);
+
+  uint64_t clip_count() const { return clips_.size(); }
+
+ private:
+  FILE* file_;
+  uint64_t features_size_;
+  std::vector<FeatureTensorClip> clips_;
+  std::string names_;
+};
+
+// Maps a feature tensor file into memory, read-only, after checking that it
+// was written with this build's frontend settings.
+class FeatureTensorFile {
+ public:
+  FeatureTensorFile();
+  ~FeatureTensorFile();
+
+  TfLiteStatus Open(tflite::ErrorReporter* error_reporter, const char* path);
+  void Close();
+
+  uint64_t clip_count() const { return header_->clip_count; }
+  const char* clip_name(uint64_t clip) const {
+    return reinterpret_cast<const char*>(data_ + header_->names_offset +
+                                         index_[clip].name_offset);
+  }
+  int clip_slice_count(uint64_t clip) const {
+    return index_[clip].slice_count;
+  }
+  int clip_sample_count(uint64_t clip) const {
+    return index_[clip].sample_count;
+  }
+  const uint8_t* clip_features(uint64_t clip) const {
+    return data_ + header_->features_offset + index_[clip].feature_offset;
+  }
+
+ private:
+  // Checks the offsets in the header and index all land inside the file.
+  bool IsWellFormed();
+
+  const uint8_t* data_;
+  size_t size_;
+  const FeatureTensorHeader* header_;
+  const FeatureTensorClip* index_;
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_FEATURE_TENSOR_FILE_H_
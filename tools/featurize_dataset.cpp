@@ -0,0 +1,301 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Featurizes a corpus of WAV files with this project's frontend, so models can
+// be trained on exactly the features the device will compute. This is a
+// standalone host program, built from the project root with:
+//
+//   TFLM=.pio/libdeps/esp32s3/TensorFlowLite_ESP32/src
+//   g++ -std=c++17 -O2 -march=native -pthread -I src -I tools -I $TFLM
+//       -o /tmp/featurize_dataset tools/featurize_dataset.cpp
+//       tools/feature_tensor_file.cpp tools/spectrogram_cache.cpp
+//       tools/wav_file.cpp src/frontend_fingerprint.cpp src/memory_report.cpp
+//       src/micro_features_generator.cpp src/micro_features_fft.cpp
+//       src/micro_features_channels.cpp src/micro_features_tables.cpp
+//       src/resampler.cpp src/resampler_tables.cpp
+//       $TFLM/tensorflow/lite/experimental/microfrontend/lib/log_lut.c
+//       $TFLM/tensorflow/lite/experimental/micro/micro_error_reporter.cpp
+//       $TFLM/tensorflow/lite/experimental/micro/debug_log.cpp
+//   /tmp/featurize_dataset [--threads=N] [--whole_clips] [--cache=dir]
+//       wav_dir output_file
+//
+// Every .wav file under wav_dir is read, resampled to kAudioSampleFrequency if
+// needed, and run through ComputeSpectrogram() from a reset frontend. As in the
+// training pipeline, clips are cut or zero-padded to one second, giving
+// kFeatureSliceCount slices each, unless --whole_clips is given, in which case
+// every clip keeps its full length. The results go into a feature tensor file,
+// described in feature_tensor_file.h, with clips in sorted path order.
+//
+// Clips are spread over all cores, or --threads of them. Each worker has its
+// own frontend workspace and resampler, and finished clips are written in
+// order as they arrive, with only a bounded number held in memory at once.
+//
+// With --cache, spectrograms are looked up in a SpectrogramCache in that
+// directory before being computed, and new ones are added to it, so running
+// again over mostly the same audio only featurizes what has changed.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "feature_tensor_file.h"
+#include "micro_features_generator.h"
+#include "micro_model_settings.h"
+#include "resampler.h"
+#include "spectrogram_cache.h"
+#include "wav_file.h"
+
+namespace {
+
+// How far ahead of the writer the workers can get.
+constexpr size_t kMaxClipsInFlight = 4096;
+
+struct ClipResult {
+  bool is_done = false;
+  bool is_ok = false;
+  int sample_count = 0;
+  std::vector<uint8_t> features;
+};
+
+// Everything the workers and the writer share.
+struct FeaturizeJob {
+  std::vector<std::string> paths;
+  std::vector<ClipResult> results;
+  std::string root;
+  bool whole_clips = false;
+  SpectrogramCache* cache = nullptr;
+  std::mutex mutex;
+  std::condition_variable changed;
+  size_t next_clip = 0;
+  size_t next_to_write = 0;
+};
+
+bool IsWavFile(const std::filesystem::path& path) {
+  std::string extension = path.extension().string();
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return extension == ".wav";
+}
+
+TfLiteStatus FeaturizeClip(tflite::ErrorReporter* error_reporter,
+                           const std::string& path, bool whole_clips,
+                           SpectrogramCache* cache,
+                           PolyphaseResampler* resampler,
+                           std::vector<int16_t>* samples,
+                           std::vector<int16_t>* resampled,
+                           MicroFeaturesWorkspace* workspace,
+                           ClipResult* result) {
+  int sample_rate;
+  TfLiteStatus read_status =
+      ReadWavFile(error_reporter, path.c_str(), samples, &sample_rate);
+  if (read_status != kTfLiteOk) {
+    return read_status;
+  }
+  TfLiteStatus resampler_status =
+      resampler->Initialize(error_reporter, sample_rate);
+  if (resampler_status != kTfLiteOk) {
+    return resampler_status;
+  }
+  resampled->resize(resampler->MaxOutputCount(samples->size()));
+  resampled->resize(
+      resampler->Process(samples->data(), samples->size(), resampled->data()));
+  if (!whole_clips) {
+    resampled->resize(kAudioSampleFrequency, 0);
+  } else if (resampled->size() < kFeatureSliceDurationSamples) {
+    resampled->resize(kFeatureSliceDurationSamples, 0);
+  }
+
+  result->sample_count = resampled->size();
+  if (cache != nullptr) {
+    const uint8_t* features;
+    int slice_count;
+    TfLiteStatus cache_status =
+        cache->GetSpectrogram(error_reporter, resampled->data(),
+                              resampled->size(), workspace, &features,
+                              &slice_count);
+    if (cache_status != kTfLiteOk) {
+      return cache_status;
+    }
+    result->features.assign(features,
+                            features + (slice_count * kFeatureSliceSize));
+    return kTfLiteOk;
+  }
+  result->features.resize(MicroFeaturesSliceCount(resampled->size()) *
+                          kFeatureSliceSize);
+  ResetMicroFeaturesWorkspace(workspace);
+  return ComputeSpectrogram(error_reporter, resampled->data(),
+                            resampled->size(), workspace,
+                            result->features.data(), result->features.size());
+}
+
+void RunWorker(FeaturizeJob* job) {
+  tflite::MicroErrorReporter micro_error_reporter;
+  PolyphaseResampler resampler;
+  std::vector<int16_t> samples;
+  std::vector<int16_t> resampled;
+  MicroFeaturesWorkspace workspace;
+  while (true) {
+    size_t clip;
+    {
+      std::unique_lock<std::mutex> lock(job->mutex);
+      job->changed.wait(lock, [job] {
+        return (job->next_clip >= job->paths.size()) ||
+               (job->next_clip < job->next_to_write + kMaxClipsInFlight);
+      });
+      if (job->next_clip >= job->paths.size()) {
+        return;
+      }
+      clip = job->next_clip++;
+    }
+    ClipResult result;
+    result.is_ok = (FeaturizeClip(&micro_error_reporter, job->paths[clip],
+                                  job->whole_clips, job->cache, &resampler, &samples,
+                                  &resampled, &workspace,
+                                  &result) == kTfLiteOk);
+    result.is_done = true;
+    {
+      std::lock_guard<std::mutex> lock(job->mutex);
+      job->results[clip] = std::move(result);
+    }
+    job->changed.notify_all();
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  tflite::MicroErrorReporter micro_error_reporter;
+  tflite::ErrorReporter* error_reporter = &micro_error_reporter;
+
+  FeaturizeJob job;
+  int thread_count = std::thread::hardware_concurrency();
+  const char* cache_directory = nullptr;
+  std::vector<const char*> positional;
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i], "--threads=", 10) == 0) {
+      thread_count = atoi(argv[i] + 10);
+    } else if (strcmp(argv[i], "--whole_clips") == 0) {
+      job.whole_clips = true;
+    } else if (strncmp(argv[i], "--cache=", 8) == 0) {
+      cache_directory = argv[i] + 8;
+    } else {
+      positional.push_back(argv[i]);
+    }
+  }
+  if (positional.size() != 2) {
+    fprintf(stderr,
+            "Usage: %s [--threads=N] [--whole_clips] [--cache=dir] wav_dir "
+            "output_file\n",
+            argv[0]);
+    return 1;
+  }
+  if (thread_count < 1) {
+    thread_count = 1;
+  }
+
+  job.root = positional[0];
+  std::error_code error;
+  for (std::filesystem::recursive_directory_iterator it(job.root, error), end;
+       !error && (it != end); it.increment(error)) {
+    if (it->is_regular_file() && IsWavFile(it->path())) {
+      job.paths.push_back(it->path().string());
+    }
+  }
+  if (error) {
+    fprintf(stderr, "Couldn't read '%s': %s\n", positional[0],
+            error.message().c_str());
+    return 1;
+  }
+  std::sort(job.paths.begin(), job.paths.end());
+  job.results.resize(job.paths.size());
+
+  SpectrogramCache cache;
+  if (cache_directory != nullptr) {
+    std::filesystem::create_directories(cache_directory, error);
+    if (cache.Open(error_reporter, cache_directory) != kTfLiteOk) {
+      return 1;
+    }
+    job.cache = &cache;
+  }
+
+  FeatureTensorWriter writer;
+  if (writer.Open(error_reporter, positional[1]) != kTfLiteOk) {
+    return 1;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (int i = 0; i < thread_count; ++i) {
+    workers.emplace_back(RunWorker, &job);
+  }
+  int failures = 0;
+  bool write_failed = false;
+  for (size_t clip = 0; clip < job.paths.size(); ++clip) {
+    ClipResult result;
+    {
+      std::unique_lock<std::mutex> lock(job.mutex);
+      job.changed.wait(lock, [&job, clip] { return job.results[clip].is_done; });
+      result = std::move(job.results[clip]);
+      job.results[clip] = ClipResult();
+      job.next_to_write = clip + 1;
+    }
+    job.changed.notify_all();
+    if (!result.is_ok) {
+      ++failures;
+      continue;
+    }
+    if (!write_failed) {
+      const std::string name =
+          std::filesystem::relative(job.paths[clip], job.root).string();
+      write_failed =
+          (writer.AppendClip(error_reporter, name, result.features.data(),
+                             result.features.size() / kFeatureSliceSize,
+                             result.sample_count) != kTfLiteOk);
+    }
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  if (write_failed || (writer.Close(error_reporter) != kTfLiteOk)) {
+    return 1;
+  }
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+
+  printf("Featurized %d clips in %.1f s with %d threads, %.0f clips/s\n",
+         static_cast<int>(writer.clip_count()), seconds, thread_count,
+         writer.clip_count() / seconds);
+  if (job.cache != nullptr) {
+    printf("Cache hits: %d, misses: %d, entries: %d\n",
+           static_cast<int>(cache.hit_count()),
+           static_cast<int>(cache.miss_count()),
+           static_cast<int>(cache.entry_count()));
+  }
+  if (failures > 0) {
+    printf("%d files couldn't be read and were left out\n", failures);
+  }
+  return 0;
+}
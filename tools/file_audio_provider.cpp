@@ -0,0 +1,165 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "file_audio_provider.h"
+
+#include <cstring>
+#include <vector>
+
+#include "micro_model_settings.h"
+#include "resampler.h"
+#include "wav_file.h"
+
+namespace {
+
+// The ring gets the same amount of audio as the live provider's, and is fed
+// in blocks of the same size as the clock advances.
+constexpr int kAudioRingSize = 8192;
+constexpr int kAudioRingWriteSize = 512;
+
+std::vector<int16_t> g_audio_data;
+int64_t g_latest_audio_sample_index = 0;
+int16_t g_audio_output_buffer[kMaxAudioSampleSize];
+int16_t g_audio_ring_buffer[kAudioRingSize];
+AudioBroadcastRing g_audio_ring(g_audio_ring_buffer, kAudioRingSize,
+                                kAudioRingWriteSize);
+AudioEnvelopeChannel g_audio_envelope_channel;
+
+}  // namespace
+
+TfLiteStatus LoadAudioFile(tflite::ErrorReporter* error_reporter,
+                           const char* path) {
+  std::vector<int16_t> samples;
+  int sample_rate;
+  TfLiteStatus read_status =
+      ReadWavFile(error_reporter, path, &samples, &sample_rate);
+  if (read_status != kTfLiteOk) {
+    return read_status;
+  }
+  return LoadAudioData(error_reporter, samples.data(), samples.size(),
+                       sample_rate);
+}
+
+TfLiteStatus LoadAudioData(tflite::ErrorReporter* error_reporter,
+                           const int16_t* samples, int sample_count,
+                           int sample_rate) {
+  PolyphaseResampler resampler;
+  TfLiteStatus resampler_status =
+      resampler.Initialize(error_reporter, sample_rate);
+  if (resampler_status != kTfLiteOk) {
+    return resampler_status;
+  }
+  g_audio_data.resize(resampler.MaxOutputCount(sample_count));
+  g_audio_data.resize(
+      resampler.Process(samples, sample_count, g_audio_data.data()));
+  g_latest_audio_sample_index = 0;
+  g_audio_ring.Reset();
+  g_audio_envelope_channel.Reset();
+  return kTfLiteOk;
+}
+
+int64_t AdvanceAudioClock(int64_t sample_count) {
+  const int64_t remaining =
+      static_cast<int64_t>(g_audio_data.size()) - g_latest_audio_sample_index;
+  const int64_t advance = (sample_count < remaining) ? sample_count : remaining;
+  for (int64_t written = 0; written < advance;) {
+    const int64_t remaining_advance = advance - written;
+    const int count = (remaining_advance < kAudioRingWriteSize)
+                          ? static_cast<int>(remaining_advance)
+                          : kAudioRingWriteSize;
+    const int16_t* block = &g_audio_data[g_latest_audio_sample_index + written];
+    AudioEnvelope envelope;
+    ComputeAudioEnvelope(block, count, g_audio_ring.write_index(), &envelope);
+    g_audio_ring.Write(block, count);
+    g_audio_envelope_channel.Publish(envelope);
+    written += count;
+  }
+  g_latest_audio_sample_index += advance;
+  return advance;
+}
+
+int64_t AudioDataSampleCount() { return g_audio_data.size(); }
+
+TfLiteStatus InitAudioRecording(tflite::ErrorReporter*) {
+  return kTfLiteOk;
+}
+
+TfLiteStatus GetAudioSamples(tflite::ErrorReporter* error_reporter,
+                             int start_ms, int duration_ms,
+                             int* audio_samples_size, int16_t** audio_samples) {
+  return GetAudioSampleRange(
+      error_reporter, static_cast<int64_t>(start_ms) * kAudioSamplesPerMs,
+      duration_ms * kAudioSamplesPerMs, audio_samples_size, audio_samples);
+}
+
+TfLiteStatus GetAudioSampleRange(tflite::ErrorReporter* error_reporter,
+                                 int64_t start_sample, int sample_count,
+                                 int* audio_samples_size,
+                                 int16_t** audio_samples) {
+  if ((sample_count < 0) || (sample_count > kMaxAudioSampleSize)) {
+    error_reporter->Report("Requested %d audio samples, at most %d allowed",
+                           sample_count, kMaxAudioSampleSize);
+    return kTfLiteError;
+  }
+  // Read through the ring, as the live provider does, so that a caller which
+  // falls too far behind loses audio here too. Samples from before the
+  // recording started, ones that have been overwritten and ones the clock
+  // hasn't reached yet all read as silence.
+  int silent_count = 0;
+  if (start_sample < 0) {
+    silent_count = (-start_sample < sample_count)
+                       ? static_cast<int>(-start_sample)
+                       : sample_count;
+  }
+  memset(g_audio_output_buffer, 0, silent_count * sizeof(int16_t));
+
+  int16_t* output = g_audio_output_buffer + silent_count;
+  const int ring_count = sample_count - silent_count;
+  AudioRingView view;
+  if (g_audio_ring.ViewRange(start_sample + silent_count, ring_count, &view)) {
+    memcpy(output, view.data[0], view.size[0] * sizeof(int16_t));
+    memcpy(output + view.size[0], view.data[1],
+           view.size[1] * sizeof(int16_t));
+    if (!g_audio_ring.IsViewIntact(view)) {
+      memset(output, 0, ring_count * sizeof(int16_t));
+    }
+  } else {
+    memset(output, 0, ring_count * sizeof(int16_t));
+  }
+  *audio_samples_size = kMaxAudioSampleSize;
+  *audio_samples = g_audio_output_buffer;
+  return kTfLiteOk;
+}
+
+int32_t LatestAudioTimestamp() {
+  return static_cast<int32_t>(g_latest_audio_sample_index / kAudioSamplesPerMs);
+}
+
+int64_t LatestAudioSampleIndex() { return g_latest_audio_sample_index; }
+
+AudioBroadcastRing* GetAudioRing() { return &g_audio_ring; }
+
+AudioEnvelopeChannel* GetAudioEnvelopeChannel() {
+  return &g_audio_envelope_channel;
+}
+
+void AddAudioMemoryRegions(MemoryReport* report) {
+  report->AddRegion("capture ring", g_audio_ring_buffer,
+                    sizeof(g_audio_ring_buffer));
+  report->AddRegion("audio output buffer", g_audio_output_buffer,
+                    sizeof(g_audio_output_buffer));
+  report->AddRegion("envelope channel", &g_audio_envelope_channel,
+                    sizeof(g_audio_envelope_channel));
+}
@@ -0,0 +1,51 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_FILE_AUDIO_PROVIDER_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_FILE_AUDIO_PROVIDER_H_
+
+#include <cstdint>
+
+#include "audio_provider.h"
+
+// A host implementation of audio_provider.h that plays back a recording
+// instead of listening to a microphone, for running the pipeline over files.
+// Link file_audio_provider.cpp in place of src/audio_provider.cpp.
+//
+// Recordings at 32, 44.1 and 48KHz go through the same PolyphaseResampler as
+// the live provider when they're loaded, so archives don't need converting to
+// kAudioSampleFrequency first. The audio clock only moves when
+// AdvanceAudioClock() is called, which lets the caller play the recording as
+// fast or as slowly as it likes. Audio is written to GetAudioRing() as the
+// clock passes it, with an envelope for each block on
+// GetAudioEnvelopeChannel(), so consumers see the same streams they would live.
+
+// Loads a WAV file, replacing any earlier audio and resetting the clock.
+TfLiteStatus LoadAudioFile(tflite::ErrorReporter* error_reporter,
+                           const char* path);
+
+// Loads audio from memory. sample_rate can be anything the resampler accepts.
+TfLiteStatus LoadAudioData(tflite::ErrorReporter* error_reporter,
+                           const int16_t* samples, int sample_count,
+                           int sample_rate);
+
+// Moves the clock forward by up to sample_count samples, stopping at the end of
+// the recording, and returns how far it moved.
+int64_t AdvanceAudioClock(int64_t sample_count);
+
+// How long the loaded recording is, in samples at kAudioSampleFrequency.
+int64_t AudioDataSampleCount();
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_FILE_AUDIO_PROVIDER_H_
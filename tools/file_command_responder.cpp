@@ -0,0 +1,72 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "file_command_responder.h"
+
+#include <cstring>
+
+#include "micro_model_settings.h"
+
+namespace {
+
+// The same cut-off as the device's responder.
+constexpr uint8_t kMinimumResponseScore = 150;
+// Room for this many commands is set aside up front, so responding doesn't
+// allocate while an allocation guard is open.
+constexpr int kReservedCommands = 4096;
+
+std::vector<RespondedCommand> g_responded_commands;
+
+}  // namespace
+
+void InitResponder() {
+  g_responded_commands.clear();
+  g_responded_commands.reserve(kReservedCommands);
+}
+
+void RespondToCommand(tflite::ErrorReporter* error_reporter,
+                      int32_t current_time, const char* found_command,
+                      uint8_t score, bool is_new_command) {
+  RespondToCommandAtSample(
+      error_reporter, static_cast<int64_t>(current_time) * kAudioSamplesPerMs,
+      found_command, score, is_new_command);
+}
+
+void RespondToCommandAtSample(tflite::ErrorReporter*,
+                              int64_t current_sample_index,
+                              const char* found_command, uint8_t score,
+                              bool is_new_command) {
+  if ((score < kMinimumResponseScore) || !is_new_command) {
+    return;
+  }
+  for (int i = 0; i < kCategoryCount; ++i) {
+    if (strcmp(found_command, kCategoryLabels[i]) != 0) {
+      continue;
+    }
+    if ((i != kSilenceIndex) && (i != kUnknownIndex)) {
+      g_responded_commands.push_back({current_sample_index, i, score});
+    }
+    return;
+  }
+}
+
+void TakeRespondedCommands(std::vector<RespondedCommand>* commands) {
+  commands->assign(g_responded_commands.begin(), g_responded_commands.end());
+  g_responded_commands.clear();
+}
+
+void drawWave(const AudioEnvelope*, int) {}
+
+void drawInput(uint8_t*) {}
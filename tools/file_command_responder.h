@@ -0,0 +1,41 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_FILE_COMMAND_RESPONDER_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_FILE_COMMAND_RESPONDER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "command_responder.h"
+
+// A host implementation of command_responder.h that collects the commands the
+// device would act on, instead of printing and drawing them. Link
+// file_command_responder.cpp in place of src/command_responder.cpp.
+//
+// The filtering is the same as the device's: results scoring under 150 and
+// the silence and unknown categories are ignored, and a command is only acted
+// on when it's new.
+
+struct RespondedCommand {
+  int64_t sample_index;
+  int category;
+  uint8_t score;
+};
+
+// Moves the commands responded to since the last call into commands.
+void TakeRespondedCommands(std::vector<RespondedCommand>* commands);
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_FILE_COMMAND_RESPONDER_H_
@@ -0,0 +1,388 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Writes src/micro_features_tables.cpp, the frontend lookup tables that
+// FrontendPopulateState() would otherwise build on the heap at every boot, and
+// the twiddle factors for the FFT in micro_features_fft.cpp.
+// This is a standalone host program, built and run from the project root with:
+//
+//   g++ -O2 -ffp-contract=off -I src -o /tmp/generate_micro_features_tables
+//       tools/generate_micro_features_tables.cpp
+//   /tmp/generate_micro_features_tables > src/micro_features_tables.cpp
+//
+// The arithmetic below mirrors the window, filterbank, noise reduction and
+// PCAN setup code in tensorflow/lite/experimental/microfrontend/lib, including
+// which steps happen in float and which in double, so that the tables are bit
+// for bit the ones the library produces. Fused multiply-adds are turned off
+// for the same reason. Building the firmware with MICRO_FEATURES_VERIFY_TABLES
+// defined compares the tables against the library's at startup.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "micro_model_settings.h"
+
+namespace {
+
+// Constants from the microfrontend library headers.
+constexpr int kFrontendWindowBits = 12;
+constexpr int kFilterbankBits = 12;
+constexpr int kFilterbankIndexAlignment = 4;
+constexpr int kFilterbankChannelBlockSize = 4;
+constexpr int kNoiseReductionBits = 14;
+constexpr int kPcanSnrBits = 12;
+constexpr int kWideDynamicFunctionBits = 32;
+constexpr int kWideDynamicFunctionLUTSize = (4 * kWideDynamicFunctionBits - 3);
+// From the FIXED_POINT 16 configuration of kissfft.
+constexpr int kFftSampleMax = 32767;
+
+int MostSignificantBit32(uint32_t n) { return n ? 32 - __builtin_clz(n) : 0; }
+
+// kissfft's fixed-point twiddle factor for a phase, from kf_cexp().
+void FftTwiddle(double phase, int16_t* real, int16_t* imag) {
+  *real = floor(.5 + kFftSampleMax * cos(phase));
+  *imag = floor(.5 + kFftSampleMax * sin(phase));
+}
+
+float FreqToMel(float freq) { return 1127.0 * log1p(freq / 700.0); }
+
+int16_t PcanGainLookupFunction(int32_t input_bits, uint32_t x) {
+  const float x_as_float = ((float)x) / ((uint32_t)1 << input_bits);
+  const float gain_as_float =
+      ((uint32_t)1 << kPcanGainControlGainBits) *
+      powf(x_as_float + kPcanGainControlOffset, -kPcanGainControlStrength);
+  if (gain_as_float > 0x7fff) {
+    return 0x7fff;
+  }
+  return (int16_t)(gain_as_float + 0.5f);
+}
+
+// Prints an array definition, wrapped to 80 columns.
+template <typename T>
+void PrintArray(const char* type, const char* name, const std::vector<T>& data,
+                bool size_in_declaration = true) {
+  if (size_in_declaration) {
+    printf("const %s %s[%d] = {\n", type, name, static_cast<int>(data.size()));
+  } else {
+    printf("const %s %s[] = {\n", type, name);
+  }
+  int column = 0;
+  for (const T& value : data) {
+    char text[32];
+    const int length = snprintf(text, sizeof(text), "%lld,",
+                                static_cast<long long>(value));
+    if (column == 0) {
+      printf("   ");
+      column = 3;
+    }
+    if (column + 1 + length > 80) {
+      printf("\n   ");
+      column = 3;
+    }
+    printf(" %s", text);
+    column += 1 + length;
+  }
+  printf("\n};\n\n");
+}
+
+}  // namespace
+
+int main() {
+  const int sample_rate = kAudioSampleFrequency;
+
+  // Window, from WindowPopulateState().
+  const int window_size = kFeatureSliceDurationMs * sample_rate / 1000;
+  std::vector<int16_t> window(window_size);
+  const float arg = M_PI * 2.0 / ((float)window_size);
+  for (int i = 0; i < window_size; ++i) {
+    float float_value = 0.5 - (0.5 * cos(arg * (i + 0.5)));
+    window[i] = floor(float_value * (1 << kFrontendWindowBits) + 0.5);
+  }
+
+  // FFT size, from FftPopulateState().
+  int fft_size = 1;
+  while (fft_size < window_size) {
+    fft_size <<= 1;
+  }
+  const int spectrum_size = fft_size / 2 + 1;
+
+  // Filterbank, from FilterbankPopulateState().
+  const int num_channels = kFeatureSliceSize;
+  const int num_channels_plus_1 = num_channels + 1;
+  const int index_alignment =
+      (kFilterbankIndexAlignment < static_cast<int>(sizeof(int16_t))
+           ? 1
+           : kFilterbankIndexAlignment / static_cast<int>(sizeof(int16_t)));
+  std::vector<int16_t> channel_frequency_starts(num_channels_plus_1);
+  std::vector<int16_t> channel_weight_starts(num_channels_plus_1);
+  std::vector<int16_t> channel_widths(num_channels_plus_1);
+  std::vector<float> center_mel_freqs(num_channels_plus_1);
+  std::vector<int16_t> actual_channel_starts(num_channels_plus_1);
+  std::vector<int16_t> actual_channel_widths(num_channels_plus_1);
+
+  {
+    const float mel_low = FreqToMel(kFilterbankLowerBandLimit);
+    const float mel_hi = FreqToMel(kFilterbankUpperBandLimit);
+    const float mel_span = mel_hi - mel_low;
+    const float mel_spacing = mel_span / ((float)num_channels_plus_1);
+    for (int i = 0; i < num_channels_plus_1; ++i) {
+      center_mel_freqs[i] = mel_low + (mel_spacing * (i + 1));
+    }
+  }
+
+  const float hz_per_sbin = 0.5 * sample_rate / ((float)spectrum_size - 1);
+  const int start_index = 1.5 + kFilterbankLowerBandLimit / hz_per_sbin;
+  int end_index = 0;
+
+  int chan_freq_index_start = start_index;
+  int weight_index_start = 0;
+  int needs_zeros = 0;
+  for (int chan = 0; chan < num_channels_plus_1; ++chan) {
+    int freq_index = chan_freq_index_start;
+    while (FreqToMel((freq_index)*hz_per_sbin) <= center_mel_freqs[chan]) {
+      ++freq_index;
+    }
+
+    const int width = freq_index - chan_freq_index_start;
+    actual_channel_starts[chan] = chan_freq_index_start;
+    actual_channel_widths[chan] = width;
+
+    if (width == 0) {
+      channel_frequency_starts[chan] = 0;
+      channel_weight_starts[chan] = 0;
+      channel_widths[chan] = kFilterbankChannelBlockSize;
+      if (!needs_zeros) {
+        needs_zeros = 1;
+        for (int j = 0; j < chan; ++j) {
+          channel_weight_starts[j] += kFilterbankChannelBlockSize;
+        }
+        weight_index_start += kFilterbankChannelBlockSize;
+      }
+    } else {
+      const int aligned_start =
+          (chan_freq_index_start / index_alignment) * index_alignment;
+      const int aligned_width = (chan_freq_index_start - aligned_start + width);
+      const int padded_width =
+          (((aligned_width - 1) / kFilterbankChannelBlockSize) + 1) *
+          kFilterbankChannelBlockSize;
+
+      channel_frequency_starts[chan] = aligned_start;
+      channel_weight_starts[chan] = weight_index_start;
+      channel_widths[chan] = padded_width;
+      weight_index_start += padded_width;
+    }
+    chan_freq_index_start = freq_index;
+  }
+
+  std::vector<int16_t> weights(weight_index_start, 0);
+  std::vector<int16_t> unweights(weight_index_start, 0);
+  {
+    const float mel_low = FreqToMel(kFilterbankLowerBandLimit);
+    for (int chan = 0; chan < num_channels_plus_1; ++chan) {
+      int frequency = actual_channel_starts[chan];
+      const int num_frequencies = actual_channel_widths[chan];
+      const int frequency_offset = frequency - channel_frequency_starts[chan];
+      const int weight_start = channel_weight_starts[chan];
+      const float denom_val =
+          (chan == 0) ? mel_low : center_mel_freqs[chan - 1];
+      for (int j = 0; j < num_frequencies; ++j, ++frequency) {
+        const float weight =
+            (center_mel_freqs[chan] - FreqToMel(frequency * hz_per_sbin)) /
+            (center_mel_freqs[chan] - denom_val);
+        const int weight_index = weight_start + frequency_offset + j;
+        weights[weight_index] = floor(weight * (1 << kFilterbankBits) + 0.5);
+        unweights[weight_index] =
+            floor((1.0 - weight) * (1 << kFilterbankBits) + 0.5);
+      }
+      if (frequency > end_index) {
+        end_index = frequency;
+      }
+    }
+  }
+  if (end_index >= spectrum_size) {
+    fprintf(stderr, "Filterbank end_index is above spectrum size.\n");
+    return 1;
+  }
+
+  // Noise reduction, from NoiseReductionPopulateState().
+  const uint16_t even_smoothing =
+      kNoiseReductionEvenSmoothing * (1 << kNoiseReductionBits);
+  const uint16_t odd_smoothing =
+      kNoiseReductionOddSmoothing * (1 << kNoiseReductionBits);
+  const uint16_t min_signal_remaining =
+      kNoiseReductionMinSignalRemaining * (1 << kNoiseReductionBits);
+
+  // PCAN gain lookup table, from PcanGainControlPopulateState().
+  const int input_correction_bits =
+      MostSignificantBit32(fft_size) - 1 - (kFilterbankBits / 2);
+  const int32_t snr_shift =
+      kPcanGainControlGainBits - input_correction_bits - kPcanSnrBits;
+  const int32_t input_bits =
+      kNoiseReductionSmoothingBits - input_correction_bits;
+  std::vector<int16_t> gain_lut(kWideDynamicFunctionLUTSize, 0);
+  gain_lut[0] = PcanGainLookupFunction(input_bits, 0);
+  gain_lut[1] = PcanGainLookupFunction(input_bits, 1);
+  for (int interval = 2; interval <= kWideDynamicFunctionBits; ++interval) {
+    const uint32_t x0 = (uint32_t)1 << (interval - 1);
+    const uint32_t x1 = x0 + (x0 >> 1);
+    const uint32_t x2 =
+        (interval == kWideDynamicFunctionBits) ? x0 + (x0 - 1) : 2 * x0;
+
+    const int16_t y0 = PcanGainLookupFunction(input_bits, x0);
+    const int16_t y1 = PcanGainLookupFunction(input_bits, x1);
+    const int16_t y2 = PcanGainLookupFunction(input_bits, x2);
+
+    const int32_t diff1 = (int32_t)y1 - y0;
+    const int32_t diff2 = (int32_t)y2 - y0;
+    const int32_t a1 = 4 * diff1 - diff2;
+    const int32_t a2 = diff2 - a1;
+
+    // The library fills these through a pointer offset by -6.
+    gain_lut[4 * interval - 6] = y0;
+    gain_lut[4 * interval - 5] = (int16_t)a1;
+    gain_lut[4 * interval - 4] = (int16_t)a2;
+  }
+
+  // FFT twiddles. kiss_fftr() runs a complex FFT of half the size over the
+  // samples taken in pairs, and then splits its output into the real
+  // spectrum. The complex twiddles are from kiss_fft_alloc(), rearranged so
+  // each radix-4 stage reads its own contiguously, and already laid out as the
+  // pairs of terms that make up the real and imaginary parts of a product.
+  const int complex_fft_size = fft_size / 2;
+  int stage_length = 1;
+  while (stage_length < complex_fft_size) {
+    stage_length *= 4;
+  }
+  if (stage_length != complex_fft_size) {
+    fprintf(stderr, "The complex FFT size %d isn't a power of four.\n",
+            complex_fft_size);
+    return 1;
+  }
+  std::vector<int16_t> twiddle_real(complex_fft_size);
+  std::vector<int16_t> twiddle_imag(complex_fft_size);
+  for (int i = 0; i < complex_fft_size; ++i) {
+    const double pi = 3.14159265358979323846264338327;
+    FftTwiddle(-2 * pi * i / complex_fft_size, &twiddle_real[i],
+               &twiddle_imag[i]);
+  }
+  std::vector<int16_t> stage_twiddles;
+  for (int m = 1; m < complex_fft_size; m *= 4) {
+    const int stride = complex_fft_size / (4 * m);
+    for (int j = 1; j <= 3; ++j) {
+      for (int k = 0; k < m; ++k) {
+        stage_twiddles.push_back(twiddle_real[j * k * stride]);
+        stage_twiddles.push_back(-twiddle_imag[j * k * stride]);
+      }
+      for (int k = 0; k < m; ++k) {
+        stage_twiddles.push_back(twiddle_imag[j * k * stride]);
+        stage_twiddles.push_back(twiddle_real[j * k * stride]);
+      }
+    }
+  }
+  // The split twiddles are kiss_fftr_alloc()'s super_twiddles.
+  std::vector<int16_t> split_twiddles;
+  for (int i = 0; i < complex_fft_size / 2; ++i) {
+    int16_t real;
+    int16_t imag;
+    FftTwiddle(-3.14159265358979323846264338327 *
+                   ((double)(i + 1) / complex_fft_size + .5),
+               &real, &imag);
+    split_twiddles.push_back(real);
+    split_twiddles.push_back(imag);
+  }
+
+  printf(
+      "/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.\n"
+      "\n"
+      "Licensed under the Apache License, Version 2.0 (the \"License\");\n"
+      "you may not use this file except in compliance with the License.\n"
+      "You may obtain a copy of the License at\n"
+      "\n"
+      "    http://www.apache.org/licenses/LICENSE-2.0\n"
+      "\n"
+      "Unless required by applicable law or agreed to in writing, software\n"
+      "distributed under the License is distributed on an \"AS IS\" BASIS,\n"
+      "WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or "
+      "implied.\n"
+      "See the License for the specific language governing permissions and\n"
+      "limitations under the License.\n"
+      "=================================================================="
+      "============*/\n"
+      "\n"
+      "// File automatically created by "
+      "tools/generate_micro_features_tables.cpp,\n"
+      "// see that file for how to regenerate it.\n"
+      "\n"
+      "#include \"micro_features_tables.h\"\n"
+      "\n"
+      "// The tables below were calculated from these settings.\n"
+      "static_assert((kAudioSampleFrequency == %d) &&\n"
+      "                  (kFeatureSliceDurationMs == %d) &&\n"
+      "                  (kFeatureSliceSize == %d) &&\n"
+      "                  (kFilterbankLowerBandLimit == %#.9gf) &&\n"
+      "                  (kFilterbankUpperBandLimit == %#.9gf) &&\n"
+      "                  (kNoiseReductionSmoothingBits == %d) &&\n"
+      "                  (kNoiseReductionEvenSmoothing == %#.9gf) &&\n"
+      "                  (kNoiseReductionOddSmoothing == %#.9gf) &&\n"
+      "                  (kNoiseReductionMinSignalRemaining == %#.9gf) &&\n"
+      "                  (kPcanGainControlStrength == %#.9gf) &&\n"
+      "                  (kPcanGainControlOffset == %#.9gf) &&\n"
+      "                  (kPcanGainControlGainBits == %d),\n"
+      "              \"micro_model_settings.h has changed, rerun \"\n"
+      "              \"tools/generate_micro_features_tables.cpp\");\n"
+      "\n",
+      kAudioSampleFrequency, kFeatureSliceDurationMs, kFeatureSliceSize,
+      kFilterbankLowerBandLimit, kFilterbankUpperBandLimit,
+      kNoiseReductionSmoothingBits, kNoiseReductionEvenSmoothing,
+      kNoiseReductionOddSmoothing, kNoiseReductionMinSignalRemaining,
+      kPcanGainControlStrength, kPcanGainControlOffset,
+      kPcanGainControlGainBits);
+
+  PrintArray("int16_t", "g_micro_features_window_coefficients", window);
+
+  printf("const int g_micro_features_filterbank_start_index = %d;\n",
+         start_index);
+  printf("const int g_micro_features_filterbank_end_index = %d;\n\n",
+         end_index);
+  PrintArray("int16_t", "g_micro_features_filterbank_channel_frequency_starts",
+             channel_frequency_starts);
+  PrintArray("int16_t", "g_micro_features_filterbank_channel_weight_starts",
+             channel_weight_starts);
+  PrintArray("int16_t", "g_micro_features_filterbank_channel_widths",
+             channel_widths);
+  printf("const int g_micro_features_filterbank_weight_count = %d;\n\n",
+         weight_index_start);
+  PrintArray("int16_t", "g_micro_features_filterbank_weights", weights, false);
+  PrintArray("int16_t", "g_micro_features_filterbank_unweights", unweights,
+             false);
+
+  printf("const uint16_t g_micro_features_noise_reduction_even_smoothing = %d;\n",
+         even_smoothing);
+  printf("const uint16_t g_micro_features_noise_reduction_odd_smoothing = %d;\n",
+         odd_smoothing);
+  printf(
+      "const uint16_t g_micro_features_noise_reduction_min_signal_remaining = "
+      "%d;\n\n",
+      min_signal_remaining);
+
+  printf("const int32_t g_micro_features_pcan_snr_shift = %d;\n\n", snr_shift);
+  PrintArray("int16_t", "g_micro_features_pcan_gain_lut", gain_lut);
+
+  PrintArray("int16_t", "g_micro_features_fft_stage_twiddles", stage_twiddles);
+  PrintArray("int16_t", "g_micro_features_fft_split_twiddles", split_twiddles);
+  return 0;
+}
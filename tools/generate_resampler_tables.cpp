@@ -0,0 +1,222 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Writes src/resampler_tables.cpp, the polyphase filter banks that
+// PolyphaseResampler uses to bring 32, 44.1 and 48KHz audio down to
+// kAudioSampleFrequency. This is a standalone host program, built and run from
+// the project root with:
+//
+//   g++ -O2 -I src -o /tmp/generate_resampler_tables
+//       tools/generate_resampler_tables.cpp
+//   /tmp/generate_resampler_tables > src/resampler_tables.cpp
+//
+// Each bank comes from a Kaiser-windowed sinc low-pass designed at the
+// interpolated rate, with its cut-off at the output Nyquist frequency. The
+// pass band runs to 7KHz, which covers the filterbank's 7.5KHz upper limit
+// with room for the transition, and everything from 9KHz up is at least 60dB
+// down, so anything that aliases lands above the top feature channel.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "micro_model_settings.h"
+
+namespace {
+
+constexpr double kPassBandHz = 7000.0;
+constexpr double kStopBandHz = 9000.0;
+constexpr double kStopBandAttenuationDb = 60.0;
+constexpr int kCoefficientBits = 15;
+// The resampler's inner loop is easiest to vectorize with a multiple of 8.
+constexpr int kTapAlignment = 8;
+
+struct BankSpec {
+  int input_rate;
+  int interpolation;
+  int decimation;
+};
+
+int GreatestCommonDivisor(int a, int b) {
+  while (b != 0) {
+    const int remainder = a % b;
+    a = b;
+    b = remainder;
+  }
+  return a;
+}
+
+// Zeroth order modified Bessel function of the first kind, for the window.
+double BesselI0(double x) {
+  double sum = 1.0;
+  double term = 1.0;
+  for (int k = 1; k < 50; ++k) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+  }
+  return sum;
+}
+
+// Designs the prototype filter at the interpolated rate and splits it into
+// Q15 phases, each stored oldest input sample first and summing to exactly
+// 1 << kCoefficientBits so DC passes through unchanged.
+std::vector<int16_t> DesignBank(const BankSpec& spec, int* taps_per_phase) {
+  const double rate = static_cast<double>(spec.input_rate) * spec.interpolation;
+  const double transition = 2.0 * M_PI * (kStopBandHz - kPassBandHz) / rate;
+  const int estimated_length = static_cast<int>(
+      ceil((kStopBandAttenuationDb - 8.0) / (2.285 * transition)));
+  int taps = (estimated_length + spec.interpolation - 1) / spec.interpolation;
+  taps = ((taps + kTapAlignment - 1) / kTapAlignment) * kTapAlignment;
+  *taps_per_phase = taps;
+
+  const int length = taps * spec.interpolation;
+  const double cutoff = ((kPassBandHz + kStopBandHz) / 2.0) / rate;
+  const double beta = 0.1102 * (kStopBandAttenuationDb - 8.7);
+  const double center = (length - 1) / 2.0;
+  std::vector<double> prototype(length);
+  for (int n = 0; n < length; ++n) {
+    const double t = n - center;
+    const double sinc =
+        (t == 0.0) ? 2.0 * cutoff : sin(2.0 * M_PI * cutoff * t) / (M_PI * t);
+    const double ratio = t / center;
+    const double window =
+        BesselI0(beta * sqrt(1.0 - ratio * ratio)) / BesselI0(beta);
+    prototype[n] = sinc * window;
+  }
+
+  std::vector<int16_t> bank(length);
+  const int32_t unity = 1 << kCoefficientBits;
+  for (int phase = 0; phase < spec.interpolation; ++phase) {
+    double phase_sum = 0.0;
+    for (int i = 0; i < taps; ++i) {
+      phase_sum += prototype[phase + i * spec.interpolation];
+    }
+    int16_t* coefficients = &bank[phase * taps];
+    int32_t quantized_sum = 0;
+    int largest = 0;
+    for (int i = 0; i < taps; ++i) {
+      // Tap i multiplies the input taps - 1 - i samples before the newest.
+      const double value =
+          prototype[phase + (taps - 1 - i) * spec.interpolation] / phase_sum;
+      coefficients[i] = static_cast<int16_t>(lround(value * unity));
+      quantized_sum += coefficients[i];
+      if (abs(coefficients[i]) > abs(coefficients[largest])) {
+        largest = i;
+      }
+    }
+    // Put any rounding error on the biggest tap, where it matters least.
+    coefficients[largest] += unity - quantized_sum;
+  }
+  return bank;
+}
+
+void PrintArray(const char* name, const std::vector<int16_t>& data) {
+  printf("const int16_t %s[%d] = {\n", name, static_cast<int>(data.size()));
+  int column = 0;
+  for (const int16_t value : data) {
+    char text[32];
+    const int length = snprintf(text, sizeof(text), "%d,", value);
+    if (column == 0) {
+      printf("   ");
+      column = 3;
+    }
+    if (column + 1 + length > 80) {
+      printf("\n   ");
+      column = 3;
+    }
+    printf(" %s", text);
+    column += 1 + length;
+  }
+  printf("\n};\n\n");
+}
+
+}  // namespace
+
+int main() {
+  const int input_rates[] = {32000, 44100, 48000};
+
+  printf(
+      "/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.\n"
+      "\n"
+      "Licensed under the Apache License, Version 2.0 (the \"License\");\n"
+      "you may not use this file except in compliance with the License.\n"
+      "You may obtain a copy of the License at\n"
+      "\n"
+      "    http://www.apache.org/licenses/LICENSE-2.0\n"
+      "\n"
+      "Unless required by applicable law or agreed to in writing, software\n"
+      "distributed under the License is distributed on an \"AS IS\" BASIS,\n"
+      "WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or "
+      "implied.\n"
+      "See the License for the specific language governing permissions and\n"
+      "limitations under the License.\n"
+      "=================================================================="
+      "============*/\n"
+      "\n"
+      "// File automatically created by tools/generate_resampler_tables.cpp,\n"
+      "// see that file for how to regenerate it.\n"
+      "\n"
+      "#include \"resampler_tables.h\"\n"
+      "\n"
+      "// The banks below resample to this rate.\n"
+      "static_assert(kAudioSampleFrequency == %d,\n"
+      "              \"micro_model_settings.h has changed, rerun \"\n"
+      "              \"tools/generate_resampler_tables.cpp\");\n"
+      "\n"
+      "namespace {\n"
+      "\n",
+      kAudioSampleFrequency);
+
+  std::vector<BankSpec> specs;
+  std::vector<int> taps;
+  int max_taps = 0;
+  for (const int input_rate : input_rates) {
+    const int divisor = GreatestCommonDivisor(input_rate, kAudioSampleFrequency);
+    const BankSpec spec = {input_rate, kAudioSampleFrequency / divisor,
+                           input_rate / divisor};
+    int taps_per_phase;
+    const std::vector<int16_t> bank = DesignBank(spec, &taps_per_phase);
+    char name[64];
+    snprintf(name, sizeof(name), "g_resampler_%d_coefficients", input_rate);
+    PrintArray(name, bank);
+    specs.push_back(spec);
+    taps.push_back(taps_per_phase);
+    if (taps_per_phase > max_taps) {
+      max_taps = taps_per_phase;
+    }
+  }
+
+  printf(
+      "}  // namespace\n"
+      "\n"
+      "static_assert(kResamplerMaxTaps >= %d,\n"
+      "              \"kResamplerMaxTaps is too small for these banks\");\n"
+      "\n"
+      "const ResamplerFilterBank g_resampler_filter_banks[] = {\n",
+      max_taps);
+  for (size_t i = 0; i < specs.size(); ++i) {
+    printf("    {%d, %d, %d, %d, g_resampler_%d_coefficients},\n",
+           specs[i].input_rate, specs[i].interpolation, specs[i].decimation,
+           taps[i], specs[i].input_rate);
+  }
+  printf(
+      "};\n"
+      "\n"
+      "const int g_resampler_filter_bank_count =\n"
+      "    sizeof(g_resampler_filter_banks) / "
+      "sizeof(g_resampler_filter_banks[0]);\n");
+  return 0;
+}
@@ -0,0 +1,163 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Checks that ConvertI2sSlots() gives exactly the same output and bias state
+// as ConvertI2sSlotsScalar(), for every shift, gain and DC adaptation setting.
+// This is a standalone host program, built from the project root with:
+//
+//   TFLM=.pio/libdeps/esp32s3/TensorFlowLite_ESP32/src
+//   g++ -O2 -msse4.1 -I src -I $TFLM -o /tmp/i2s_slot_converter_test
+//       tools/i2s_slot_converter_test.cpp src/i2s_slot_converter.cpp
+//       $TFLM/tensorflow/lite/experimental/micro/micro_error_reporter.cpp
+//       $TFLM/tensorflow/lite/experimental/micro/debug_log.cpp
+//   /tmp/i2s_slot_converter_test
+//
+// The vectorized code is picked at compile time, so build with -msse4.1 for
+// the SSE4.1 path, or on an ARM host with -DMICRO_SPEECH_I2S_SLOT_NEON for the
+// NEON one. Without either it only compares the scalar code with itself. It
+// prints the number of mismatched blocks and exits with 1 if there are any.
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "i2s_slot_converter.h"
+
+namespace {
+
+// Block lengths that hit the empty and short cases, the leftovers after the
+// vectorized loop, and the point where lane sums are flushed to 64 bits.
+constexpr int kBlockLengths[] = {0, 1, 7, 8, 9, 15, 16, 17, 512, 4095, 4096,
+                                 4097, 4103, 8200, 12345};
+constexpr int kBlockLengthCount =
+    sizeof(kBlockLengths) / sizeof(kBlockLengths[0]);
+constexpr int kMaxBlockLength = 12345;
+
+uint32_t g_random = 1;
+
+uint32_t NextRandom() {
+  g_random = (g_random * 1664525u) + 1013904223u;
+  return g_random;
+}
+
+// Fills a block with one of several kinds of slot data: microphone-like
+// 24-bit samples on a bias, full-range noise that saturates at every shift,
+// the most extreme slot values, and a constant offset that pulls the bias
+// estimate far from zero.
+void FillSlots(int kind, int count, int32_t* slots) {
+  const int32_t bias = static_cast<int32_t>(NextRandom() >> 12) - (1 << 19);
+  for (int i = 0; i < count; ++i) {
+    const uint32_t random = NextRandom();
+    int32_t slot;
+    switch (kind % 4) {
+      case 0:
+        slot = static_cast<int32_t>(
+            ((bias + (static_cast<int32_t>(random) >> 14)) & 0xffffff) << 8);
+        break;
+      case 1:
+        slot = static_cast<int32_t>(random);
+        break;
+      case 2:
+        slot = (random & 1) ? INT32_MAX : INT32_MIN;
+        break;
+      default:
+        slot = static_cast<int32_t>(0x7fff0000u + (random & 0xffff));
+        break;
+    }
+    slots[i] = slot;
+  }
+}
+
+// Runs the same blocks through both converters, starting from the same
+// settings, and counts the blocks where the output or bias state differs.
+int CompareConverters(tflite::ErrorReporter* error_reporter, int shift,
+                      int32_t gain, int dc_adaptation_shift, int block_count,
+                      int32_t* slots, int16_t* output, int16_t* expected) {
+  I2sSlotConverterState state;
+  I2sSlotConverterState expected_state;
+  if ((InitI2sSlotConverter(error_reporter, shift, gain, dc_adaptation_shift,
+                            &state) != kTfLiteOk) ||
+      (InitI2sSlotConverter(error_reporter, shift, gain, dc_adaptation_shift,
+                            &expected_state) != kTfLiteOk)) {
+    return block_count;
+  }
+  int mismatches = 0;
+  for (int block = 0; block < block_count; ++block) {
+    const int count = kBlockLengths[NextRandom() % kBlockLengthCount];
+    FillSlots(block, count, slots);
+    ConvertI2sSlots(&state, slots, count, output);
+    ConvertI2sSlotsScalar(&expected_state, slots, count, expected);
+    if ((state.dc_estimate != expected_state.dc_estimate) ||
+        (memcmp(output, expected, count * sizeof(int16_t)) != 0)) {
+      if (mismatches == 0) {
+        fprintf(stderr,
+                "Mismatch with shift %d, gain %d, adaptation %d, %d slots\n",
+                shift, static_cast<int>(gain), dc_adaptation_shift, count);
+      }
+      ++mismatches;
+      // Carry on from the same state, so one difference isn't counted again
+      // in every later block.
+      state = expected_state;
+    }
+  }
+  return mismatches;
+}
+
+}  // namespace
+
+int main() {
+  tflite::MicroErrorReporter micro_error_reporter;
+  tflite::ErrorReporter* error_reporter = &micro_error_reporter;
+
+  std::vector<int32_t> slots(kMaxBlockLength);
+  std::vector<int16_t> output(kMaxBlockLength);
+  std::vector<int16_t> expected(kMaxBlockLength);
+
+  int compared = 0;
+  int mismatches = 0;
+  // Every shift against every adaptation setting, at the gains where the
+  // rounding and saturation change behaviour plus a few random ones.
+  const int32_t kEdgeGains[] = {0, 1, 2, 16383, 16384, 16385, 32767, 32768};
+  for (int shift = 8; shift <= 24; ++shift) {
+    for (int adaptation = 0; adaptation <= 16; ++adaptation) {
+      for (int32_t gain : kEdgeGains) {
+        mismatches += CompareConverters(error_reporter, shift, gain, adaptation,
+                                        8, slots.data(), output.data(),
+                                        expected.data());
+        compared += 8;
+      }
+      for (int i = 0; i < 4; ++i) {
+        const int32_t gain = NextRandom() % (kI2sSlotMaxGain + 1);
+        mismatches += CompareConverters(error_reporter, shift, gain, adaptation,
+                                        8, slots.data(), output.data(),
+                                        expected.data());
+        compared += 8;
+      }
+    }
+  }
+  // Every gain, with the shift and adaptation setting picked at random.
+  for (int32_t gain = 0; gain <= kI2sSlotMaxGain; ++gain) {
+    const int shift = 8 + (NextRandom() % 17);
+    const int adaptation = NextRandom() % 17;
+    mismatches += CompareConverters(error_reporter, shift, gain, adaptation, 1,
+                                    slots.data(), output.data(),
+                                    expected.data());
+    ++compared;
+  }
+
+  printf("Compared blocks: %d\n", compared);
+  printf("Mismatched blocks: %d\n", mismatches);
+  return (mismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "inference_log.h"
+
+#include <cstring>
+
+namespace {
+
+constexpr size_t kRecordSize = sizeof(uint32_t) + kCategoryCount;
+
+static_assert(sizeof(InferenceLogHeader) == 16,
+              "The header layout is part of the file format");
+
+}  // namespace
+
+InferenceLogWriter::InferenceLogWriter()
+    : file_(nullptr), previous_sample_index_(0) {}
+
+InferenceLogWriter::~InferenceLogWriter() {
+  if (file_ != nullptr) {
+    fclose(file_);
+  }
+}
+
+TfLiteStatus InferenceLogWriter::Open(tflite::ErrorReporter* error_reporter,
+                                      const char* path) {
+  file_ = fopen(path, "wb");
+  if (file_ == nullptr) {
+    error_reporter->Report("Couldn't open '%s' for writing", path);
+    return kTfLiteError;
+  }
+  InferenceLogHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = kInferenceLogMagic;
+  header.version = kInferenceLogVersion;
+  header.category_count = kCategoryCount;
+  header.sample_rate = kAudioSampleFrequency;
+  if (fwrite(&header, sizeof(header), 1, file_) != 1) {
+    error_reporter->Report("Couldn't write to '%s'", path);
+    return kTfLiteError;
+  }
+  previous_sample_index_ = 0;
+  return kTfLiteOk;
+}
+
+TfLiteStatus InferenceLogWriter::Append(tflite::ErrorReporter* error_reporter,
+                                        int64_t sample_index,
+                                        const uint8_t* scores) {
+  const int64_t delta = sample_index - previous_sample_index_;
+  if ((delta < 0) || (delta > UINT32_MAX)) {
+    error_reporter->Report("Inference log records must be in time order");
+    return kTfLiteError;
+  }
+  uint8_t record[kRecordSize];
+  const uint32_t delta32 = static_cast<uint32_t>(delta);
+  memcpy(record, &delta32, sizeof(delta32));
+  memcpy(record + sizeof(delta32), scores, kCategoryCount);
+  if (fwrite(record, kRecordSize, 1, file_) != 1) {
+    error_reporter->Report("Couldn't write to the inference log");
+    return kTfLiteError;
+  }
+  previous_sample_index_ = sample_index;
+  return kTfLiteOk;
+}
+
+TfLiteStatus InferenceLogWriter::Close(tflite::ErrorReporter* error_reporter) {
+  const bool closed = (fclose(file_) == 0);
+  file_ = nullptr;
+  if (!closed) {
+    error_reporter->Report("Couldn't finish writing the inference log");
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus ReadInferenceLog(tflite::ErrorReporter* error_reporter,
+                              const char* path,
+                              std::vector<InferenceRecord>* records) {
+  FILE* file = fopen(path, "rb");
+  if (file == nullptr) {
+    error_reporter->Report("Couldn't open '%s'", path);
+    return kTfLiteError;
+  }
+  std::vector<uint8_t> contents;
+  uint8_t buffer[64 * 1024];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    contents.insert(contents.end(), buffer, buffer + read);
+  }
+  fclose(file);
+
+  InferenceLogHeader header;
+  if (contents.size() < sizeof(header)) {
+    error_reporter->Report("'%s' is too small to be an inference log", path);
+    return kTfLiteError;
+  }
+  memcpy(&header, contents.data(), sizeof(header));
+  if ((header.magic != kInferenceLogMagic) ||
+      (header.version != kInferenceLogVersion)) {
+    error_reporter->Report("'%s' isn't a version %d inference log", path,
+                           kInferenceLogVersion);
+    return kTfLiteError;
+  }
+  if ((header.category_count != kCategoryCount) ||
+      (header.sample_rate != kAudioSampleFrequency)) {
+    error_reporter->Report("'%s' has %d categories at %dHz, expected %d at "
+                           "%dHz",
+                           path, header.category_count, header.sample_rate,
+                           kCategoryCount, kAudioSampleFrequency);
+    return kTfLiteError;
+  }
+  const size_t body_size = contents.size() - sizeof(header);
+  if (body_size % kRecordSize != 0) {
+    error_reporter->Report("'%s' ends partway through a record", path);
+    return kTfLiteError;
+  }
+
+  records->resize(body_size / kRecordSize);
+  const uint8_t* record = contents.data() + sizeof(header);
+  int64_t sample_index = 0;
+  for (InferenceRecord& entry : *records) {
+    uint32_t delta;
+    memcpy(&delta, record, sizeof(delta));
+    sample_index += delta;
+    entry.sample_index = sample_index;
+    memcpy(entry.scores, record + sizeof(delta), kCategoryCount);
+    record += kRecordSize;
+  }
+  return kTfLiteOk;
+}
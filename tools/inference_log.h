@@ -0,0 +1,79 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_INFERENCE_LOG_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_INFERENCE_LOG_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "micro_model_settings.h"
+#include "tensorflow/lite/c/c_api_internal.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+
+// An inference log keeps the model's raw output for every Invoke() over a
+// recording, so that recognizer settings can be tried out by replaying the
+// log through RecognizeCommands instead of running the frontend and model
+// again.
+//
+// The file is a 16-byte header followed by one record per inference, in time
+// order. Each record is the number of samples since the previous inference,
+// or since the start of the recording for the first, as a uint32_t, then the
+// kCategoryCount uint8 scores. Everything is little-endian, the native order
+// of the hosts this runs on.
+
+constexpr uint32_t kInferenceLogMagic = 0x4c49534d;  // "MSIL"
+constexpr uint16_t kInferenceLogVersion = 1;
+
+struct InferenceLogHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t category_count;
+  uint32_t sample_rate;
+  uint32_t reserved;
+};
+
+struct InferenceRecord {
+  // When the scores were given to the recognizer, on the
+  // LatestAudioSampleIndex() clock.
+  int64_t sample_index;
+  uint8_t scores[kCategoryCount];
+};
+
+// Writes a log one inference at a time.
+class InferenceLogWriter {
+ public:
+  InferenceLogWriter();
+  ~InferenceLogWriter();
+
+  TfLiteStatus Open(tflite::ErrorReporter* error_reporter, const char* path);
+  // Records must be appended in time order.
+  TfLiteStatus Append(tflite::ErrorReporter* error_reporter,
+                      int64_t sample_index, const uint8_t* scores);
+  TfLiteStatus Close(tflite::ErrorReporter* error_reporter);
+
+ private:
+  FILE* file_;
+  int64_t previous_sample_index_;
+};
+
+// Reads a whole log, which must have been written with this build's
+// categories and sample rate.
+TfLiteStatus ReadInferenceLog(tflite::ErrorReporter* error_reporter,
+                              const char* path,
+                              std::vector<InferenceRecord>* records);
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_INFERENCE_LOG_H_
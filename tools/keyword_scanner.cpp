@@ -0,0 +1,143 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "keyword_scanner.h"
+
+#include <cstring>
+
+#include "tensorflow/lite/experimental/micro/kernels/micro_ops.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+#include "tensorflow/lite/version.h"
+
+KeywordScanner::KeywordScanner() : model_input_(nullptr) {}
+
+TfLiteStatus KeywordScanner::Initialize(tflite::ErrorReporter* error_reporter,
+                                        const void* model_data,
+                                        const RecognizerSettings& settings) {
+  const tflite::Model* model = tflite::GetModel(model_data);
+  if (model->version() != TFLITE_SCHEMA_VERSION) {
+    error_reporter->Report(
+        "Model provided is schema version %d not equal "
+        "to supported version %d.",
+        model->version(), TFLITE_SCHEMA_VERSION);
+    return kTfLiteError;
+  }
+  op_resolver_.AddBuiltin(tflite::BuiltinOperator_DEPTHWISE_CONV_2D,
+                          tflite::ops::micro::Register_DEPTHWISE_CONV_2D());
+  op_resolver_.AddBuiltin(tflite::BuiltinOperator_FULLY_CONNECTED,
+                          tflite::ops::micro::Register_FULLY_CONNECTED());
+  op_resolver_.AddBuiltin(tflite::BuiltinOperator_SOFTMAX,
+                          tflite::ops::micro::Register_SOFTMAX());
+
+  tensor_arena_.resize(kTensorArenaSize);
+  interpreter_.reset(new tflite::MicroInterpreter(
+      model, op_resolver_, tensor_arena_.data(), tensor_arena_.size(),
+      error_reporter));
+  if (interpreter_->AllocateTensors() != kTfLiteOk) {
+    error_reporter->Report("AllocateTensors() failed");
+    return kTfLiteError;
+  }
+  model_input_ = interpreter_->input(0);
+  if ((model_input_->dims->size != 4) || (model_input_->dims->data[0] != 1) ||
+      (model_input_->dims->data[1] != kFeatureSliceCount) ||
+      (model_input_->dims->data[2] != kFeatureSliceSize) ||
+      (model_input_->type != kTfLiteUInt8)) {
+    error_reporter->Report("Bad input tensor parameters in model");
+    return kTfLiteError;
+  }
+  settings_ = settings;
+  return kTfLiteOk;
+}
+
+TfLiteStatus KeywordScanner::Scan(tflite::ErrorReporter* error_reporter,
+                                  const int16_t* samples, size_t sample_count,
+                                  int64_t first_slice, int64_t report_slice,
+                                  int64_t end_slice,
+                                  std::vector<ScanDetection>* detections,
+                                  std::vector<uint8_t>* scores) {
+  if ((first_slice < 0) || (first_slice > report_slice) ||
+      (report_slice > end_slice) ||
+      (end_slice > MicroFeaturesSliceCount(sample_count))) {
+    error_reporter->Report("Can't scan slices %d to %d of %d",
+                           static_cast<int>(first_slice),
+                           static_cast<int>(end_slice),
+                           MicroFeaturesSliceCount(sample_count));
+    return kTfLiteError;
+  }
+
+  RecognizeCommands recognizer(error_reporter,
+                               settings_.average_window_duration_ms,
+                               settings_.detection_threshold,
+                               settings_.suppression_ms,
+                               settings_.minimum_count);
+  uint8_t* spectrogram = model_input_->data.uint8;
+  memset(spectrogram, 0, kFeatureElementCount);
+  ResetMicroFeaturesWorkspace(&workspace_);
+  uint8_t* newest_slice =
+      spectrogram + ((kFeatureSliceCount - 1) * kFeatureSliceSize);
+
+  for (int64_t slice = first_slice; slice < end_slice; ++slice) {
+    memmove(spectrogram, spectrogram + kFeatureSliceSize,
+            kFeatureElementCount - kFeatureSliceSize);
+    const int64_t slice_start = slice * kFeatureSliceStrideSamples;
+    TfLiteStatus feature_status = ComputeSpectrogram(
+        error_reporter, samples + slice_start, kFeatureSliceDurationSamples,
+        &workspace_, newest_slice, kFeatureSliceSize);
+    if (feature_status != kTfLiteOk) {
+      return feature_status;
+    }
+
+    if (interpreter_->Invoke() != kTfLiteOk) {
+      error_reporter->Report("Invoke failed");
+      return kTfLiteError;
+    }
+    const TfLiteTensor* output = interpreter_->output(0);
+    const int64_t current_sample_index =
+        slice_start + kFeatureSliceDurationSamples;
+    const char* found_command = nullptr;
+    uint8_t score = 0;
+    bool is_new_command = false;
+    TfLiteStatus process_status = recognizer.ProcessLatestResultsAtSample(
+        output, current_sample_index, &found_command, &score, &is_new_command);
+    if (process_status != kTfLiteOk) {
+      return process_status;
+    }
+    if (slice < report_slice) {
+      continue;
+    }
+    if (scores != nullptr) {
+      scores->insert(scores->end(), output->data.uint8,
+                     output->data.uint8 + kCategoryCount);
+    }
+    if (!is_new_command) {
+      continue;
+    }
+    int category = kSilenceIndex;
+    for (int i = 0; i < kCategoryCount; ++i) {
+      if (found_command == kCategoryLabels[i]) {
+        category = i;
+      }
+    }
+    if ((category == kSilenceIndex) || (category == kUnknownIndex)) {
+      continue;
+    }
+    ScanDetection detection;
+    detection.sample_index = current_sample_index;
+    detection.category = category;
+    detection.score = score;
+    detections->push_back(detection);
+  }
+  return kTfLiteOk;
+}
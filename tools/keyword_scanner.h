@@ -0,0 +1,88 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_KEYWORD_SCANNER_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_KEYWORD_SCANNER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "micro_features_generator.h"
+#include "micro_model_settings.h"
+#include "recognize_commands.h"
+#include "tensorflow/lite/c/c_api_internal.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+#include "tensorflow/lite/experimental/micro/micro_interpreter.h"
+#include "tensorflow/lite/experimental/micro/micro_mutable_op_resolver.h"
+
+// A new command reported by RecognizeCommands, at the LatestAudioSampleIndex()
+// time the recognizer was given. Like RespondToCommand(), the scanner ignores
+// silence and unknown.
+struct ScanDetection {
+  int64_t sample_index;
+  int category;
+  uint8_t score;
+};
+
+// Runs the device's pipeline of frontend, model and recognizer over audio held
+// in memory, with one inference for each new feature slice. On the device the
+// model runs whenever a loop() finds at least one new slice, so this is the
+// cadence it has when it keeps up with the microphone. Each scanner has its own
+// interpreter and frontend workspace, so several can run on separate threads.
+class KeywordScanner {
+ public:
+  KeywordScanner();
+
+  // Sets up an interpreter for the model, which must stay alive as long as the
+  // scanner, and the recognizer settings used by Scan().
+  TfLiteStatus Initialize(tflite::ErrorReporter* error_reporter,
+                          const void* model_data,
+                          const RecognizerSettings& settings);
+
+  // Runs the slices in [first_slice, end_slice) of samples, which are at
+  // kAudioSampleFrequency, through the pipeline, starting from a reset
+  // frontend, an empty spectrogram and a new recognizer. Slice n is complete
+  // at sample n * kFeatureSliceStrideSamples + kFeatureSliceDurationSamples,
+  // which is the time its inference is given to the recognizer.
+  //
+  // Only the slices from report_slice on are reported. The ones before it
+  // are there to warm up the noise estimates, spectrogram and averaging
+  // window, so a scan of part of a recording can pick up where a scan of what
+  // came before would have been. New commands are appended to detections, and
+  // if scores isn't null, the model's kCategoryCount outputs for each
+  // reported slice are appended to it.
+  TfLiteStatus Scan(tflite::ErrorReporter* error_reporter,
+                    const int16_t* samples, size_t sample_count,
+                    int64_t first_slice, int64_t report_slice,
+                    int64_t end_slice, std::vector<ScanDetection>* detections,
+                    std::vector<uint8_t>* scores);
+
+  const RecognizerSettings& settings() const { return settings_; }
+
+ private:
+  // The same size as the device's arena.
+  static constexpr int kTensorArenaSize = 10 * 1024;
+
+  tflite::MicroMutableOpResolver op_resolver_;
+  std::unique_ptr<tflite::MicroInterpreter> interpreter_;
+  std::vector<uint8_t> tensor_arena_;
+  TfLiteTensor* model_input_;
+  MicroFeaturesWorkspace workspace_;
+  RecognizerSettings settings_;
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_KEYWORD_SCANNER_H_
@@ -0,0 +1,198 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Times the frontend's window and FFT from micro_features_fft.h, checks the
+// vectorized versions give exactly the same results as the scalar ones, and
+// measures how far the fixed-point spectrum is from a double-precision one.
+// This is a standalone host program, built from the project root with:
+//
+//   g++ -O2 -mavx2 -I src -I $TFLM -o /tmp/micro_features_fft_benchmark
+//       tools/micro_features_fft_benchmark.cpp src/micro_features_fft.cpp
+//       src/micro_features_tables.cpp
+//   /tmp/micro_features_fft_benchmark [iterations]
+//
+// where TFLM=.pio/libdeps/esp32s3/TensorFlowLite_ESP32/src. The vectorized
+// code is picked at compile time, so -mavx2, -msse4.1 and no flag at all each
+// give a different backend to compare against the scalar code. Adding
+// -DMICRO_FEATURES_FFT_BENCHMARK_LIBRARY and the library's fft.cc, fft_util.cc
+// and kiss_fft_int16.cc also times FftCompute() and checks it matches.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "micro_features_fft.h"
+
+#if defined(MICRO_FEATURES_FFT_BENCHMARK_LIBRARY)
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_util.h"
+#endif  // defined(MICRO_FEATURES_FFT_BENCHMARK_LIBRARY)
+
+namespace {
+
+constexpr int kBinCount = kMicroFeaturesFftComplexSize + 1;
+constexpr int kTestWindowCount = 64;
+
+// Windows of test audio: noise and tones at a spread of levels, since the
+// level decides the input shift and so how much of the FFT's range is used.
+void GenerateTestWindows(int16_t windows[][kMicroFeaturesWindowSize]) {
+  uint32_t random = 1;
+  for (int w = 0; w < kTestWindowCount; ++w) {
+    const int level_shift = w % 12;
+    const double frequency = 0.01 + (0.04 * w);
+    for (int i = 0; i < kMicroFeaturesWindowSize; ++i) {
+      random = (random * 1664525u) + 1013904223u;
+      int32_t value;
+      if (w % 2) {
+        value = static_cast<int16_t>(random >> 16);
+      } else {
+        value = static_cast<int32_t>(30000.0 * std::sin(frequency * i));
+      }
+      windows[w][i] = static_cast<int16_t>(value >> level_shift);
+    }
+  }
+}
+
+int InputShift(int16_t max_abs_value) {
+  int bits = 0;
+  while ((bits < 16) && ((max_abs_value >> bits) != 0)) {
+    ++bits;
+  }
+  return 15 - bits;
+}
+
+// The spectrum the fixed-point FFT approximates. kissfft scales its output
+// down by the FFT size as it goes, so this does too.
+void ReferenceSpectrum(const int16_t* windowed, int input_shift,
+                       double* real, double* imag) {
+  const double scale = std::ldexp(1.0, input_shift) / kMicroFeaturesFftSize;
+  for (int k = 0; k < kBinCount; ++k) {
+    double sum_real = 0.0;
+    double sum_imag = 0.0;
+    for (int n = 0; n < kMicroFeaturesWindowSize; ++n) {
+      const double phase = -2.0 * M_PI * k * n / kMicroFeaturesFftSize;
+      sum_real += windowed[n] * std::cos(phase);
+      sum_imag += windowed[n] * std::sin(phase);
+    }
+    real[k] = sum_real * scale;
+    imag[k] = sum_imag * scale;
+  }
+}
+
+template <typename Function>
+void PrintTiming(const char* stage, const char* backend, int iterations,
+                 Function function) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    function(i % kTestWindowCount);
+  }
+  const auto end = std::chrono::steady_clock::now();
+  printf("%-6s %-7s %8.1f ns\n", stage, backend,
+         std::chrono::duration<double, std::nano>(end - start).count() /
+             iterations);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int iterations = (argc > 1) ? atoi(argv[1]) : 200000;
+  static int16_t windows[kTestWindowCount][kMicroFeaturesWindowSize];
+  GenerateTestWindows(windows);
+
+  static int16_t windowed[kTestWindowCount][kMicroFeaturesWindowSize];
+  static int shifts[kTestWindowCount];
+  int16_t work[kMicroFeaturesFftSize];
+  complex_int16_t output[kBinCount];
+  complex_int16_t scalar_output[kBinCount];
+  int16_t scalar_windowed[kMicroFeaturesWindowSize];
+
+  int mismatches = 0;
+  double error_energy = 0.0;
+  double signal_energy = 0.0;
+  double max_error = 0.0;
+  for (int w = 0; w < kTestWindowCount; ++w) {
+    const int16_t max_abs_value =
+        ApplyMicroFeaturesWindow(windows[w], windowed[w]);
+    mismatches += (max_abs_value != ApplyMicroFeaturesWindowScalar(
+                                        windows[w], scalar_windowed));
+    mismatches += (memcmp(windowed[w], scalar_windowed,
+                          sizeof(scalar_windowed)) != 0);
+    shifts[w] = InputShift(max_abs_value);
+    ComputeMicroFeaturesFft(windowed[w], shifts[w], work, output);
+    ComputeMicroFeaturesFftScalar(windowed[w], shifts[w], work,
+                                  scalar_output);
+    mismatches += (memcmp(output, scalar_output, sizeof(output)) != 0);
+
+    double real[kBinCount];
+    double imag[kBinCount];
+    ReferenceSpectrum(windowed[w], shifts[w], real, imag);
+    for (int k = 0; k < kBinCount; ++k) {
+      const double error_real = output[k].real - real[k];
+      const double error_imag = output[k].imag - imag[k];
+      const double error =
+          std::sqrt((error_real * error_real) + (error_imag * error_imag));
+      error_energy += error * error;
+      signal_energy += (real[k] * real[k]) + (imag[k] * imag[k]);
+      max_error = (error > max_error) ? error : max_error;
+    }
+  }
+
+#if defined(MICRO_FEATURES_FFT_BENCHMARK_LIBRARY)
+  FftState library_state;
+  if (!FftPopulateState(&library_state, kMicroFeaturesWindowSize)) {
+    fprintf(stderr, "FftPopulateState() failed\n");
+    return 1;
+  }
+  for (int w = 0; w < kTestWindowCount; ++w) {
+    FftCompute(&library_state, windowed[w], shifts[w]);
+    ComputeMicroFeaturesFft(windowed[w], shifts[w], work, output);
+    mismatches +=
+        (memcmp(output, library_state.output, sizeof(output)) != 0);
+  }
+#endif  // defined(MICRO_FEATURES_FFT_BENCHMARK_LIBRARY)
+
+  printf("Backend: %s\n", MicroFeaturesFftBackend());
+  printf("Mismatched windows: %d\n", mismatches);
+  printf("Error against double precision: %.2f dB below the signal, at most "
+         "%.2f per bin\n",
+         10.0 * std::log10(signal_energy / error_energy), max_error);
+
+  int16_t scratch[kMicroFeaturesWindowSize];
+  volatile int16_t sink = 0;
+  PrintTiming("Window", "scalar", iterations, [&](int w) {
+    sink = ApplyMicroFeaturesWindowScalar(windows[w], scratch);
+  });
+  PrintTiming("Window", MicroFeaturesFftBackend(), iterations, [&](int w) {
+    sink = ApplyMicroFeaturesWindow(windows[w], scratch);
+  });
+  PrintTiming("FFT", "scalar", iterations, [&](int w) {
+    ComputeMicroFeaturesFftScalar(windowed[w], shifts[w], work, output);
+    sink = output[1].real;
+  });
+  PrintTiming("FFT", MicroFeaturesFftBackend(), iterations, [&](int w) {
+    ComputeMicroFeaturesFft(windowed[w], shifts[w], work, output);
+    sink = output[1].real;
+  });
+#if defined(MICRO_FEATURES_FFT_BENCHMARK_LIBRARY)
+  PrintTiming("FFT", "library", iterations, [&](int w) {
+    FftCompute(&library_state, windowed[w], shifts[w]);
+    sink = library_state.output[1].real;
+  });
+  FftFreeStateContents(&library_state);
+#endif  // defined(MICRO_FEATURES_FFT_BENCHMARK_LIBRARY)
+  (void)sink;
+  return (mismatches == 0) ? 0 : 1;
+}
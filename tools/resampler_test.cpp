@@ -0,0 +1,162 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Checks PolyphaseResampler against the design targets in
+// tools/generate_resampler_tables.cpp, and that full-scale input saturates
+// instead of wrapping. This is a standalone host program, built from the
+// project root with:
+//
+//   TFLM=.pio/libdeps/esp32s3/TensorFlowLite_ESP32/src
+//   g++ -O2 -I src -I $TFLM -o /tmp/resampler_test tools/resampler_test.cpp
+//       src/resampler.cpp src/resampler_tables.cpp
+//       $TFLM/tensorflow/lite/experimental/micro/micro_error_reporter.cpp
+//       $TFLM/tensorflow/lite/experimental/micro/debug_log.cpp
+//   /tmp/resampler_test
+//
+// For every bank it prints the level of tones in the pass band, which should
+// be within 1dB, and in the stop band, which should be at least 60dB down.
+// Then, for every phase, it feeds the input with the signs that drive that
+// phase hardest in each direction and checks the output clamps to the int16
+// limits. Adding -fsanitize=undefined also catches any overflow on the way.
+// It exits with 1 if any check fails.
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "resampler.h"
+
+namespace {
+
+constexpr double kPassBandToleranceDb = 1.0;
+constexpr double kStopBandAttenuationDb = 60.0;
+constexpr double kToneAmplitude = 16384.0;
+
+enum ToneBand { kPassBand, kTransitionBand, kStopBand };
+
+struct ToneCheck {
+  double frequency;
+  ToneBand band;
+};
+
+// Tones in the transition band are only printed.
+constexpr ToneCheck kToneChecks[] = {
+    {1000.0, kPassBand},  {6500.0, kPassBand},  {7500.0, kTransitionBand},
+    {10000.0, kStopBand}, {14000.0, kStopBand},
+};
+
+// Resamples a second of a tone and returns its output level relative to the
+// input, in dB, leaving out the start while the history fills.
+double MeasureToneDb(PolyphaseResampler* resampler, int input_rate,
+                     double frequency) {
+  std::vector<int16_t> input(input_rate);
+  for (int i = 0; i < input_rate; ++i) {
+    input[i] = static_cast<int16_t>(std::lround(
+        kToneAmplitude * std::sin(2.0 * M_PI * frequency * i / input_rate)));
+  }
+  std::vector<int16_t> output(resampler->MaxOutputCount(input_rate));
+  resampler->Reset();
+  const int output_count =
+      resampler->Process(input.data(), input_rate, output.data());
+  double sum_of_squares = 0.0;
+  int counted = 0;
+  for (int i = kResamplerMaxTaps; i < output_count; ++i) {
+    sum_of_squares += static_cast<double>(output[i]) * output[i];
+    ++counted;
+  }
+  const double rms = std::sqrt(sum_of_squares / counted);
+  return 20.0 * std::log10(rms / (kToneAmplitude / std::sqrt(2.0)));
+}
+
+// Output k is computed once 1 + k * decimation / interpolation inputs have
+// arrived, from the last taps of them and phase k * decimation %
+// interpolation. For each phase this builds the input that makes the output
+// as large as possible in the given direction, and checks it lands on the
+// int16 limit. Returns the number of phases that didn't.
+int CheckFullScale(PolyphaseResampler* resampler,
+                   const ResamplerFilterBank& bank, int direction) {
+  const int taps = bank.taps;
+  const int64_t interpolation = bank.interpolation;
+  const int64_t decimation = bank.decimation;
+  const int16_t expected = (direction > 0) ? INT16_MAX : INT16_MIN;
+  int failures = 0;
+  for (int64_t k = 0; k < interpolation; ++k) {
+    // Skip whole cycles of phases until the history is full.
+    int64_t output_index = k;
+    while ((1 + (output_index * decimation) / interpolation) < taps) {
+      output_index += interpolation;
+    }
+    const int input_count =
+        static_cast<int>(1 + (output_index * decimation) / interpolation);
+    const int16_t* coefficients =
+        bank.coefficients + ((output_index * decimation) % interpolation) * taps;
+    std::vector<int16_t> input(input_count, 0);
+    for (int j = 0; j < taps; ++j) {
+      const bool is_high = ((coefficients[j] >= 0) == (direction > 0));
+      input[input_count - taps + j] = is_high ? INT16_MAX : INT16_MIN;
+    }
+    std::vector<int16_t> output(resampler->MaxOutputCount(input_count));
+    resampler->Reset();
+    const int output_count =
+        resampler->Process(input.data(), input_count, output.data());
+    if ((output_count != output_index + 1) ||
+        (output[output_index] != expected)) {
+      if (failures == 0) {
+        fprintf(stderr, "%dHz phase %d gave %d instead of %d\n",
+                bank.input_rate, static_cast<int>(k),
+                (output_count > output_index) ? output[output_index] : 0,
+                expected);
+      }
+      ++failures;
+    }
+  }
+  return failures;
+}
+
+}  // namespace
+
+int main() {
+  tflite::MicroErrorReporter micro_error_reporter;
+  tflite::ErrorReporter* error_reporter = &micro_error_reporter;
+
+  int failures = 0;
+  for (int b = 0; b < g_resampler_filter_bank_count; ++b) {
+    const ResamplerFilterBank& bank = g_resampler_filter_banks[b];
+    PolyphaseResampler resampler;
+    if (resampler.Initialize(error_reporter, bank.input_rate) != kTfLiteOk) {
+      return 1;
+    }
+    printf("%dHz:", bank.input_rate);
+    for (const ToneCheck& check : kToneChecks) {
+      const double level_db =
+          MeasureToneDb(&resampler, bank.input_rate, check.frequency);
+      printf(" %.0fHz %.1fdB", check.frequency, level_db);
+      if ((check.band == kPassBand) &&
+          (std::fabs(level_db) > kPassBandToleranceDb)) {
+        ++failures;
+      } else if ((check.band == kStopBand) &&
+                 (level_db > -kStopBandAttenuationDb)) {
+        ++failures;
+      }
+    }
+    const int full_scale_failures = CheckFullScale(&resampler, bank, 1) +
+                                    CheckFullScale(&resampler, bank, -1);
+    printf(", %d of %d full-scale phases wrong\n", full_scale_failures,
+           2 * bank.interpolation);
+    failures += full_scale_failures;
+  }
+  printf("Failed checks: %d\n", failures);
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,355 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Scans a long recording for commands, splitting it into chunks that are run
+// on separate threads. This is a standalone host program, built from the
+// project root with:
+//
+//   TFLM=.pio/libdeps/esp32s3/TensorFlowLite_ESP32/src
+//   g++ -std=c++17 -O2 -march=native -pthread -I src -I tools -I $TFLM
+//       -o /tmp/scan_recording tools/scan_recording.cpp
+//       tools/inference_log.cpp tools/keyword_scanner.cpp tools/wav_file.cpp
+//       src/memory_report.cpp
+//       src/micro_features_generator.cpp src/micro_features_fft.cpp
+//       src/micro_features_channels.cpp src/micro_features_tables.cpp
+//       src/micro_model_settings.cpp src/recognize_commands.cpp
+//       src/resampler.cpp src/resampler_tables.cpp
+//       src/tiny_conv_micro_features_model_data.cpp
+//       $TFLM/tensorflow/lite/experimental/microfrontend/lib/log_lut.c
+//       $TFLM/tensorflow/lite/experimental/micro/*.cpp
+//       $TFLM/tensorflow/lite/experimental/micro/kernels/*.cpp
+//       $TFLM/tensorflow/lite/core/api/*.cpp
+//       $TFLM/tensorflow/lite/kernels/kernel_util.cpp
+//       $TFLM/tensorflow/lite/kernels/internal/quantization_util.cpp
+//       $TFLM/tensorflow/lite/c/c_api_internal.c
+//   /tmp/scan_recording [--threads=N] [--chunk_seconds=S]
+//       [--warm_up_seconds=S] [--compare] [--log=path] recording.wav
+//
+// The frontend's noise estimates, the spectrogram and the recognizer's
+// averaging window all depend on the audio before them, so a chunk can't
+// simply be started from scratch. Instead each chunk's scan begins
+// --warm_up_seconds early, with those results discarded, which gives the state
+// time to settle to what a scan of everything before would have reached.
+// Chunks are then joined in order, and a command that repeats the one before
+// it within the recognizer's suppression time is dropped as a duplicate, in
+// case a too-short warm-up let it be reported by both chunks.
+//
+// With --compare the recording is also scanned in one piece, and the report
+// shows how far the chunked results differ: which detections don't match,
+// how many inferences gave different scores, and how long after a chunk
+// boundary the scores took to agree again.
+//
+// With --log, the scores of every inference are written to an inference log,
+// described in inference_log.h, for tools/sweep_recognizer.cpp to replay.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "inference_log.h"
+#include "keyword_scanner.h"
+#include "micro_model_settings.h"
+#include "resampler.h"
+#include "tiny_conv_micro_features_model_data.h"
+#include "wav_file.h"
+
+namespace {
+
+struct Chunk {
+  int64_t first_slice;
+  int64_t report_slice;
+  int64_t end_slice;
+  bool is_ok = false;
+  std::vector<ScanDetection> detections;
+  std::vector<uint8_t> scores;
+};
+
+double SliceSeconds(int64_t slices) {
+  return (slices * kFeatureSliceStrideMs) / 1000.0;
+}
+
+double SampleSeconds(int64_t sample_index) {
+  return static_cast<double>(sample_index) / kAudioSampleFrequency;
+}
+
+void PrintDetection(const char* prefix, const ScanDetection& detection) {
+  printf("%s%10.3fs  %-8s %3d\n", prefix, SampleSeconds(detection.sample_index),
+         kCategoryLabels[detection.category], detection.score);
+}
+
+// Joins the chunks' detections in time order, dropping any that repeat the
+// previous command within the suppression time. Returns how many were dropped.
+int StitchDetections(const std::vector<Chunk>& chunks,
+                     const RecognizerSettings& settings,
+                     std::vector<ScanDetection>* detections) {
+  const int64_t suppression_samples =
+      static_cast<int64_t>(settings.suppression_ms) * kAudioSamplesPerMs;
+  int duplicates = 0;
+  for (const Chunk& chunk : chunks) {
+    for (const ScanDetection& detection : chunk.detections) {
+      if (!detections->empty() &&
+          (detections->back().category == detection.category) &&
+          (detection.sample_index - detections->back().sample_index <=
+           suppression_samples)) {
+        ++duplicates;
+        continue;
+      }
+      detections->push_back(detection);
+    }
+  }
+  return duplicates;
+}
+
+void Compare(const std::vector<Chunk>& chunks,
+             const std::vector<ScanDetection>& stitched,
+             const std::vector<ScanDetection>& sequential,
+             const std::vector<uint8_t>& sequential_scores) {
+  // Detections only count as the same if they agree exactly.
+  std::vector<bool> is_matched(sequential.size(), false);
+  int matched = 0;
+  for (const ScanDetection& detection : stitched) {
+    bool found = false;
+    for (size_t i = 0; i < sequential.size(); ++i) {
+      if (!is_matched[i] &&
+          (sequential[i].sample_index == detection.sample_index) &&
+          (sequential[i].category == detection.category)) {
+        is_matched[i] = true;
+        found = true;
+        ++matched;
+        break;
+      }
+    }
+    if (!found) {
+      PrintDetection("  only chunked:   ", detection);
+    }
+  }
+  for (size_t i = 0; i < sequential.size(); ++i) {
+    if (!is_matched[i]) {
+      PrintDetection("  only sequential:", sequential[i]);
+    }
+  }
+  printf("Detections: %d sequential, %d chunked, %d matching\n",
+         static_cast<int>(sequential.size()),
+         static_cast<int>(stitched.size()), matched);
+
+  int64_t differing_slices = 0;
+  int max_difference = 0;
+  int64_t max_settle_slices = 0;
+  for (const Chunk& chunk : chunks) {
+    const uint8_t* expected =
+        sequential_scores.data() + (chunk.report_slice * kCategoryCount);
+    const int64_t slice_count = chunk.end_slice - chunk.report_slice;
+    for (int64_t slice = 0; slice < slice_count; ++slice) {
+      bool differs = false;
+      for (int i = 0; i < kCategoryCount; ++i) {
+        const int difference =
+            std::abs(chunk.scores[(slice * kCategoryCount) + i] -
+                     expected[(slice * kCategoryCount) + i]);
+        max_difference = std::max(max_difference, difference);
+        differs |= (difference != 0);
+      }
+      if (differs) {
+        ++differing_slices;
+        max_settle_slices = std::max(max_settle_slices, slice + 1);
+      }
+    }
+  }
+  printf("Inferences with different scores: %lld of %lld, largest difference "
+         "%d\n",
+         static_cast<long long>(differing_slices),
+         static_cast<long long>(sequential_scores.size() / kCategoryCount),
+         max_difference);
+  if (differing_slices > 0) {
+    printf("Scores agreed again within %.2f s of every chunk boundary\n",
+           SliceSeconds(max_settle_slices));
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  tflite::MicroErrorReporter micro_error_reporter;
+  tflite::ErrorReporter* error_reporter = &micro_error_reporter;
+
+  int thread_count = std::thread::hardware_concurrency();
+  double chunk_seconds = 60.0;
+  double warm_up_seconds = 10.0;
+  bool compare = false;
+  const char* log_path = nullptr;
+  const char* path = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i], "--threads=", 10) == 0) {
+      thread_count = atoi(argv[i] + 10);
+    } else if (strncmp(argv[i], "--chunk_seconds=", 16) == 0) {
+      chunk_seconds = atof(argv[i] + 16);
+    } else if (strncmp(argv[i], "--warm_up_seconds=", 18) == 0) {
+      warm_up_seconds = atof(argv[i] + 18);
+    } else if (strcmp(argv[i], "--compare") == 0) {
+      compare = true;
+    } else if (strncmp(argv[i], "--log=", 6) == 0) {
+      log_path = argv[i] + 6;
+    } else if (path == nullptr) {
+      path = argv[i];
+    } else {
+      path = nullptr;
+      break;
+    }
+  }
+  const int64_t chunk_slices =
+      static_cast<int64_t>(chunk_seconds * 1000.0 / kFeatureSliceStrideMs);
+  const int64_t warm_up_slices =
+      static_cast<int64_t>(warm_up_seconds * 1000.0 / kFeatureSliceStrideMs);
+  if ((path == nullptr) || (chunk_slices < 1) || (warm_up_slices < 0)) {
+    fprintf(stderr,
+            "Usage: %s [--threads=N] [--chunk_seconds=S] "
+            "[--warm_up_seconds=S] [--compare] [--log=path] recording.wav\n",
+            argv[0]);
+    return 1;
+  }
+  if (thread_count < 1) {
+    thread_count = 1;
+  }
+
+  std::vector<int16_t> samples;
+  int sample_rate;
+  if (ReadWavFile(error_reporter, path, &samples, &sample_rate) != kTfLiteOk) {
+    return 1;
+  }
+  PolyphaseResampler resampler;
+  if (resampler.Initialize(error_reporter, sample_rate) != kTfLiteOk) {
+    return 1;
+  }
+  std::vector<int16_t> resampled(resampler.MaxOutputCount(samples.size()));
+  resampled.resize(
+      resampler.Process(samples.data(), samples.size(), resampled.data()));
+  samples.clear();
+  samples.shrink_to_fit();
+  const int64_t slice_count = MicroFeaturesSliceCount(resampled.size());
+
+  std::vector<Chunk> chunks;
+  for (int64_t start = 0; start < slice_count; start += chunk_slices) {
+    Chunk chunk;
+    chunk.first_slice = std::max<int64_t>(0, start - warm_up_slices);
+    chunk.report_slice = start;
+    chunk.end_slice = std::min(slice_count, start + chunk_slices);
+    chunks.push_back(chunk);
+  }
+  thread_count = std::min<int>(thread_count, std::max<size_t>(chunks.size(), 1));
+
+  RecognizerSettings settings;
+  std::vector<KeywordScanner> scanners(thread_count);
+  for (KeywordScanner& scanner : scanners) {
+    if (scanner.Initialize(error_reporter, g_tiny_conv_micro_features_model_data,
+                           settings) != kTfLiteOk) {
+      return 1;
+    }
+  }
+
+  const bool keep_scores = compare || (log_path != nullptr);
+  const auto start = std::chrono::steady_clock::now();
+  std::atomic<size_t> next_chunk(0);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < thread_count; ++i) {
+    workers.emplace_back([&, i] {
+      tflite::MicroErrorReporter worker_error_reporter;
+      for (size_t index = next_chunk++; index < chunks.size();
+           index = next_chunk++) {
+        Chunk& chunk = chunks[index];
+        chunk.is_ok =
+            (scanners[i].Scan(&worker_error_reporter, resampled.data(),
+                              resampled.size(), chunk.first_slice,
+                              chunk.report_slice, chunk.end_slice,
+                              &chunk.detections,
+                              keep_scores ? &chunk.scores : nullptr) ==
+             kTfLiteOk);
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+  for (const Chunk& chunk : chunks) {
+    if (!chunk.is_ok) {
+      return 1;
+    }
+  }
+
+  std::vector<ScanDetection> detections;
+  const int duplicates = StitchDetections(chunks, settings, &detections);
+  for (const ScanDetection& detection : detections) {
+    PrintDetection("", detection);
+  }
+  const double audio_seconds = SampleSeconds(resampled.size());
+  printf("Scanned %.1f s of audio in %d chunks on %d threads in %.1f s, %.0fx "
+         "real time\n",
+         audio_seconds, static_cast<int>(chunks.size()), thread_count, seconds,
+         audio_seconds / seconds);
+  if (duplicates > 0) {
+    printf("%d detections were reported by two chunks, consider a longer "
+           "warm-up\n",
+           duplicates);
+  }
+
+  if (log_path != nullptr) {
+    InferenceLogWriter log_writer;
+    if (log_writer.Open(error_reporter, log_path) != kTfLiteOk) {
+      return 1;
+    }
+    for (const Chunk& chunk : chunks) {
+      for (int64_t slice = chunk.report_slice; slice < chunk.end_slice;
+           ++slice) {
+        const uint8_t* scores =
+            chunk.scores.data() +
+            ((slice - chunk.report_slice) * kCategoryCount);
+        if (log_writer.Append(error_reporter,
+                              (slice * kFeatureSliceStrideSamples) +
+                                  kFeatureSliceDurationSamples,
+                              scores) != kTfLiteOk) {
+          return 1;
+        }
+      }
+    }
+    if (log_writer.Close(error_reporter) != kTfLiteOk) {
+      return 1;
+    }
+  }
+
+  if (compare) {
+    std::vector<ScanDetection> sequential;
+    std::vector<uint8_t> sequential_scores;
+    const auto sequential_start = std::chrono::steady_clock::now();
+    if (scanners[0].Scan(error_reporter, resampled.data(), resampled.size(), 0,
+                         0, slice_count, &sequential,
+                         &sequential_scores) != kTfLiteOk) {
+      return 1;
+    }
+    const double sequential_seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                      sequential_start)
+            .count();
+    printf("Sequential scan took %.1f s, %.0fx real time\n", sequential_seconds,
+           audio_seconds / sequential_seconds);
+    Compare(chunks, detections, sequential, sequential_scores);
+  }
+  return 0;
+}
@@ -0,0 +1,369 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "spectrogram_cache.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cinttypes>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "frontend_fingerprint.h"
+#include "micro_model_settings.h"
+
+namespace {
+
+constexpr uint32_t kPackMagic = 0x4353534d;    // "MSSC"
+constexpr uint32_t kRecordMagic = 0x5253534d;  // "MSSR"
+constexpr uint32_t kPackVersion = 1;
+// Records and their features start on multiples of this.
+constexpr uint64_t kRecordAlignment = 8;
+// The mapping grows by at least this much, so appends rarely need a new one.
+constexpr uint64_t kMinMappingGrowth = 64 * 1024 * 1024;
+
+struct PackHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t settings_fingerprint;
+  uint32_t slice_size;
+  uint32_t reserved[3];
+};
+
+struct RecordHeader {
+  uint32_t magic;
+  uint32_t slice_count;
+  uint64_t audio_hash;
+  uint64_t sample_count;
+  // Fnv1a64() of the features, so that a torn append is caught on open.
+  uint64_t checksum;
+};
+
+static_assert(sizeof(PackHeader) % kRecordAlignment == 0,
+              "Records after the header must stay aligned");
+static_assert(sizeof(RecordHeader) % kRecordAlignment == 0,
+              "Features after a record header must stay aligned");
+
+uint64_t PaddedFeaturesSize(int slice_count) {
+  const uint64_t size = static_cast<uint64_t>(slice_count) * kFeatureSliceSize;
+  return (size + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+bool WriteFully(int fd, const void* data, size_t size, off_t offset) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  while (size > 0) {
+    const ssize_t written = pwrite(fd, bytes, size, offset);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    bytes += written;
+    size -= written;
+    offset += written;
+  }
+  return true;
+}
+
+// Holds an exclusive lock on the pack for as long as it's in scope.
+class PackLock {
+ public:
+  explicit PackLock(int fd) : fd_(fd) { flock(fd_, LOCK_EX); }
+  ~PackLock() { flock(fd_, LOCK_UN); }
+
+ private:
+  int fd_;
+};
+
+}  // namespace
+
+SpectrogramCache::SpectrogramCache()
+    : fd_(-1),
+      data_(nullptr),
+      mapped_size_(0),
+      hit_count_(0),
+      miss_count_(0) {}
+
+SpectrogramCache::~SpectrogramCache() { Close(); }
+
+TfLiteStatus SpectrogramCache::Open(tflite::ErrorReporter* error_reporter,
+                                    const char* directory) {
+  Close();
+  char file_name[64];
+  snprintf(file_name, sizeof(file_name), "/spectrograms-%016" PRIx64 ".pack",
+           FrontendSettingsFingerprint());
+  const std::string path = std::string(directory) + file_name;
+  fd_ = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd_ < 0) {
+    error_reporter->Report("Couldn't open the spectrogram cache '%s'",
+                           path.c_str());
+    return kTfLiteError;
+  }
+  TfLiteStatus status;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    PackLock lock(fd_);
+    status = LoadPack(error_reporter, path.c_str());
+  }
+  if (status != kTfLiteOk) {
+    Close();
+  }
+  return status;
+}
+
+TfLiteStatus SpectrogramCache::LoadPack(tflite::ErrorReporter* error_reporter,
+                                        const char* path) {
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) != 0) {
+    error_reporter->Report("Couldn't read the size of '%s'", path);
+    return kTfLiteError;
+  }
+  uint64_t file_size = file_stat.st_size;
+  if (file_size < sizeof(PackHeader)) {
+    // A new pack, or one whose creator died before finishing the header.
+    PackHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = kPackMagic;
+    header.version = kPackVersion;
+    header.settings_fingerprint = FrontendSettingsFingerprint();
+    header.slice_size = kFeatureSliceSize;
+    if ((ftruncate(fd_, 0) != 0) ||
+        !WriteFully(fd_, &header, sizeof(header), 0)) {
+      error_reporter->Report("Couldn't write to '%s'", path);
+      return kTfLiteError;
+    }
+    file_size = sizeof(header);
+  }
+  if (!EnsureMapped(file_size)) {
+    error_reporter->Report("Couldn't map '%s'", path);
+    return kTfLiteError;
+  }
+
+  const PackHeader* header = reinterpret_cast<const PackHeader*>(data_);
+  if ((header->magic != kPackMagic) || (header->version != kPackVersion) ||
+      (header->settings_fingerprint != FrontendSettingsFingerprint()) ||
+      (header->slice_size != kFeatureSliceSize)) {
+    error_reporter->Report("'%s' isn't a version %d spectrogram cache for "
+                           "these settings",
+                           path, kPackVersion);
+    return kTfLiteError;
+  }
+
+  const uint64_t valid_size = IndexRecords(file_size);
+  if ((valid_size < file_size) && (ftruncate(fd_, valid_size) != 0)) {
+    error_reporter->Report("Couldn't cut the incomplete record off '%s'",
+                           path);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+void SpectrogramCache::Close() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (const auto& mapping : old_mappings_) {
+    munmap(mapping.first, mapping.second);
+  }
+  old_mappings_.clear();
+  if (data_ != nullptr) {
+    munmap(const_cast<uint8_t*>(data_), mapped_size_);
+  }
+  data_ = nullptr;
+  mapped_size_ = 0;
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+  fd_ = -1;
+  index_.clear();
+}
+
+uint64_t SpectrogramCache::HashAudio(const int16_t* samples,
+                                     size_t sample_count) {
+  const uint64_t count = sample_count;
+  return Fnv1a64(samples, sample_count * sizeof(int16_t),
+                 Fnv1a64(&count, sizeof(count)));
+}
+
+const uint8_t* SpectrogramCache::Find(uint64_t audio_hash,
+                                      size_t sample_count, int* slice_count) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto entry = index_.find(audio_hash);
+  if ((entry == index_.end()) ||
+      (entry->second.sample_count != sample_count)) {
+    ++miss_count_;
+    return nullptr;
+  }
+  ++hit_count_;
+  *slice_count = entry->second.slice_count;
+  return data_ + entry->second.features_offset;
+}
+
+TfLiteStatus SpectrogramCache::Insert(tflite::ErrorReporter* error_reporter,
+                                      uint64_t audio_hash, size_t sample_count,
+                                      const uint8_t* features,
+                                      int slice_count) {
+  const size_t features_size =
+      static_cast<size_t>(slice_count) * kFeatureSliceSize;
+  RecordHeader record;
+  record.magic = kRecordMagic;
+  record.slice_count = slice_count;
+  record.audio_hash = audio_hash;
+  record.sample_count = sample_count;
+  record.checksum = Fnv1a64(features, features_size);
+  static const uint8_t kZeros[kRecordAlignment] = {};
+  const size_t padding = PaddedFeaturesSize(slice_count) - features_size;
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (index_.count(audio_hash) > 0) {
+    return kTfLiteOk;
+  }
+  PackLock lock(fd_);
+  // Other processes may have appended since this one last looked, so the end
+  // of the file is only known once the lock is held.
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) != 0) {
+    error_reporter->Report("Couldn't read the size of the spectrogram cache");
+    return kTfLiteError;
+  }
+  const uint64_t offset = file_stat.st_size;
+  const uint64_t features_offset = offset + sizeof(record);
+  if (!WriteFully(fd_, &record, sizeof(record), offset) ||
+      !WriteFully(fd_, features, features_size, features_offset) ||
+      !WriteFully(fd_, kZeros, padding, features_offset + features_size)) {
+    error_reporter->Report("Couldn't append to the spectrogram cache");
+    return kTfLiteError;
+  }
+  if (!EnsureMapped(features_offset + features_size)) {
+    error_reporter->Report("Couldn't map the grown spectrogram cache");
+    return kTfLiteError;
+  }
+  Entry& entry = index_[audio_hash];
+  entry.features_offset = features_offset;
+  entry.sample_count = sample_count;
+  entry.slice_count = slice_count;
+  return kTfLiteOk;
+}
+
+TfLiteStatus SpectrogramCache::GetSpectrogram(
+    tflite::ErrorReporter* error_reporter, const int16_t* samples,
+    size_t sample_count, MicroFeaturesWorkspace* workspace,
+    const uint8_t** features, int* slice_count) {
+  const uint64_t audio_hash = HashAudio(samples, sample_count);
+  *features = Find(audio_hash, sample_count, slice_count);
+  if (*features != nullptr) {
+    return kTfLiteOk;
+  }
+
+  const int computed_slice_count = MicroFeaturesSliceCount(sample_count);
+  std::vector<uint8_t> computed(static_cast<size_t>(computed_slice_count) *
+                                kFeatureSliceSize);
+  ResetMicroFeaturesWorkspace(workspace);
+  TfLiteStatus compute_status =
+      ComputeSpectrogram(error_reporter, samples, sample_count, workspace,
+                         computed.data(), computed.size());
+  if (compute_status != kTfLiteOk) {
+    return compute_status;
+  }
+  TfLiteStatus insert_status =
+      Insert(error_reporter, audio_hash, sample_count, computed.data(),
+             computed_slice_count);
+  if (insert_status != kTfLiteOk) {
+    return insert_status;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  const Entry& entry = index_[audio_hash];
+  *features = data_ + entry.features_offset;
+  *slice_count = entry.slice_count;
+  return kTfLiteOk;
+}
+
+uint64_t SpectrogramCache::entry_count() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return index_.size();
+}
+
+uint64_t SpectrogramCache::hit_count() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return hit_count_;
+}
+
+uint64_t SpectrogramCache::miss_count() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return miss_count_;
+}
+
+uint64_t SpectrogramCache::IndexRecords(uint64_t file_size) {
+  uint64_t offset = sizeof(PackHeader);
+  while (file_size - offset >= sizeof(RecordHeader)) {
+    const RecordHeader* record =
+        reinterpret_cast<const RecordHeader*>(data_ + offset);
+    const uint64_t features_offset = offset + sizeof(RecordHeader);
+    if ((record->magic != kRecordMagic) ||
+        (record->sample_count > INT32_MAX) ||
+        (static_cast<int>(record->slice_count) !=
+         MicroFeaturesSliceCount(record->sample_count))) {
+      break;
+    }
+    const uint64_t padded_size = PaddedFeaturesSize(record->slice_count);
+    if (padded_size > file_size - features_offset) {
+      break;
+    }
+    const uint8_t* features = data_ + features_offset;
+    if (record->checksum !=
+        Fnv1a64(features,
+                static_cast<size_t>(record->slice_count) * kFeatureSliceSize)) {
+      break;
+    }
+    Entry& entry = index_[record->audio_hash];
+    entry.features_offset = features_offset;
+    entry.sample_count = record->sample_count;
+    entry.slice_count = record->slice_count;
+    offset = features_offset + padded_size;
+  }
+  return offset;
+}
+
+bool SpectrogramCache::EnsureMapped(uint64_t size) {
+  if (size <= mapped_size_) {
+    return true;
+  }
+  // Mapping past the end of the file is allowed, and as the pack grows those
+  // pages fill in, so the mapping is made larger than needed.
+  uint64_t new_size = mapped_size_ + kMinMappingGrowth;
+  if (new_size < size) {
+    new_size = size;
+  }
+  if (new_size < 2 * mapped_size_) {
+    new_size = 2 * mapped_size_;
+  }
+  void* mapping = mmap(nullptr, new_size, PROT_READ, MAP_SHARED, fd_, 0);
+  if (mapping == MAP_FAILED) {
+    return false;
+  }
+  if (data_ != nullptr) {
+    old_mappings_.emplace_back(const_cast<uint8_t*>(data_), mapped_size_);
+  }
+  data_ = static_cast<const uint8_t*>(mapping);
+  mapped_size_ = new_size;
+  return true;
+}
@@ -0,0 +1,109 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_SPECTROGRAM_CACHE_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_SPECTROGRAM_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "micro_features_generator.h"
+#include "tensorflow/lite/c/c_api_internal.h"
+#include "tensorflow/lite/experimental/micro/micro_error_reporter.h"
+
+// A persistent cache of spectrograms, so that evaluating the same audio again
+// with a new model or new recognizer thresholds doesn't featurize it again.
+// Entries are keyed by a hash of the audio at kAudioSampleFrequency, and kept
+// in a pack file named after FrontendSettingsFingerprint(). A build whose
+// frontend settings differ in any way looks for a different pack, so stale
+// features are never returned.
+//
+// The pack is append-only, a short header followed by records that each hold
+// a spectrogram. Open() maps it into memory and indexes the records, and
+// Find() returns pointers straight into the mapping, so hits cost no copying.
+// New entries are appended under a file lock, which lets several processes
+// share a cache directory, although each only sees the others' entries once
+// it reopens the pack. A record left incomplete by a crash is cut off the
+// next time the pack is opened.
+//
+// All the methods are safe to call from several threads at once.
+class SpectrogramCache {
+ public:
+  SpectrogramCache();
+  ~SpectrogramCache();
+
+  // Opens this build's pack in directory, creating the pack if needed.
+  TfLiteStatus Open(tflite::ErrorReporter* error_reporter,
+                    const char* directory);
+  // Unmaps the pack, invalidating every pointer Find() has returned.
+  void Close();
+
+  // The key for a buffer of audio.
+  static uint64_t HashAudio(const int16_t* samples, size_t sample_count);
+
+  // Returns the features cached for the audio with this hash and length, and
+  // sets slice_count, or returns null if there are none.
+  const uint8_t* Find(uint64_t audio_hash, size_t sample_count,
+                      int* slice_count);
+
+  // Adds a spectrogram to the pack. Does nothing if it's already there.
+  TfLiteStatus Insert(tflite::ErrorReporter* error_reporter,
+                      uint64_t audio_hash, size_t sample_count,
+                      const uint8_t* features, int slice_count);
+
+  // Looks up the spectrogram of samples, or on a miss computes it with
+  // ComputeSpectrogram() from a reset workspace and adds it to the pack.
+  TfLiteStatus GetSpectrogram(tflite::ErrorReporter* error_reporter,
+                              const int16_t* samples, size_t sample_count,
+                              MicroFeaturesWorkspace* workspace,
+                              const uint8_t** features, int* slice_count);
+
+  uint64_t entry_count();
+  uint64_t hit_count();
+  uint64_t miss_count();
+
+ private:
+  struct Entry {
+    uint64_t features_offset;
+    uint64_t sample_count;
+    int slice_count;
+  };
+
+  // Checks the pack's header and indexes it, with the file lock held.
+  TfLiteStatus LoadPack(tflite::ErrorReporter* error_reporter,
+                        const char* path);
+  // Reads the records in the first file_size bytes into the index, and returns
+  // where the last complete one ends.
+  uint64_t IndexRecords(uint64_t file_size);
+  // Makes sure the mapping covers the first size bytes of the pack.
+  bool EnsureMapped(uint64_t size);
+
+  std::mutex mutex_;
+  int fd_;
+  const uint8_t* data_;
+  size_t mapped_size_;
+  // Earlier, smaller mappings stay alive so that pointers into them remain
+  // valid after the pack grows.
+  std::vector<std::pair<void*, size_t>> old_mappings_;
+  std::unordered_map<uint64_t, Entry> index_;
+  uint64_t hit_count_;
+  uint64_t miss_count_;
+};
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICRO_EXAMPLES_MICRO_SPEECH_TOOLS_SPECTROGRAM_CACHE_H_
@@ -0,0 +1,341 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Tunes RecognizeCommands by replaying inference logs through it with many
+// combinations of its settings, and scoring the commands it reports against
+// labelled keyword times. This is a standalone host program, built from the
+// project root with:
+//
+//   TFLM=.pio/libdeps/esp32s3/TensorFlowLite_ESP32/src
+//   g++ -std=c++17 -O2 -march=native -pthread -I src -I tools -I $TFLM
+//       -o /tmp/sweep_recognizer tools/sweep_recognizer.cpp
+//       tools/detection_scoring.cpp tools/inference_log.cpp
+//       src/micro_model_settings.cpp
+//       src/recognize_commands.cpp
+//       $TFLM/tensorflow/lite/experimental/micro/micro_error_reporter.cpp
+//       $TFLM/tensorflow/lite/experimental/micro/debug_log.cpp
+//   /tmp/sweep_recognizer [--threads=N] [--max_latency_ms=MS]
+//       [--window_ms=FIRST:LAST:STEP] [--threshold=FIRST:LAST:STEP]
+//       [--suppression_ms=FIRST:LAST:STEP] [--minimum_count=FIRST:LAST:STEP]
+//       [--output=results.csv] log labels [log labels ...]
+//
+// Logs come from tools/scan_recording.cpp --log. Each is paired with a text
+// file listing the keywords spoken in that recording, one per line, as the
+// time in seconds at which the word starts followed by its label, for example
+// "12.34 on". Lines starting with '#' are ignored. A reported command is a
+// true accept if a word with its label started at most --max_latency_ms
+// before it and hasn't been matched already, and its latency is the time
+// between the two. Every other reported command is a false accept, and every
+// word left unmatched is a miss. Like RespondToCommand(), this ignores silence
+// and unknown.
+//
+// Every combination in the four ranges is tried, spread across all cores, or
+// --threads of them. Each combination's results go to --output as a CSV row,
+// and the combinations that no other one beats on both recall and false
+// accepts per hour are printed, with the device's settings for comparison.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "detection_scoring.h"
+#include "inference_log.h"
+#include "micro_model_settings.h"
+#include "recognize_commands.h"
+
+namespace {
+
+struct LabelledLog {
+  std::vector<InferenceRecord> records;
+  std::vector<LabelledWord> words;
+};
+
+struct Range {
+  int first;
+  int last;
+  int step;
+};
+
+struct SweepResult {
+  RecognizerSettings settings;
+  DetectionScore score;
+};
+
+bool ParseRange(const char* text, Range* range) {
+  if (sscanf(text, "%d:%d:%d", &range->first, &range->last, &range->step) !=
+      3) {
+    return false;
+  }
+  return (range->step > 0) && (range->first <= range->last);
+}
+
+TfLiteStatus ReadLabels(tflite::ErrorReporter* error_reporter,
+                        const char* path, std::vector<LabelledWord>* words) {
+  FILE* file = fopen(path, "r");
+  if (file == nullptr) {
+    error_reporter->Report("Couldn't open '%s'", path);
+    return kTfLiteError;
+  }
+  char line[256];
+  int line_number = 0;
+  TfLiteStatus status = kTfLiteOk;
+  while ((status == kTfLiteOk) && (fgets(line, sizeof(line), file) != nullptr)) {
+    ++line_number;
+    double seconds;
+    char label[64];
+    if ((line[0] == '#') || (sscanf(line, " %63s", label) != 1)) {
+      continue;
+    }
+    LabelledWord word;
+    word.category = -1;
+    if (sscanf(line, "%lf %63s", &seconds, label) == 2) {
+      word.category = FindCategory(label);
+    }
+    if (word.category < 0) {
+      error_reporter->Report("Line %d of '%s' isn't a time and a known label",
+                             line_number, path);
+      status = kTfLiteError;
+      break;
+    }
+    word.sample_index = static_cast<int64_t>(seconds * kAudioSampleFrequency);
+    words->push_back(word);
+  }
+  fclose(file);
+  std::sort(words->begin(), words->end(),
+            [](const LabelledWord& a, const LabelledWord& b) {
+              return a.sample_index < b.sample_index;
+            });
+  return status;
+}
+
+// Replays every log through a recognizer with one combination of settings.
+void Evaluate(tflite::ErrorReporter* error_reporter,
+              const std::vector<LabelledLog>& logs, int64_t max_latency,
+              SweepResult* result) {
+  const RecognizerSettings& settings = result->settings;
+  // RecognizeCommands takes the scores as a model output tensor.
+  int dims[3] = {2, 1, kCategoryCount};
+  TfLiteTensor output;
+  memset(&output, 0, sizeof(output));
+  output.type = kTfLiteUInt8;
+  output.dims = reinterpret_cast<TfLiteIntArray*>(dims);
+
+  for (const LabelledLog& log : logs) {
+    RecognizeCommands recognizer(
+        error_reporter, settings.average_window_duration_ms,
+        settings.detection_threshold, settings.suppression_ms,
+        settings.minimum_count);
+    DetectionScorer scorer(&log.words, max_latency, &result->score);
+    for (const InferenceRecord& record : log.records) {
+      output.data.uint8 = const_cast<uint8_t*>(record.scores);
+      const char* found_command = nullptr;
+      uint8_t score = 0;
+      bool is_new_command = false;
+      recognizer.ProcessLatestResultsAtSample(&output, record.sample_index,
+                                              &found_command, &score,
+                                              &is_new_command);
+      if (!is_new_command) {
+        continue;
+      }
+      int category = kSilenceIndex;
+      for (int i = 0; i < kCategoryCount; ++i) {
+        if (found_command == kCategoryLabels[i]) {
+          category = i;
+        }
+      }
+      if ((category != kSilenceIndex) && (category != kUnknownIndex)) {
+        scorer.AddDetection(record.sample_index, category);
+      }
+    }
+    scorer.Finish();
+  }
+}
+
+void PrintResult(FILE* file, const SweepResult& result, double hours) {
+  const DetectionScore& score = result.score;
+  fprintf(file, "%d,%d,%d,%d,%d,%d,%d,%.4f,%.4f,%.3f,%.0f,%.0f\n",
+          result.settings.average_window_duration_ms,
+          result.settings.detection_threshold, result.settings.suppression_ms,
+          result.settings.minimum_count, score.true_accepts,
+          score.false_accepts, score.misses, score.Precision(), score.Recall(),
+          score.false_accepts / hours, score.MeanLatencyMs(),
+          static_cast<double>(score.max_latency) / kAudioSamplesPerMs);
+}
+
+constexpr char kCsvHeader[] =
+    "window_ms,threshold,suppression_ms,minimum_count,true_accepts,"
+    "false_accepts,misses,precision,recall,false_accepts_per_hour,"
+    "mean_latency_ms,max_latency_ms\n";
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  tflite::MicroErrorReporter micro_error_reporter;
+  tflite::ErrorReporter* error_reporter = &micro_error_reporter;
+
+  int thread_count = std::thread::hardware_concurrency();
+  int max_latency_ms = 1500;
+  Range windows = {250, 2000, 250};
+  Range thresholds = {100, 250, 10};
+  Range suppressions = {500, 2500, 500};
+  Range minimum_counts = {1, 5, 1};
+  const char* output_path = nullptr;
+  std::vector<const char*> positional;
+  bool is_usage_ok = true;
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i], "--threads=", 10) == 0) {
+      thread_count = atoi(argv[i] + 10);
+    } else if (strncmp(argv[i], "--max_latency_ms=", 17) == 0) {
+      max_latency_ms = atoi(argv[i] + 17);
+    } else if (strncmp(argv[i], "--window_ms=", 12) == 0) {
+      is_usage_ok &= ParseRange(argv[i] + 12, &windows);
+    } else if (strncmp(argv[i], "--threshold=", 12) == 0) {
+      is_usage_ok &= ParseRange(argv[i] + 12, &thresholds);
+    } else if (strncmp(argv[i], "--suppression_ms=", 17) == 0) {
+      is_usage_ok &= ParseRange(argv[i] + 17, &suppressions);
+    } else if (strncmp(argv[i], "--minimum_count=", 16) == 0) {
+      is_usage_ok &= ParseRange(argv[i] + 16, &minimum_counts);
+    } else if (strncmp(argv[i], "--output=", 9) == 0) {
+      output_path = argv[i] + 9;
+    } else {
+      positional.push_back(argv[i]);
+    }
+  }
+  if (!is_usage_ok || positional.empty() || (positional.size() % 2 != 0) ||
+      (thresholds.first < 0) || (thresholds.last > 255)) {
+    fprintf(stderr,
+            "Usage: %s [--threads=N] [--max_latency_ms=MS] "
+            "[--window_ms=FIRST:LAST:STEP] [--threshold=FIRST:LAST:STEP] "
+            "[--suppression_ms=FIRST:LAST:STEP] "
+            "[--minimum_count=FIRST:LAST:STEP] [--output=results.csv] "
+            "log labels [log labels ...]\n",
+            argv[0]);
+    return 1;
+  }
+  if (thread_count < 1) {
+    thread_count = 1;
+  }
+
+  std::vector<LabelledLog> logs(positional.size() / 2);
+  int64_t total_samples = 0;
+  int word_count = 0;
+  for (size_t i = 0; i < logs.size(); ++i) {
+    if ((ReadInferenceLog(error_reporter, positional[2 * i],
+                          &logs[i].records) != kTfLiteOk) ||
+        (ReadLabels(error_reporter, positional[(2 * i) + 1],
+                    &logs[i].words) != kTfLiteOk)) {
+      return 1;
+    }
+    if (!logs[i].records.empty()) {
+      total_samples += logs[i].records.back().sample_index;
+    }
+    word_count += logs[i].words.size();
+  }
+  const double hours =
+      std::max(1.0, static_cast<double>(total_samples)) /
+      (3600.0 * kAudioSampleFrequency);
+
+  std::vector<SweepResult> results;
+  for (int window = windows.first; window <= windows.last;
+       window += windows.step) {
+    for (int threshold = thresholds.first; threshold <= thresholds.last;
+         threshold += thresholds.step) {
+      for (int suppression = suppressions.first;
+           suppression <= suppressions.last; suppression += suppressions.step) {
+        for (int minimum_count = minimum_counts.first;
+             minimum_count <= minimum_counts.last;
+             minimum_count += minimum_counts.step) {
+          SweepResult result;
+          result.settings.average_window_duration_ms = window;
+          result.settings.detection_threshold = threshold;
+          result.settings.suppression_ms = suppression;
+          result.settings.minimum_count = minimum_count;
+          results.push_back(result);
+        }
+      }
+    }
+  }
+  // The device's own settings are always evaluated, for reference.
+  results.push_back(SweepResult());
+  const int64_t max_latency =
+      static_cast<int64_t>(max_latency_ms) * kAudioSamplesPerMs;
+
+  const auto start = std::chrono::steady_clock::now();
+  std::atomic<size_t> next_result(0);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < thread_count; ++i) {
+    workers.emplace_back([&] {
+      tflite::MicroErrorReporter worker_error_reporter;
+      for (size_t index = next_result++; index < results.size();
+           index = next_result++) {
+        Evaluate(&worker_error_reporter, logs, max_latency, &results[index]);
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+  const SweepResult device_result = results.back();
+  results.pop_back();
+
+  if (output_path != nullptr) {
+    FILE* output = fopen(output_path, "w");
+    if (output == nullptr) {
+      fprintf(stderr, "Couldn't open '%s' for writing\n", output_path);
+      return 1;
+    }
+    fputs(kCsvHeader, output);
+    for (const SweepResult& result : results) {
+      PrintResult(output, result, hours);
+    }
+    fclose(output);
+  }
+
+  printf("Tried %d settings over %.2f hours of logs with %d words in %.1f s "
+         "on %d threads\n",
+         static_cast<int>(results.size()), hours, word_count, seconds,
+         thread_count);
+  // Once sorted by false accepts, and then by recall from best to worst, each
+  // result is only worth listing if it has better recall than every result
+  // before it, since those all have as few false accepts or fewer.
+  std::vector<SweepResult> sorted = results;
+  std::sort(sorted.begin(), sorted.end(),
+            [](const SweepResult& a, const SweepResult& b) {
+              if (a.score.false_accepts != b.score.false_accepts) {
+                return a.score.false_accepts < b.score.false_accepts;
+              }
+              return a.score.true_accepts > b.score.true_accepts;
+            });
+  printf("Best trade-offs between recall and false accepts:\n");
+  fputs(kCsvHeader, stdout);
+  int best_true_accepts = -1;
+  for (const SweepResult& result : sorted) {
+    if (result.score.true_accepts > best_true_accepts) {
+      best_true_accepts = result.score.true_accepts;
+      PrintResult(stdout, result, hours);
+    }
+  }
+  printf("Device settings:\n");
+  PrintResult(stdout, device_result, hours);
+  return 0;
+}
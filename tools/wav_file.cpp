@@ -0,0 +1,147 @@
+/* Copyright 2019 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "wav_file.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr uint16_t kFormatPcm = 1;
+constexpr uint16_t kFormatFloat = 3;
+constexpr uint16_t kFormatExtensible = 0xfffe;
+
+uint16_t ReadLittleEndian16(const uint8_t* data) {
+  return data[0] | (data[1] << 8);
+}
+
+uint32_t ReadLittleEndian32(const uint8_t* data) {
+  return data[0] | (data[1] << 8) | (data[2] << 16) |
+         (static_cast<uint32_t>(data[3]) << 24);
+}
+
+// Decodes one sample to a float in [-1, 1).
+float DecodeSample(const uint8_t* data, uint16_t format, int bits) {
+  if (format == kFormatFloat) {
+    float value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+  }
+  switch (bits) {
+    case 8:
+      return (data[0] - 128) / 128.0f;
+    case 16:
+      return static_cast<int16_t>(ReadLittleEndian16(data)) / 32768.0f;
+    case 24: {
+      const int32_t value = static_cast<int32_t>(
+          (data[0] << 8) | (data[1] << 16) |
+          (static_cast<uint32_t>(data[2]) << 24));
+      return (value >> 8) / 8388608.0f;
+    }
+    default:
+      return static_cast<int32_t>(ReadLittleEndian32(data)) / 2147483648.0f;
+  }
+}
+
+}  // namespace
+
+TfLiteStatus ReadWavFile(tflite::ErrorReporter* error_reporter,
+                         const char* path, std::vector<int16_t>* samples,
+                         int* sample_rate) {
+  FILE* file = fopen(path, "rb");
+  if (file == nullptr) {
+    error_reporter->Report("Couldn't open %s", path);
+    return kTfLiteError;
+  }
+  std::vector<uint8_t> contents;
+  uint8_t buffer[4096];
+  size_t bytes_read;
+  while ((bytes_read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    contents.insert(contents.end(), buffer, buffer + bytes_read);
+  }
+  fclose(file);
+
+  if ((contents.size() < 12) || (memcmp(contents.data(), "RIFF", 4) != 0) ||
+      (memcmp(contents.data() + 8, "WAVE", 4) != 0)) {
+    error_reporter->Report("%s isn't a WAVE file", path);
+    return kTfLiteError;
+  }
+
+  uint16_t format = 0;
+  int channels = 0;
+  int bits = 0;
+  int rate = 0;
+  const uint8_t* data = nullptr;
+  size_t data_size = 0;
+  size_t offset = 12;
+  while (offset + 8 <= contents.size()) {
+    const uint8_t* chunk = contents.data() + offset;
+    size_t chunk_size = ReadLittleEndian32(chunk + 4);
+    if (chunk_size > contents.size() - offset - 8) {
+      // Streaming writers sometimes leave the size unset, so take what's there.
+      chunk_size = contents.size() - offset - 8;
+    }
+    if ((memcmp(chunk, "fmt ", 4) == 0) && (chunk_size >= 16)) {
+      format = ReadLittleEndian16(chunk + 8);
+      channels = ReadLittleEndian16(chunk + 10);
+      rate = ReadLittleEndian32(chunk + 12);
+      bits = ReadLittleEndian16(chunk + 22);
+      if ((format == kFormatExtensible) && (chunk_size >= 26)) {
+        format = ReadLittleEndian16(chunk + 32);
+      }
+    } else if (memcmp(chunk, "data", 4) == 0) {
+      data = chunk + 8;
+      data_size = chunk_size;
+    }
+    offset += 8 + chunk_size + (chunk_size & 1);
+  }
+
+  const bool is_supported =
+      ((format == kFormatPcm) &&
+       ((bits == 8) || (bits == 16) || (bits == 24) || (bits == 32))) ||
+      ((format == kFormatFloat) && (bits == 32));
+  if (!is_supported || (channels < 1) || (rate <= 0)) {
+    error_reporter->Report(
+        "%s has format %d with %d bits and %d channels, which isn't supported",
+        path, format, bits, channels);
+    return kTfLiteError;
+  }
+  if (data == nullptr) {
+    error_reporter->Report("%s has no data chunk", path);
+    return kTfLiteError;
+  }
+
+  const int frame_size = (bits / 8) * channels;
+  const size_t frame_count = data_size / frame_size;
+  samples->resize(frame_count);
+  for (size_t frame = 0; frame < frame_count; ++frame) {
+    float sum = 0.0f;
+    for (int channel = 0; channel < channels; ++channel) {
+      sum += DecodeSample(data + (frame * frame_size) + (channel * (bits / 8)),
+                          format, bits);
+    }
+    float value = roundf((sum / channels) * 32768.0f);
+    if (value > 32767.0f) {
+      value = 32767.0f;
+    } else if (value < -32768.0f) {
+      value = -32768.0f;
+    }
+    (*samples)[frame] = static_cast<int16_t>(value);
+  }
+  *sample_rate = rate;
+  return kTfLiteOk;
+}